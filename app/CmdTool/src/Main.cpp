@@ -17,9 +17,13 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <signal.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 int main(int argc, char* argv[])
@@ -45,6 +49,27 @@ int main(int argc, char* argv[])
     return std::stoi(arguments.back());
   }
 
+  if (arguments.size() == 2 && arguments.front() == "--touch")
+  {
+    return std::ofstream{arguments.back()} ? 0 : 1;
+  }
+
+  if (arguments.size() == 3 && arguments.front() == "--wait")
+  {
+    const auto path = std::filesystem::path{arguments[1]};
+    const auto timeout = std::chrono::milliseconds{std::stoi(arguments[2])};
+    const auto endTime = std::chrono::steady_clock::now() + timeout;
+    while (!std::filesystem::exists(path))
+    {
+      if (std::chrono::steady_clock::now() >= endTime)
+      {
+        return 1;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    return 0;
+  }
+
   if (!arguments.empty() && arguments.front() == "--printArgs")
   {
     for (size_t i = 1; i < arguments.size(); ++i)
@@ -58,6 +83,8 @@ int main(int argc, char* argv[])
             << "  --abort      Abort the program by calling std::abort\n"
             << "  --crash      Crash the program by raising the SIGSEGV signal\n"
             << "  --exit n     Return exit code n\n"
+            << "  --touch f    Create file f\n"
+            << "  --wait f ms  Wait up to ms milliseconds for file f to exist\n"
             << "  --printArgs  Print all remaining arguments line by line\n";
 
   return -1;
@@ -0,0 +1,229 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IntersectionBenchmarks.h"
+
+#include "mdl/Polyhedron.h"
+#include "mdl/Polyhedron3.h"
+
+#include "vm/intersection.h"
+#include "vm/packed_intersection.h"
+#include "vm/scalar.h"
+#include "vm/vec.h"
+
+#include <optional>
+#include <random>
+#include <ranges>
+
+namespace tb::benchmarks
+{
+namespace
+{
+
+constexpr auto Radius = 64.0;
+constexpr auto PolyhedronCount = std::size_t(16);
+constexpr auto PolyhedronPointCount = std::size_t(48);
+constexpr auto TriangleCount = std::size_t(500);
+
+struct Face
+{
+  vm::plane3d plane;
+  std::vector<vm::vec3d> vertices;
+};
+
+struct Polyhedron
+{
+  std::vector<Face> faces;
+  vm::packed_planes<double> planes;
+};
+
+vm::vec3d createPoint(const double radius, std::mt19937& rng)
+{
+  auto distribution = std::uniform_real_distribution<double>{-radius, radius};
+  return vm::vec3d{distribution(rng), distribution(rng), distribution(rng)};
+}
+
+/**
+ * Creates convex polyhedra with a few dozen faces each, similar to a detailed brush.
+ */
+std::vector<Polyhedron> createPolyhedra(std::mt19937& rng)
+{
+  auto result = std::vector<Polyhedron>{};
+  result.reserve(PolyhedronCount);
+
+  while (result.size() < PolyhedronCount)
+  {
+    auto points = std::vector<vm::vec3d>{};
+    for (std::size_t i = 0; i < PolyhedronPointCount; ++i)
+    {
+      points.push_back(createPoint(Radius, rng));
+    }
+
+    const auto polyhedron = mdl::Polyhedron3{points};
+    auto faces = std::vector<Face>{};
+    for (const auto* face : polyhedron.faces())
+    {
+      faces.push_back(Face{face->plane(), face->vertexPositions()});
+    }
+
+    auto planes = vm::packed_planes<double>{
+      faces | std::views::transform([](const auto& face) { return face.plane; })};
+    result.push_back(Polyhedron{std::move(faces), std::move(planes)});
+  }
+
+  return result;
+}
+
+/**
+ * Creates small triangles scattered in a ball, similar to the triangles of an entity
+ * model.
+ */
+std::vector<vm::vec3f> createTriangles(std::mt19937& rng)
+{
+  auto result = std::vector<vm::vec3f>{};
+  result.reserve(3 * TriangleCount);
+
+  for (std::size_t i = 0; i < TriangleCount; ++i)
+  {
+    const auto center = createPoint(Radius, rng);
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+      result.push_back(vm::vec3f{center + createPoint(Radius / 8.0, rng)});
+    }
+  }
+
+  return result;
+}
+
+std::vector<vm::ray3d> createRays(const std::size_t rayCount, std::mt19937& rng)
+{
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(rayCount);
+
+  for (std::size_t i = 0; i < rayCount; ++i)
+  {
+    const auto origin = createPoint(4.0 * Radius, rng);
+    const auto target = createPoint(Radius, rng);
+    result.emplace_back(origin, vm::normalize(target - origin));
+  }
+
+  return result;
+}
+
+std::optional<double> intersectFaces(const vm::ray3d& ray, const std::vector<Face>& faces)
+{
+  for (const auto& face : faces)
+  {
+    if (vm::dot(face.plane.normal, ray.direction) < 0.0)
+    {
+      if (
+        const auto distance = vm::intersect_ray_polygon(
+          ray, face.plane, face.vertices.begin(), face.vertices.end()))
+      {
+        return distance;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+std::vector<BenchmarkResult> runIntersectionBenchmarks(
+  const IntersectionBenchmarkConfig& config)
+{
+  const auto rayCount = config.rayCount;
+
+  auto rng = std::mt19937{config.seed};
+  auto results = std::vector<BenchmarkResult>{};
+
+  // count the hits so that the intersection tests are not optimized away
+  auto hitCount = std::size_t(0);
+  const auto record = [&](std::string name, const auto& f) {
+    results.push_back(BenchmarkResult{std::move(name), rayCount, measure(f)});
+  };
+
+  const auto polyhedra = createPolyhedra(rng);
+  const auto rays = createRays(rayCount, rng);
+
+  record("ray vs convex polyhedron faces", [&]() {
+    for (const auto& ray : rays)
+    {
+      for (const auto& polyhedron : polyhedra)
+      {
+        hitCount += intersectFaces(ray, polyhedron.faces) ? 1 : 0;
+      }
+    }
+  });
+
+  record("ray vs convex polyhedron packed planes", [&]() {
+    for (const auto& ray : rays)
+    {
+      for (const auto& polyhedron : polyhedra)
+      {
+        const auto hit = vm::intersect_ray_convex_polyhedron(ray, polyhedron.planes);
+        hitCount += hit ? 1 : 0;
+      }
+    }
+  });
+
+  const auto triangles = createTriangles(rng);
+  auto packedTriangles = vm::packed_triangles<float>{};
+  packedTriangles.reserve(TriangleCount);
+  for (std::size_t i = 0; i < TriangleCount; ++i)
+  {
+    packedTriangles.push_back(
+      triangles[3 * i + 0], triangles[3 * i + 1], triangles[3 * i + 2]);
+  }
+
+  auto raysf = std::vector<vm::ray3f>{};
+  raysf.reserve(rays.size());
+  for (const auto& ray : rays)
+  {
+    raysf.emplace_back(ray);
+  }
+
+  record("ray vs triangles", [&]() {
+    for (const auto& ray : raysf)
+    {
+      auto closestDistance = std::optional<float>{};
+      for (std::size_t i = 0; i < TriangleCount; ++i)
+      {
+        closestDistance = vm::safe_min(
+          closestDistance,
+          vm::intersect_ray_triangle(
+            ray, triangles[3 * i + 0], triangles[3 * i + 1], triangles[3 * i + 2]));
+      }
+      hitCount += closestDistance ? 1 : 0;
+    }
+  });
+
+  record("ray vs packed triangles", [&]() {
+    for (const auto& ray : raysf)
+    {
+      hitCount += vm::intersect_ray_triangles(ray, packedTriangles) ? 1 : 0;
+    }
+  });
+
+  [[maybe_unused]] volatile const auto hitCountSink = hitCount;
+
+  return results;
+}
+
+} // namespace tb::benchmarks
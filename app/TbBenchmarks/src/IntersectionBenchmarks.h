@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tb::benchmarks
+{
+
+struct IntersectionBenchmarkConfig
+{
+  std::size_t rayCount;
+  std::uint32_t seed;
+};
+
+/**
+ * Times picking convex polyhedra and triangle soups with the configured number of random
+ * rays, once face by face or triangle by triangle and once with the packed kernels.
+ */
+std::vector<BenchmarkResult> runIntersectionBenchmarks(
+  const IntersectionBenchmarkConfig& config);
+
+} // namespace tb::benchmarks
@@ -0,0 +1,239 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IntersectionBenchmarks.h"
+#include "MapBenchmarks.h"
+#include "NodeTreeBenchmarks.h"
+#include "PolyhedronBenchmarks.h"
+
+#include "kd/string_utils.h"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tb::benchmarks
+{
+namespace
+{
+
+struct Options
+{
+  std::vector<std::size_t> brushCounts = {1'000, 10'000, 100'000, 1'000'000};
+  std::vector<std::size_t> pointCounts = {1'000, 10'000, 100'000};
+  std::vector<std::size_t> rayCounts = {10'000, 100'000};
+  std::vector<std::size_t> nodeCounts = {100'000, 1'000'000};
+  std::uint32_t seed = 1;
+  std::optional<std::filesystem::path> outputPath = std::nullopt;
+  std::filesystem::path workDir = std::filesystem::temp_directory_path();
+};
+
+std::optional<Options> parseOptions(const std::vector<std::string>& arguments)
+{
+  auto options = Options{};
+
+  for (std::size_t i = 0; i + 1 < arguments.size(); i += 2)
+  {
+    const auto& option = arguments[i];
+    const auto& value = arguments[i + 1];
+
+    if (option == "--sizes")
+    {
+      options.brushCounts.clear();
+      for (const auto& size : kdl::str_split(value, ","))
+      {
+        options.brushCounts.push_back(std::stoul(size));
+      }
+    }
+    else if (option == "--points")
+    {
+      options.pointCounts.clear();
+      for (const auto& pointCount : kdl::str_split(value, ","))
+      {
+        options.pointCounts.push_back(std::stoul(pointCount));
+      }
+    }
+    else if (option == "--rays")
+    {
+      options.rayCounts.clear();
+      for (const auto& rayCount : kdl::str_split(value, ","))
+      {
+        options.rayCounts.push_back(std::stoul(rayCount));
+      }
+    }
+    else if (option == "--nodes")
+    {
+      options.nodeCounts.clear();
+      for (const auto& nodeCount : kdl::str_split(value, ","))
+      {
+        options.nodeCounts.push_back(std::stoul(nodeCount));
+      }
+    }
+    else if (option == "--seed")
+    {
+      options.seed = std::uint32_t(std::stoul(value));
+    }
+    else if (option == "--output")
+    {
+      options.outputPath = value;
+    }
+    else if (option == "--work-dir")
+    {
+      options.workDir = value;
+    }
+    else
+    {
+      return std::nullopt;
+    }
+  }
+
+  if (arguments.size() % 2 != 0)
+  {
+    return std::nullopt;
+  }
+
+  return options;
+}
+
+void writeResults(
+  std::ostream& stream,
+  const Options& options,
+  const std::vector<BenchmarkResult>& results)
+{
+  stream << "{\n";
+  stream << fmt::format("  \"seed\": {},\n", options.seed);
+  stream << "  \"results\": [";
+
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    const auto& result = results[i];
+    stream << (i == 0 ? "\n" : ",\n")
+           << fmt::format(
+                R"(    {{"name": "{}", "size": {}, "milliseconds": {:.3f}}})",
+                result.name,
+                result.size,
+                result.milliseconds);
+  }
+
+  stream << "\n  ]\n}\n";
+}
+
+} // namespace
+} // namespace tb::benchmarks
+
+int main(int argc, char* argv[])
+{
+  using namespace tb::benchmarks;
+
+  auto arguments = std::vector<std::string>{};
+  for (std::size_t i = 1; i < std::size_t(argc); ++i)
+  {
+    arguments.emplace_back(argv[i]);
+  }
+
+  const auto options = parseOptions(arguments);
+  if (!options)
+  {
+    std::cout << "Usage:\n"
+              << "  --sizes n,...   Benchmark maps with n brushes each "
+                 "(default 1000,10000,100000,1000000)\n"
+              << "  --points n,...  Benchmark convex hulls of n points each "
+                 "(default 1000,10000,100000)\n"
+              << "  --rays n,...    Benchmark ray intersections with n rays each "
+                 "(default 10000,100000)\n"
+              << "  --nodes n,...   Benchmark node trees with n nodes each "
+                 "(default 100000,1000000)\n"
+              << "  --seed n        Seed for generating the maps, points, rays and nodes "
+                 "(default 1)\n"
+              << "  --output f      Write the results to file f instead of stdout\n"
+              << "  --work-dir d    Save the generated maps in directory d "
+                 "(default temp dir)\n";
+    return -1;
+  }
+
+  auto results = std::vector<BenchmarkResult>{};
+  for (const auto brushCount : options->brushCounts)
+  {
+    std::cerr << "Benchmarking map with " << brushCount << " brushes\n";
+
+    auto mapResults = runMapBenchmarks(MapBenchmarkConfig{
+      .brushCount = brushCount,
+      .seed = options->seed,
+      .workDir = options->workDir,
+    });
+    results.insert(results.end(), mapResults.begin(), mapResults.end());
+  }
+
+  for (const auto pointCount : options->pointCounts)
+  {
+    std::cerr << "Benchmarking convex hulls with " << pointCount << " points\n";
+
+    auto polyhedronResults = runPolyhedronBenchmarks(PolyhedronBenchmarkConfig{
+      .pointCount = pointCount,
+      .seed = options->seed,
+    });
+    results.insert(results.end(), polyhedronResults.begin(), polyhedronResults.end());
+  }
+
+  for (const auto rayCount : options->rayCounts)
+  {
+    std::cerr << "Benchmarking ray intersections with " << rayCount << " rays\n";
+
+    auto intersectionResults = runIntersectionBenchmarks(IntersectionBenchmarkConfig{
+      .rayCount = rayCount,
+      .seed = options->seed,
+    });
+    results.insert(
+      results.end(), intersectionResults.begin(), intersectionResults.end());
+  }
+
+  for (const auto nodeCount : options->nodeCounts)
+  {
+    std::cerr << "Benchmarking node tree with " << nodeCount << " nodes\n";
+
+    auto nodeTreeResults = runNodeTreeBenchmarks(NodeTreeBenchmarkConfig{
+      .nodeCount = nodeCount,
+      .seed = options->seed,
+    });
+    results.insert(results.end(), nodeTreeResults.begin(), nodeTreeResults.end());
+  }
+
+  if (options->outputPath)
+  {
+    auto stream = std::ofstream{*options->outputPath};
+    if (!stream)
+    {
+      std::cerr << "Could not open " << *options->outputPath << "\n";
+      return 1;
+    }
+    writeResults(stream, *options, results);
+  }
+  else
+  {
+    writeResults(std::cout, *options, results);
+  }
+
+  return 0;
+}
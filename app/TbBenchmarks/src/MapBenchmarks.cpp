@@ -0,0 +1,271 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapBenchmarks.h"
+
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/Map.h"
+#include "mdl/MapFixture.h"
+#include "mdl/Map_Geometry.h"
+#include "mdl/Map_Groups.h"
+#include "mdl/Map_Nodes.h"
+#include "mdl/Map_Picking.h"
+#include "mdl/Map_Selection.h"
+#include "mdl/NodeQueries.h"
+#include "mdl/PickResult.h"
+#include "mdl/Transaction.h"
+#include "mdl/WorldNode.h"
+
+#include "kd/contracts.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::benchmarks
+{
+namespace
+{
+
+constexpr auto CellSize = 64.0;
+constexpr auto MaterialCount = 8;
+constexpr auto LinkedGroupBrushCount = std::size_t(256);
+constexpr auto PickRayCount = std::size_t(1000);
+constexpr auto TransformStepCount = std::size_t(4);
+
+const auto BenchmarkFixtureConfig = mdl::MapFixtureConfig{
+  .mapFormat = mdl::MapFormat::Valve,
+};
+
+double gridExtent(const std::size_t brushCount)
+{
+  const auto cellsPerAxis = std::ceil(std::cbrt(double(brushCount)));
+  return cellsPerAxis * CellSize;
+}
+
+/**
+ * Creates axis aligned cuboids of random size in the cells of a cubic grid centered at
+ * the origin. The cuboids are smaller than the cells, so no two brushes touch.
+ */
+std::vector<mdl::Node*> createBrushNodes(
+  const mdl::Map& map, const std::size_t brushCount, std::mt19937& rng)
+{
+  const auto builder =
+    mdl::BrushBuilder{map.worldNode().mapFormat(), map.worldBounds()};
+
+  const auto cellsPerAxis = std::size_t(gridExtent(brushCount) / CellSize);
+  const auto origin = vm::vec3d::fill(-gridExtent(brushCount) / 2.0);
+
+  auto sizeDistribution = std::uniform_int_distribution<int>{2, 7};
+  auto materialDistribution = std::uniform_int_distribution<int>{0, MaterialCount - 1};
+
+  auto result = std::vector<mdl::Node*>{};
+  result.reserve(brushCount);
+
+  for (std::size_t i = 0; i < brushCount; ++i)
+  {
+    const auto cell = vm::vec3d{
+      double(i % cellsPerAxis),
+      double(i / cellsPerAxis % cellsPerAxis),
+      double(i / (cellsPerAxis * cellsPerAxis)),
+    };
+    const auto size = vm::vec3d{
+      8.0 * sizeDistribution(rng),
+      8.0 * sizeDistribution(rng),
+      8.0 * sizeDistribution(rng),
+    };
+    const auto min = origin + cell * CellSize;
+    const auto materialName =
+      fmt::format("benchmark/material{}", materialDistribution(rng));
+
+    result.push_back(new mdl::BrushNode{
+      builder.createCuboid(vm::bbox3d{min, min + size}, materialName) | kdl::value()});
+  }
+
+  return result;
+}
+
+std::vector<vm::ray3d> createPickRays(const std::size_t brushCount, std::mt19937& rng)
+{
+  const auto extent = gridExtent(brushCount);
+  auto distribution = std::uniform_real_distribution<double>{-extent / 2.0, extent / 2.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(PickRayCount);
+
+  for (std::size_t i = 0; i < PickRayCount; ++i)
+  {
+    const auto origin = vm::vec3d{distribution(rng), distribution(rng), extent};
+    const auto target = vm::vec3d{distribution(rng), distribution(rng), -extent};
+    result.emplace_back(origin, vm::normalize(target - origin));
+  }
+
+  return result;
+}
+
+std::vector<mdl::Node*> collectBrushNodes(mdl::Node& parent, const std::size_t maxCount)
+{
+  auto result = std::vector<mdl::Node*>{};
+  for (auto* child : parent.children())
+  {
+    if (result.size() == maxCount)
+    {
+      break;
+    }
+    if (dynamic_cast<mdl::BrushNode*>(child))
+    {
+      result.push_back(child);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+std::vector<BenchmarkResult> runMapBenchmarks(const MapBenchmarkConfig& config)
+{
+  const auto brushCount = config.brushCount;
+  const auto mapPath = config.workDir / fmt::format("benchmark-{}.map", brushCount);
+
+  auto rng = std::mt19937{config.seed};
+  auto results = std::vector<BenchmarkResult>{};
+
+  const auto record = [&](std::string name, const auto& f) {
+    results.push_back(BenchmarkResult{std::move(name), brushCount, measure(f)});
+  };
+
+  {
+    auto fixture = mdl::MapFixture{};
+    auto& map = fixture.create(BenchmarkFixtureConfig);
+
+    auto brushNodes = createBrushNodes(map, brushCount, rng);
+    record("add nodes", [&]() {
+      addNodes(map, {{parentForNodes(map), std::move(brushNodes)}});
+    });
+
+    record("save", [&]() { contract_assert(map.saveAs(mapPath) | kdl::is_success()); });
+  }
+
+  auto fixture = mdl::MapFixture{};
+  auto* mapPtr = static_cast<mdl::Map*>(nullptr);
+  record("load", [&]() { mapPtr = &fixture.load(mapPath, BenchmarkFixtureConfig); });
+
+  auto& map = *mapPtr;
+
+  record("select all", [&]() { selectAllNodes(map); });
+  record("translate", [&]() { translateSelection(map, vm::vec3d{16, 0, 0}); });
+  record("undo", [&]() { map.undoCommand(); });
+  record("redo", [&]() { map.redoCommand(); });
+
+  // A transform made of several commands in one transaction, observed by per node
+  // bookkeeping similar to the map renderer's. Observing nodesDidChangeNotifier is how
+  // the renderer was notified before node change batching.
+  const auto transformInTransaction = [&]() {
+    auto transaction = mdl::Transaction{map, "benchmark"};
+    for (std::size_t i = 0; i < TransformStepCount; ++i)
+    {
+      translateSelection(map, vm::vec3d{16, 0, 0});
+    }
+    transaction.commit();
+  };
+
+  auto trackedNodes = std::unordered_map<mdl::Node*, std::size_t>{};
+  const auto trackChangedNodes = [&](const std::vector<mdl::Node*>& nodes) {
+    for (auto* node : nodes)
+    {
+      ++trackedNodes[node];
+    }
+  };
+
+  {
+    const auto connection = map.nodesDidChangeNotifier.connect(trackChangedNodes);
+    record("transform notified per command", transformInTransaction);
+  }
+  {
+    const auto connection = map.batchedNodesDidChangeNotifier.connect(trackChangedNodes);
+    record("transform notified per transaction", transformInTransaction);
+  }
+
+  deselectAll(map);
+
+  // subtract a cube at the center of the grid from all brushes it touches
+  const auto builder =
+    mdl::BrushBuilder{map.worldNode().mapFormat(), map.worldBounds()};
+  auto* subtrahendNode = new mdl::BrushNode{
+    builder.createCuboid(
+      vm::bbox3d{vm::vec3d::fill(-100.0), vm::vec3d::fill(100.0)}, "benchmark/subtrahend")
+    | kdl::value()};
+  addNodes(map, {{parentForNodes(map), {subtrahendNode}}});
+  selectNodes(map, {subtrahendNode});
+
+  record("csg subtract", [&]() { csgSubtract(map); });
+
+  deselectAll(map);
+
+  // link a group of brushes and change the contents of one of the linked groups
+  selectNodes(
+    map, collectBrushNodes(*map.worldNode().defaultLayer(), LinkedGroupBrushCount));
+  auto* groupNode = groupSelectedNodes(map, "benchmark");
+
+  deselectAll(map);
+  selectNodes(map, {groupNode});
+  createLinkedDuplicate(map);
+
+  deselectAll(map);
+  openGroup(map, *groupNode);
+  selectNodes(map, groupNode->children());
+
+  record("update linked groups", [&]() { translateSelection(map, vm::vec3d{0, 16, 0}); });
+
+  deselectAll(map);
+  closeGroup(map);
+
+  const auto nodes = mdl::collectNodesAndDescendants({&map.worldNode()});
+  const auto validators = map.worldNode().registeredValidators();
+  record("validate", [&]() {
+    for (auto* node : nodes)
+    {
+      node->invalidateIssues();
+      node->issues(validators);
+    }
+  });
+
+  const auto pickRays = createPickRays(brushCount, rng);
+  record("pick", [&]() {
+    for (const auto& pickRay : pickRays)
+    {
+      auto pickResult = mdl::PickResult{};
+      pick(map, pickRay, pickResult);
+    }
+  });
+
+  return results;
+}
+
+} // namespace tb::benchmarks
@@ -0,0 +1,47 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace tb::benchmarks
+{
+
+struct MapBenchmarkConfig
+{
+  std::size_t brushCount;
+  std::uint32_t seed;
+  std::filesystem::path workDir;
+};
+
+/**
+ * Generates a map with the configured number of brushes, saves it, loads it again and
+ * times a fixed sequence of operations on the loaded map. The operations build on each
+ * other, e.g. undo reverts the preceding translation, so the results are only comparable
+ * between runs with the same configuration.
+ */
+std::vector<BenchmarkResult> runMapBenchmarks(const MapBenchmarkConfig& config);
+
+} // namespace tb::benchmarks
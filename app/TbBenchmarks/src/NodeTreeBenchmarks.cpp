@@ -0,0 +1,122 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NodeTreeBenchmarks.h"
+
+#include "mdl/Octree.h"
+
+#include "kd/contracts.h"
+#include "kd/task_manager.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <cmath>
+#include <random>
+#include <utility>
+
+namespace tb::benchmarks
+{
+namespace
+{
+
+// same as the node tree of a world node
+constexpr auto MinNodeSize = 256.0;
+constexpr auto CellSize = 64.0;
+constexpr auto LargeNodeRatio = 100;
+
+using NodeTree = mdl::octree<double, std::size_t>;
+using NodeTreeItems = std::vector<std::pair<vm::bbox3d, std::size_t>>;
+
+/**
+ * Creates the bounds of brush sized nodes in the cells of a cubic grid centered at the
+ * origin, and every so often the bounds of a large node such as a long wall or a floor
+ * that spans many cells.
+ */
+NodeTreeItems createItems(const std::size_t nodeCount, std::mt19937& rng)
+{
+  const auto cellsPerAxis = std::size_t(std::ceil(std::cbrt(double(nodeCount))));
+  const auto extent = double(cellsPerAxis) * CellSize;
+  const auto origin = vm::vec3d::fill(-extent / 2.0);
+
+  auto sizeDistribution = std::uniform_real_distribution<double>{8.0, CellSize};
+  auto largeSizeDistribution =
+    std::uniform_real_distribution<double>{CellSize, extent / 4.0};
+  auto largeNodeDistribution = std::uniform_int_distribution<int>{0, LargeNodeRatio - 1};
+
+  auto result = NodeTreeItems{};
+  result.reserve(nodeCount);
+
+  for (std::size_t i = 0; i < nodeCount; ++i)
+  {
+    const auto cell = vm::vec3d{
+      double(i % cellsPerAxis),
+      double(i / cellsPerAxis % cellsPerAxis),
+      double(i / (cellsPerAxis * cellsPerAxis)),
+    };
+    auto& distribution =
+      largeNodeDistribution(rng) == 0 ? largeSizeDistribution : sizeDistribution;
+    const auto size =
+      vm::vec3d{distribution(rng), distribution(rng), distribution(rng)};
+    const auto min = origin + cell * CellSize;
+
+    result.emplace_back(vm::bbox3d{min, min + size}, i);
+  }
+
+  return result;
+}
+
+} // namespace
+
+std::vector<BenchmarkResult> runNodeTreeBenchmarks(const NodeTreeBenchmarkConfig& config)
+{
+  const auto nodeCount = config.nodeCount;
+
+  auto rng = std::mt19937{config.seed};
+  auto results = std::vector<BenchmarkResult>{};
+
+  const auto record = [&](std::string name, const auto& f) {
+    results.push_back(BenchmarkResult{std::move(name), nodeCount, measure(f)});
+  };
+
+  const auto items = createItems(nodeCount, rng);
+
+  record("node tree insert", [&]() {
+    auto tree = NodeTree{MinNodeSize};
+    for (const auto& [bounds, data] : items)
+    {
+      contract_assert(tree.insert(bounds, data));
+    }
+  });
+
+  record("node tree build", [&]() {
+    auto tree = NodeTree{MinNodeSize};
+    tree.build(items);
+  });
+
+  auto taskManager = kdl::task_manager{};
+  record("node tree parallel build", [&]() {
+    auto tree = NodeTree{MinNodeSize};
+    tree.build(items, taskManager);
+  });
+
+  return results;
+}
+
+} // namespace tb::benchmarks
@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Benchmark.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tb::benchmarks
+{
+
+struct NodeTreeBenchmarkConfig
+{
+  std::size_t nodeCount;
+  std::uint32_t seed;
+};
+
+/**
+ * Times filling a node tree with the bounds of the configured number of nodes, once by
+ * inserting the nodes one by one and once by building the tree in bulk, like when a map
+ * is loaded.
+ */
+std::vector<BenchmarkResult> runNodeTreeBenchmarks(const NodeTreeBenchmarkConfig& config);
+
+} // namespace tb::benchmarks
@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PolyhedronBenchmarks.h"
+
+#include "mdl/Polyhedron.h"
+#include "mdl/Polyhedron3.h"
+
+#include "vm/vec.h"
+
+#include <random>
+
+namespace tb::benchmarks
+{
+namespace
+{
+
+constexpr auto Radius = 1024.0;
+
+/**
+ * Creates points which are uniformly distributed in a ball. Most of them are not on the
+ * convex hull.
+ */
+std::vector<vm::vec3d> createPointsInBall(const std::size_t pointCount, std::mt19937& rng)
+{
+  auto distribution = std::uniform_real_distribution<double>{-Radius, Radius};
+
+  auto result = std::vector<vm::vec3d>{};
+  result.reserve(pointCount);
+
+  while (result.size() < pointCount)
+  {
+    const auto point = vm::vec3d{distribution(rng), distribution(rng), distribution(rng)};
+    if (vm::squared_length(point) <= Radius * Radius)
+    {
+      result.push_back(point);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Creates the vertices of overlapping cuboids on an integer grid, similar to the vertices
+ * collected when merging many brushes. Many of the points are duplicates.
+ */
+std::vector<vm::vec3d> createCuboidVertices(
+  const std::size_t pointCount, std::mt19937& rng)
+{
+  auto positionDistribution = std::uniform_int_distribution<int>{-16, 15};
+  auto sizeDistribution = std::uniform_int_distribution<int>{1, 4};
+
+  auto result = std::vector<vm::vec3d>{};
+  result.reserve(pointCount);
+
+  while (result.size() < pointCount)
+  {
+    const auto min = vm::vec3d{
+      64.0 * positionDistribution(rng),
+      64.0 * positionDistribution(rng),
+      64.0 * positionDistribution(rng),
+    };
+    const auto max = min
+                     + vm::vec3d{
+                       64.0 * sizeDistribution(rng),
+                       64.0 * sizeDistribution(rng),
+                       64.0 * sizeDistribution(rng),
+                     };
+
+    for (std::size_t i = 0; i < 8 && result.size() < pointCount; ++i)
+    {
+      result.emplace_back(
+        i & 1 ? max.x() : min.x(), i & 2 ? max.y() : min.y(), i & 4 ? max.z() : min.z());
+    }
+  }
+
+  return result;
+}
+
+} // namespace
+
+std::vector<BenchmarkResult> runPolyhedronBenchmarks(
+  const PolyhedronBenchmarkConfig& config)
+{
+  const auto pointCount = config.pointCount;
+
+  auto rng = std::mt19937{config.seed};
+  auto results = std::vector<BenchmarkResult>{};
+
+  const auto record = [&](std::string name, const auto& f) {
+    results.push_back(BenchmarkResult{std::move(name), pointCount, measure(f)});
+  };
+
+  const auto pointsInBall = createPointsInBall(pointCount, rng);
+  record("convex hull of points in ball", [&]() {
+    [[maybe_unused]] const auto polyhedron = mdl::Polyhedron3{pointsInBall};
+  });
+
+  const auto cuboidVertices = createCuboidVertices(pointCount, rng);
+  record("convex hull of cuboid vertices", [&]() {
+    [[maybe_unused]] const auto polyhedron = mdl::Polyhedron3{cuboidVertices};
+  });
+
+  return results;
+}
+
+} // namespace tb::benchmarks
@@ -0,0 +1,196 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace tb
+{
+
+enum class FrameCounter
+{
+  DrawCalls,
+  BytesUploaded,
+  BrushesValidated,
+};
+
+inline constexpr auto FrameCounterCount = std::size_t(3);
+
+std::string_view frameCounterName(FrameCounter counter);
+
+using FrameProfileClock = std::chrono::steady_clock;
+
+struct FrameProfileScope
+{
+  /** Must point to a string literal or to another string with static storage duration. */
+  const char* name;
+  std::size_t depth;
+  FrameProfileClock::time_point start;
+  FrameProfileClock::duration duration;
+};
+
+struct FrameProfile
+{
+  std::uint64_t index = 0;
+  FrameProfileClock::time_point start;
+  FrameProfileClock::duration duration{};
+
+  /**
+   * The scopes in the order in which they were entered. This includes scopes that were
+   * entered between the end of the previous frame and the start of this frame, e.g. when
+   * renderers were updated in response to a change of the map.
+   */
+  std::vector<FrameProfileScope> scopes;
+  std::array<std::uint64_t, FrameCounterCount> counters{};
+};
+
+/**
+ * Records the CPU time spent in nested scopes and a few counters for each rendered frame
+ * and keeps the last frames in a ring buffer.
+ *
+ * The profiler is disabled by default. While it is disabled, entering a scope or
+ * incrementing a counter only checks a flag, so the instrumentation can stay compiled in.
+ * Only the thread that renders the frames is profiled, calls from other threads are
+ * ignored. Recording can be suspended on that thread, e.g. while a view is painted whose
+ * frames should not be profiled.
+ */
+class FrameProfiler
+{
+private:
+  static constexpr auto MaxScopesPerFrame = std::size_t(1) << 16;
+
+  // read by every thread that enters a scope or increments a counter
+  std::atomic<bool> m_enabled{false};
+  std::atomic<bool> m_suspended{false};
+  std::atomic<std::thread::id> m_thread;
+
+  std::vector<FrameProfile> m_frames;
+  std::size_t m_nextFrame = 0;
+  std::size_t m_frameCount = 0;
+
+  FrameProfile m_currentFrame;
+  std::size_t m_depth = 0;
+
+public:
+  static constexpr auto NoScope = std::size_t(-1);
+
+  static FrameProfiler& instance();
+
+  explicit FrameProfiler(std::size_t capacity = 240);
+
+  bool enabled() const { return m_enabled; }
+
+  /**
+   * Enables or disables the profiler. Disabling the profiler discards the recorded
+   * frames. The calling thread becomes the profiled thread.
+   */
+  void setEnabled(bool enabled);
+
+  bool suspended() const { return m_suspended; }
+
+  /**
+   * Suspends or resumes recording without discarding the recorded frames. Prefer using
+   * SuspendProfiling.
+   */
+  void setSuspended(bool suspended);
+
+  void beginFrame();
+  void endFrame();
+
+  /**
+   * Enters a scope with the given name and returns a handle to be passed to endScope().
+   * Prefer using ProfileScope.
+   */
+  std::size_t beginScope(const char* name);
+  void endScope(std::size_t scope);
+
+  void count(FrameCounter counter, std::uint64_t amount = 1);
+
+  /**
+   * Returns the recorded frames, oldest first.
+   */
+  std::vector<const FrameProfile*> frames() const;
+
+  /**
+   * Writes the recorded frames in the Chrome trace event format, which can be loaded
+   * into chrome://tracing or Perfetto.
+   */
+  void writeChromeTrace(std::ostream& stream) const;
+
+private:
+  bool recording() const;
+
+  deleteCopyAndMove(FrameProfiler);
+};
+
+/**
+ * Measures the time between its construction and destruction as a scope of the current
+ * frame.
+ */
+class ProfileScope
+{
+private:
+  FrameProfiler& m_profiler;
+  std::size_t m_scope;
+
+public:
+  explicit ProfileScope(
+    const char* name, FrameProfiler& profiler = FrameProfiler::instance());
+  ~ProfileScope();
+
+  deleteCopyAndMove(ProfileScope);
+};
+
+/**
+ * Suspends recording for its lifetime.
+ */
+class SuspendProfiling
+{
+private:
+  FrameProfiler& m_profiler;
+  bool m_wasSuspended;
+
+public:
+  explicit SuspendProfiling(FrameProfiler& profiler = FrameProfiler::instance());
+  ~SuspendProfiling();
+
+  deleteCopyAndMove(SuspendProfiling);
+};
+
+/**
+ * Summarizes the given frames into human readable lines: the average and maximum frame
+ * time, the average time per scope name indented by nesting depth, and the average value
+ * of every counter.
+ */
+std::vector<std::string> summarizeFrameProfiles(
+  const std::vector<const FrameProfile*>& frames);
+
+} // namespace tb
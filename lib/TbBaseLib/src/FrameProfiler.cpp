@@ -0,0 +1,382 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameProfiler.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <ostream>
+
+namespace tb
+{
+namespace
+{
+
+using Milliseconds = std::chrono::duration<double, std::milli>;
+using Microseconds = std::chrono::duration<double, std::micro>;
+
+void writeJsonString(std::ostream& stream, const std::string_view str)
+{
+  stream << '"';
+  for (const auto c : str)
+  {
+    switch (c)
+    {
+    case '"':
+      stream << "\\\"";
+      break;
+    case '\\':
+      stream << "\\\\";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        stream << fmt::format("\\u{:04x}", static_cast<unsigned int>(c));
+      }
+      else
+      {
+        stream << c;
+      }
+      break;
+    }
+  }
+  stream << '"';
+}
+
+void writeCompleteEvent(
+  std::ostream& stream,
+  const std::string_view name,
+  const std::string_view category,
+  const FrameProfileClock::time_point origin,
+  const FrameProfileClock::time_point start,
+  const FrameProfileClock::duration duration)
+{
+  stream << "{\"name\":";
+  writeJsonString(stream, name);
+  stream << ",\"cat\":";
+  writeJsonString(stream, category);
+  stream << fmt::format(
+    R"(,"ph":"X","pid":1,"tid":1,"ts":{:.3f},"dur":{:.3f}}})",
+    Microseconds{start - origin}.count(),
+    Microseconds{duration}.count());
+}
+
+} // namespace
+
+std::string_view frameCounterName(const FrameCounter counter)
+{
+  switch (counter)
+  {
+  case FrameCounter::DrawCalls:
+    return "Draw calls";
+  case FrameCounter::BytesUploaded:
+    return "Bytes uploaded";
+  case FrameCounter::BrushesValidated:
+    return "Brushes validated";
+    switchDefault();
+  }
+}
+
+FrameProfiler& FrameProfiler::instance()
+{
+  static auto instance = FrameProfiler{};
+  return instance;
+}
+
+FrameProfiler::FrameProfiler(const std::size_t capacity)
+  : m_frames(std::max(capacity, std::size_t(1)))
+{
+}
+
+void FrameProfiler::setEnabled(const bool enabled)
+{
+  if (enabled != m_enabled)
+  {
+    // set the thread first so that no other thread records once the profiler is enabled
+    m_thread = std::this_thread::get_id();
+    m_enabled = enabled;
+
+    for (auto& frame : m_frames)
+    {
+      frame.scopes.clear();
+    }
+    m_nextFrame = 0;
+    m_frameCount = 0;
+
+    m_currentFrame.index = 0;
+    m_currentFrame.start = FrameProfileClock::now();
+    m_currentFrame.scopes.clear();
+    m_currentFrame.counters = {};
+    m_depth = 0;
+  }
+}
+
+void FrameProfiler::setSuspended(const bool suspended)
+{
+  m_suspended = suspended;
+}
+
+void FrameProfiler::beginFrame()
+{
+  if (recording())
+  {
+    m_currentFrame.start = FrameProfileClock::now();
+  }
+}
+
+void FrameProfiler::endFrame()
+{
+  if (recording())
+  {
+    const auto now = FrameProfileClock::now();
+    m_currentFrame.duration = now - m_currentFrame.start;
+
+    // swap instead of copying so that the scope vectors are reused
+    const auto index = m_currentFrame.index;
+    std::swap(m_frames[m_nextFrame], m_currentFrame);
+    m_nextFrame = (m_nextFrame + 1) % m_frames.size();
+    m_frameCount = std::min(m_frameCount + 1, m_frames.size());
+
+    m_currentFrame.index = index + 1;
+    m_currentFrame.start = now;
+    m_currentFrame.duration = {};
+    m_currentFrame.scopes.clear();
+    m_currentFrame.counters = {};
+
+    // scopes that are still open will be ignored when they end
+    m_depth = 0;
+  }
+}
+
+std::size_t FrameProfiler::beginScope(const char* name)
+{
+  if (!recording() || m_currentFrame.scopes.size() == MaxScopesPerFrame)
+  {
+    return NoScope;
+  }
+
+  const auto scope = m_currentFrame.scopes.size();
+  m_currentFrame.scopes.push_back(
+    FrameProfileScope{name, m_depth++, FrameProfileClock::now(), {}});
+
+  // The handle identifies the frame so that a scope which outlives its frame is ignored.
+  return std::size_t(m_currentFrame.index) * MaxScopesPerFrame + scope;
+}
+
+void FrameProfiler::endScope(const std::size_t scope)
+{
+  if (
+    scope == NoScope || !recording()
+    || scope / MaxScopesPerFrame != std::size_t(m_currentFrame.index))
+  {
+    return;
+  }
+
+  auto& frameScope = m_currentFrame.scopes[scope % MaxScopesPerFrame];
+  frameScope.duration = FrameProfileClock::now() - frameScope.start;
+  m_depth = frameScope.depth;
+}
+
+void FrameProfiler::count(const FrameCounter counter, const std::uint64_t amount)
+{
+  if (recording())
+  {
+    m_currentFrame.counters[std::size_t(counter)] += amount;
+  }
+}
+
+std::vector<const FrameProfile*> FrameProfiler::frames() const
+{
+  auto result = std::vector<const FrameProfile*>{};
+  result.reserve(m_frameCount);
+
+  const auto first = (m_nextFrame + m_frames.size() - m_frameCount) % m_frames.size();
+  for (std::size_t i = 0; i < m_frameCount; ++i)
+  {
+    result.push_back(&m_frames[(first + i) % m_frames.size()]);
+  }
+  return result;
+}
+
+void FrameProfiler::writeChromeTrace(std::ostream& stream) const
+{
+  const auto recordedFrames = frames();
+
+  auto origin = FrameProfileClock::time_point::max();
+  for (const auto* frame : recordedFrames)
+  {
+    origin = std::min(origin, frame->start);
+    for (const auto& scope : frame->scopes)
+    {
+      origin = std::min(origin, scope.start);
+    }
+  }
+
+  stream << "{\"traceEvents\":[";
+
+  auto first = true;
+  const auto separate = [&]() {
+    if (!first)
+    {
+      stream << ",";
+    }
+    stream << "\n";
+    first = false;
+  };
+
+  for (const auto* frame : recordedFrames)
+  {
+    separate();
+    writeCompleteEvent(
+      stream,
+      fmt::format("Frame {}", frame->index),
+      "frame",
+      origin,
+      frame->start,
+      frame->duration);
+
+    for (const auto& scope : frame->scopes)
+    {
+      separate();
+      writeCompleteEvent(
+        stream, scope.name, "scope", origin, scope.start, scope.duration);
+    }
+
+    for (std::size_t i = 0; i < FrameCounterCount; ++i)
+    {
+      separate();
+      stream << "{\"name\":";
+      writeJsonString(stream, frameCounterName(FrameCounter(i)));
+      stream << fmt::format(
+        R"(,"ph":"C","pid":1,"tid":1,"ts":{:.3f},"args":{{"value":{}}}}})",
+        Microseconds{frame->start + frame->duration - origin}.count(),
+        frame->counters[i]);
+    }
+  }
+
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool FrameProfiler::recording() const
+{
+  return m_enabled && !m_suspended && std::this_thread::get_id() == m_thread.load();
+}
+
+ProfileScope::ProfileScope(const char* name, FrameProfiler& profiler)
+  : m_profiler{profiler}
+  , m_scope{m_profiler.enabled() ? m_profiler.beginScope(name) : FrameProfiler::NoScope}
+{
+}
+
+ProfileScope::~ProfileScope()
+{
+  if (m_scope != FrameProfiler::NoScope)
+  {
+    m_profiler.endScope(m_scope);
+  }
+}
+
+SuspendProfiling::SuspendProfiling(FrameProfiler& profiler)
+  : m_profiler{profiler}
+  , m_wasSuspended{m_profiler.suspended()}
+{
+  m_profiler.setSuspended(true);
+}
+
+SuspendProfiling::~SuspendProfiling()
+{
+  m_profiler.setSuspended(m_wasSuspended);
+}
+
+std::vector<std::string> summarizeFrameProfiles(
+  const std::vector<const FrameProfile*>& frames)
+{
+  if (frames.empty())
+  {
+    return {};
+  }
+
+  struct ScopeSummary
+  {
+    std::string_view name;
+    std::size_t depth;
+    FrameProfileClock::duration total;
+  };
+
+  auto totalFrameTime = FrameProfileClock::duration{};
+  auto maxFrameTime = FrameProfileClock::duration{};
+  auto scopes = std::vector<ScopeSummary>{};
+  auto counters = std::array<std::uint64_t, FrameCounterCount>{};
+
+  for (const auto* frame : frames)
+  {
+    totalFrameTime += frame->duration;
+    maxFrameTime = std::max(maxFrameTime, frame->duration);
+
+    for (const auto& scope : frame->scopes)
+    {
+      const auto it = std::ranges::find_if(scopes, [&](const auto& summary) {
+        return summary.name == scope.name && summary.depth == scope.depth;
+      });
+      if (it != scopes.end())
+      {
+        it->total += scope.duration;
+      }
+      else
+      {
+        scopes.push_back(ScopeSummary{scope.name, scope.depth, scope.duration});
+      }
+    }
+
+    for (std::size_t i = 0; i < FrameCounterCount; ++i)
+    {
+      counters[i] += frame->counters[i];
+    }
+  }
+
+  const auto frameCount = double(frames.size());
+
+  auto result = std::vector<std::string>{};
+  result.push_back(fmt::format(
+    "Frame time: {:.2f} ms avg, {:.2f} ms max ({} frames)",
+    Milliseconds{totalFrameTime}.count() / frameCount,
+    Milliseconds{maxFrameTime}.count(),
+    frames.size()));
+
+  for (const auto& scope : scopes)
+  {
+    result.push_back(fmt::format(
+      "{:{}}{}: {:.2f} ms",
+      "",
+      2 * (scope.depth + 1),
+      scope.name,
+      Milliseconds{scope.total}.count() / frameCount));
+  }
+
+  for (std::size_t i = 0; i < FrameCounterCount; ++i)
+  {
+    result.push_back(fmt::format(
+      "{}: {:.0f}", frameCounterName(FrameCounter(i)), double(counters[i]) / frameCount));
+  }
+
+  return result;
+}
+
+} // namespace tb
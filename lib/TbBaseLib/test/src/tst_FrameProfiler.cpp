@@ -0,0 +1,231 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameProfiler.h"
+
+#include <sstream>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb
+{
+
+TEST_CASE("FrameProfiler")
+{
+  auto profiler = FrameProfiler{3};
+
+  SECTION("Records nothing while disabled")
+  {
+    profiler.beginFrame();
+    {
+      const auto scope = ProfileScope{"scope", profiler};
+      profiler.count(FrameCounter::DrawCalls);
+    }
+    profiler.endFrame();
+
+    CHECK(profiler.frames().empty());
+  }
+
+  SECTION("Records nested scopes and counters")
+  {
+    profiler.setEnabled(true);
+
+    profiler.beginFrame();
+    {
+      const auto outer = ProfileScope{"outer", profiler};
+      {
+        const auto inner = ProfileScope{"inner", profiler};
+        profiler.count(FrameCounter::DrawCalls, 2);
+      }
+      const auto sibling = ProfileScope{"sibling", profiler};
+      profiler.count(FrameCounter::BytesUploaded, 128);
+    }
+    profiler.endFrame();
+
+    const auto frames = profiler.frames();
+    REQUIRE(frames.size() == 1);
+
+    const auto& frame = *frames.front();
+    CHECK(frame.index == 0);
+    REQUIRE(frame.scopes.size() == 3);
+    CHECK(std::string{frame.scopes[0].name} == "outer");
+    CHECK(frame.scopes[0].depth == 0);
+    CHECK(std::string{frame.scopes[1].name} == "inner");
+    CHECK(frame.scopes[1].depth == 1);
+    CHECK(std::string{frame.scopes[2].name} == "sibling");
+    CHECK(frame.scopes[2].depth == 1);
+    CHECK(frame.scopes[0].duration >= frame.scopes[1].duration);
+
+    CHECK(frame.counters[std::size_t(FrameCounter::DrawCalls)] == 2);
+    CHECK(frame.counters[std::size_t(FrameCounter::BytesUploaded)] == 128);
+    CHECK(frame.counters[std::size_t(FrameCounter::BrushesValidated)] == 0);
+  }
+
+  SECTION("Keeps the most recent frames")
+  {
+    profiler.setEnabled(true);
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+      profiler.beginFrame();
+      profiler.count(FrameCounter::DrawCalls, i);
+      profiler.endFrame();
+    }
+
+    const auto frames = profiler.frames();
+    REQUIRE(frames.size() == 3);
+    CHECK(frames[0]->index == 2);
+    CHECK(frames[1]->index == 3);
+    CHECK(frames[2]->index == 4);
+    CHECK(frames[2]->counters[std::size_t(FrameCounter::DrawCalls)] == 4);
+  }
+
+  SECTION("Ignores scopes that outlive their frame")
+  {
+    profiler.setEnabled(true);
+
+    profiler.beginFrame();
+    {
+      const auto scope = ProfileScope{"scope", profiler};
+      profiler.endFrame();
+      profiler.beginFrame();
+    }
+    {
+      const auto next = ProfileScope{"next", profiler};
+    }
+    profiler.endFrame();
+
+    const auto frames = profiler.frames();
+    REQUIRE(frames.size() == 2);
+    CHECK(frames[1]->scopes.size() == 1);
+    CHECK(frames[1]->scopes[0].depth == 0);
+  }
+
+  SECTION("Ignores other threads")
+  {
+    profiler.setEnabled(true);
+
+    profiler.beginFrame();
+    auto thread = std::thread{[&]() {
+      const auto scope = ProfileScope{"other", profiler};
+      profiler.count(FrameCounter::DrawCalls);
+    }};
+    thread.join();
+    profiler.endFrame();
+
+    const auto frames = profiler.frames();
+    REQUIRE(frames.size() == 1);
+    CHECK(frames[0]->scopes.empty());
+    CHECK(frames[0]->counters[std::size_t(FrameCounter::DrawCalls)] == 0);
+  }
+
+  SECTION("Disabling discards recorded frames")
+  {
+    profiler.setEnabled(true);
+    profiler.beginFrame();
+    profiler.endFrame();
+    profiler.setEnabled(false);
+
+    CHECK(profiler.frames().empty());
+  }
+
+  SECTION("Ignores scopes and counters while suspended")
+  {
+    profiler.setEnabled(true);
+
+    profiler.beginFrame();
+    {
+      const auto suspend = SuspendProfiling{profiler};
+      CHECK(profiler.suspended());
+
+      const auto scope = ProfileScope{"suspended", profiler};
+      profiler.count(FrameCounter::DrawCalls);
+    }
+    CHECK_FALSE(profiler.suspended());
+
+    {
+      const auto scope = ProfileScope{"resumed", profiler};
+    }
+    profiler.endFrame();
+
+    const auto frames = profiler.frames();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0]->scopes.size() == 1);
+    CHECK(std::string{frames[0]->scopes[0].name} == "resumed");
+    CHECK(frames[0]->counters[std::size_t(FrameCounter::DrawCalls)] == 0);
+  }
+
+  SECTION("writeChromeTrace")
+  {
+    profiler.setEnabled(true);
+
+    profiler.beginFrame();
+    {
+      const auto scope = ProfileScope{"a \"quoted\" scope", profiler};
+    }
+    profiler.endFrame();
+
+    auto str = std::stringstream{};
+    profiler.writeChromeTrace(str);
+
+    const auto trace = str.str();
+    CHECK(trace.starts_with("{\"traceEvents\":["));
+    CHECK(trace.find(R"("name":"Frame 0","cat":"frame","ph":"X")") != std::string::npos);
+    CHECK(
+      trace.find(R"("name":"a \"quoted\" scope","cat":"scope","ph":"X")")
+      != std::string::npos);
+    CHECK(trace.find(R"("name":"Draw calls","ph":"C")") != std::string::npos);
+  }
+}
+
+TEST_CASE("summarizeFrameProfiles")
+{
+  using namespace std::chrono_literals;
+
+  CHECK(summarizeFrameProfiles({}).empty());
+
+  auto frame1 = FrameProfile{};
+  frame1.duration = 10ms;
+  frame1.scopes = {
+    {"render", 0, {}, 8ms},
+    {"brushes", 1, {}, 4ms},
+  };
+  frame1.counters = {10, 1000, 2};
+
+  auto frame2 = FrameProfile{};
+  frame2.duration = 20ms;
+  frame2.scopes = {
+    {"render", 0, {}, 12ms},
+  };
+  frame2.counters = {20, 3000, 0};
+
+  CHECK(
+    summarizeFrameProfiles({&frame1, &frame2})
+    == std::vector<std::string>{
+      "Frame time: 15.00 ms avg, 20.00 ms max (2 frames)",
+      "  render: 10.00 ms",
+      "    brushes: 2.00 ms",
+      "Draw calls: 15",
+      "Bytes uploaded: 2000",
+      "Brushes validated: 1",
+    });
+}
+
+} // namespace tb
@@ -0,0 +1,172 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "el/Expression.h"
+#include "el/Types.h"
+#include "el/Value.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace tb::el
+{
+class EvaluationContext;
+
+namespace detail
+{
+
+struct UndefinedRegister
+{
+};
+
+struct NullRegister
+{
+};
+
+/**
+ * A string that is short enough to be stored inline in a register.
+ */
+struct ShortString
+{
+  static constexpr size_t Capacity = 22;
+
+  std::array<char, Capacity> chars;
+  std::uint8_t length;
+
+  std::string_view view() const;
+};
+
+/**
+ * A register of the bytecode evaluator. Booleans, numbers, short strings, null and
+ * undefined are stored inline, all other values are stored as el::Value.
+ */
+using Register = std::variant<
+  UndefinedRegister,
+  NullRegister,
+  BooleanType,
+  NumberType,
+  ShortString,
+  Value>;
+
+enum class OpCode : std::uint8_t
+{
+  LoadConstant,
+  LoadVariable,
+  Evaluate,
+  UnaryPlus,
+  UnaryMinus,
+  LogicalNegation,
+  BitwiseNegation,
+  Addition,
+  Subtraction,
+  Multiplication,
+  Division,
+  Modulus,
+  BitwiseAnd,
+  BitwiseXOr,
+  BitwiseOr,
+  BitwiseShiftLeft,
+  BitwiseShiftRight,
+  Less,
+  LessOrEqual,
+  Greater,
+  GreaterOrEqual,
+  Equal,
+  NotEqual,
+  LogicalAndLhs,
+  LogicalAndRhs,
+  LogicalOrLhs,
+  LogicalOrRhs,
+  CaseLhs,
+  JumpIfDefined,
+  MakeArray,
+  MakeMap,
+  Subscript,
+};
+
+/**
+ * A single instruction. The meaning of the operands depends on the op code, but the
+ * target is always a register index, and the node is the index of the expression node
+ * that this instruction was compiled from.
+ */
+struct Instruction
+{
+  OpCode opCode;
+  size_t target = 0;
+  size_t operand1 = 0;
+  size_t operand2 = 0;
+  size_t node = 0;
+};
+
+} // namespace detail
+
+/**
+ * An expression that was compiled to a flat sequence of instructions operating on
+ * registers.
+ *
+ * Evaluating a compiled expression yields the same values and throws the same errors as
+ * evaluating the expression node it was compiled from. Operations on booleans, numbers
+ * and short strings are evaluated directly on the registers without allocating values.
+ * Whenever an operation encounters operands that it cannot handle directly, it falls
+ * back to evaluating the original expression node.
+ */
+class CompiledExpression
+{
+private:
+  /**
+   * Expressions that need at most this many registers are evaluated with registers on
+   * the stack, all others allocate their registers on the heap.
+   */
+  static constexpr size_t InlineRegisterCount = 16;
+
+  ExpressionNode m_expression;
+  std::vector<ExpressionNode> m_nodes;
+  std::vector<detail::Instruction> m_instructions;
+  std::vector<detail::Register> m_constants;
+  std::vector<std::string> m_variableNames;
+  std::vector<std::vector<std::string>> m_mapKeys;
+  size_t m_registerCount = 0;
+
+public:
+  explicit CompiledExpression(ExpressionNode expression);
+
+  const ExpressionNode& expression() const;
+  size_t instructionCount() const;
+
+  Value evaluate(EvaluationContext& context) const;
+
+private:
+  Value evaluate(
+    EvaluationContext& context,
+    std::span<detail::Register> registers,
+    std::span<size_t> producers) const;
+
+  void compile(const ExpressionNode& expression, size_t target);
+  size_t addNode(const ExpressionNode& expression);
+  size_t addInstruction(detail::Instruction instruction);
+};
+
+} // namespace tb::el
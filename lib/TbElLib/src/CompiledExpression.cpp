@@ -0,0 +1,1015 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "el/CompiledExpression.h"
+
+#include "Macros.h"
+#include "el/EvaluationContext.h"
+#include "el/Value.h"
+
+#include "kd/overload.h"
+#include "kd/result.h"
+#include "kd/string_compare.h"
+#include "kd/string_format.h"
+#include "kd/string_utils.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+
+namespace tb::el
+{
+namespace detail
+{
+
+std::string_view ShortString::view() const
+{
+  return std::string_view{chars.data(), length};
+}
+
+} // namespace detail
+
+namespace
+{
+
+using detail::Instruction;
+using detail::NullRegister;
+using detail::OpCode;
+using detail::Register;
+using detail::ShortString;
+using detail::UndefinedRegister;
+
+Register makeString(const std::string_view str)
+{
+  if (str.length() <= ShortString::Capacity)
+  {
+    auto result = ShortString{};
+    std::ranges::copy(str, result.chars.begin());
+    result.length = static_cast<std::uint8_t>(str.length());
+    return result;
+  }
+  return Value{std::string{str}};
+}
+
+Register toRegister(const EvaluationContext& context, const Value& value)
+{
+  switch (value.type())
+  {
+  case ValueType::Boolean:
+    return value.booleanValue(context);
+  case ValueType::String:
+    return makeString(value.stringValue(context));
+  case ValueType::Number:
+    return value.numberValue(context);
+  case ValueType::Null:
+    return NullRegister{};
+  case ValueType::Undefined:
+    return UndefinedRegister{};
+  case ValueType::Array:
+  case ValueType::Map:
+  case ValueType::Range:
+    break;
+  }
+  return value;
+}
+
+Register toRegister(const Value& value)
+{
+  return withEvaluationContext(
+           [&](const auto& context) { return toRegister(context, value); })
+         | kdl::value();
+}
+
+Value toValue(const Register& reg)
+{
+  return std::visit(
+    kdl::overload(
+      [](const UndefinedRegister&) { return Value::Undefined; },
+      [](const NullRegister&) { return Value::Null; },
+      [](const BooleanType b) { return Value{b}; },
+      [](const NumberType n) { return Value{n}; },
+      [](const ShortString& s) { return Value{std::string{s.view()}}; },
+      [](const Value& v) { return v; }),
+    reg);
+}
+
+ValueType typeOf(const Register& reg)
+{
+  return std::visit(
+    kdl::overload(
+      [](const UndefinedRegister&) { return ValueType::Undefined; },
+      [](const NullRegister&) { return ValueType::Null; },
+      [](const BooleanType) { return ValueType::Boolean; },
+      [](const NumberType) { return ValueType::Number; },
+      [](const ShortString&) { return ValueType::String; },
+      [](const Value& v) { return v.type(); }),
+    reg);
+}
+
+bool isUndefined(const Register& reg)
+{
+  return typeOf(reg) == ValueType::Undefined;
+}
+
+bool isBooleanOrNumber(const Register& reg)
+{
+  const auto type = typeOf(reg);
+  return type == ValueType::Boolean || type == ValueType::Number;
+}
+
+// The following accessors require that the register holds a value of the respective type
+
+BooleanType booleanOf(const EvaluationContext& context, const Register& reg)
+{
+  return std::visit(
+    kdl::overload(
+      [&](const Value& v) { return v.booleanValue(context); },
+      [](const BooleanType b) { return b; },
+      [](const auto&) { return false; }),
+    reg);
+}
+
+NumberType numberOf(const EvaluationContext& context, const Register& reg)
+{
+  return std::visit(
+    kdl::overload(
+      [&](const Value& v) { return v.numberValue(context); },
+      [](const NumberType n) { return n; },
+      [](const auto&) { return 0.0; }),
+    reg);
+}
+
+std::string_view stringOf(const EvaluationContext& context, const Register& reg)
+{
+  return std::visit(
+    kdl::overload(
+      [&](const Value& v) { return std::string_view{v.stringValue(context)}; },
+      [](const ShortString& s) { return s.view(); },
+      [](const auto&) { return std::string_view{}; }),
+    reg);
+}
+
+/**
+ * Mirrors Value::convertTo(ValueType::Boolean) for scalar values. Returns nullopt if the
+ * register holds a value that cannot be converted.
+ */
+std::optional<BooleanType> convertToBoolean(
+  const EvaluationContext& context, const Register& reg)
+{
+  switch (typeOf(reg))
+  {
+  case ValueType::Boolean:
+    return booleanOf(context, reg);
+  case ValueType::Number:
+    return numberOf(context, reg) != 0.0;
+  case ValueType::String: {
+    const auto str = stringOf(context, reg);
+    return !kdl::cs::str_is_equal(str, "false") && !str.empty();
+  }
+  case ValueType::Null:
+    return false;
+  case ValueType::Array:
+  case ValueType::Map:
+  case ValueType::Range:
+  case ValueType::Undefined:
+    break;
+  }
+  return std::nullopt;
+}
+
+/**
+ * Mirrors Value::convertTo(ValueType::Number) for scalar values. Returns nullopt if the
+ * register holds a value that cannot be converted.
+ */
+std::optional<NumberType> convertToNumber(
+  const EvaluationContext& context, const Register& reg)
+{
+  switch (typeOf(reg))
+  {
+  case ValueType::Boolean:
+    return booleanOf(context, reg) ? 1.0 : 0.0;
+  case ValueType::Number:
+    return numberOf(context, reg);
+  case ValueType::String: {
+    const auto str = stringOf(context, reg);
+    return kdl::str_is_blank(str) ? std::optional{0.0} : kdl::str_to_double(str);
+  }
+  case ValueType::Null:
+    return 0.0;
+  case ValueType::Array:
+  case ValueType::Map:
+  case ValueType::Range:
+  case ValueType::Undefined:
+    break;
+  }
+  return std::nullopt;
+}
+
+bool isScalar(const Register& reg)
+{
+  const auto type = typeOf(reg);
+  return type == ValueType::Boolean || type == ValueType::Number
+         || type == ValueType::String;
+}
+
+// The following functions mirror the tree evaluator for the operand types they handle
+// directly. They return nullopt for all other operands, in which case the caller falls
+// back to evaluating the expression node.
+
+std::optional<Register> evaluateUnaryPlus(
+  const EvaluationContext& context, const Register& operand)
+{
+  if (isUndefined(operand))
+  {
+    return UndefinedRegister{};
+  }
+
+  if (isScalar(operand))
+  {
+    if (const auto number = convertToNumber(context, operand))
+    {
+      return *number;
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<Register> evaluateUnaryMinus(
+  const EvaluationContext& context, const Register& operand)
+{
+  if (isUndefined(operand))
+  {
+    return UndefinedRegister{};
+  }
+
+  if (isScalar(operand))
+  {
+    if (const auto number = convertToNumber(context, operand))
+    {
+      return -*number;
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<Register> evaluateLogicalNegation(
+  const EvaluationContext& context, const Register& operand)
+{
+  switch (typeOf(operand))
+  {
+  case ValueType::Boolean:
+    return !booleanOf(context, operand);
+  case ValueType::Undefined:
+    return UndefinedRegister{};
+  case ValueType::Number:
+  case ValueType::String:
+  case ValueType::Array:
+  case ValueType::Map:
+  case ValueType::Range:
+  case ValueType::Null:
+    break;
+  }
+  return std::nullopt;
+}
+
+std::optional<Register> evaluateBitwiseNegation(
+  const EvaluationContext& context, const Register& operand)
+{
+  switch (typeOf(operand))
+  {
+  case ValueType::Number:
+  case ValueType::String:
+    if (const auto number = convertToNumber(context, operand))
+    {
+      return static_cast<NumberType>(~static_cast<IntegerType>(*number));
+    }
+    break;
+  case ValueType::Undefined:
+    return UndefinedRegister{};
+  case ValueType::Boolean:
+  case ValueType::Array:
+  case ValueType::Map:
+  case ValueType::Range:
+  case ValueType::Null:
+    break;
+  }
+  return std::nullopt;
+}
+
+template <typename Eval>
+std::optional<Register> evaluateAlgebraicOperator(
+  const EvaluationContext& context,
+  const Register& lhs,
+  const Register& rhs,
+  const Eval& eval)
+{
+  if (isUndefined(lhs) || isUndefined(rhs))
+  {
+    return UndefinedRegister{};
+  }
+
+  // two strings are never converted to numbers
+  if (
+    isScalar(lhs) && isScalar(rhs)
+    && (isBooleanOrNumber(lhs) || isBooleanOrNumber(rhs)))
+  {
+    const auto lhsNumber = convertToNumber(context, lhs);
+    const auto rhsNumber = convertToNumber(context, rhs);
+    if (lhsNumber && rhsNumber)
+    {
+      return eval(*lhsNumber, *rhsNumber);
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<Register> evaluateAddition(
+  const EvaluationContext& context, const Register& lhs, const Register& rhs)
+{
+  if (
+    const auto result = evaluateAlgebraicOperator(
+      context, lhs, rhs, [](const auto l, const auto r) { return l + r; }))
+  {
+    return result;
+  }
+
+  if (typeOf(lhs) == ValueType::String && typeOf(rhs) == ValueType::String)
+  {
+    const auto lhsString = stringOf(context, lhs);
+    const auto rhsString = stringOf(context, rhs);
+    if (lhsString.length() + rhsString.length() <= ShortString::Capacity)
+    {
+      auto result = ShortString{};
+      const auto it = std::ranges::copy(lhsString, result.chars.begin()).out;
+      std::ranges::copy(rhsString, it);
+      result.length = static_cast<std::uint8_t>(lhsString.length() + rhsString.length());
+      return result;
+    }
+    return Value{std::string{lhsString}.append(rhsString)};
+  }
+
+  return std::nullopt;
+}
+
+template <typename Eval>
+std::optional<Register> evaluateBitwiseOperator(
+  const EvaluationContext& context,
+  const Register& lhs,
+  const Register& rhs,
+  const Eval& eval)
+{
+  if (isUndefined(lhs) || isUndefined(rhs))
+  {
+    return UndefinedRegister{};
+  }
+
+  const auto lhsNumber = convertToNumber(context, lhs);
+  const auto rhsNumber = convertToNumber(context, rhs);
+  if (lhsNumber && rhsNumber)
+  {
+    return static_cast<NumberType>(
+      eval(static_cast<IntegerType>(*lhsNumber), static_cast<IntegerType>(*rhsNumber)));
+  }
+
+  return std::nullopt;
+}
+
+int compareAsBooleans(
+  const EvaluationContext& context, const Register& lhs, const Register& rhs)
+{
+  const auto lhsValue = *convertToBoolean(context, lhs);
+  const auto rhsValue = *convertToBoolean(context, rhs);
+  return lhsValue == rhsValue ? 0 : lhsValue ? 1 : -1;
+}
+
+std::optional<int> compareAsNumbers(
+  const EvaluationContext& context, const Register& lhs, const Register& rhs)
+{
+  const auto lhsNumber = convertToNumber(context, lhs);
+  const auto rhsNumber = convertToNumber(context, rhs);
+  if (lhsNumber && rhsNumber)
+  {
+    const auto diff = *lhsNumber - *rhsNumber;
+    return diff < 0.0 ? -1 : diff > 0.0 ? 1 : 0;
+  }
+  return std::nullopt;
+}
+
+std::optional<int> evaluateCompare(
+  const EvaluationContext& context, const Register& lhs, const Register& rhs)
+{
+  const auto rhsType = typeOf(rhs);
+  const auto rhsIsNullOrUndefined =
+    rhsType == ValueType::Null || rhsType == ValueType::Undefined;
+
+  switch (typeOf(lhs))
+  {
+  case ValueType::Boolean:
+    if (isScalar(rhs))
+    {
+      return compareAsBooleans(context, lhs, rhs);
+    }
+    if (rhsIsNullOrUndefined)
+    {
+      return 1;
+    }
+    break;
+  case ValueType::Number:
+    if (rhsType == ValueType::Boolean)
+    {
+      return compareAsBooleans(context, lhs, rhs);
+    }
+    if (rhsType == ValueType::Number || rhsType == ValueType::String)
+    {
+      return compareAsNumbers(context, lhs, rhs);
+    }
+    if (rhsIsNullOrUndefined)
+    {
+      return 1;
+    }
+    break;
+  case ValueType::String:
+    if (rhsType == ValueType::Boolean)
+    {
+      return compareAsBooleans(context, lhs, rhs);
+    }
+    if (rhsType == ValueType::Number)
+    {
+      return compareAsNumbers(context, lhs, rhs);
+    }
+    if (rhsType == ValueType::String)
+    {
+      return stringOf(context, lhs).compare(stringOf(context, rhs));
+    }
+    if (rhsIsNullOrUndefined)
+    {
+      return 1;
+    }
+    break;
+  case ValueType::Null:
+    return rhsType == ValueType::Null ? 0 : -1;
+  case ValueType::Undefined:
+    return rhsType == ValueType::Undefined ? 0 : -1;
+  case ValueType::Array:
+  case ValueType::Map:
+  case ValueType::Range:
+    break;
+  }
+
+  return std::nullopt;
+}
+
+template <typename Predicate>
+std::optional<Register> evaluateComparison(
+  const EvaluationContext& context,
+  const Register& lhs,
+  const Register& rhs,
+  const Predicate& predicate)
+{
+  if (const auto result = evaluateCompare(context, lhs, rhs))
+  {
+    return predicate(*result);
+  }
+  return std::nullopt;
+}
+
+std::optional<Register> evaluateLogicalRhs(
+  const EvaluationContext& context, const Register& rhs)
+{
+  switch (typeOf(rhs))
+  {
+  case ValueType::Boolean:
+  case ValueType::Null:
+    return *convertToBoolean(context, rhs);
+  case ValueType::Undefined:
+    return UndefinedRegister{};
+  case ValueType::String:
+  case ValueType::Number:
+  case ValueType::Array:
+  case ValueType::Map:
+  case ValueType::Range:
+    break;
+  }
+  return std::nullopt;
+}
+
+size_t computeIndex(const long index, const size_t indexableSize)
+{
+  const auto size = static_cast<long>(indexableSize);
+  return (index >= 0 && index < size) || (index < 0 && index >= -size)
+           ? static_cast<size_t>((size + index % size) % size)
+           : static_cast<size_t>(size);
+}
+
+std::optional<Register> evaluateSubscript(
+  const EvaluationContext& context, const Register& lhs, const Register& rhs)
+{
+  if (const auto* lhsValue = std::get_if<Value>(&lhs))
+  {
+    switch (lhsValue->type())
+    {
+    case ValueType::Map:
+      if (typeOf(rhs) == ValueType::String)
+      {
+        const auto& map = lhsValue->mapValue(context);
+        const auto it = map.find(std::string{stringOf(context, rhs)});
+        return it != map.end() ? Register{it->second} : Register{UndefinedRegister{}};
+      }
+      break;
+    case ValueType::Array:
+      if (isBooleanOrNumber(rhs))
+      {
+        const auto& array = lhsValue->arrayValue(context);
+        const auto index = computeIndex(
+          static_cast<long>(*convertToNumber(context, rhs)), array.size());
+        if (index < array.size())
+        {
+          return array[index];
+        }
+      }
+      break;
+    case ValueType::Boolean:
+    case ValueType::String:
+    case ValueType::Number:
+    case ValueType::Range:
+    case ValueType::Null:
+    case ValueType::Undefined:
+      break;
+    }
+  }
+  return std::nullopt;
+}
+
+OpCode opCode(const UnaryOperation operation)
+{
+  switch (operation)
+  {
+  case UnaryOperation::Plus:
+    return OpCode::UnaryPlus;
+  case UnaryOperation::Minus:
+    return OpCode::UnaryMinus;
+  case UnaryOperation::LogicalNegation:
+    return OpCode::LogicalNegation;
+  case UnaryOperation::BitwiseNegation:
+    return OpCode::BitwiseNegation;
+  case UnaryOperation::Group:
+  case UnaryOperation::LeftBoundedRange:
+  case UnaryOperation::RightBoundedRange:
+    return OpCode::Evaluate;
+    switchDefault();
+  }
+}
+
+OpCode opCode(const BinaryOperation operation)
+{
+  switch (operation)
+  {
+  case BinaryOperation::Addition:
+    return OpCode::Addition;
+  case BinaryOperation::Subtraction:
+    return OpCode::Subtraction;
+  case BinaryOperation::Multiplication:
+    return OpCode::Multiplication;
+  case BinaryOperation::Division:
+    return OpCode::Division;
+  case BinaryOperation::Modulus:
+    return OpCode::Modulus;
+  case BinaryOperation::BitwiseAnd:
+    return OpCode::BitwiseAnd;
+  case BinaryOperation::BitwiseXOr:
+    return OpCode::BitwiseXOr;
+  case BinaryOperation::BitwiseOr:
+    return OpCode::BitwiseOr;
+  case BinaryOperation::BitwiseShiftLeft:
+    return OpCode::BitwiseShiftLeft;
+  case BinaryOperation::BitwiseShiftRight:
+    return OpCode::BitwiseShiftRight;
+  case BinaryOperation::Less:
+    return OpCode::Less;
+  case BinaryOperation::LessOrEqual:
+    return OpCode::LessOrEqual;
+  case BinaryOperation::Greater:
+    return OpCode::Greater;
+  case BinaryOperation::GreaterOrEqual:
+    return OpCode::GreaterOrEqual;
+  case BinaryOperation::Equal:
+    return OpCode::Equal;
+  case BinaryOperation::NotEqual:
+    return OpCode::NotEqual;
+  case BinaryOperation::LogicalAnd:
+    return OpCode::LogicalAndLhs;
+  case BinaryOperation::LogicalOr:
+    return OpCode::LogicalOrLhs;
+  case BinaryOperation::Case:
+    return OpCode::CaseLhs;
+  case BinaryOperation::BoundedRange:
+    return OpCode::Evaluate;
+    switchDefault();
+  }
+}
+
+} // namespace
+
+CompiledExpression::CompiledExpression(ExpressionNode expression)
+  : m_expression{std::move(expression)}
+{
+  compile(m_expression, 0);
+}
+
+const ExpressionNode& CompiledExpression::expression() const
+{
+  return m_expression;
+}
+
+size_t CompiledExpression::instructionCount() const
+{
+  return m_instructions.size();
+}
+
+Value CompiledExpression::evaluate(EvaluationContext& context) const
+{
+  if (m_registerCount <= InlineRegisterCount)
+  {
+    auto registers = std::array<Register, InlineRegisterCount>{};
+
+    // the index of the node that produced the value in each register, used for tracing
+    auto producers = std::array<size_t, InlineRegisterCount>{};
+    return evaluate(context, registers, producers);
+  }
+
+  auto registers = std::vector<Register>(m_registerCount);
+  auto producers = std::vector<size_t>(m_registerCount, 0);
+  return evaluate(context, registers, producers);
+}
+
+Value CompiledExpression::evaluate(
+  EvaluationContext& context,
+  const std::span<Register> registers,
+  const std::span<size_t> producers) const
+{
+  auto pc = size_t(0);
+  while (pc < m_instructions.size())
+  {
+    const auto& instruction = m_instructions[pc++];
+    const auto& operand1 = registers[instruction.operand1];
+
+    const auto write = [&](std::optional<Register> result) {
+      registers[instruction.target] =
+        result ? std::move(*result)
+               : Register{m_nodes[instruction.node].evaluate(context)};
+      producers[instruction.target] = instruction.node;
+    };
+
+    const auto writeAndJump = [&](std::optional<Register> result) {
+      write(std::move(result));
+      pc = instruction.operand2;
+    };
+
+    const auto binary = [&](const auto& evaluateBinary) {
+      write(evaluateBinary(context, operand1, registers[instruction.operand2]));
+    };
+
+    const auto compare = [&](const auto& predicate) {
+      write(evaluateComparison(
+        context, operand1, registers[instruction.operand2], predicate));
+    };
+
+    switch (instruction.opCode)
+    {
+    case OpCode::LoadConstant:
+      write(m_constants[instruction.operand1]);
+      break;
+    case OpCode::LoadVariable:
+      write(Register{context.variableValue(m_variableNames[instruction.operand1])});
+      break;
+    case OpCode::Evaluate:
+      write(std::nullopt);
+      break;
+    case OpCode::UnaryPlus:
+      write(evaluateUnaryPlus(context, operand1));
+      break;
+    case OpCode::UnaryMinus:
+      write(evaluateUnaryMinus(context, operand1));
+      break;
+    case OpCode::LogicalNegation:
+      write(evaluateLogicalNegation(context, operand1));
+      break;
+    case OpCode::BitwiseNegation:
+      write(evaluateBitwiseNegation(context, operand1));
+      break;
+    case OpCode::Addition:
+      binary(evaluateAddition);
+      break;
+    case OpCode::Subtraction:
+      binary([](const auto& c, const auto& l, const auto& r) {
+        return evaluateAlgebraicOperator(c, l, r, std::minus<NumberType>{});
+      });
+      break;
+    case OpCode::Multiplication:
+      binary([](const auto& c, const auto& l, const auto& r) {
+        return evaluateAlgebraicOperator(c, l, r, std::multiplies<NumberType>{});
+      });
+      break;
+    case OpCode::Division:
+      binary([](const auto& c, const auto& l, const auto& r) {
+        return evaluateAlgebraicOperator(c, l, r, std::divides<NumberType>{});
+      });
+      break;
+    case OpCode::Modulus:
+      binary([](const auto& c, const auto& l, const auto& r) {
+        return evaluateAlgebraicOperator(
+          c, l, r, [](const auto x, const auto y) { return std::fmod(x, y); });
+      });
+      break;
+    case OpCode::BitwiseAnd:
+      binary([](const auto& c, const auto& l, const auto& r) {
+        return evaluateBitwiseOperator(c, l, r, std::bit_and<IntegerType>{});
+      });
+      break;
+    case OpCode::BitwiseXOr:
+      binary([](const auto& c, const auto& l, const auto& r) {
+        return evaluateBitwiseOperator(c, l, r, std::bit_xor<IntegerType>{});
+      });
+      break;
+    case OpCode::BitwiseOr:
+      binary([](const auto& c, const auto& l, const auto& r) {
+        return evaluateBitwiseOperator(c, l, r, std::bit_or<IntegerType>{});
+      });
+      break;
+    case OpCode::BitwiseShiftLeft:
+      binary([](const auto& c, const auto& l, const auto& r) {
+        return evaluateBitwiseOperator(
+          c, l, r, [](const auto x, const auto y) { return x << y; });
+      });
+      break;
+    case OpCode::BitwiseShiftRight:
+      binary([](const auto& c, const auto& l, const auto& r) {
+        return evaluateBitwiseOperator(
+          c, l, r, [](const auto x, const auto y) { return x >> y; });
+      });
+      break;
+    case OpCode::Less:
+      compare([](const auto c) { return c < 0; });
+      break;
+    case OpCode::LessOrEqual:
+      compare([](const auto c) { return c <= 0; });
+      break;
+    case OpCode::Greater:
+      compare([](const auto c) { return c > 0; });
+      break;
+    case OpCode::GreaterOrEqual:
+      compare([](const auto c) { return c >= 0; });
+      break;
+    case OpCode::Equal:
+      compare([](const auto c) { return c == 0; });
+      break;
+    case OpCode::NotEqual:
+      compare([](const auto c) { return c != 0; });
+      break;
+    case OpCode::LogicalAndLhs:
+    case OpCode::LogicalOrLhs: {
+      const auto shortCircuitValue = instruction.opCode == OpCode::LogicalOrLhs;
+      const auto type = typeOf(operand1);
+      if (type == ValueType::Undefined)
+      {
+        writeAndJump(UndefinedRegister{});
+      }
+      else if (type == ValueType::Boolean || type == ValueType::Null)
+      {
+        if (*convertToBoolean(context, operand1) == shortCircuitValue)
+        {
+          writeAndJump(shortCircuitValue);
+        }
+      }
+      else
+      {
+        writeAndJump(std::nullopt);
+      }
+      break;
+    }
+    case OpCode::LogicalAndRhs:
+    case OpCode::LogicalOrRhs:
+      write(evaluateLogicalRhs(context, operand1));
+      break;
+    case OpCode::CaseLhs:
+      if (isUndefined(operand1))
+      {
+        writeAndJump(UndefinedRegister{});
+      }
+      else if (const auto condition = convertToBoolean(context, operand1))
+      {
+        if (!*condition)
+        {
+          writeAndJump(UndefinedRegister{});
+        }
+      }
+      else
+      {
+        writeAndJump(std::nullopt);
+      }
+      break;
+    case OpCode::JumpIfDefined:
+      if (!isUndefined(operand1))
+      {
+        pc = instruction.operand2;
+      }
+      break;
+    case OpCode::MakeArray: {
+      const auto first = instruction.target;
+      const auto count = instruction.operand1;
+
+      const auto containsRange = std::any_of(
+        std::next(registers.begin(), long(first)),
+        std::next(registers.begin(), long(first + count)),
+        [](const auto& reg) { return typeOf(reg) == ValueType::Range; });
+
+      if (containsRange)
+      {
+        write(std::nullopt);
+        break;
+      }
+
+      auto array = ArrayType{};
+      array.reserve(count);
+      for (size_t i = first; i < first + count; ++i)
+      {
+        array.push_back(context.trace(toValue(registers[i]), m_nodes[producers[i]]));
+      }
+      write(Value{std::move(array)});
+      break;
+    }
+    case OpCode::MakeMap: {
+      const auto first = instruction.target;
+      const auto& keys = m_mapKeys[instruction.operand1];
+
+      auto map = MapType{};
+      for (size_t i = 0; i < keys.size(); ++i)
+      {
+        map.emplace(
+          keys[i],
+          context.trace(toValue(registers[first + i]), m_nodes[producers[first + i]]));
+      }
+      write(Value{std::move(map)});
+      break;
+    }
+    case OpCode::Subscript:
+      binary(evaluateSubscript);
+      break;
+      switchDefault();
+    }
+  }
+
+  auto result = toValue(registers.front());
+  context.trace(result, m_nodes[producers.front()]);
+  return context.trace(std::move(result), m_expression);
+}
+
+void CompiledExpression::compile(const ExpressionNode& expression, const size_t target)
+{
+  using namespace detail;
+
+  m_registerCount = std::max(m_registerCount, target + 1);
+  const auto node = addNode(expression);
+
+  const auto compileOperands = [&](const auto& leftOperand, const auto& rightOperand) {
+    compile(leftOperand, target);
+    compile(rightOperand, target + 1);
+  };
+
+  expression.accept(kdl::overload(
+    [&](const LiteralExpression& literalExpression) {
+      m_constants.push_back(toRegister(literalExpression.value));
+      addInstruction({OpCode::LoadConstant, target, m_constants.size() - 1, 0, node});
+    },
+    [&](const VariableExpression& variableExpression) {
+      m_variableNames.push_back(variableExpression.variableName);
+      addInstruction(
+        {OpCode::LoadVariable, target, m_variableNames.size() - 1, 0, node});
+    },
+    [&](const ArrayExpression& arrayExpression) {
+      const auto& elements = arrayExpression.elements;
+      for (size_t i = 0; i < elements.size(); ++i)
+      {
+        compile(elements[i], target + i);
+      }
+      addInstruction({OpCode::MakeArray, target, elements.size(), 0, node});
+    },
+    [&](const MapExpression& mapExpression) {
+      auto keys = std::vector<std::string>{};
+      keys.reserve(mapExpression.elements.size());
+      for (const auto& [key, element] : mapExpression.elements)
+      {
+        compile(element, target + keys.size());
+        keys.push_back(key);
+      }
+      m_mapKeys.push_back(std::move(keys));
+      addInstruction({OpCode::MakeMap, target, m_mapKeys.size() - 1, 0, node});
+    },
+    [&](const UnaryExpression& unaryExpression) {
+      if (unaryExpression.operation == UnaryOperation::Group)
+      {
+        compile(unaryExpression.operand, target);
+        return;
+      }
+
+      const auto code = opCode(unaryExpression.operation);
+      if (code != OpCode::Evaluate)
+      {
+        compile(unaryExpression.operand, target);
+      }
+      addInstruction({code, target, target, 0, node});
+    },
+    [&](const BinaryExpression& binaryExpression) {
+      const auto code = opCode(binaryExpression.operation);
+      switch (code)
+      {
+      case OpCode::Evaluate:
+        addInstruction({code, target, 0, 0, node});
+        break;
+      case OpCode::LogicalAndLhs:
+      case OpCode::LogicalOrLhs: {
+        compile(binaryExpression.leftOperand, target);
+        const auto jump = addInstruction({code, target, target, 0, node});
+        compile(binaryExpression.rightOperand, target + 1);
+        const auto rhsCode =
+          code == OpCode::LogicalAndLhs ? OpCode::LogicalAndRhs : OpCode::LogicalOrRhs;
+        addInstruction({rhsCode, target, target + 1, 0, node});
+        m_instructions[jump].operand2 = m_instructions.size();
+        break;
+      }
+      case OpCode::CaseLhs: {
+        compile(binaryExpression.leftOperand, target);
+        const auto jump = addInstruction({code, target, target, 0, node});
+        compile(binaryExpression.rightOperand, target);
+        m_instructions[jump].operand2 = m_instructions.size();
+        break;
+      }
+      default:
+        compileOperands(binaryExpression.leftOperand, binaryExpression.rightOperand);
+        addInstruction({code, target, target, target + 1, node});
+        break;
+      }
+    },
+    [&](const SubscriptExpression& subscriptExpression) {
+      compileOperands(subscriptExpression.leftOperand, subscriptExpression.rightOperand);
+      addInstruction({OpCode::Subscript, target, target, target + 1, node});
+    },
+    [&](const SwitchExpression& switchExpression) {
+      const auto& cases = switchExpression.cases;
+      if (cases.empty())
+      {
+        m_constants.push_back(UndefinedRegister{});
+        addInstruction({OpCode::LoadConstant, target, m_constants.size() - 1, 0, node});
+        return;
+      }
+
+      auto jumps = std::vector<size_t>{};
+      for (size_t i = 0; i < cases.size(); ++i)
+      {
+        compile(cases[i], target);
+        if (i + 1 < cases.size())
+        {
+          jumps.push_back(
+            addInstruction({OpCode::JumpIfDefined, target, target, 0, node}));
+        }
+      }
+      for (const auto jump : jumps)
+      {
+        m_instructions[jump].operand2 = m_instructions.size();
+      }
+    }));
+}
+
+size_t CompiledExpression::addNode(const ExpressionNode& expression)
+{
+  m_nodes.push_back(expression);
+  return m_nodes.size() - 1;
+}
+
+size_t CompiledExpression::addInstruction(detail::Instruction instruction)
+{
+  m_instructions.push_back(std::move(instruction));
+  return m_instructions.size() - 1;
+}
+
+} // namespace tb::el
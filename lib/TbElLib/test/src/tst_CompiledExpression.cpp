@@ -0,0 +1,252 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "el/CompiledExpression.h"
+#include "el/EvaluationContext.h"
+#include "el/ParseExpression.h"
+#include "el/Value.h"
+#include "el/VariableStore.h"
+
+#include "kd/ranges/to.h"
+
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace tb::el
+{
+namespace
+{
+
+auto parse(const std::string& expression)
+{
+  return parseExpression(ParseMode::Strict, expression).value();
+}
+
+auto evaluateTree(const ExpressionNode& expression, const VariableStore& variables)
+{
+  return withEvaluationContext(
+    [&](auto& context) { return expression.evaluate(context); }, variables);
+}
+
+auto evaluateCompiled(
+  const CompiledExpression& expression, const VariableStore& variables)
+{
+  return withEvaluationContext(
+    [&](auto& context) { return expression.evaluate(context); }, variables);
+}
+
+// Model expressions as found in FGD files, with entity properties that are always strings
+const auto ModelExpressions = std::vector<std::string>{
+  R"("progs/player.mdl")",
+  R"({ path: "progs/armor.mdl", skin: 0 })",
+  R"({{
+    spawnflags == 1 -> "maps/b_shell0.bsp",
+                       "maps/b_shell1.bsp"
+  }})",
+  R"({{
+    spawnflags & 1 -> { path: "progs/h_ogre.mdl", skin: 1 },
+    spawnflags & 2 -> { path: "progs/h_ogre.mdl", frame: 2 },
+                      { path: "progs/ogre.mdl" }
+  }})",
+  R"({ path: model, skin: skin, frame: frame, scale: scale })",
+  R"({{
+    style == "1" || style == "2" -> { path: "progs/lantern.mdl", skin: style - 1 },
+    (spawnflags & 4) == 0 && angle >= 90 -> "progs/torch.mdl",
+                                           { path: model, scale: 0.5 * scale }
+  }})",
+};
+
+const auto ModelVariables = std::vector<VariableTable>{
+  VariableTable{},
+  VariableTable{{{"spawnflags", Value{"1"}}}},
+  VariableTable{{{"spawnflags", Value{"2"}}, {"angle", Value{"90"}}}},
+  VariableTable{{
+    {"spawnflags", Value{"4"}},
+    {"angle", Value{"180"}},
+    {"scale", Value{"2"}},
+  }},
+  VariableTable{{
+    {"style", Value{"2"}},
+    {"model", Value{"progs/a_rather_long_model_name.mdl"}},
+  }},
+  VariableTable{{
+    {"model", Value{"progs/x.mdl"}},
+    {"skin", Value{"1"}},
+    {"frame", Value{"2"}},
+    {"scale", Value{"1.5"}},
+  }},
+};
+
+} // namespace
+
+TEST_CASE("CompiledExpression")
+{
+  SECTION("evaluate")
+  {
+    using T = std::tuple<std::string, MapType>;
+
+    // clang-format off
+    const auto
+    [expression,                       variables] = GENERATE(values<T>({
+    {"true",                           {}},
+    {"'asdf'",                         {}},
+    {"'a string that is too long to be short'", {}},
+    {"-2",                             {}},
+    {"null",                           {}},
+    {"x",                              {}},
+    {"x",                              {{"x", Value{7}}}},
+    {"[1, 2, x]",                      {{"x", Value{"test"}}}},
+    {"[1, 2..4, x]",                   {{"x", Value{"test"}}}},
+    {"{k1: 'asdf', k2: x, k3: 1 + 2}", {{"x", Value{55}}}},
+    {"(1 + 2) * 3",                    {}},
+    {"+x",                             {{"x", Value{"2"}}}},
+    {"+x",                             {{"x", Value{"a"}}}},
+    {"-x",                             {{"x", Value{true}}}},
+    {"-x",                             {{"x", Value::Null}}},
+    {"!x",                             {{"x", Value{false}}}},
+    {"!x",                             {{"x", Value{1}}}},
+    {"~x",                             {{"x", Value{"3"}}}},
+    {"~x",                             {{"x", Value{true}}}},
+    {"x + 1",                          {{"x", Value{"1"}}}},
+    {"x + 1",                          {{"x", Value{"a"}}}},
+    {"x + y",                          {{"x", Value{"1"}}, {"y", Value{"2"}}}},
+    {"x + y",                          {{"x", Value{"a string that is"}}, {"y", Value{" too long"}}}},
+    {"x + y",                          {{"x", Value{ArrayType{Value{1}}}}, {"y", Value{ArrayType{Value{2}}}}}},
+    {"x + y",                          {{"x", Value{true}}, {"y", Value::Null}}},
+    {"x + y",                          {{"x", Value{1}}}},
+    {"x - 1.5",                        {{"x", Value{true}}}},
+    {"x * 2",                          {{"x", Value{"  "}}}},
+    {"x / 0",                          {{"x", Value{1}}}},
+    {"x % 3",                          {{"x", Value{-7}}}},
+    {"x & 6",                          {{"x", Value{"3"}}}},
+    {"x | 6",                          {{"x", Value::Null}}},
+    {"x ^ 6",                          {{"x", Value{"a"}}}},
+    {"x << 2",                         {{"x", Value{true}}}},
+    {"x >> 1",                         {{"x", Value{-8}}}},
+    {"x < 2",                          {{"x", Value{"1"}}}},
+    {"x < 2",                          {{"x", Value{"a"}}}},
+    {"x <= y",                         {{"x", Value{"abc"}}, {"y", Value{"abd"}}}},
+    {"x > y",                          {{"x", Value{true}}, {"y", Value{"false"}}}},
+    {"x >= y",                         {{"x", Value{0}}, {"y", Value{false}}}},
+    {"x == y",                         {{"x", Value::Null}}},
+    {"x == y",                         {{"x", Value::Null}, {"y", Value::Null}}},
+    {"x != y",                         {{"x", Value{1}}, {"y", Value::Null}}},
+    {"x == y",                         {{"x", Value{ArrayType{Value{1}}}}, {"y", Value{ArrayType{Value{1}}}}}},
+    {"x == y",                         {{"x", Value{ArrayType{}}}, {"y", Value{1}}}},
+    {"x && y",                         {{"x", Value{true}}, {"y", Value::Null}}},
+    {"x && y",                         {{"x", Value{false}}, {"y", Value{1}}}},
+    {"x && y",                         {{"x", Value{true}}, {"y", Value{1}}}},
+    {"x && y",                         {{"x", Value{1}}}},
+    {"x && y",                         {{"y", Value{1}}}},
+    {"x || y",                         {{"x", Value{true}}, {"y", Value{1}}}},
+    {"x || y",                         {{"x", Value{false}}, {"y", Value{true}}}},
+    {"x || y",                         {{"x", Value{"true"}}, {"y", Value{true}}}},
+    {"x -> 'yes'",                     {{"x", Value{"false"}}}},
+    {"x -> 'yes'",                     {{"x", Value{"1"}}}},
+    {"x -> 'yes'",                     {{"x", Value{ArrayType{}}}}},
+    {"{{ x -> 1, y -> 2, 3 }}",        {{"y", Value{true}}}},
+    {"{{ x -> 1, y -> 2 }}",           {}},
+    {"x[1]",                           {{"x", Value{ArrayType{Value{1}, Value{2}}}}}},
+    {"x[-1]",                          {{"x", Value{ArrayType{Value{1}, Value{2}}}}}},
+    {"x[2]",                           {{"x", Value{ArrayType{Value{1}, Value{2}}}}}},
+    {"x[1..]",                         {{"x", Value{ArrayType{Value{1}, Value{2}}}}}},
+    {"x['k']",                         {{"x", Value{MapType{{"k", Value{1}}}}}}},
+    {"x['j']",                         {{"x", Value{MapType{{"k", Value{1}}}}}}},
+    {"x[1]",                           {{"x", Value{"abc"}}}},
+    {"{k: x}['k'] + 1",                {{"x", Value{1}}}},
+    {"[1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, x]", {{"x", Value{1}}}},
+    }));
+    // clang-format on
+
+    CAPTURE(expression, variables);
+
+    const auto node = parse(expression);
+    const auto variableStore = VariableTable{variables};
+    CHECK(
+      evaluateCompiled(CompiledExpression{node}, variableStore)
+      == evaluateTree(node, variableStore));
+  }
+
+  SECTION("model expressions")
+  {
+    for (const auto& expression : ModelExpressions)
+    {
+      const auto node = parse(expression);
+      const auto compiledExpression = CompiledExpression{node};
+
+      for (const auto& variables : ModelVariables)
+      {
+        CAPTURE(expression);
+        CHECK(
+          evaluateCompiled(compiledExpression, variables)
+          == evaluateTree(node, variables));
+      }
+    }
+  }
+}
+
+TEST_CASE("CompiledExpression.benchmarkTreeEvaluation", "[.]")
+{
+  const auto nodes = ModelExpressions
+                     | std::views::transform([](const auto& x) { return parse(x); })
+                     | kdl::ranges::to<std::vector>();
+
+  auto successCount = size_t(0);
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    for (const auto& node : nodes)
+    {
+      for (const auto& variables : ModelVariables)
+      {
+        successCount += evaluateTree(node, variables).is_success() ? 1 : 0;
+      }
+    }
+  }
+
+  CHECK(successCount == 10000 * nodes.size() * ModelVariables.size());
+}
+
+TEST_CASE("CompiledExpression.benchmarkCompiledEvaluation", "[.]")
+{
+  const auto compiledExpressions =
+    ModelExpressions
+    | std::views::transform([](const auto& x) { return CompiledExpression{parse(x)}; })
+    | kdl::ranges::to<std::vector>();
+
+  auto successCount = size_t(0);
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    for (const auto& compiledExpression : compiledExpressions)
+    {
+      for (const auto& variables : ModelVariables)
+      {
+        successCount +=
+          evaluateCompiled(compiledExpression, variables).is_success() ? 1 : 0;
+      }
+    }
+  }
+
+  CHECK(successCount == 10000 * compiledExpressions.size() * ModelVariables.size());
+}
+
+} // namespace tb::el
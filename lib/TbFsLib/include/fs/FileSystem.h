@@ -74,6 +74,12 @@ public:
    */
   Result<std::shared_ptr<File>> openFile(const std::filesystem::path& path) const;
 
+  /** Indicates whether the contents of this file system never change once it has been
+   * created. The contents of an immutable file system can be indexed when it is mounted
+   * into a virtual file system.
+   */
+  virtual bool isImmutable() const;
+
 protected:
   virtual Result<std::vector<std::filesystem::path>> doFind(
     const std::filesystem::path& path, const TraversalMode& traversalMode) const = 0;
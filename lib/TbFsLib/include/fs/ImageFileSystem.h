@@ -77,6 +77,8 @@ public:
 
   void setMetadata(std::unordered_map<std::string, FileSystemMetadata> metadata);
 
+  bool isImmutable() const override;
+
 protected:
   void addFile(const std::filesystem::path& path, GetImageFile getFile);
 
@@ -24,10 +24,15 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace tb::fs
 {
+enum class PathInfo;
 
 class VirtualMountPointId
 {
@@ -48,13 +53,46 @@ struct VirtualMountPoint
   VirtualMountPointId id;
   std::filesystem::path path;
   std::unique_ptr<FileSystem> mountedFileSystem;
+
+  /**
+   * The index keys and path infos of all paths in the mounted file system, or
+   * std::nullopt if the file system is not indexed.
+   */
+  std::optional<std::vector<std::pair<std::string, PathInfo>>> indexedPaths;
+};
+
+struct VirtualIndexEntry
+{
+  size_t mountPointIndex;
+  PathInfo pathInfo;
 };
 
+/**
+ * Combines several file systems, each mounted at a path. If several mounted file systems
+ * contain the same path, the one that was mounted last takes precedence.
+ *
+ * The contents of immutable file systems are merged into an index when they are mounted.
+ * The index maps the case folded paths to the mount point which takes precedence, so a
+ * path is resolved with a single lookup instead of querying every mounted file system.
+ * Mutable file systems, such as disk file systems, are still queried on every lookup.
+ *
+ * The paths of each immutable file system are collected only once, when it is mounted.
+ * Unmounting a file system merges the collected paths of the remaining file systems into
+ * a new index without querying them again.
+ */
 class VirtualFileSystem : public FileSystem
 {
 private:
   std::vector<VirtualMountPoint> m_mountPoints;
 
+  std::unordered_map<std::string, VirtualIndexEntry> m_index;
+
+  /**
+   * The indices of the mount points whose file systems are not indexed, in ascending
+   * order.
+   */
+  std::vector<size_t> m_unindexedMountPoints;
+
 public:
   Result<std::filesystem::path> makeAbsolute(
     const std::filesystem::path& path) const override;
@@ -65,6 +103,13 @@ public:
   VirtualMountPointId mount(
     const std::filesystem::path& path, std::unique_ptr<FileSystem> fs);
   bool unmount(const VirtualMountPointId& id);
+
+  /**
+   * Unmounts all given mount points and rebuilds the index once. Returns the number of
+   * mount points that were unmounted.
+   */
+  size_t unmount(const std::vector<VirtualMountPointId>& ids);
+
   void unmountAll();
 
 protected:
@@ -72,6 +117,24 @@ protected:
     const std::filesystem::path& path, const TraversalMode& traversalMode) const override;
   Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const override;
+
+private:
+  struct Resolution
+  {
+    const VirtualMountPoint& mountPoint;
+    std::filesystem::path pathSuffix;
+    PathInfo pathInfo;
+  };
+
+  /**
+   * Returns the mount point that takes precedence for the given path, the path relative
+   * to that mount point, and its path info. Returns std::nullopt if no mounted file system
+   * contains the given path.
+   */
+  std::optional<Resolution> resolve(const std::filesystem::path& path) const;
+
+  void addToIndex(size_t mountPointIndex);
+  void rebuildIndex();
 };
 
 class WritableVirtualFileSystem : public WritableFileSystem
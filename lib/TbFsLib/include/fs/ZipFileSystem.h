@@ -22,25 +22,64 @@
 #include "Result.h"
 #include "fs/ImageFileSystem.h"
 
-#include <miniz/miniz.h>
-
-#include <mutex>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
 
 namespace tb::fs
 {
 class CFile;
+class ZipIndexCache;
+
+/**
+ * The location and compression parameters of a file in a zip archive, taken from the
+ * archive's central directory.
+ */
+struct ZipFileEntry
+{
+  std::filesystem::path path;
+  size_t localHeaderOffset;
+  size_t compressedSize;
+  size_t uncompressedSize;
+  uint16_t method;
+  uint32_t crc32;
+  bool encrypted;
 
+  bool operator==(const ZipFileEntry&) const = default;
+};
+
+/**
+ * A file system backed by a zip archive. The archive's central directory is only read
+ * when the directory is read. Files are extracted without locking the archive, so they
+ * can be opened concurrently.
+ *
+ * If an index cache is given, the file entries are taken from the cache if the archive
+ * has not changed since they were stored, and the central directory is not read at all.
+ */
 class ZipFileSystem : public ImageFileSystem<CFile>
 {
 private:
-  mz_zip_archive m_archive;
-  std::mutex m_mutex;
+  std::filesystem::path m_path;
+  std::shared_ptr<ZipIndexCache> m_indexCache;
 
 public:
   using ImageFileSystem::ImageFileSystem;
-  ~ZipFileSystem() override;
+
+  /**
+   * Creates a zip file system that uses the given index cache.
+   *
+   * @param file the archive file
+   * @param path the path of the archive file on disk, used as the cache key
+   * @param indexCache the index cache
+   */
+  ZipFileSystem(
+    std::shared_ptr<CFile> file,
+    std::filesystem::path path,
+    std::shared_ptr<ZipIndexCache> indexCache);
 
 private:
+  Result<std::vector<ZipFileEntry>> readEntries() const;
   Result<void> doReadDirectory() override;
 };
 } // namespace tb::fs
@@ -0,0 +1,102 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+#include "fs/ZipFileSystem.h"
+
+#include "kd/path_hash.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::fs
+{
+class Reader;
+
+/**
+ * Caches the file entries of zip archives on disk, so that unchanged archives can be
+ * mounted without reading their central directories.
+ *
+ * The entries of an archive are keyed by its path and are only used if the size and the
+ * modification time of the archive have not changed since they were stored. The cache
+ * file is read when the cache is first accessed, and it is only written by calling
+ * save(). Archives that no longer exist are removed from the cache when it is read.
+ *
+ * Only the file entries are cached, not the directory tree that ZipFileSystem builds
+ * from them. On a cache hit, the archive is not opened to read its central directory,
+ * but every entry is still added to the directory tree of the file system.
+ */
+class ZipIndexCache
+{
+private:
+  struct ArchiveStamp
+  {
+    uint64_t size;
+    int64_t modificationTime;
+
+    bool operator==(const ArchiveStamp&) const = default;
+  };
+
+  struct Archive
+  {
+    ArchiveStamp stamp;
+    std::vector<ZipFileEntry> entries;
+  };
+
+  using ArchiveMap = std::unordered_map<std::filesystem::path, Archive, kdl::path_hash>;
+
+  std::filesystem::path m_cacheFilePath;
+
+  std::mutex m_mutex;
+  bool m_loaded = false;
+  bool m_modified = false;
+  ArchiveMap m_archives;
+
+public:
+  explicit ZipIndexCache(std::filesystem::path cacheFilePath);
+
+  /**
+   * Returns the cached entries of the archive at the given path, or std::nullopt if the
+   * archive is not cached or if it was changed since its entries were stored.
+   */
+  std::optional<std::vector<ZipFileEntry>> find(const std::filesystem::path& archivePath);
+
+  /**
+   * Stores the given entries for the archive at the given path, replacing any entries
+   * that were previously stored for it.
+   */
+  void store(const std::filesystem::path& archivePath, std::vector<ZipFileEntry> entries);
+
+  /**
+   * Writes the cache file if any entries were stored since it was read.
+   */
+  Result<void> save();
+
+private:
+  void loadIfNecessary();
+  static ArchiveMap readArchives(Reader& reader);
+};
+
+} // namespace tb::fs
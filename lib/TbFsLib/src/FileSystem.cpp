@@ -77,6 +77,11 @@ Result<std::shared_ptr<File>> FileSystem::openFile(
   return doOpenFile(path);
 }
 
+bool FileSystem::isImmutable() const
+{
+  return false;
+}
+
 WritableFileSystem::~WritableFileSystem() = default;
 
 Result<void> WritableFileSystem::createFileAtomic(
@@ -204,6 +204,12 @@ void ImageFileSystemBase::setMetadata(
   m_metadata = std::move(metadata);
 }
 
+bool ImageFileSystemBase::isImmutable() const
+{
+  // the directory is only read when the file system is created
+  return true;
+}
+
 void ImageFileSystemBase::addFile(const std::filesystem::path& path, GetImageFile getFile)
 {
   auto& directoryEntry =
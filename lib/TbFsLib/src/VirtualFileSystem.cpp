@@ -29,6 +29,7 @@
 #include "kd/ranges/to.h"
 #include "kd/result.h"
 #include "kd/result_fold.h"
+#include "kd/string_format.h"
 #include "kd/vector_utils.h"
 
 #include <fmt/format.h>
@@ -65,6 +66,33 @@ std::filesystem::path suffix(
   return kdl::path_clip(path, kdl::path_length(mountPoint.path));
 }
 
+std::string makeIndexKey(const std::filesystem::path& path)
+{
+  return kdl::str_to_lower(path.generic_string());
+}
+
+std::optional<std::vector<std::pair<std::string, PathInfo>>> collectIndexedPaths(
+  const std::filesystem::path& mountPointPath, const FileSystem& fs)
+{
+  if (fs.isImmutable())
+  {
+    if (auto paths = fs.find("", TraversalMode::Recursive))
+    {
+      auto result = std::vector<std::pair<std::string, PathInfo>>{};
+      result.reserve(paths.value().size() + 1);
+
+      result.emplace_back(makeIndexKey(mountPointPath), fs.pathInfo(""));
+      for (const auto& path : paths.value())
+      {
+        result.emplace_back(makeIndexKey(mountPointPath / path), fs.pathInfo(path));
+      }
+      return result;
+    }
+  }
+
+  return std::nullopt;
+}
+
 } // namespace
 
 VirtualMountPointId::VirtualMountPointId()
@@ -85,19 +113,13 @@ bool operator!=(const VirtualMountPointId& lhs, const VirtualMountPointId& rhs)
 Result<std::filesystem::path> VirtualFileSystem::makeAbsolute(
   const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto resolution = resolve(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
+    if (
+      auto absPath =
+        resolution->mountPoint.mountedFileSystem->makeAbsolute(resolution->pathSuffix))
     {
-      const auto pathSuffix = suffix(mountPoint, path);
-      const auto absPath = mountPoint.mountedFileSystem->makeAbsolute(pathSuffix);
-      if (
-        absPath
-        && mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
-      {
-        return absPath;
-      }
+      return absPath;
     }
   }
 
@@ -106,18 +128,9 @@ Result<std::filesystem::path> VirtualFileSystem::makeAbsolute(
 
 PathInfo VirtualFileSystem::pathInfo(const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto resolution = resolve(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
-          pathInfo != PathInfo::Unknown)
-      {
-        return pathInfo;
-      }
-    }
+    return resolution->pathInfo;
   }
 
   return std::ranges::any_of(
@@ -133,18 +146,10 @@ PathInfo VirtualFileSystem::pathInfo(const std::filesystem::path& path) const
 const FileSystemMetadata* VirtualFileSystem::metadata(
   const std::filesystem::path& path, const std::string& key) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto resolution = resolve(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
-          pathInfo != PathInfo::Unknown)
-      {
-        return mountPoint.mountedFileSystem->metadata(pathSuffix, key);
-      }
-    }
+    return resolution->mountPoint.mountedFileSystem->metadata(
+      resolution->pathSuffix, key);
   }
 
   return nullptr;
@@ -154,25 +159,95 @@ VirtualMountPointId VirtualFileSystem::mount(
   const std::filesystem::path& path, std::unique_ptr<FileSystem> fs)
 {
   const auto id = VirtualMountPointId{};
-  m_mountPoints.push_back({id, path, std::move(fs)});
+  auto indexedPaths = collectIndexedPaths(path, *fs);
+  m_mountPoints.push_back({id, path, std::move(fs), std::move(indexedPaths)});
+  addToIndex(m_mountPoints.size() - 1);
   return id;
 }
 
 bool VirtualFileSystem::unmount(const VirtualMountPointId& id)
 {
-  if (const auto it = std::ranges::find_if(
-        m_mountPoints, [&](const auto& mountPoint) { return mountPoint.id == id; });
-      it != m_mountPoints.end())
+  return unmount(std::vector<VirtualMountPointId>{id}) > 0;
+}
+
+size_t VirtualFileSystem::unmount(const std::vector<VirtualMountPointId>& ids)
+{
+  const auto count = std::erase_if(m_mountPoints, [&](const auto& mountPoint) {
+    return std::ranges::find(ids, mountPoint.id) != ids.end();
+  });
+
+  if (count > 0)
   {
-    m_mountPoints.erase(it);
-    return true;
+    rebuildIndex();
   }
-  return false;
+  return count;
 }
 
 void VirtualFileSystem::unmountAll()
 {
   m_mountPoints.clear();
+  rebuildIndex();
+}
+
+std::optional<VirtualFileSystem::Resolution> VirtualFileSystem::resolve(
+  const std::filesystem::path& path) const
+{
+  const auto indexIt = m_index.find(makeIndexKey(path));
+  const auto* indexEntry = indexIt != m_index.end() ? &indexIt->second : nullptr;
+
+  // unindexed mount points take precedence if they were mounted after the indexed mount
+  // point that contains the path
+  const auto firstMountPointIndex = indexEntry ? indexEntry->mountPointIndex + 1 : 0;
+  for (auto it = m_unindexedMountPoints.rbegin();
+       it != m_unindexedMountPoints.rend() && *it >= firstMountPointIndex;
+       ++it)
+  {
+    const auto& mountPoint = m_mountPoints[*it];
+    if (matches(mountPoint, path))
+    {
+      auto pathSuffix = suffix(mountPoint, path);
+      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
+          pathInfo != PathInfo::Unknown)
+      {
+        return Resolution{mountPoint, std::move(pathSuffix), pathInfo};
+      }
+    }
+  }
+
+  if (indexEntry)
+  {
+    const auto& mountPoint = m_mountPoints[indexEntry->mountPointIndex];
+    return Resolution{mountPoint, suffix(mountPoint, path), indexEntry->pathInfo};
+  }
+
+  return std::nullopt;
+}
+
+void VirtualFileSystem::addToIndex(const size_t mountPointIndex)
+{
+  const auto& mountPoint = m_mountPoints[mountPointIndex];
+  if (mountPoint.indexedPaths)
+  {
+    for (const auto& [key, pathInfo] : *mountPoint.indexedPaths)
+    {
+      m_index[key] = VirtualIndexEntry{mountPointIndex, pathInfo};
+    }
+  }
+  else
+  {
+    m_unindexedMountPoints.push_back(mountPointIndex);
+  }
+}
+
+void VirtualFileSystem::rebuildIndex()
+{
+  m_index.clear();
+  m_unindexedMountPoints.clear();
+
+  for (size_t i = 0; i < m_mountPoints.size(); ++i)
+  {
+    addToIndex(i);
+  }
 }
 
 namespace
@@ -302,17 +377,9 @@ Result<std::vector<std::filesystem::path>> VirtualFileSystem::doFind(
 Result<std::shared_ptr<File>> VirtualFileSystem::doOpenFile(
   const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto resolution = resolve(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
-      {
-        return mountPoint.mountedFileSystem->openFile(pathSuffix);
-      }
-    }
+    return resolution->mountPoint.mountedFileSystem->openFile(resolution->pathSuffix);
   }
 
   return Error{fmt::format("{} not found", path)};
@@ -20,11 +20,15 @@
 #include "fs/ZipFileSystem.h"
 
 #include "fs/File.h"
+#include "fs/Reader.h"
+#include "fs/ReaderException.h"
+#include "fs/ZipIndexCache.h"
 
 #include "kd/result.h"
 
 #include <fmt/format.h>
 #include <fmt/std.h>
+#include <miniz/miniz.h>
 
 #include <memory>
 #include <string>
@@ -56,53 +60,137 @@ std::string filename(mz_zip_archive& archive, const mz_uint fileIndex)
 
   return result;
 }
-} // namespace
 
-ZipFileSystem::~ZipFileSystem()
+constexpr auto LocalHeaderSignature = 0x04034b50u;
+constexpr auto LocalHeaderSize = size_t(30);
+constexpr auto LocalHeaderFilenameLengthOffset = size_t(26);
+
+size_t dataOffset(const CFile& file, const ZipFileEntry& entry)
 {
-  mz_zip_reader_end(&m_archive);
+  auto reader =
+    file.reader().subReaderFromBegin(entry.localHeaderOffset, LocalHeaderSize);
+  if (reader.readUnsignedInt<uint32_t>() != LocalHeaderSignature)
+  {
+    throw ReaderException{"Invalid local file header signature"};
+  }
+
+  reader.seekFromBegin(LocalHeaderFilenameLengthOffset);
+  const auto filenameLength = reader.readSize<uint16_t>();
+  const auto extraLength = reader.readSize<uint16_t>();
+
+  return entry.localHeaderOffset + LocalHeaderSize + filenameLength + extraLength;
 }
 
-Result<void> ZipFileSystem::doReadDirectory()
+/**
+ * Opens the given entry without accessing the zip archive. Compressed data is read from
+ * the file and decompressed by the calling thread, so several entries can be extracted
+ * concurrently. Stored entries are returned as views of the file.
+ */
+Result<std::shared_ptr<File>> openEntry(
+  const std::shared_ptr<CFile>& file, const ZipFileEntry& entry)
+{
+  const auto& path = entry.path;
+
+  if (entry.encrypted)
+  {
+    return Error{fmt::format("Cannot open encrypted file {}", path)};
+  }
+
+  try
+  {
+    const auto offset = dataOffset(*file, entry);
+
+    if (entry.method == 0 && entry.compressedSize == entry.uncompressedSize)
+    {
+      return std::static_pointer_cast<File>(
+        std::make_shared<FileView>(file, offset, entry.uncompressedSize));
+    }
+
+    if (entry.method != MZ_DEFLATED)
+    {
+      return Error{
+        fmt::format("Unsupported compression method {} for {}", entry.method, path)};
+    }
+
+    auto compressedData = std::make_unique<char[]>(entry.compressedSize);
+    file->reader()
+      .subReaderFromBegin(offset, entry.compressedSize)
+      .read(compressedData.get(), entry.compressedSize);
+
+    auto data = std::make_unique<char[]>(entry.uncompressedSize);
+    const auto decompressedSize = tinfl_decompress_mem_to_mem(
+      data.get(),
+      entry.uncompressedSize,
+      compressedData.get(),
+      entry.compressedSize,
+      TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+
+    if (decompressedSize != entry.uncompressedSize)
+    {
+      return Error{fmt::format("Failed to decompress {}", path)};
+    }
+
+    const auto crc32 = mz_crc32(
+      MZ_CRC32_INIT,
+      reinterpret_cast<const unsigned char*>(data.get()),
+      entry.uncompressedSize);
+    if (crc32 != entry.crc32)
+    {
+      return Error{fmt::format("CRC mismatch for {}", path)};
+    }
+
+    return std::static_pointer_cast<File>(
+      std::make_shared<OwningBufferFile>(std::move(data), entry.uncompressedSize));
+  }
+  catch (const ReaderException& e)
+  {
+    return Error{fmt::format("Failed to read {}: {}", path, e.what())};
+  }
+}
+
+Result<std::vector<ZipFileEntry>> readCentralDirectory(CFile& file)
 {
-  mz_zip_zero_struct(&m_archive);
+  auto archive = mz_zip_archive{};
+  mz_zip_zero_struct(&archive);
 
-  if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
+  if (mz_zip_reader_init_cfile(&archive, file.file(), file.size(), 0) != MZ_TRUE)
   {
     return Error{"Error calling mz_zip_reader_init_cfile"};
   }
 
-  const auto numFiles = mz_zip_reader_get_num_files(&m_archive);
+  auto entries = std::vector<ZipFileEntry>{};
+
+  const auto numFiles = mz_zip_reader_get_num_files(&archive);
+  entries.reserve(numFiles);
+
   for (mz_uint i = 0; i < numFiles; ++i)
   {
-    if (!mz_zip_reader_is_file_a_directory(&m_archive, i))
+    if (!mz_zip_reader_is_file_a_directory(&archive, i))
     {
-      const auto path = std::filesystem::path{filename(m_archive, i)};
-      addFile(path, [&, i, path]() -> Result<std::shared_ptr<File>> {
-        auto loadFileGoard = std::lock_guard{m_mutex};
-
-        auto stat = mz_zip_archive_file_stat{};
-        if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
-        {
-          return Error{fmt::format("mz_zip_reader_file_stat failed for {}", path)};
-        }
-
-        const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-        auto data = std::make_unique<char[]>(uncompressedSize);
-        auto* begin = data.get();
-
-        if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
-        {
-          return Error{fmt::format("mz_zip_reader_extract_to_mem failed for {}", path)};
-        }
-
-        return std::static_pointer_cast<File>(
-          std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+      auto path = std::filesystem::path{filename(archive, i)};
+
+      auto stat = mz_zip_archive_file_stat{};
+      if (!mz_zip_reader_file_stat(&archive, i, &stat))
+      {
+        mz_zip_reader_end(&archive);
+        return Error{fmt::format("mz_zip_reader_file_stat failed for {}", path)};
+      }
+
+      entries.push_back(ZipFileEntry{
+        std::move(path),
+        static_cast<size_t>(stat.m_local_header_ofs),
+        static_cast<size_t>(stat.m_comp_size),
+        static_cast<size_t>(stat.m_uncomp_size),
+        stat.m_method,
+        static_cast<uint32_t>(stat.m_crc32),
+        stat.m_is_encrypted == MZ_TRUE,
       });
     }
   }
 
-  const auto err = mz_zip_get_last_error(&m_archive);
+  const auto err = mz_zip_get_last_error(&archive);
+  mz_zip_reader_end(&archive);
+
   if (err != MZ_ZIP_NO_ERROR)
   {
     return Error{
@@ -110,7 +198,53 @@ Result<void> ZipFileSystem::doReadDirectory()
       + mz_zip_get_error_string(err)};
   }
 
-  return kdl::void_success;
+  return entries;
+}
+
+} // namespace
+
+ZipFileSystem::ZipFileSystem(
+  std::shared_ptr<CFile> file,
+  std::filesystem::path path,
+  std::shared_ptr<ZipIndexCache> indexCache)
+  : ImageFileSystem{std::move(file)}
+  , m_path{std::move(path)}
+  , m_indexCache{std::move(indexCache)}
+{
+}
+
+Result<std::vector<ZipFileEntry>> ZipFileSystem::readEntries() const
+{
+  if (m_indexCache)
+  {
+    if (auto entries = m_indexCache->find(m_path))
+    {
+      return std::move(*entries);
+    }
+
+    return readCentralDirectory(*m_file) | kdl::transform([&](auto entries) {
+             m_indexCache->store(m_path, entries);
+             return entries;
+           });
+  }
+
+  return readCentralDirectory(*m_file);
+}
+
+Result<void> ZipFileSystem::doReadDirectory()
+{
+  return readEntries() | kdl::transform([&](auto entries) {
+           for (auto& entry_ : entries)
+           {
+             const auto path = entry_.path;
+             addFile(
+               path,
+               [file = m_file,
+                entry = std::move(entry_)]() -> Result<std::shared_ptr<File>> {
+                 return openEntry(file, entry);
+               });
+           }
+         });
 }
 
 } // namespace tb::fs
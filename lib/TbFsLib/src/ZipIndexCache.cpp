@@ -0,0 +1,273 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fs/ZipIndexCache.h"
+
+#include "fs/DiskIO.h"
+#include "fs/File.h"
+#include "fs/PathInfo.h"
+#include "fs/Reader.h"
+#include "fs/ReaderException.h"
+
+#include "kd/result.h"
+
+#include <fmt/format.h>
+
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace tb::fs
+{
+namespace
+{
+
+constexpr auto Magic = std::string_view{"TBZIPIDX"};
+constexpr auto Version = uint32_t(1);
+
+// the number of bytes that an entry with an empty path occupies in the cache file
+constexpr auto MinEntrySize = sizeof(uint32_t) + 3 * sizeof(uint64_t) + sizeof(uint16_t)
+                              + sizeof(uint32_t) + sizeof(uint8_t);
+
+template <typename T>
+void write(std::ostream& stream, const T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& stream, const std::string& str)
+{
+  write(stream, uint32_t(str.size()));
+  stream.write(str.data(), std::streamsize(str.size()));
+}
+
+void ensureCanRead(const Reader& reader, const size_t size)
+{
+  if (!reader.canRead(size))
+  {
+    throw ReaderException{
+      fmt::format("Cannot read {} bytes at position {}", size, reader.position())};
+  }
+}
+
+std::string readString(Reader& reader)
+{
+  const auto length = reader.readSize<uint32_t>();
+  ensureCanRead(reader, length);
+
+  auto str = std::string(length, '\0');
+  reader.read(str.data(), length);
+  return str;
+}
+
+} // namespace
+
+ZipIndexCache::ZipIndexCache(std::filesystem::path cacheFilePath)
+  : m_cacheFilePath{std::move(cacheFilePath)}
+{
+}
+
+std::optional<std::vector<ZipFileEntry>> ZipIndexCache::find(
+  const std::filesystem::path& archivePath)
+{
+  auto guard = std::lock_guard{m_mutex};
+  loadIfNecessary();
+
+  const auto it = m_archives.find(archivePath);
+  if (it == m_archives.end())
+  {
+    return std::nullopt;
+  }
+
+  auto errorCode = std::error_code{};
+  const auto size = std::filesystem::file_size(archivePath, errorCode);
+  const auto modificationTime = std::filesystem::last_write_time(archivePath, errorCode);
+  if (
+    errorCode
+    || it->second.stamp
+         != ArchiveStamp{size, int64_t(modificationTime.time_since_epoch().count())})
+  {
+    m_archives.erase(it);
+    m_modified = true;
+    return std::nullopt;
+  }
+
+  return it->second.entries;
+}
+
+void ZipIndexCache::store(
+  const std::filesystem::path& archivePath, std::vector<ZipFileEntry> entries)
+{
+  auto guard = std::lock_guard{m_mutex};
+  loadIfNecessary();
+
+  auto errorCode = std::error_code{};
+  const auto size = std::filesystem::file_size(archivePath, errorCode);
+  const auto modificationTime = std::filesystem::last_write_time(archivePath, errorCode);
+  if (errorCode)
+  {
+    return;
+  }
+
+  m_archives[archivePath] = Archive{
+    ArchiveStamp{size, int64_t(modificationTime.time_since_epoch().count())},
+    std::move(entries),
+  };
+  m_modified = true;
+}
+
+Result<void> ZipIndexCache::save()
+{
+  auto guard = std::lock_guard{m_mutex};
+  if (!m_modified)
+  {
+    return kdl::void_success;
+  }
+
+  const auto writeArchives = [&](auto& stream) {
+    stream.write(Magic.data(), std::streamsize(Magic.size()));
+    write(stream, Version);
+    write(stream, uint32_t(m_archives.size()));
+
+    for (const auto& [archivePath, archive] : m_archives)
+    {
+      writeString(stream, archivePath.string());
+      write(stream, archive.stamp.size);
+      write(stream, archive.stamp.modificationTime);
+      write(stream, uint32_t(archive.entries.size()));
+
+      for (const auto& entry : archive.entries)
+      {
+        writeString(stream, entry.path.string());
+        write(stream, uint64_t(entry.localHeaderOffset));
+        write(stream, uint64_t(entry.compressedSize));
+        write(stream, uint64_t(entry.uncompressedSize));
+        write(stream, entry.method);
+        write(stream, entry.crc32);
+        write(stream, uint8_t(entry.encrypted));
+      }
+    }
+  };
+
+  const auto directoryPath = m_cacheFilePath.parent_path();
+  return Disk::makeUniqueFilename(directoryPath)
+         | kdl::and_then([&](const auto& tempFilename) {
+             // write to a temporary file first so that a partially written cache file
+             // never replaces the previous one
+             const auto tempPath = directoryPath / tempFilename;
+             return Disk::withOutputStream(
+                      tempPath, std::ios::out | std::ios::binary, writeArchives)
+                    | kdl::and_then(
+                      [&]() { return Disk::moveFile(tempPath, m_cacheFilePath); })
+                    | kdl::or_else([&](auto e) {
+                        return Disk::deleteFile(tempPath)
+                               | kdl::and_then([&](auto) { return Result<void>{e}; });
+                      });
+           })
+         | kdl::transform([&]() { m_modified = false; });
+}
+
+void ZipIndexCache::loadIfNecessary()
+{
+  if (m_loaded)
+  {
+    return;
+  }
+  m_loaded = true;
+
+  if (Disk::pathInfo(m_cacheFilePath) != PathInfo::File)
+  {
+    return;
+  }
+
+  // A cache file that cannot be read is ignored and overwritten when the cache is saved
+  Disk::openFile(m_cacheFilePath)
+    | kdl::transform([&](const std::shared_ptr<CFile>& file) {
+        try
+        {
+          auto reader = file->reader().buffer();
+          m_archives = readArchives(reader);
+        }
+        catch (const ReaderException&)
+        {
+          m_archives.clear();
+        }
+      })
+    | kdl::transform_error([](const auto&) {});
+
+  // forget archives that were deleted so that the cache file does not grow forever
+  const auto removedCount = std::erase_if(m_archives, [](const auto& archive) {
+    return Disk::pathInfo(archive.first) != PathInfo::File;
+  });
+  m_modified = removedCount > 0;
+}
+
+ZipIndexCache::ArchiveMap ZipIndexCache::readArchives(Reader& reader)
+{
+  auto magic = std::string(Magic.size(), '\0');
+  reader.read(magic.data(), magic.size());
+  if (magic != Magic || reader.readUnsignedInt<uint32_t>() != Version)
+  {
+    return {};
+  }
+
+  auto archives = ArchiveMap{};
+
+  const auto archiveCount = reader.readSize<uint32_t>();
+  for (size_t i = 0; i < archiveCount; ++i)
+  {
+    auto archivePath = std::filesystem::path{readString(reader)};
+    const auto size = reader.read<uint64_t, uint64_t>();
+    const auto modificationTime = reader.read<int64_t, int64_t>();
+
+    const auto entryCount = reader.readSize<uint32_t>();
+    ensureCanRead(reader, entryCount * MinEntrySize);
+
+    auto entries = std::vector<ZipFileEntry>{};
+    entries.reserve(entryCount);
+
+    for (size_t j = 0; j < entryCount; ++j)
+    {
+      auto path = std::filesystem::path{readString(reader)};
+      const auto localHeaderOffset = reader.readSize<uint64_t>();
+      const auto compressedSize = reader.readSize<uint64_t>();
+      const auto uncompressedSize = reader.readSize<uint64_t>();
+      const auto method = reader.read<uint16_t, uint16_t>();
+      const auto crc32 = reader.read<uint32_t, uint32_t>();
+      const auto encrypted = reader.readBool<uint8_t>();
+
+      entries.push_back(ZipFileEntry{
+        std::move(path),
+        localHeaderOffset,
+        compressedSize,
+        uncompressedSize,
+        method,
+        crc32,
+        encrypted,
+      });
+    }
+
+    archives[std::move(archivePath)] =
+      Archive{ArchiveStamp{size, modificationTime}, std::move(entries)};
+  }
+
+  return archives;
+}
+
+} // namespace tb::fs
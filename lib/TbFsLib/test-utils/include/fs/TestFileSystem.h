@@ -67,6 +67,7 @@ private:
   Entry m_root;
   std::unordered_map<std::string, FileSystemMetadata> m_metadata;
   std::filesystem::path m_absolutePathPrefix;
+  bool m_immutable = false;
 
 public:
   explicit TestFileSystem(
@@ -79,6 +80,9 @@ public:
   PathInfo pathInfo(const std::filesystem::path& path) const override;
   const FileSystemMetadata* metadata(
     const std::filesystem::path& path, const std::string& key) const override;
+  bool isImmutable() const override;
+
+  void setImmutable(bool immutable);
 
 private:
   const Entry* findEntry(std::filesystem::path path) const;
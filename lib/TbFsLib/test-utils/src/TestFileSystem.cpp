@@ -104,6 +104,16 @@ const FileSystemMetadata* TestFileSystem::metadata(
   return nullptr;
 }
 
+bool TestFileSystem::isImmutable() const
+{
+  return m_immutable;
+}
+
+void TestFileSystem::setImmutable(const bool immutable)
+{
+  m_immutable = immutable;
+}
+
 Result<std::filesystem::path> TestFileSystem::makeAbsolute(
   const std::filesystem::path& path) const
 {
@@ -22,12 +22,17 @@
 #include "fs/DkPakFileSystem.h"
 #include "fs/IdPakFileSystem.h"
 #include "fs/PathInfo.h"
+#include "fs/TestEnvironment.h"
 #include "fs/TestUtils.h"
 #include "fs/TraversalMode.h"
 #include "fs/WadFileSystem.h"
 #include "fs/ZipFileSystem.h"
+#include "fs/ZipIndexCache.h"
 
 #include <filesystem>
+#include <future>
+#include <string>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
@@ -985,6 +990,161 @@ TEST_CASE("Flat ImageFileSystems")
   }
 }
 
+TEST_CASE("ZipFileSystem")
+{
+  SECTION("Files can be opened concurrently")
+  {
+    const auto fsTestPath = std::filesystem::current_path() / "fixture/test/fs/";
+    const auto fs = openFS<ZipFileSystem>(fsTestPath / "Zip/zip.zip");
+
+    const auto readContents = [&](const std::filesystem::path& path) {
+      const auto file = fs->openFile(path) | kdl::value();
+      auto reader = file->reader();
+      return reader.readString(reader.size());
+    };
+
+    const auto paths = fs->find("", fs::TraversalMode::Recursive) | kdl::value();
+
+    auto expectedContents = std::vector<std::string>{};
+    for (const auto& path : paths)
+    {
+      if (fs->pathInfo(path) == fs::PathInfo::File)
+      {
+        expectedContents.push_back(readContents(path));
+      }
+    }
+
+    auto futures = std::vector<std::future<std::vector<std::string>>>{};
+    for (size_t i = 0; i < 8; ++i)
+    {
+      futures.push_back(std::async(std::launch::async, [&]() {
+        auto contents = std::vector<std::string>{};
+        for (const auto& path : paths)
+        {
+          if (fs->pathInfo(path) == fs::PathInfo::File)
+          {
+            contents.push_back(readContents(path));
+          }
+        }
+        return contents;
+      }));
+    }
+
+    for (auto& future : futures)
+    {
+      CHECK(future.get() == expectedContents);
+    }
+  }
+
+  SECTION("Entries are taken from the index cache")
+  {
+    const auto env = TestEnvironment{};
+    const auto zipPath = std::filesystem::current_path() / "fixture/test/fs/Zip/zip.zip";
+    const auto cachePath = env.dir() / "index.bin";
+
+    const auto openCachedFS = [&](const std::shared_ptr<ZipIndexCache>& indexCache) {
+      return Disk::openFile(zipPath) | kdl::and_then([&](auto file) {
+               return createImageFileSystem<ZipFileSystem>(
+                 std::move(file), zipPath, indexCache);
+             })
+             | kdl::value();
+    };
+
+    auto indexCache = std::make_shared<ZipIndexCache>(cachePath);
+    CHECK(indexCache->find(zipPath) == std::nullopt);
+
+    openCachedFS(indexCache);
+
+    const auto entries = indexCache->find(zipPath);
+    REQUIRE(entries != std::nullopt);
+    CHECK(!entries->empty());
+
+    CHECK(indexCache->save().is_success());
+    CHECK(env.fileExists("index.bin"));
+
+    auto loadedIndexCache = std::make_shared<ZipIndexCache>(cachePath);
+    CHECK(loadedIndexCache->find(zipPath) == entries);
+
+    const auto fs = openCachedFS(loadedIndexCache);
+    CHECK(fs->pathInfo("pics/tag1.pcx") == fs::PathInfo::File);
+
+    const auto file = fs->openFile("amnet.cfg") | kdl::value();
+    auto reader = file->reader();
+    CHECK(reader.readString(reader.size()).starts_with("//\n// my stuff"));
+  }
+
+  SECTION("Corrupt index cache files are ignored")
+  {
+    const auto env = TestEnvironment{[](auto& e) { e.createFile("index.bin", "TBZI"); }};
+    const auto zipPath = std::filesystem::current_path() / "fixture/test/fs/Zip/zip.zip";
+
+    auto indexCache = ZipIndexCache{env.dir() / "index.bin"};
+    CHECK(indexCache.find(zipPath) == std::nullopt);
+  }
+
+  SECTION("Index cache files with invalid lengths are ignored")
+  {
+    const auto toBytes = [](const auto value) {
+      return std::string{reinterpret_cast<const char*>(&value), sizeof(value)};
+    };
+    const auto header =
+      std::string{"TBZIPIDX"} + toBytes(uint32_t(1)) + toBytes(uint32_t(1));
+    const auto zipPath = std::filesystem::current_path() / "fixture/test/fs/Zip/zip.zip";
+
+    SECTION("Path length")
+    {
+      const auto env = TestEnvironment{[&](auto& e) {
+        e.createFile("index.bin", header + toBytes(uint32_t(0xFFFFFFFF)));
+      }};
+
+      auto indexCache = ZipIndexCache{env.dir() / "index.bin"};
+      CHECK(indexCache.find(zipPath) == std::nullopt);
+    }
+
+    SECTION("Entry count")
+    {
+      const auto env = TestEnvironment{[&](auto& e) {
+        e.createFile(
+          "index.bin",
+          header + toBytes(uint32_t(5)) + "a.zip" + toBytes(uint64_t(0))
+            + toBytes(int64_t(0)) + toBytes(uint32_t(0xFFFFFFFF)));
+      }};
+
+      auto indexCache = ZipIndexCache{env.dir() / "index.bin"};
+      CHECK(indexCache.find(zipPath) == std::nullopt);
+    }
+  }
+
+  SECTION("Archives that no longer exist are removed from the index cache")
+  {
+    auto env = TestEnvironment{[](auto& e) {
+      e.createFile("a.zip", "a");
+      e.createFile("b.zip", "b");
+    }};
+    const auto cachePath = env.dir() / "index.bin";
+
+    auto indexCache = ZipIndexCache{cachePath};
+    indexCache.store(env.dir() / "a.zip", {});
+    indexCache.store(env.dir() / "b.zip", {});
+    REQUIRE(indexCache.save().is_success());
+
+    // the cache file is written to a temporary file that is then renamed
+    CHECK(
+      env.directoryContents("")
+      == std::vector<std::filesystem::path>{"a.zip", "b.zip", "index.bin"});
+
+    REQUIRE(env.remove("a.zip"));
+
+    auto loadedIndexCache = ZipIndexCache{cachePath};
+    CHECK(loadedIndexCache.find(env.dir() / "b.zip") != std::nullopt);
+    REQUIRE(loadedIndexCache.save().is_success());
+
+    const auto contents = env.loadFile("index.bin");
+    CHECK(contents.find("a.zip") == std::string::npos);
+    CHECK(contents.find("b.zip") != std::string::npos);
+  }
+}
+
 TEST_CASE("WadFileSystem")
 {
   SECTION("Wad files can be replaced while wad file system exists")
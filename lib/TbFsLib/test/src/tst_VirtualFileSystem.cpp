@@ -30,12 +30,30 @@
 #include <fmt/std.h>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 namespace tb::fs
 {
 
+namespace
+{
+
+template <typename... Args>
+std::unique_ptr<TestFileSystem> makeTestFileSystem(const bool immutable, Args&&... args)
+{
+  auto fs = std::make_unique<TestFileSystem>(std::forward<Args>(args)...);
+  fs->setImmutable(immutable);
+  return fs;
+}
+
+} // namespace
+
 TEST_CASE("VirtualFileSystem")
 {
+  // immutable file systems are resolved using the index
+  const auto immutable = GENERATE(false, true);
+  CAPTURE(immutable);
+
   auto vfs = VirtualFileSystem{};
 
   SECTION("if nothing is mounted")
@@ -98,7 +116,8 @@ TEST_CASE("VirtualFileSystem")
 
     vfs.mount(
       "",
-      std::make_unique<TestFileSystem>(
+      makeTestFileSystem(
+        immutable,
         Entry{DirectoryEntry{
           "",
           {
@@ -223,7 +242,8 @@ TEST_CASE("VirtualFileSystem")
 
     vfs.mount(
       "",
-      std::make_unique<TestFileSystem>(
+      makeTestFileSystem(
+        immutable,
         Entry{DirectoryEntry{
           "",
           {
@@ -248,7 +268,8 @@ TEST_CASE("VirtualFileSystem")
         "/fs1"));
     vfs.mount(
       "",
-      std::make_unique<TestFileSystem>(
+      makeTestFileSystem(
+        immutable,
         Entry{DirectoryEntry{
           "",
           {
@@ -410,7 +431,8 @@ TEST_CASE("VirtualFileSystem")
 
     vfs.mount(
       "foo",
-      std::make_unique<TestFileSystem>(
+      makeTestFileSystem(
+        immutable,
         Entry{DirectoryEntry{
           "",
           {
@@ -424,7 +446,8 @@ TEST_CASE("VirtualFileSystem")
         "/fs1"));
     vfs.mount(
       "bar",
-      std::make_unique<TestFileSystem>(
+      makeTestFileSystem(
+        immutable,
         Entry{DirectoryEntry{
           "",
           {
@@ -539,7 +562,8 @@ TEST_CASE("VirtualFileSystem")
 
     vfs.mount(
       "foo",
-      std::make_unique<TestFileSystem>(
+      makeTestFileSystem(
+        immutable,
         Entry{DirectoryEntry{
           "",
           {
@@ -553,7 +577,8 @@ TEST_CASE("VirtualFileSystem")
         "/fs1"));
     vfs.mount(
       "foo/bar",
-      std::make_unique<TestFileSystem>(
+      makeTestFileSystem(
+        immutable,
         Entry{DirectoryEntry{
           "",
           {
@@ -660,7 +685,8 @@ TEST_CASE("VirtualFileSystem")
 
     vfs.mount(
       "foo",
-      std::make_unique<TestFileSystem>(
+      makeTestFileSystem(
+        immutable,
         Entry{DirectoryEntry{
           "",
           {
@@ -678,7 +704,8 @@ TEST_CASE("VirtualFileSystem")
         "/fs1"));
     vfs.mount(
       "foo/bar",
-      std::make_unique<TestFileSystem>(
+      makeTestFileSystem(
+        immutable,
         Entry{DirectoryEntry{
           "",
           {
@@ -775,4 +802,127 @@ TEST_CASE("VirtualFileSystem")
   }
 }
 
+TEST_CASE("VirtualFileSystem.mixedMutability")
+{
+  auto fs1_a = makeObjectFile(1);
+  auto fs1_b = makeObjectFile(2);
+  auto fs2_a = makeObjectFile(3);
+  auto fs2_c = makeObjectFile(4);
+
+  auto vfs = VirtualFileSystem{};
+
+  const auto mountFileSystems = [&](const bool fs1Immutable, const bool fs2Immutable) {
+    vfs.mount(
+      "",
+      makeTestFileSystem(
+        fs1Immutable,
+        Entry{DirectoryEntry{
+          "",
+          {
+            FileEntry{"a", fs1_a},
+            FileEntry{"b", fs1_b},
+          }}},
+        std::unordered_map<std::string, FileSystemMetadata>{},
+        "/fs1"));
+    vfs.mount(
+      "",
+      makeTestFileSystem(
+        fs2Immutable,
+        Entry{DirectoryEntry{
+          "",
+          {
+            FileEntry{"a", fs2_a},
+            FileEntry{"c", fs2_c},
+          }}},
+        std::unordered_map<std::string, FileSystemMetadata>{},
+        "/fs2"));
+  };
+
+  SECTION("a mutable file system mounted after an immutable one shadows it")
+  {
+    mountFileSystems(true, false);
+  }
+
+  SECTION("an immutable file system mounted after a mutable one shadows it")
+  {
+    mountFileSystems(false, true);
+  }
+
+  CHECK(vfs.makeAbsolute("a") == "/fs2/a");
+  CHECK(vfs.makeAbsolute("b") == "/fs1/b");
+  CHECK(vfs.makeAbsolute("c") == "/fs2/c");
+  CHECK(vfs.pathInfo("a") == PathInfo::File);
+  CHECK(vfs.pathInfo("d") == PathInfo::Unknown);
+  CHECK(vfs.openFile("a") == Result<std::shared_ptr<File>>{fs2_a});
+  CHECK(vfs.openFile("b") == Result<std::shared_ptr<File>>{fs1_b});
+  CHECK(vfs.openFile("c") == Result<std::shared_ptr<File>>{fs2_c});
+}
+
+TEST_CASE("VirtualFileSystem.unmount")
+{
+  auto fs1_a = makeObjectFile(1);
+  auto fs2_a = makeObjectFile(2);
+  auto fs2_b = makeObjectFile(3);
+  auto fs3_a = makeObjectFile(4);
+  auto fs3_b = makeObjectFile(5);
+
+  // the second file system is mutable and resolved without the index
+  auto vfs = VirtualFileSystem{};
+  const auto id1 = vfs.mount(
+    "",
+    makeTestFileSystem(
+      true,
+      Entry{DirectoryEntry{"", {FileEntry{"a", fs1_a}}}},
+      std::unordered_map<std::string, FileSystemMetadata>{},
+      "/fs1"));
+  const auto id2 = vfs.mount(
+    "",
+    makeTestFileSystem(
+      false,
+      Entry{DirectoryEntry{"", {FileEntry{"a", fs2_a}, FileEntry{"b", fs2_b}}}},
+      std::unordered_map<std::string, FileSystemMetadata>{},
+      "/fs2"));
+  const auto id3 = vfs.mount(
+    "",
+    makeTestFileSystem(
+      true,
+      Entry{DirectoryEntry{"", {FileEntry{"a", fs3_a}, FileEntry{"b", fs3_b}}}},
+      std::unordered_map<std::string, FileSystemMetadata>{},
+      "/fs3"));
+
+  CHECK(vfs.openFile("a") == Result<std::shared_ptr<File>>{fs3_a});
+  CHECK(vfs.openFile("b") == Result<std::shared_ptr<File>>{fs3_b});
+
+  SECTION("Unmounting a single mount point")
+  {
+    CHECK(vfs.unmount(id3));
+    CHECK_FALSE(vfs.unmount(id3));
+
+    CHECK(vfs.openFile("a") == Result<std::shared_ptr<File>>{fs2_a});
+    CHECK(vfs.openFile("b") == Result<std::shared_ptr<File>>{fs2_b});
+
+    CHECK(vfs.unmount(id2));
+
+    CHECK(vfs.openFile("a") == Result<std::shared_ptr<File>>{fs1_a});
+    CHECK(vfs.pathInfo("b") == PathInfo::Unknown);
+  }
+
+  SECTION("Unmounting several mount points at once")
+  {
+    CHECK(vfs.unmount(std::vector{id2, id3, id3}) == 2);
+    CHECK(vfs.unmount(std::vector{id2, id3}) == 0);
+
+    CHECK(vfs.openFile("a") == Result<std::shared_ptr<File>>{fs1_a});
+    CHECK(vfs.pathInfo("b") == PathInfo::Unknown);
+  }
+
+  SECTION("Unmounting a mount point below others")
+  {
+    CHECK(vfs.unmount(std::vector{id1, id2}) == 2);
+
+    CHECK(vfs.openFile("a") == Result<std::shared_ptr<File>>{fs3_a});
+    CHECK(vfs.openFile("b") == Result<std::shared_ptr<File>>{fs3_b});
+  }
+}
+
 } // namespace tb::fs
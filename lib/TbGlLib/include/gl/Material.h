@@ -152,6 +152,16 @@ public:
 
   const TextureResource& textureResource() const;
 
+  /**
+   * Sets the priority with which the texture is loaded, see ResourcePriority.
+   */
+  void setLoadPriority(int priority) const;
+
+  /**
+   * Blocks until the texture has finished loading in the background.
+   */
+  void waitForLoading() const;
+
   const std::set<std::string>& surfaceParms() const;
   void setSurfaceParms(std::set<std::string> surfaceParms);
 
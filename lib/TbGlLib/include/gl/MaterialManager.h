@@ -53,8 +53,18 @@ public:
 
   void setMaterialCollections(std::vector<MaterialCollection> collections);
 
+  /**
+   * Removes all materials. Waits until the textures that are being loaded in the
+   * background have finished loading, since their loaders refer to the file system.
+   */
   void clear();
 
+  /**
+   * Blocks until all textures that are being loaded in the background have finished
+   * loading.
+   */
+  void waitForLoading() const;
+
   const Material* material(const std::string& name) const;
   Material* material(const std::string& name);
 
@@ -227,6 +227,9 @@ using GLsizeiptr = std::intptr_t;
 #ifndef GL_OUT_OF_MEMORY
 #define GL_OUT_OF_MEMORY 0x0505
 #endif
+#ifndef GL_PACK_ALIGNMENT
+#define GL_PACK_ALIGNMENT 0x0D05
+#endif
 #ifndef GL_POINTS
 #define GL_POINTS 0x0000
 #endif
@@ -31,6 +31,7 @@
 #include <future>
 #include <iostream>
 #include <memory>
+#include <utility>
 #include <variant>
 
 namespace tb::gl
@@ -86,6 +87,15 @@ struct ResourceLoading
   kdl_reflect_inline_empty(ResourceLoading);
 };
 
+template <typename T>
+struct ResourceReloading
+{
+  T resource;
+  std::future<std::unique_ptr<TaskResult>> future;
+
+  kdl_reflect_inline(ResourceReloading, resource);
+};
+
 template <typename T>
 struct ResourceLoaded
 {
@@ -115,6 +125,14 @@ struct ResourceDropped
   kdl_reflect_inline_empty(ResourceDropped);
 };
 
+template <typename T>
+struct ResourceEvicted
+{
+  ResourceLoader<T> loader;
+
+  kdl_reflect_inline_empty(ResourceEvicted);
+};
+
 struct ResourceFailed
 {
   std::string error;
@@ -126,10 +144,12 @@ template <typename T>
 using ResourceState = std::variant<
   ResourceUnloaded<T>,
   ResourceLoading<T>,
+  ResourceReloading<T>,
   ResourceLoaded<T>,
   ResourceReady<T>,
   ResourceDropping<T>,
   ResourceDropped,
+  ResourceEvicted<T>,
   ResourceFailed>;
 
 template <typename T>
@@ -151,6 +171,44 @@ ResourceState<T> triggerLoading(ResourceUnloaded<T> state, TaskRunner taskRunner
   return ResourceLoading<T>{std::move(future)};
 }
 
+template <typename T>
+ResourceState<T> triggerReloading(
+  ResourceReady<T> state, const ResourceLoader<T>& loader, TaskRunner taskRunner)
+{
+  auto future = taskRunner(
+    [=]() { return std::make_unique<LoaderTaskResult<T>>(loader()); });
+  return ResourceReloading<T>{std::move(state.resource), std::move(future)};
+}
+
+template <typename T>
+ResourceState<T> finishReloading(
+  ResourceReloading<T> state, Gl& gl, const ErrorHandler& errorHandler, const ResourceId& id)
+{
+  if (state.future.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+  {
+    auto taskResult = state.future.valid() ? state.future.get() : nullptr;
+    auto* loaderTaskResult = static_cast<LoaderTaskResult<T>*>(taskResult.get());
+    if (!loaderTaskResult)
+    {
+      errorHandler(id, "Invalid future");
+      return ResourceReady<T>{std::move(state.resource)};
+    }
+
+    // keep the previous resource if reloading fails
+    return std::move(loaderTaskResult->get())
+           | kdl::transform([&](auto value) -> ResourceState<T> {
+               state.resource.drop(gl);
+               return ResourceLoaded<T>{std::move(value)};
+             })
+           | kdl::transform_error([&](auto error) -> ResourceState<T> {
+               errorHandler(id, error.msg);
+               return ResourceReady<T>{std::move(state.resource)};
+             })
+           | kdl::value();
+  }
+  return state;
+}
+
 template <typename T>
 ResourceState<T> finishLoading(ResourceLoading<T> state)
 {
@@ -203,8 +261,42 @@ ResourceState<T> drop(ResourceDropping<T> state, Gl& gl)
   return ResourceDropped{};
 }
 
+template <typename T>
+ResourceState<T> drop(ResourceReloading<T> state, Gl& gl)
+{
+  state.resource.drop(gl);
+  return ResourceDropped{};
+}
+
+template <typename T>
+ResourceState<T> evict(ResourceReady<T> state, ResourceLoader<T> loader, Gl& gl)
+{
+  state.resource.drop(gl);
+  return ResourceEvicted<T>{std::move(loader)};
+}
+
+template <typename T>
+ResourceState<T> reload(ResourceEvicted<T> state)
+{
+  return ResourceUnloaded<T>{std::move(state.loader)};
+}
+
 } // namespace detail
 
+/**
+ * The priorities with which views request resources, see Resource::setPriority. If
+ * several views request the same resource, the most recent request wins.
+ */
+namespace ResourcePriority
+{
+/** The resource is not needed by any view. */
+constexpr auto Default = 0;
+/** The resource is likely to be needed soon, e.g. just outside of a browser viewport. */
+constexpr auto Nearby = 1;
+/** The resource is needed now, e.g. in a browser viewport or close to the camera. */
+constexpr auto Visible = 2;
+} // namespace ResourcePriority
+
 /**
  * A resource that can be loaded, uploaded, and dropped.
  *
@@ -216,9 +308,24 @@ ResourceState<T> drop(ResourceDropping<T> state, Gl& gl)
  * | Loading        | process          | Loaded or Failed|
  * | Loaded         | process          | Ready           |
  * | Ready          | drop             | Dropping        |
+ * | Ready          | evict            | Evicted         |
+ * | Ready          | reload           | Reloading       |
+ * | Reloading      | process          | Loaded or Ready |
+ * | Reloading      | drop             | Dropping        |
  * | Dropping       | process          | Dropped         |
+ * | Evicted        | markUsed         | Unloaded        |
+ * | Evicted        | drop             | Dropped         |
  * | Dropped        | -                | -               |
  * | Failed         | -                | -               |
+ *
+ * Only resources that were created with a loader can be evicted or reloaded, since the
+ * loader is needed to load the resource again. While a resource is being reloaded, the
+ * previous resource remains available. If reloading fails, the previous resource is
+ * kept.
+ *
+ * A resource also carries a priority, which the resource manager uses to decide which
+ * unloaded resources to load first, and a flag that records whether the resource was
+ * used since the resource manager last looked at it.
  */
 template <typename T>
 class Resource
@@ -226,12 +333,16 @@ class Resource
 private:
   ResourceId m_id;
   ResourceState<T> m_state;
+  ResourceLoader<T> m_loader;
+  int m_priority = ResourcePriority::Default;
+  bool m_used = false;
 
   kdl_reflect_inline(Resource, m_state);
 
 public:
   explicit Resource(ResourceLoader<T> loader)
-    : m_state(ResourceUnloaded<T>{std::move(loader)})
+    : m_state(ResourceUnloaded<T>{loader})
+    , m_loader{std::move(loader)}
   {
   }
 
@@ -252,6 +363,7 @@ public:
       kdl::overload(
         [](const ResourceLoaded<T>& state) -> const T* { return &state.resource; },
         [](const ResourceReady<T>& state) -> const T* { return &state.resource; },
+        [](const ResourceReloading<T>& state) -> const T* { return &state.resource; },
         [](const auto&) -> const T* { return nullptr; }),
       m_state);
   }
@@ -262,18 +374,120 @@ public:
       kdl::overload(
         [](ResourceLoaded<T>& state) -> T* { return &state.resource; },
         [](ResourceReady<T>& state) -> T* { return &state.resource; },
+        [](ResourceReloading<T>& state) -> T* { return &state.resource; },
         [](auto&) -> T* { return nullptr; }),
       m_state);
   }
 
   bool isDropped() const { return std::holds_alternative<ResourceDropped>(m_state); }
 
+  bool isUnloaded() const
+  {
+    return std::holds_alternative<ResourceUnloaded<T>>(m_state);
+  }
+
+  bool isLoading() const
+  {
+    return std::holds_alternative<ResourceLoading<T>>(m_state)
+           || std::holds_alternative<ResourceReloading<T>>(m_state);
+  }
+
+  bool isReady() const { return std::holds_alternative<ResourceReady<T>>(m_state); }
+
+  bool isEvicted() const { return std::holds_alternative<ResourceEvicted<T>>(m_state); }
+
   bool needsProcessing() const
   {
     return !std::holds_alternative<ResourceReady<T>>(m_state)
+           && !std::holds_alternative<ResourceEvicted<T>>(m_state)
            && !std::holds_alternative<ResourceFailed>(m_state);
   }
 
+  /**
+   * Resources with a higher priority are loaded before resources with a lower priority.
+   */
+  int priority() const { return m_priority; }
+
+  void setPriority(const int priority) { m_priority = priority; }
+
+  /**
+   * Records that this resource was used, e.g. because it was rendered. If the resource
+   * was evicted, it is scheduled for loading again.
+   */
+  void markUsed()
+  {
+    m_used = true;
+    if (auto* evictedState = std::get_if<ResourceEvicted<T>>(&m_state))
+    {
+      m_state = detail::reload(std::move(*evictedState));
+    }
+  }
+
+  /**
+   * Returns whether this resource was used since the last call to this function and
+   * resets the flag.
+   */
+  bool takeUsed() { return std::exchange(m_used, false); }
+
+  bool canEvict() const { return m_loader && isReady(); }
+
+  bool canReload() const { return m_loader && isReady(); }
+
+  /**
+   * Loads the resource again in the background while keeping the current one available.
+   */
+  void reload(TaskRunner taskRunner)
+  {
+    if (m_loader)
+    {
+      m_state = std::visit(
+        kdl::overload(
+          [&](ResourceReady<T> state) -> ResourceState<T> {
+            return detail::triggerReloading(std::move(state), m_loader, taskRunner);
+          },
+          [](auto state) -> ResourceState<T> { return state; }),
+        std::move(m_state));
+    }
+  }
+
+  /**
+   * Blocks until a background load of this resource has finished. The loaded resource
+   * is picked up by the next call to process.
+   *
+   * The loader may refer to objects that are owned elsewhere, such as a file system. The
+   * owner must call this function before it changes or destroys these objects.
+   */
+  void waitForLoading() const
+  {
+    const auto wait = [](const auto& future) {
+      if (future.valid())
+      {
+        future.wait();
+      }
+    };
+
+    std::visit(
+      kdl::overload(
+        [&](const ResourceLoading<T>& state) { wait(state.future); },
+        [&](const ResourceReloading<T>& state) { wait(state.future); },
+        [](const auto&) {}),
+      m_state);
+  }
+
+  void evict(Gl& gl)
+  {
+    if (m_loader)
+    {
+      m_state = std::visit(
+        kdl::overload(
+          [&](ResourceReady<T> state) -> ResourceState<T> {
+            return detail::evict(std::move(state), m_loader, gl);
+          },
+          [](auto state) -> ResourceState<T> { return state; }),
+        std::move(m_state));
+    }
+  }
+
   bool process(TaskRunner taskRunner, const ProcessContext& context)
   {
     const auto previousStateIndex = m_state.index();
@@ -285,6 +499,10 @@ public:
         [&](ResourceLoading<T> state) -> ResourceState<T> {
           return detail::finishLoading(std::move(state));
         },
+        [&](ResourceReloading<T> state) -> ResourceState<T> {
+          return detail::finishReloading(
+            std::move(state), context.gl, context.errorHandler, m_id);
+        },
         [&](ResourceLoaded<T> state) -> ResourceState<T> {
           return detail::upload(std::move(state), context.gl);
         },
@@ -314,6 +532,9 @@ public:
         [](ResourceReady<T> state) -> ResourceState<T> {
           return detail::triggerDropping(std::move(state));
         },
+        [](ResourceReloading<T> state) -> ResourceState<T> {
+          return ResourceDropping<T>{std::move(state.resource)};
+        },
         [&](ResourceDropping<T> state) -> ResourceState<T> { return state; },
         [](auto) -> ResourceState<T> { return ResourceDropped{}; }),
       std::move(m_state));
@@ -357,6 +578,9 @@ public:
         [&](ResourceDropping<T> state) -> ResourceState<T> {
           return detail::drop(std::move(state), gl);
         },
+        [&](ResourceReloading<T> state) -> ResourceState<T> {
+          return detail::drop(std::move(state), gl);
+        },
         [](auto) -> ResourceState<T> { return ResourceDropped{}; }),
       std::move(m_state));
   }
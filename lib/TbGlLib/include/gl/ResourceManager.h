@@ -29,7 +29,9 @@
 #include <algorithm>
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <ranges>
+#include <tuple>
 #include <vector>
 
 namespace tb::gl
@@ -37,6 +39,9 @@ namespace tb::gl
 
 class ResourceWrapperBase
 {
+private:
+  std::optional<std::chrono::steady_clock::time_point> m_lastUsed;
+
 public:
   virtual ~ResourceWrapperBase() = default;
 
@@ -45,10 +50,59 @@ public:
   virtual long useCount() const = 0;
 
   virtual bool isDropped() const = 0;
+  virtual bool isUnloaded() const = 0;
+  virtual bool isLoading() const = 0;
+  virtual bool isReady() const = 0;
+  virtual bool isEvicted() const = 0;
   virtual bool needsProcessing() const = 0;
 
+  virtual int priority() const = 0;
+
+  /**
+   * Returns the number of bytes occupied by the resource if it is ready, and 0 otherwise.
+   * Resource types that do not report their size always return 0.
+   */
+  virtual size_t memorySize() const = 0;
+
+  virtual bool canEvict() const = 0;
+
+  /**
+   * Indicates whether the resource can shrink its memory footprint without being evicted,
+   * e.g. by dropping the top mip levels of a texture.
+   */
+  virtual bool canReduce() const = 0;
+
+  /**
+   * Indicates whether the resource was reduced to save memory.
+   */
+  virtual bool isReduced() const = 0;
+
   virtual void drop() = 0;
+  virtual void evict(Gl& gl) = 0;
+  virtual void reduce(Gl& gl) = 0;
+  virtual void reload(TaskRunner taskRunner) = 0;
   virtual bool process(TaskRunner taskRunner, const ProcessContext& processContext) = 0;
+
+  const std::optional<std::chrono::steady_clock::time_point>& lastUsed() const
+  {
+    return m_lastUsed;
+  }
+
+  /**
+   * Returns true if the resource was used since this function was last called.
+   */
+  bool updateLastUsed(const std::chrono::steady_clock::time_point now)
+  {
+    if (takeUsed())
+    {
+      m_lastUsed = now;
+      return true;
+    }
+    return false;
+  }
+
+private:
+  virtual bool takeUsed() = 0;
 };
 
 template <typename T>
@@ -68,8 +122,53 @@ public:
   const ResourceId& id() const override { return m_resource->id(); }
   long useCount() const override { return m_resource.use_count(); }
   bool isDropped() const override { return m_resource->isDropped(); }
+  bool isUnloaded() const override { return m_resource->isUnloaded(); }
+  bool isLoading() const override { return m_resource->isLoading(); }
+  bool isReady() const override { return m_resource->isReady(); }
+  bool isEvicted() const override { return m_resource->isEvicted(); }
   bool needsProcessing() const override { return m_resource->needsProcessing(); }
+  int priority() const override { return m_resource->priority(); }
+  size_t memorySize() const override
+  {
+    if constexpr (requires(const T& t) { t.memorySize(); })
+    {
+      if (m_resource->isReady())
+      {
+        return m_resource->get()->memorySize();
+      }
+    }
+    return 0;
+  }
+  bool canEvict() const override { return m_resource->canEvict(); }
+  bool canReduce() const override
+  {
+    if constexpr (requires(const T& t) { t.canDropMipLevel(); })
+    {
+      return m_resource->isReady() && m_resource->get()->canDropMipLevel();
+    }
+    return false;
+  }
+  bool isReduced() const override
+  {
+    if constexpr (requires(const T& t) { t.droppedMipLevels(); })
+    {
+      return m_resource->isReady() && m_resource->get()->droppedMipLevels() > 0;
+    }
+    return false;
+  }
   void drop() override { m_resource->drop(); }
+  void evict(Gl& gl) override { m_resource->evict(gl); }
+  void reduce(Gl& gl) override
+  {
+    if constexpr (requires(T& t, Gl& g) { t.dropMipLevel(g); })
+    {
+      if (canReduce())
+      {
+        m_resource->get()->dropMipLevel(gl);
+      }
+    }
+  }
+  void reload(TaskRunner taskRunner) override { m_resource->reload(taskRunner); }
   bool process(TaskRunner taskRunner, const ProcessContext& processContext) override
   {
     return m_resource->process(taskRunner, processContext);
@@ -82,8 +181,44 @@ public:
         [](const auto&) { return std::nullopt; }),
       m_resource->state());
   };
+
+private:
+  bool takeUsed() override { return m_resource->takeUsed(); }
+};
+
+struct ResourceStatistics
+{
+  size_t resourceCount = 0;
+  size_t loadingCount = 0;
+  size_t readyCount = 0;
+  size_t reducedCount = 0;
+  size_t evictedCount = 0;
+  size_t memorySize = 0;
+
+  kdl_reflect_inline(
+    ResourceStatistics,
+    resourceCount,
+    loadingCount,
+    readyCount,
+    reducedCount,
+    evictedCount,
+    memorySize);
 };
 
+/**
+ * Manages the life cycle of resources.
+ *
+ * Unloaded resources are loaded in order of their priority. Among resources with equal
+ * priority, the most recently used ones are loaded first, and the remaining ones are
+ * loaded in the order in which they were added. The number of resources that are loaded
+ * concurrently can be limited.
+ *
+ * If a memory budget is set, the manager keeps the ready resources within the budget.
+ * Resources that have not been used for a while are reduced first, e.g. by dropping the
+ * top mip levels of a texture, least recently used first. If that is not sufficient, idle
+ * resources are evicted entirely. A reduced resource is reloaded in the background when
+ * it is used, and an evicted resource is loaded again when it is used.
+ */
 class ResourceManager
 {
 public:
@@ -92,6 +227,10 @@ public:
 private:
   std::vector<std::unique_ptr<ResourceWrapperBase>> m_resources;
 
+  std::optional<size_t> m_maxConcurrentLoads;
+  std::optional<size_t> m_memoryBudget;
+  std::chrono::milliseconds m_minIdleTimeBeforeEviction = std::chrono::seconds{30};
+
 public:
   bool needsProcessing() const
   {
@@ -108,6 +247,55 @@ public:
            | kdl::ranges::to<std::vector>();
   }
 
+  ResourceStatistics statistics() const
+  {
+    auto result = ResourceStatistics{};
+    for (const auto& resourceWrapper : m_resources)
+    {
+      ++result.resourceCount;
+      result.loadingCount += resourceWrapper->isLoading() ? 1 : 0;
+      result.readyCount += resourceWrapper->isReady() ? 1 : 0;
+      result.reducedCount += resourceWrapper->isReduced() ? 1 : 0;
+      result.evictedCount += resourceWrapper->isEvicted() ? 1 : 0;
+      result.memorySize += resourceWrapper->memorySize();
+    }
+    return result;
+  }
+
+  /**
+   * Returns the total size of all ready resources in bytes.
+   */
+  size_t memorySize() const
+  {
+    auto result = size_t(0);
+    for (const auto& resourceWrapper : m_resources)
+    {
+      result += resourceWrapper->memorySize();
+    }
+    return result;
+  }
+
+  const std::optional<size_t>& maxConcurrentLoads() const { return m_maxConcurrentLoads; }
+
+  void setMaxConcurrentLoads(std::optional<size_t> maxConcurrentLoads)
+  {
+    m_maxConcurrentLoads = std::move(maxConcurrentLoads);
+  }
+
+  const std::optional<size_t>& memoryBudget() const { return m_memoryBudget; }
+
+  /**
+   * Sets the memory budget in bytes. If the ready resources exceed the budget, those
+   * that were not used for at least the given idle time are reduced or evicted.
+   */
+  void setMemoryBudget(
+    std::optional<size_t> memoryBudget,
+    const std::chrono::milliseconds minIdleTimeBeforeEviction = std::chrono::seconds{30})
+  {
+    m_memoryBudget = std::move(memoryBudget);
+    m_minIdleTimeBeforeEviction = minIdleTimeBeforeEviction;
+  }
+
   template <typename ResourceT>
   void addResource(std::shared_ptr<Resource<ResourceT>> resource)
   {
@@ -120,24 +308,32 @@ public:
     const ProcessContext& processContext,
     std::optional<std::chrono::milliseconds> timeout = std::nullopt)
   {
+    const auto now = std::chrono::steady_clock::now();
     const auto checkTimeout =
-      timeout ? std::function{[timeout_ = *timeout,
-                               startTime = std::chrono::steady_clock::now()]() {
+      timeout ? std::function{[timeout_ = *timeout, startTime = now]() {
         return std::chrono::steady_clock::now() - startTime < timeout_;
       }}
               : std::function{[]() { return true; }};
 
     auto processedResourceIds = std::vector<ResourceId>{};
+    auto resourcesToLoad = std::vector<ResourceWrapperBase*>{};
+    auto currentLoads = size_t(0);
 
-    for (auto it = m_resources.begin(); it != m_resources.end() && checkTimeout();)
+    // advance every resource except for those that are waiting to be loaded
+    for (auto& resourceWrapper : m_resources)
     {
-      auto& resourceWrapper = *it;
+      const auto wasUsed = resourceWrapper->updateLastUsed(now);
+
       if (resourceWrapper->useCount() == 1 && !resourceWrapper->isDropped())
       {
         resourceWrapper->drop();
       }
 
-      if (resourceWrapper->needsProcessing())
+      if (resourceWrapper->isUnloaded() || (wasUsed && resourceWrapper->isReduced()))
+      {
+        resourcesToLoad.push_back(resourceWrapper.get());
+      }
+      else if (resourceWrapper->needsProcessing() && checkTimeout())
       {
         if (resourceWrapper->process(taskRunner, processContext))
         {
@@ -145,16 +341,118 @@ public:
         }
       }
 
-      it = resourceWrapper->useCount() == 1 && resourceWrapper->isDropped()
-             ? m_resources.erase(it)
-             : std::next(it);
+      if (resourceWrapper->isLoading())
+      {
+        ++currentLoads;
+      }
+    }
+
+    // start loading the resources with the highest priority, preferring those that were
+    // used most recently, e.g. because they are visible in a view
+    std::ranges::stable_sort(
+      resourcesToLoad, std::ranges::greater{}, [](const auto* resourceWrapper) {
+        return std::tuple{resourceWrapper->priority(), resourceWrapper->lastUsed()};
+      });
+
+    for (auto* resourceWrapper : resourcesToLoad)
+    {
+      if (
+        (m_maxConcurrentLoads && currentLoads >= *m_maxConcurrentLoads) || !checkTimeout())
+      {
+        break;
+      }
+
+      if (resourceWrapper->isReduced())
+      {
+        // restore the full resource in the background
+        resourceWrapper->reload(taskRunner);
+      }
+      else if (resourceWrapper->process(taskRunner, processContext))
+      {
+        processedResourceIds.push_back(resourceWrapper->id());
+      }
+
+      if (resourceWrapper->isLoading())
+      {
+        ++currentLoads;
+      }
     }
 
+    enforceMemoryBudget(processContext.gl, now, checkTimeout);
+
+    std::erase_if(m_resources, [](const auto& resourceWrapper) {
+      return resourceWrapper->useCount() == 1 && resourceWrapper->isDropped();
+    });
+
     if (!processedResourceIds.empty())
     {
       resourcesWereProcessedNotifier(processedResourceIds);
     }
   }
+
+private:
+  void enforceMemoryBudget(
+    Gl& gl,
+    const std::chrono::steady_clock::time_point now,
+    const std::function<bool()>& checkTimeout)
+  {
+    if (!m_memoryBudget)
+    {
+      return;
+    }
+
+    auto currentMemorySize = memorySize();
+    if (currentMemorySize <= *m_memoryBudget)
+    {
+      return;
+    }
+
+    const auto isIdle = [&](const auto* resourceWrapper) {
+      const auto& lastUsed = resourceWrapper->lastUsed();
+      return !lastUsed || now - *lastUsed >= m_minIdleTimeBeforeEviction;
+    };
+
+    auto candidates = m_resources | std::views::transform([](const auto& resourceWrapper) {
+                        return resourceWrapper.get();
+                      })
+                      | std::views::filter([&](const auto* resourceWrapper) {
+                          return resourceWrapper->isReady()
+                                 && resourceWrapper->memorySize() > 0
+                                 && isIdle(resourceWrapper);
+                        })
+                      | kdl::ranges::to<std::vector>();
+
+    // consider resources that were never used first, then the least recently used ones
+    std::ranges::stable_sort(candidates, [](const auto* lhs, const auto* rhs) {
+      return lhs->lastUsed() < rhs->lastUsed();
+    });
+
+    // reduce resources first so that they remain available at a lower quality
+    for (auto* resourceWrapper : candidates)
+    {
+      while (currentMemorySize > *m_memoryBudget && resourceWrapper->canReduce()
+             && checkTimeout())
+      {
+        const auto previousMemorySize = resourceWrapper->memorySize();
+        resourceWrapper->reduce(gl);
+        currentMemorySize -= previousMemorySize - resourceWrapper->memorySize();
+      }
+    }
+
+    for (auto* resourceWrapper : candidates)
+    {
+      if (currentMemorySize <= *m_memoryBudget)
+      {
+        break;
+      }
+
+      if (resourceWrapper->canEvict())
+      {
+        currentMemorySize -= resourceWrapper->memorySize();
+        resourceWrapper->evict(gl);
+      }
+    }
+  }
 };
 
 } // namespace tb::gl
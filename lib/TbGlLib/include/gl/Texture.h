@@ -71,8 +71,9 @@ struct TextureLoadedState
 struct TextureReadyState
 {
   GLuint textureId;
+  size_t droppedMipLevels = 0;
 
-  kdl_reflect_decl(TextureReadyState, textureId);
+  kdl_reflect_decl(TextureReadyState, textureId, droppedMipLevels);
 };
 
 struct TextureDroppedState
@@ -95,6 +96,9 @@ private:
 
   EmbeddedDefaults m_embeddedDefaults;
 
+  // the number of buffers passed to the constructor
+  size_t m_storedMipLevels = 0;
+
   mutable TextureState m_state;
 
   kdl_reflect_decl(
@@ -150,6 +154,36 @@ public:
 
   bool isReady() const;
 
+  /**
+   * Returns the number of mip levels of this texture once it is uploaded, including the
+   * mipmaps that the driver generates for textures that were loaded without any.
+   */
+  size_t mipLevels() const;
+
+  /**
+   * Returns the approximate number of bytes that this texture occupies, either in main
+   * memory while it is loaded or in video memory once it was uploaded. Dropped mip levels
+   * are not counted.
+   */
+  size_t memorySize() const;
+
+  /**
+   * Returns the number of top mip levels that were dropped to save video memory. The
+   * width and height of the texture are not affected by this.
+   */
+  size_t droppedMipLevels() const;
+
+  bool canDropMipLevel() const;
+
+  /**
+   * Replaces the uploaded texture by one that lacks the current top mip level. The
+   * remaining levels are read back from video memory, and the texture's format becomes
+   * GL_RGBA.
+   *
+   * Precondition: canDropMipLevel()
+   */
+  void dropMipLevel(Gl& gl);
+
   bool activate(Gl& gl, int minFilter, int magFilter) const;
   bool deactivate(Gl& gl) const;
 
@@ -50,9 +50,23 @@ std::ostream& operator<<(std::ostream& lhs, const TextureBuffer& rhs);
 using TextureBufferList = std::vector<TextureBuffer>;
 
 vm::vec2s sizeAtMipLevel(size_t width, size_t height, size_t level);
+
+/**
+ * Returns the number of levels in a full mipmap chain for a texture of the given size,
+ * including the base level.
+ */
+size_t mipChainLength(size_t width, size_t height);
+
 bool isCompressedFormat(GLenum format);
 size_t blockSizeForFormat(GLenum format);
 size_t bytesPerPixelForFormat(GLenum format);
+
+/**
+ * Returns the number of bytes needed to store the given mip level of a texture with the
+ * given size and format.
+ */
+size_t mipLevelSize(size_t width, size_t height, GLenum format, size_t level);
+
 void setMipBufferSize(
   TextureBufferList& buffers,
   size_t mipLevels,
@@ -60,6 +74,12 @@ void setMipBufferSize(
   size_t height,
   GLenum format);
 
+/**
+ * Generates a full mipmap chain from the first buffer in the given list using a 2x2 box
+ * filter. The given list must contain exactly one buffer in a four byte per pixel format.
+ */
+void generateMips(TextureBufferList& buffers, size_t width, size_t height, GLenum format);
+
 void resizeMips(
   TextureBufferList& buffers, const vm::vec2s& oldSize, const vm::vec2s& newSize);
 
@@ -0,0 +1,57 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "gl/TextureBuffer.h"
+
+namespace tb::gl
+{
+class Texture;
+
+/**
+ * Encodes a block of 4x4 pixels as an 8 byte BC1 (DXT1) block. The pixels are given in
+ * RGBA order, row by row. The alpha channel is ignored.
+ */
+void compressBlockBC1(const unsigned char* rgba, unsigned char* block);
+
+/**
+ * Encodes a block of 4x4 pixels as a 16 byte BC3 (DXT5) block. The pixels are given in
+ * RGBA order, row by row.
+ */
+void compressBlockBC3(const unsigned char* rgba, unsigned char* block);
+
+/**
+ * Indicates whether the given texture can be block compressed. This requires that the
+ * texture is loaded, that it is stored in an uncompressed RGBA or BGRA format and that
+ * its dimensions are multiples of 4.
+ */
+bool canCompressTexture(const Texture& texture);
+
+/**
+ * Returns a block compressed copy of the given texture. Textures that have a mask or
+ * any transparent pixels are compressed to BC3, all others to BC1. If the given texture
+ * has no mipmaps, a full mipmap chain is generated first because the driver cannot
+ * generate mipmaps for compressed textures.
+ *
+ * Precondition: canCompressTexture(texture)
+ */
+Texture compressTexture(const Texture& texture);
+
+} // namespace tb::gl
@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "kd/reflection_decl.h"
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+
+namespace tb::gl
+{
+class Texture;
+
+struct TextureCompressionConfig
+{
+  bool enabled = false;
+
+  /**
+   * The directory where compressed textures are cached. No cache is used if unset.
+   */
+  std::optional<std::filesystem::path> cachePath = std::nullopt;
+
+  /**
+   * The maximum total size of the cached files in bytes. When it is exceeded, the least
+   * recently used files are deleted.
+   */
+  size_t maxCacheSize = size_t(512) * 1024 * 1024;
+
+  kdl_reflect_decl(TextureCompressionConfig, enabled, cachePath, maxCacheSize);
+};
+
+/**
+ * Block compresses textures while they are loaded. Compressed textures are cached on
+ * disk, keyed by a hash of their uncompressed contents, so that textures only need to
+ * be compressed once. The cache is pruned when it grows beyond its maximum size.
+ *
+ * The configuration can be changed while textures are being loaded on other threads. It
+ * only affects textures that are loaded afterwards.
+ */
+class TextureCompressor
+{
+private:
+  mutable std::mutex m_mutex;
+  TextureCompressionConfig m_config;
+
+  mutable std::mutex m_cacheMutex;
+
+  /**
+   * The total size of the cached files, determined when the first file is stored.
+   */
+  mutable std::optional<size_t> m_cacheSize;
+
+public:
+  TextureCompressionConfig config() const;
+  void setConfig(TextureCompressionConfig config);
+
+  /**
+   * Returns a compressed version of the given texture, or the given texture itself if
+   * compression is disabled or the texture cannot be compressed.
+   */
+  Texture compress(Texture texture) const;
+
+private:
+  void cacheFileStored(const TextureCompressionConfig& config, size_t fileSize) const;
+};
+
+} // namespace tb::gl
@@ -177,6 +177,16 @@ const TextureResource& Material::textureResource() const
   return *m_textureResource;
 }
 
+void Material::setLoadPriority(const int priority) const
+{
+  m_textureResource->setPriority(priority);
+}
+
+void Material::waitForLoading() const
+{
+  m_textureResource->waitForLoading();
+}
+
 const std::set<std::string>& Material::surfaceParms() const
 {
   return m_surfaceParms;
@@ -227,6 +237,8 @@ void Material::decUsageCount() const
 
 void Material::activate(Gl& gl, const int minFilter, const int magFilter) const
 {
+  m_textureResource->markUsed();
+
   if (const auto* texture = m_textureResource->get();
       texture && texture->activate(gl, minFilter, magFilter))
   {
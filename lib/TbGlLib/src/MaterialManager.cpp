@@ -40,7 +40,10 @@ MaterialManager::MaterialManager(Logger& logger)
 {
 }
 
-MaterialManager::~MaterialManager() = default;
+MaterialManager::~MaterialManager()
+{
+  clear();
+}
 
 void MaterialManager::setMaterialCollections(std::vector<MaterialCollection> collections)
 {
@@ -53,6 +56,8 @@ void MaterialManager::setMaterialCollections(std::vector<MaterialCollection> col
 
 void MaterialManager::clear()
 {
+  waitForLoading();
+
   m_collections.clear();
   m_externalMaterials.clear();
   m_materialsByName.clear();
@@ -61,6 +66,14 @@ void MaterialManager::clear()
   // Remove logging because it might fail when the document is already destroyed.
 }
 
+void MaterialManager::waitForLoading() const
+{
+  for (const auto* material : m_materials)
+  {
+    material->waitForLoading();
+  }
+}
+
 const Material* MaterialManager::material(const std::string& name) const
 {
   auto it = m_materialsByName.find(kdl::str_to_lower(name));
@@ -41,19 +41,9 @@ auto makeTextureLoadedState(
   const GLenum format,
   std::vector<TextureBuffer> buffers)
 {
-  const auto compressed = isCompressedFormat(format);
-  [[maybe_unused]] const auto bytesPerPixel =
-    compressed ? 0U : bytesPerPixelForFormat(format);
-  [[maybe_unused]] const auto blockSize = compressed ? blockSizeForFormat(format) : 0U;
-
   for (size_t level = 0; level < buffers.size(); ++level)
   {
-    [[maybe_unused]] const auto mipSize = sizeAtMipLevel(width, height, level);
-    [[maybe_unused]] const auto numBytes =
-      compressed ? (blockSize * std::max(size_t(1), mipSize.x() / 4)
-                    * std::max(size_t(1), mipSize.y() / 4))
-                 : (bytesPerPixel * mipSize.x() * mipSize.y());
-    contract_assert(buffers[level].size() >= numBytes);
+    contract_assert(buffers[level].size() >= mipLevelSize(width, height, format, level));
   }
 
   return TextureLoadedState{std::move(buffers)};
@@ -192,6 +182,7 @@ Texture::Texture(
   , m_format{format}
   , m_mask{mask}
   , m_embeddedDefaults{std::move(embeddedDefaults)}
+  , m_storedMipLevels{buffers.size()}
   , m_state{makeTextureLoadedState(m_width, m_height, m_format, std::move(buffers))}
 {
   contract_pre(m_width > 0);
@@ -274,6 +265,78 @@ bool Texture::isReady() const
   return std::holds_alternative<TextureReadyState>(m_state);
 }
 
+size_t Texture::mipLevels() const
+{
+  if (m_storedMipLevels == 0 || m_mask == TextureMask::On)
+  {
+    return std::min(m_storedMipLevels, size_t(1));
+  }
+
+  if (m_storedMipLevels == 1)
+  {
+    // the driver generates a full mipmap chain
+    return mipChainLength(m_width, m_height);
+  }
+
+  return m_storedMipLevels;
+}
+
+size_t Texture::memorySize() const
+{
+  auto result = size_t(0);
+  for (size_t level = droppedMipLevels(); level < mipLevels(); ++level)
+  {
+    result += mipLevelSize(m_width, m_height, m_format, level);
+  }
+  return result;
+}
+
+size_t Texture::droppedMipLevels() const
+{
+  const auto* readyState = std::get_if<TextureReadyState>(&m_state);
+  return readyState ? readyState->droppedMipLevels : 0;
+}
+
+bool Texture::canDropMipLevel() const
+{
+  const auto* readyState = std::get_if<TextureReadyState>(&m_state);
+  return readyState && !isCompressedFormat(m_format) && m_mask == TextureMask::Off
+         && readyState->droppedMipLevels + 1 < mipLevels();
+}
+
+void Texture::dropMipLevel(Gl& gl)
+{
+  contract_pre(canDropMipLevel());
+
+  auto& readyState = std::get<TextureReadyState>(m_state);
+  const auto droppedMipLevels = readyState.droppedMipLevels + 1;
+
+  // the uploaded texture's base level is the first level that wasn't dropped yet
+  auto buffers = std::vector<TextureBuffer>{};
+  gl.bindTexture(GL_TEXTURE_2D, readyState.textureId);
+  gl.pixelStorei(GL_PACK_ALIGNMENT, 1);
+  for (size_t level = droppedMipLevels; level < mipLevels(); ++level)
+  {
+    auto& buffer = buffers.emplace_back(mipLevelSize(m_width, m_height, GL_RGBA, level));
+    gl.getTexImage(
+      GL_TEXTURE_2D,
+      GLint(level - readyState.droppedMipLevels),
+      GL_RGBA,
+      GL_UNSIGNED_BYTE,
+      buffer.data());
+  }
+  gl.bindTexture(GL_TEXTURE_2D, 0);
+  dropTexture(gl, readyState.textureId);
+
+  const auto reducedSize = sizeAtMipLevel(m_width, m_height, droppedMipLevels);
+  readyState = TextureReadyState{
+    uploadTexture(gl, GL_RGBA, m_mask, buffers, reducedSize.x(), reducedSize.y()),
+    droppedMipLevels};
+
+  // the remaining levels were read back and uploaded as RGBA
+  m_format = GL_RGBA;
+}
+
 bool Texture::activate(Gl& gl, const int minFilter, const int magFilter) const
 {
   return std::visit(
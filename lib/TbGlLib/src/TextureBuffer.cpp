@@ -25,6 +25,10 @@
 #include <algorithm>
 #include <iostream>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace tb::gl
 {
 
@@ -71,6 +75,16 @@ vm::vec2s sizeAtMipLevel(const size_t width, const size_t height, const size_t l
     std::max(size_t(1), width >> level), std::max(size_t(1), height >> level)};
 }
 
+size_t mipChainLength(const size_t width, const size_t height)
+{
+  auto result = size_t(1);
+  for (auto size = std::max(width, height); size > 1; size >>= 1)
+  {
+    ++result;
+  }
+  return result;
+}
+
 bool isCompressedFormat(const GLenum format)
 {
   return format >= GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
@@ -110,6 +124,21 @@ size_t bytesPerPixelForFormat(const GLenum format)
   return 0U;
 }
 
+size_t mipLevelSize(
+  const size_t width, const size_t height, const GLenum format, const size_t level)
+{
+  const auto mipSize = sizeAtMipLevel(width, height, level);
+  if (isCompressedFormat(format))
+  {
+    // compressed formats store partial blocks at the edges as whole blocks
+    const auto blocksX = (mipSize.x() + 3) / 4;
+    const auto blocksY = (mipSize.y() + 3) / 4;
+    return blockSizeForFormat(format) * blocksX * blocksY;
+  }
+
+  return bytesPerPixelForFormat(format) * mipSize.x() * mipSize.y();
+}
+
 void setMipBufferSize(
   TextureBufferList& buffers,
   const size_t mipLevels,
@@ -117,18 +146,102 @@ void setMipBufferSize(
   const size_t height,
   const GLenum format)
 {
-  const auto compressed = isCompressedFormat(format);
-  const auto bytesPerPixel = compressed ? 0U : bytesPerPixelForFormat(format);
-  const auto blockSize = compressed ? blockSizeForFormat(format) : 0U;
-
   buffers.resize(mipLevels);
   for (size_t level = 0u; level < buffers.size(); ++level)
+  {
+    buffers[level] = TextureBuffer{mipLevelSize(width, height, format, level)};
+  }
+}
+
+namespace
+{
+
+void downsampleRow(
+  const unsigned char* row0,
+  const unsigned char* row1,
+  const size_t srcWidth,
+  unsigned char* dst,
+  const size_t dstWidth)
+{
+  auto x = size_t(0);
+
+#if defined(__SSE2__)
+  // Filter two destination pixels at a time while their 2x2 footprints are complete
+  const auto zero = _mm_setzero_si128();
+  const auto two = _mm_set1_epi16(2);
+  for (; 2 * x + 3 < srcWidth && x + 2 <= dstWidth; x += 2)
+  {
+    const auto top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 8 * x));
+    const auto bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 8 * x));
+
+    // vertical sums of the source pixels 0, 1 and 2, 3
+    const auto sum01 =
+      _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+    const auto sum23 =
+      _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+    // horizontal sums yield the destination pixels 0 and 1
+    const auto sum = _mm_add_epi16(
+      _mm_unpacklo_epi64(sum01, sum23), _mm_unpackhi_epi64(sum01, sum23));
+    const auto average = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+    _mm_storel_epi64(
+      reinterpret_cast<__m128i*>(dst + 4 * x), _mm_packus_epi16(average, zero));
+  }
+#endif
+
+  for (; x < dstWidth; ++x)
+  {
+    const auto x0 = std::min(2 * x, srcWidth - 1);
+    const auto x1 = std::min(2 * x + 1, srcWidth - 1);
+    for (size_t c = 0; c < 4; ++c)
+    {
+      const auto sum = unsigned(row0[4 * x0 + c]) + unsigned(row0[4 * x1 + c])
+                       + unsigned(row1[4 * x0 + c]) + unsigned(row1[4 * x1 + c]);
+      dst[4 * x + c] = static_cast<unsigned char>((sum + 2) / 4);
+    }
+  }
+}
+
+void downsample(const TextureBuffer& src, const vm::vec2s& srcSize, TextureBuffer& dst)
+{
+  const auto dstSize =
+    vm::vec2s{std::max(size_t(1), srcSize.x() / 2), std::max(size_t(1), srcSize.y() / 2)};
+  const auto srcPitch = 4 * srcSize.x();
+  const auto dstPitch = 4 * dstSize.x();
+
+  for (size_t y = 0; y < dstSize.y(); ++y)
+  {
+    const auto y0 = std::min(2 * y, srcSize.y() - 1);
+    const auto y1 = std::min(2 * y + 1, srcSize.y() - 1);
+    downsampleRow(
+      src.data() + y0 * srcPitch,
+      src.data() + y1 * srcPitch,
+      srcSize.x(),
+      dst.data() + y * dstPitch,
+      dstSize.x());
+  }
+}
+
+} // namespace
+
+void generateMips(
+  TextureBufferList& buffers,
+  const size_t width,
+  const size_t height,
+  const GLenum format)
+{
+  contract_pre(buffers.size() == 1);
+  contract_pre(bytesPerPixelForFormat(format) == 4);
+  contract_pre(buffers.front().size() == 4 * width * height);
+
+  const auto levels = mipChainLength(width, height);
+  buffers.reserve(levels);
+  for (size_t level = 1; level < levels; ++level)
   {
     const auto mipSize = sizeAtMipLevel(width, height, level);
-    const auto numBytes = compressed ? (blockSize * std::max(size_t(1), mipSize.x() / 4)
-                                        * std::max(size_t(1), mipSize.y() / 4))
-                                     : (bytesPerPixel * mipSize.x() * mipSize.y());
-    buffers[level] = TextureBuffer{numBytes};
+    auto buffer = TextureBuffer{4 * mipSize.x() * mipSize.y()};
+    downsample(buffers.back(), sizeAtMipLevel(width, height, level - 1), buffer);
+    buffers.push_back(std::move(buffer));
   }
 }
 
@@ -0,0 +1,357 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gl/TextureCompression.h"
+
+#include "gl/Texture.h"
+
+#include "kd/contracts.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+namespace tb::gl
+{
+namespace
+{
+
+using Rgb = std::array<int, 3>;
+
+uint16_t packRgb565(const Rgb& color)
+{
+  const auto r = (color[0] * 31 + 127) / 255;
+  const auto g = (color[1] * 63 + 127) / 255;
+  const auto b = (color[2] * 31 + 127) / 255;
+  return uint16_t((r << 11) | (g << 5) | b);
+}
+
+Rgb unpackRgb565(const uint16_t color)
+{
+  const auto r = (color >> 11) & 0x1F;
+  const auto g = (color >> 5) & 0x3F;
+  const auto b = color & 0x1F;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+int squaredDistance(const Rgb& lhs, const unsigned char* rhs)
+{
+  const auto dr = lhs[0] - int(rhs[0]);
+  const auto dg = lhs[1] - int(rhs[1]);
+  const auto db = lhs[2] - int(rhs[2]);
+  return dr * dr + dg * dg + db * db;
+}
+
+void writeUint16(unsigned char* dst, const uint16_t value)
+{
+  dst[0] = static_cast<unsigned char>(value & 0xFF);
+  dst[1] = static_cast<unsigned char>(value >> 8);
+}
+
+/**
+ * Encodes the color part of a BC1 or BC3 block. The endpoints are the corners of the
+ * slightly inset bounding box of the block's colors that lie on the diagonal best
+ * matching the colors' distribution, and every pixel is mapped to the nearest of the
+ * four interpolated colors.
+ */
+void compressColorBlock(const unsigned char* rgba, unsigned char* block)
+{
+  auto min = Rgb{255, 255, 255};
+  auto max = Rgb{0, 0, 0};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    for (size_t c = 0; c < 3; ++c)
+    {
+      min[c] = std::min(min[c], int(rgba[4 * i + c]));
+      max[c] = std::max(max[c], int(rgba[4 * i + c]));
+    }
+  }
+
+  // inset the bounding box to reduce the error for colors near its center
+  for (size_t c = 0; c < 3; ++c)
+  {
+    const auto inset = (max[c] - min[c]) / 16;
+    min[c] += inset;
+    max[c] -= inset;
+  }
+
+  // choose the diagonal of the bounding box by flipping the channels that are
+  // anti-correlated with the channel that has the largest extent
+  const auto extent = Rgb{max[0] - min[0], max[1] - min[1], max[2] - min[2]};
+  const auto axis =
+    size_t(std::distance(extent.begin(), std::ranges::max_element(extent)));
+
+  auto mean = Rgb{0, 0, 0};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    for (size_t c = 0; c < 3; ++c)
+    {
+      mean[c] += int(rgba[4 * i + c]);
+    }
+  }
+
+  auto covariance = Rgb{0, 0, 0};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    const auto d = 16 * int(rgba[4 * i + axis]) - mean[axis];
+    for (size_t c = 0; c < 3; ++c)
+    {
+      covariance[c] += d * (16 * int(rgba[4 * i + c]) - mean[c]);
+    }
+  }
+
+  for (size_t c = 0; c < 3; ++c)
+  {
+    if (covariance[c] < 0)
+    {
+      std::swap(min[c], max[c]);
+    }
+  }
+
+  // the block is decoded in four color mode only if color0 > color1
+  auto color0 = packRgb565(max);
+  auto color1 = packRgb565(min);
+  if (color0 < color1)
+  {
+    std::swap(color0, color1);
+  }
+
+  auto indices = uint32_t(0);
+  if (color0 != color1)
+  {
+    const auto c0 = unpackRgb565(color0);
+    const auto c1 = unpackRgb565(color1);
+    const auto palette = std::array<Rgb, 4>{
+      c0,
+      c1,
+      Rgb{
+        (2 * c0[0] + c1[0]) / 3, (2 * c0[1] + c1[1]) / 3, (2 * c0[2] + c1[2]) / 3},
+      Rgb{
+        (c0[0] + 2 * c1[0]) / 3, (c0[1] + 2 * c1[1]) / 3, (c0[2] + 2 * c1[2]) / 3},
+    };
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+      auto bestIndex = uint32_t(0);
+      auto bestDistance = std::numeric_limits<int>::max();
+      for (uint32_t index = 0; index < 4; ++index)
+      {
+        if (const auto distance = squaredDistance(palette[index], rgba + 4 * i);
+            distance < bestDistance)
+        {
+          bestIndex = index;
+          bestDistance = distance;
+        }
+      }
+      indices |= bestIndex << (2 * i);
+    }
+  }
+
+  writeUint16(block + 0, color0);
+  writeUint16(block + 2, color1);
+  writeUint16(block + 4, uint16_t(indices & 0xFFFF));
+  writeUint16(block + 6, uint16_t(indices >> 16));
+}
+
+/**
+ * Encodes the alpha part of a BC3 block using the eight value mode.
+ */
+void compressAlphaBlock(const unsigned char* rgba, unsigned char* block)
+{
+  auto min = 255;
+  auto max = 0;
+  for (size_t i = 0; i < 16; ++i)
+  {
+    min = std::min(min, int(rgba[4 * i + 3]));
+    max = std::max(max, int(rgba[4 * i + 3]));
+  }
+
+  auto indices = uint64_t(0);
+  if (max != min)
+  {
+    auto palette = std::array<int, 8>{max, min};
+    for (size_t index = 2; index < 8; ++index)
+    {
+      palette[index] = (int(8 - index) * max + int(index - 1) * min) / 7;
+    }
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+      const auto alpha = int(rgba[4 * i + 3]);
+
+      auto bestIndex = uint64_t(0);
+      auto bestDistance = std::numeric_limits<int>::max();
+      for (uint64_t index = 0; index < 8; ++index)
+      {
+        if (const auto distance = std::abs(palette[index] - alpha);
+            distance < bestDistance)
+        {
+          bestIndex = index;
+          bestDistance = distance;
+        }
+      }
+      indices |= bestIndex << (3 * i);
+    }
+  }
+
+  block[0] = static_cast<unsigned char>(max);
+  block[1] = static_cast<unsigned char>(min);
+  for (size_t i = 0; i < 6; ++i)
+  {
+    block[2 + i] = static_cast<unsigned char>((indices >> (8 * i)) & 0xFF);
+  }
+}
+
+bool hasTransparentPixels(const TextureBuffer& buffer)
+{
+  for (size_t i = 3; i < buffer.size(); i += 4)
+  {
+    if (buffer.data()[i] != 0xFF)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+TextureBuffer copyBuffer(const TextureBuffer& buffer)
+{
+  auto result = TextureBuffer{buffer.size()};
+  std::memcpy(result.data(), buffer.data(), buffer.size());
+  return result;
+}
+
+void compressImage(
+  const TextureBuffer& src,
+  const vm::vec2s& size,
+  const GLenum srcFormat,
+  const GLenum dstFormat,
+  TextureBuffer& dst)
+{
+  const auto r = size_t(srcFormat == GL_RGBA ? 0 : 2);
+  const auto b = size_t(srcFormat == GL_RGBA ? 2 : 0);
+  const auto blocksX = (size.x() + 3) / 4;
+  const auto blocksY = (size.y() + 3) / 4;
+  const auto blockSize = blockSizeForFormat(dstFormat);
+
+  auto rgba = std::array<unsigned char, 64>{};
+  for (size_t by = 0; by < blocksY; ++by)
+  {
+    for (size_t bx = 0; bx < blocksX; ++bx)
+    {
+      // mip levels smaller than a block repeat their edge pixels
+      for (size_t y = 0; y < 4; ++y)
+      {
+        for (size_t x = 0; x < 4; ++x)
+        {
+          const auto sx = std::min(4 * bx + x, size.x() - 1);
+          const auto sy = std::min(4 * by + y, size.y() - 1);
+          const auto* pixel = src.data() + 4 * (sy * size.x() + sx);
+          auto* blockPixel = rgba.data() + 4 * (4 * y + x);
+          blockPixel[0] = pixel[r];
+          blockPixel[1] = pixel[1];
+          blockPixel[2] = pixel[b];
+          blockPixel[3] = pixel[3];
+        }
+      }
+
+      auto* block = dst.data() + (by * blocksX + bx) * blockSize;
+      if (dstFormat == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT)
+      {
+        compressBlockBC1(rgba.data(), block);
+      }
+      else
+      {
+        compressBlockBC3(rgba.data(), block);
+      }
+    }
+  }
+}
+
+} // namespace
+
+void compressBlockBC1(const unsigned char* rgba, unsigned char* block)
+{
+  compressColorBlock(rgba, block);
+}
+
+void compressBlockBC3(const unsigned char* rgba, unsigned char* block)
+{
+  compressAlphaBlock(rgba, block);
+  compressColorBlock(rgba, block + 8);
+}
+
+bool canCompressTexture(const Texture& texture)
+{
+  return (texture.format() == GL_RGBA || texture.format() == GL_BGRA)
+         && !texture.buffersIfLoaded().empty() && texture.width() % 4 == 0
+         && texture.height() % 4 == 0;
+}
+
+Texture compressTexture(const Texture& texture)
+{
+  contract_pre(canCompressTexture(texture));
+
+  const auto width = texture.width();
+  const auto height = texture.height();
+  const auto& loadedBuffers = texture.buffersIfLoaded();
+
+  // masked textures are uploaded without mipmaps
+  auto generatedBuffers = TextureBufferList{};
+  if (texture.mask() == TextureMask::Off && loadedBuffers.size() == 1)
+  {
+    generatedBuffers.push_back(copyBuffer(loadedBuffers.front()));
+    generateMips(generatedBuffers, width, height, texture.format());
+  }
+
+  const auto& buffers = generatedBuffers.empty() ? loadedBuffers : generatedBuffers;
+  const auto mipLevels = texture.mask() == TextureMask::On ? size_t(1) : buffers.size();
+
+  const auto format =
+    texture.mask() == TextureMask::On || hasTransparentPixels(buffers.front())
+      ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+      : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+
+  auto compressedBuffers = TextureBufferList{};
+  setMipBufferSize(compressedBuffers, mipLevels, width, height, format);
+  for (size_t level = 0; level < mipLevels; ++level)
+  {
+    compressImage(
+      buffers[level],
+      sizeAtMipLevel(width, height, level),
+      texture.format(),
+      format,
+      compressedBuffers[level]);
+  }
+
+  return Texture{
+    width,
+    height,
+    texture.averageColor(),
+    format,
+    texture.mask(),
+    texture.embeddedDefaults(),
+    std::move(compressedBuffers)};
+}
+
+} // namespace tb::gl
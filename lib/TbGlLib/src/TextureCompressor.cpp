@@ -0,0 +1,362 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gl/TextureCompressor.h"
+
+#include "fs/DiskIO.h"
+#include "fs/File.h"
+#include "fs/Reader.h"
+#include "fs/ReaderException.h"
+#include "gl/Texture.h"
+#include "gl/TextureCompression.h"
+
+#include "kd/contracts.h"
+#include "kd/reflection_impl.h"
+#include "kd/result.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <system_error>
+#include <vector>
+
+namespace tb::gl
+{
+namespace
+{
+
+constexpr auto CacheFileIdent = uint32_t(0x43544254); // "TBTC"
+constexpr auto CacheFileVersion = uint32_t(1);
+
+constexpr auto CacheFileExtension = ".tbtc";
+
+/**
+ * A 64 bit FNV-1a hash. Unlike std::hash, its values do not depend on the standard
+ * library implementation, so the cache file names are stable across builds.
+ */
+class Fnv1aHash
+{
+private:
+  uint64_t m_hash = 0xcbf29ce484222325;
+
+public:
+  void add(const unsigned char* data, const size_t size)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      m_hash = (m_hash ^ data[i]) * 0x100000001b3;
+    }
+  }
+
+  void add(const uint64_t value)
+  {
+    // add the bytes in a fixed order so that the hash does not depend on endianness
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+      const auto byte = static_cast<unsigned char>(value >> (i * 8));
+      add(&byte, 1);
+    }
+  }
+
+  uint64_t value() const { return m_hash; }
+};
+
+std::filesystem::path cacheFilePath(
+  const std::filesystem::path& cachePath, const Texture& texture)
+{
+  auto hash = Fnv1aHash{};
+  hash.add(texture.width());
+  hash.add(texture.height());
+  hash.add(texture.format());
+  hash.add(texture.mask() == TextureMask::On);
+  for (const auto& buffer : texture.buffersIfLoaded())
+  {
+    hash.add(buffer.size());
+    hash.add(buffer.data(), buffer.size());
+  }
+
+  return cachePath / fmt::format("{:016x}{}", hash.value(), CacheFileExtension);
+}
+
+std::optional<Texture> readCachedTexture(fs::Reader& reader, const Texture& texture)
+{
+  try
+  {
+    if (
+      reader.readSize<uint32_t>() != CacheFileIdent
+      || reader.readSize<uint32_t>() != CacheFileVersion)
+    {
+      return std::nullopt;
+    }
+
+    const auto format = GLenum(reader.readSize<uint32_t>());
+    const auto mipLevels = reader.readSize<uint32_t>();
+    if (
+      !isCompressedFormat(format) || mipLevels == 0
+      || mipLevels > mipChainLength(texture.width(), texture.height()))
+    {
+      return std::nullopt;
+    }
+
+    auto dataSize = size_t(0);
+    for (size_t level = 0; level < mipLevels; ++level)
+    {
+      dataSize += mipLevelSize(texture.width(), texture.height(), format, level);
+    }
+    if (!reader.canRead(dataSize))
+    {
+      return std::nullopt;
+    }
+
+    auto buffers = TextureBufferList{};
+    setMipBufferSize(buffers, mipLevels, texture.width(), texture.height(), format);
+    for (auto& buffer : buffers)
+    {
+      reader.read(buffer.data(), buffer.size());
+    }
+
+    return Texture{
+      texture.width(),
+      texture.height(),
+      texture.averageColor(),
+      format,
+      texture.mask(),
+      texture.embeddedDefaults(),
+      std::move(buffers)};
+  }
+  catch (const fs::ReaderException&)
+  {
+    return std::nullopt;
+  }
+}
+
+std::optional<Texture> loadCachedTexture(
+  const std::filesystem::path& path, const Texture& texture)
+{
+  return fs::Disk::openFile(path) | kdl::transform([&](const auto& file) {
+           auto reader = file->reader().buffer();
+           return readCachedTexture(reader, texture);
+         })
+         | kdl::value_or(std::nullopt);
+}
+
+void writeUint32(std::ostream& stream, const uint32_t value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+Result<void> storeCachedTexture(
+  const std::filesystem::path& path, const Texture& compressedTexture)
+{
+  const auto directoryPath = path.parent_path();
+  return fs::Disk::createDirectory(directoryPath)
+         | kdl::and_then(
+           [&](auto) { return fs::Disk::makeUniqueFilename(directoryPath); })
+         | kdl::and_then([&](const auto& tempFilename) {
+             // write to a temporary file first so that other threads never see a
+             // partially written cache file
+             const auto tempPath = directoryPath / tempFilename;
+             return fs::Disk::withOutputStream(
+                      tempPath,
+                      std::ios::out | std::ios::binary,
+                      [&](auto& stream) {
+                        const auto& buffers = compressedTexture.buffersIfLoaded();
+                        writeUint32(stream, CacheFileIdent);
+                        writeUint32(stream, CacheFileVersion);
+                        writeUint32(stream, uint32_t(compressedTexture.format()));
+                        writeUint32(stream, uint32_t(buffers.size()));
+                        for (const auto& buffer : buffers)
+                        {
+                          stream.write(
+                            reinterpret_cast<const char*>(buffer.data()),
+                            std::streamsize(buffer.size()));
+                        }
+                      })
+                    | kdl::and_then([&]() { return fs::Disk::moveFile(tempPath, path); })
+                    | kdl::or_else([&](auto e) {
+                        return fs::Disk::deleteFile(tempPath)
+                               | kdl::and_then([&](auto) { return Result<void>{e}; });
+                      });
+           });
+}
+
+size_t cacheFileSize(const Texture& compressedTexture)
+{
+  auto result = 4 * sizeof(uint32_t);
+  for (const auto& buffer : compressedTexture.buffersIfLoaded())
+  {
+    result += buffer.size();
+  }
+  return result;
+}
+
+void markCacheFileUsed(const std::filesystem::path& path)
+{
+  auto errorCode = std::error_code{};
+  std::filesystem::last_write_time(
+    path, std::filesystem::file_time_type::clock::now(), errorCode);
+}
+
+struct CacheFileInfo
+{
+  std::filesystem::path path;
+  size_t size;
+  std::filesystem::file_time_type lastUsed;
+};
+
+std::vector<CacheFileInfo> listCacheFiles(const std::filesystem::path& cachePath)
+{
+  auto result = std::vector<CacheFileInfo>{};
+
+  auto errorCode = std::error_code{};
+  for (auto it = std::filesystem::directory_iterator{cachePath, errorCode};
+       !errorCode && it != std::filesystem::directory_iterator{};
+       it.increment(errorCode))
+  {
+    if (it->path().extension() == CacheFileExtension)
+    {
+      auto fileErrorCode = std::error_code{};
+      const auto size = it->file_size(fileErrorCode);
+      const auto lastUsed = it->last_write_time(fileErrorCode);
+      if (!fileErrorCode)
+      {
+        result.push_back(CacheFileInfo{it->path(), size_t(size), lastUsed});
+      }
+    }
+  }
+
+  return result;
+}
+
+size_t totalSize(const std::vector<CacheFileInfo>& cacheFiles)
+{
+  auto result = size_t(0);
+  for (const auto& cacheFile : cacheFiles)
+  {
+    result += cacheFile.size;
+  }
+  return result;
+}
+
+/**
+ * Deletes the least recently used cache files until the total size of the remaining
+ * files is at most the given size. Returns the total size of the remaining files.
+ */
+size_t pruneCacheFiles(std::vector<CacheFileInfo> cacheFiles, const size_t maxSize)
+{
+  std::ranges::sort(cacheFiles, {}, &CacheFileInfo::lastUsed);
+
+  auto size = totalSize(cacheFiles);
+  for (const auto& cacheFile : cacheFiles)
+  {
+    if (size <= maxSize)
+    {
+      break;
+    }
+
+    // files that are being read by another thread may not be deleted on some platforms
+    auto errorCode = std::error_code{};
+    if (std::filesystem::remove(cacheFile.path, errorCode))
+    {
+      size -= cacheFile.size;
+    }
+  }
+
+  return size;
+}
+
+} // namespace
+
+kdl_reflect_impl(TextureCompressionConfig);
+
+TextureCompressionConfig TextureCompressor::config() const
+{
+  auto guard = std::lock_guard{m_mutex};
+  return m_config;
+}
+
+void TextureCompressor::setConfig(TextureCompressionConfig config)
+{
+  auto guard = std::lock_guard{m_mutex};
+  if (config.cachePath != m_config.cachePath)
+  {
+    auto cacheGuard = std::lock_guard{m_cacheMutex};
+    m_cacheSize = std::nullopt;
+  }
+  m_config = std::move(config);
+}
+
+Texture TextureCompressor::compress(Texture texture) const
+{
+  const auto config = this->config();
+  if (!config.enabled || !canCompressTexture(texture))
+  {
+    return texture;
+  }
+
+  if (!config.cachePath)
+  {
+    return compressTexture(texture);
+  }
+
+  const auto path = cacheFilePath(*config.cachePath, texture);
+  if (auto cachedTexture = loadCachedTexture(path, texture))
+  {
+    markCacheFileUsed(path);
+    return std::move(*cachedTexture);
+  }
+
+  auto compressedTexture = compressTexture(texture);
+
+  // a failure to write the cache file only means that the texture must be compressed
+  // again next time
+  storeCachedTexture(path, compressedTexture)
+    | kdl::transform(
+      [&]() { cacheFileStored(config, cacheFileSize(compressedTexture)); })
+    | kdl::transform_error([](auto) {});
+
+  return compressedTexture;
+}
+
+void TextureCompressor::cacheFileStored(
+  const TextureCompressionConfig& config, const size_t fileSize) const
+{
+  contract_pre(config.cachePath != std::nullopt);
+
+  auto guard = std::lock_guard{m_cacheMutex};
+  if (m_cacheSize)
+  {
+    *m_cacheSize += fileSize;
+  }
+  else
+  {
+    // the stored file is already included
+    m_cacheSize = totalSize(listCacheFiles(*config.cachePath));
+  }
+
+  if (*m_cacheSize > config.maxCacheSize)
+  {
+    // leave some room so that the cache is not pruned again for every file stored
+    m_cacheSize =
+      pruneCacheFiles(listCacheFiles(*config.cachePath), config.maxCacheSize / 4 * 3);
+  }
+}
+
+} // namespace tb::gl
@@ -113,6 +113,26 @@ TEST_CASE("Resource")
     CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource.state()));
     CHECK(!resource.isDropped());
     CHECK(mockTaskRunner.tasks.empty());
+
+    SECTION("cannot be evicted")
+    {
+      resource.uploadSync(testGl);
+      REQUIRE(std::holds_alternative<ResourceReady<MockResource>>(resource.state()));
+      CHECK(!resource.canEvict());
+
+      resource.evict(testGl);
+      CHECK(std::holds_alternative<ResourceReady<MockResource>>(resource.state()));
+    }
+  }
+
+  SECTION("markUsed")
+  {
+    auto resource = ResourceT{MockResource{}};
+    CHECK(!resource.takeUsed());
+
+    resource.markUsed();
+    CHECK(resource.takeUsed());
+    CHECK(!resource.takeUsed());
   }
 
   SECTION("Resource loading fails")
@@ -550,6 +570,84 @@ TEST_CASE("Resource")
         CHECK(!mockUploadCall);
         CHECK(mockDropCall);
       }
+
+      SECTION("evict")
+      {
+        CHECK(resource.canEvict());
+
+        resource.evict(testGl);
+        CHECK(resource.get() == nullptr);
+        CHECK(std::holds_alternative<ResourceEvicted<MockResource>>(resource.state()));
+        CHECK(!resource.isDropped());
+        CHECK(!resource.needsProcessing());
+        CHECK(!mockUploadCall);
+        CHECK(mockDropCall);
+
+        SECTION("markUsed")
+        {
+          resource.markUsed();
+          CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource.state()));
+          CHECK(resource.needsProcessing());
+
+          CHECK(resource.process(taskRunner, processContext));
+          mockTaskRunner.resolveNextPromise();
+          CHECK(resource.process(taskRunner, processContext));
+          CHECK(resource.process(taskRunner, processContext));
+          CHECK(std::holds_alternative<ResourceReady<MockResource>>(resource.state()));
+          CHECK(mockUploadCall);
+        }
+
+        SECTION("drop")
+        {
+          resource.drop();
+          CHECK(std::holds_alternative<ResourceDropped>(resource.state()));
+          CHECK(resource.isDropped());
+        }
+      }
+
+      SECTION("reload")
+      {
+        CHECK(resource.canReload());
+
+        resource.reload(taskRunner);
+        CHECK(resource.get() != nullptr);
+        CHECK(std::holds_alternative<ResourceReloading<MockResource>>(resource.state()));
+        CHECK(resource.isLoading());
+        CHECK(resource.needsProcessing());
+        CHECK(mockTaskRunner.tasks.size() == 1);
+
+        SECTION("TaskRunner has not resolved promise")
+        {
+          CHECK(!resource.process(taskRunner, processContext));
+          CHECK(resource.get() != nullptr);
+          CHECK(
+            std::holds_alternative<ResourceReloading<MockResource>>(resource.state()));
+          CHECK(!mockDropCall);
+        }
+
+        SECTION("TaskRunner resolves promise")
+        {
+          mockTaskRunner.resolveNextPromise();
+          CHECK(resource.process(taskRunner, processContext));
+          CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource.state()));
+          CHECK(mockDropCall);
+
+          CHECK(resource.process(taskRunner, processContext));
+          CHECK(std::holds_alternative<ResourceReady<MockResource>>(resource.state()));
+          CHECK(mockUploadCall);
+        }
+
+        SECTION("drop")
+        {
+          resource.drop();
+          CHECK(std::holds_alternative<ResourceDropping<MockResource>>(resource.state()));
+          CHECK(!mockDropCall);
+
+          CHECK(resource.process(taskRunner, processContext));
+          CHECK(std::holds_alternative<ResourceDropped>(resource.state()));
+          CHECK(mockDropCall);
+        }
+      }
     }
 
     SECTION("ResourceDropping state")
@@ -745,6 +843,15 @@ TEST_CASE("Resource")
       setResourceState<ResourceDropped>(resource, mockTaskRunner, processContext);
       CHECK(resource.needsProcessing());
     }
+
+    SECTION("ResourceEvicted state")
+    {
+      auto resource = ResourceT{[&]() { return Result<MockResource>{MockResource{}}; }};
+      setResourceState<ResourceReady<MockResource>>(
+        resource, mockTaskRunner, processContext);
+      resource.evict(testGl);
+      CHECK(!resource.needsProcessing());
+    }
   }
 }
 
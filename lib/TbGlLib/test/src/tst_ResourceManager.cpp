@@ -41,9 +41,16 @@ struct MockResource
 {
   void upload(Gl& gl) const { mockUpload(gl); }
   void drop(Gl& gl) const { mockDrop(gl); }
+  size_t memorySize() const { return mockMemorySize >> (2 * mockDroppedMipLevels); }
+  size_t droppedMipLevels() const { return mockDroppedMipLevels; }
+  bool canDropMipLevel() const { return mockDroppedMipLevels + 1 < mockMipLevels; }
+  void dropMipLevel(Gl&) { ++mockDroppedMipLevels; }
 
   std::function<void(Gl&)> mockUpload = [](auto&) {};
   std::function<void(Gl&)> mockDrop = [](auto&) {};
+  size_t mockMemorySize = 0;
+  size_t mockMipLevels = 1;
+  size_t mockDroppedMipLevels = 0;
 
   kdl_reflect_inline_empty(MockResource);
 };
@@ -313,6 +320,237 @@ TEST_CASE("ResourceManager")
       CHECK(resourceManager.resources().empty());
       CHECK(mockDropCalls[1]);
     }
+
+    SECTION("resources are loaded by priority")
+    {
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource3 = std::make_shared<ResourceT>(mockResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+      resourceManager.addResource(resource3);
+
+      resource3->setPriority(1);
+
+      resourceManager.process(taskRunner, processContext);
+      CHECK(
+        resourcesWereProcessed.notifications
+        == std::vector<std::vector<ResourceId>>{
+          {resource3->id(), resource1->id(), resource2->id()}});
+    }
+
+    SECTION("recently used resources are loaded first")
+    {
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource3 = std::make_shared<ResourceT>(mockResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+      resourceManager.addResource(resource3);
+
+      resource3->setPriority(1);
+      resource2->markUsed();
+
+      resourceManager.process(taskRunner, processContext);
+      CHECK(
+        resourcesWereProcessed.notifications
+        == std::vector<std::vector<ResourceId>>{
+          {resource3->id(), resource2->id(), resource1->id()}});
+    }
+
+    SECTION("number of concurrent loads is limited")
+    {
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource3 = std::make_shared<ResourceT>(mockResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+      resourceManager.addResource(resource3);
+
+      resource2->setPriority(1);
+      resourceManager.setMaxConcurrentLoads(2);
+
+      resourceManager.process(taskRunner, processContext);
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource1->state()));
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource2->state()));
+      CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource3->state()));
+
+      resourceManager.process(taskRunner, processContext);
+      CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource3->state()));
+
+      mockTaskRunner.resolveNextPromise();
+      resourceManager.process(taskRunner, processContext);
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource1->state()));
+      CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource2->state()));
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource3->state()));
+    }
+
+    SECTION("idle resources are evicted if the memory budget is exceeded")
+    {
+      auto mockMemorySizeLoader = [](const size_t memorySize) {
+        return [=]() {
+          return Result<MockResource>{
+            MockResource{[](auto&) {}, [](auto&) {}, memorySize}};
+        };
+      };
+
+      auto resource1 = std::make_shared<ResourceT>(mockMemorySizeLoader(10));
+      auto resource2 = std::make_shared<ResourceT>(mockMemorySizeLoader(20));
+      auto resource3 = std::make_shared<ResourceT>(MockResource{
+        [](auto&) {}, [](auto&) {}, 30});
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+      resourceManager.addResource(resource3);
+
+      resourceManager.process(taskRunner, processContext);
+      mockTaskRunner.resolveNextPromise();
+      mockTaskRunner.resolveNextPromise();
+      resourceManager.process(taskRunner, processContext);
+      resourceManager.process(taskRunner, processContext);
+      REQUIRE(resource1->isReady());
+      REQUIRE(resource2->isReady());
+      REQUIRE(resource3->isReady());
+      CHECK(resourceManager.memorySize() == 60);
+
+      resource2->markUsed();
+      resourceManager.process(taskRunner, processContext);
+      resource1->markUsed();
+
+      SECTION("no budget")
+      {
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resource1->isReady());
+        CHECK(resource2->isReady());
+        CHECK(resource3->isReady());
+      }
+
+      SECTION("resources used recently are not evicted")
+      {
+        resourceManager.setMemoryBudget(0, std::chrono::hours{1});
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resource1->isReady());
+        CHECK(resource2->isReady());
+        CHECK(resource3->isReady());
+      }
+
+      SECTION("least recently used resources are evicted first")
+      {
+        resourceManager.setMemoryBudget(45, std::chrono::milliseconds{0});
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resource1->isReady());
+        CHECK(resource2->isEvicted());
+        CHECK(resource3->isReady());
+        CHECK(resourceManager.memorySize() == 40);
+
+        resource2->markUsed();
+        CHECK(resource2->isUnloaded());
+
+        resourceManager.setMemoryBudget(std::nullopt);
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resource2->isLoading());
+      }
+
+      SECTION("resources without loader are not evicted")
+      {
+        resourceManager.setMemoryBudget(0, std::chrono::milliseconds{0});
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resource1->isEvicted());
+        CHECK(resource2->isEvicted());
+        CHECK(resource3->isReady());
+        CHECK(resourceManager.memorySize() == 30);
+        CHECK(
+          resourceManager.statistics()
+          == ResourceStatistics{
+            .resourceCount = 3,
+            .loadingCount = 0,
+            .readyCount = 1,
+            .reducedCount = 0,
+            .evictedCount = 2,
+            .memorySize = 30,
+          });
+      }
+
+      SECTION("resources that do not report their size are not evicted")
+      {
+        auto resource4 = std::make_shared<ResourceT>(mockMemorySizeLoader(0));
+        resourceManager.addResource(resource4);
+
+        resourceManager.process(taskRunner, processContext);
+        mockTaskRunner.resolveNextPromise();
+        resourceManager.process(taskRunner, processContext);
+        resourceManager.process(taskRunner, processContext);
+        REQUIRE(resource4->isReady());
+
+        resourceManager.setMemoryBudget(0, std::chrono::milliseconds{0});
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resource1->isEvicted());
+        CHECK(resource2->isEvicted());
+        CHECK(resource4->isReady());
+      }
+    }
+
+    SECTION("idle resources are reduced before they are evicted")
+    {
+      auto mockMipLevelsLoader = [](const size_t memorySize) {
+        return [=]() {
+          return Result<MockResource>{
+            MockResource{[](auto&) {}, [](auto&) {}, memorySize, 3}};
+        };
+      };
+
+      auto resource1 = std::make_shared<ResourceT>(mockMipLevelsLoader(64));
+      auto resource2 = std::make_shared<ResourceT>(mockMipLevelsLoader(64));
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+
+      resourceManager.process(taskRunner, processContext);
+      mockTaskRunner.resolveNextPromise();
+      mockTaskRunner.resolveNextPromise();
+      resourceManager.process(taskRunner, processContext);
+      resourceManager.process(taskRunner, processContext);
+      REQUIRE(resource1->isReady());
+      REQUIRE(resource2->isReady());
+
+      resource2->markUsed();
+      resourceManager.process(taskRunner, processContext);
+
+      resourceManager.setMemoryBudget(40, std::chrono::milliseconds{0});
+      resourceManager.process(taskRunner, processContext);
+
+      CHECK(resource1->isReady());
+      CHECK(resource1->get()->droppedMipLevels() == 2);
+      CHECK(resource2->isReady());
+      CHECK(resource2->get()->droppedMipLevels() == 1);
+      CHECK(resourceManager.memorySize() == 20);
+      CHECK(resourceManager.statistics().reducedCount == 2);
+
+      SECTION("reduced resources are reloaded when they are used")
+      {
+        resourceManager.setMemoryBudget(40, std::chrono::hours{1});
+
+        resource2->markUsed();
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resource2->isLoading());
+        REQUIRE(resource2->get() != nullptr);
+        CHECK(resource2->get()->droppedMipLevels() == 1);
+
+        mockTaskRunner.resolveNextPromise();
+        resourcesWereProcessed.reset();
+        resourceManager.process(taskRunner, processContext);
+        CHECK(
+          resourcesWereProcessed.notifications
+          == std::vector<std::vector<ResourceId>>{{resource2->id()}});
+        CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource2->state()));
+
+        resourceManager.process(taskRunner, processContext);
+        CHECK(resource2->isReady());
+        CHECK(resource2->get()->droppedMipLevels() == 0);
+
+        // resource1 cannot be reduced any further
+        CHECK(resource1->isEvicted());
+        CHECK(resourceManager.memorySize() == 64);
+      }
+    }
   }
 }
 
@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gl/TestGl.h"
+#include "gl/Texture.h"
+
+#include "kd/vector_utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::gl
+{
+
+TEST_CASE("Texture")
+{
+  auto testGl = TestGl{};
+
+  SECTION("mipLevels")
+  {
+    SECTION("without stored mip levels")
+    {
+      CHECK(Texture{16, 16}.mipLevels() == 0);
+    }
+
+    SECTION("with a single stored level")
+    {
+      auto texture = Texture{
+        16, 8, Color{}, GL_RGBA, TextureMask::Off, NoEmbeddedDefaults{}, TextureBuffer{512}};
+      CHECK(texture.mipLevels() == 5);
+
+      texture.setMask(TextureMask::On);
+      CHECK(texture.mipLevels() == 1);
+    }
+
+    SECTION("with stored mip levels")
+    {
+      auto buffers = std::vector<TextureBuffer>{};
+      setMipBufferSize(buffers, 2, 16, 8, GL_RGBA);
+
+      const auto texture = Texture{
+        16, 8, Color{}, GL_RGBA, TextureMask::Off, NoEmbeddedDefaults{}, std::move(buffers)};
+      CHECK(texture.mipLevels() == 2);
+    }
+  }
+
+  SECTION("memorySize")
+  {
+    auto buffers = std::vector<TextureBuffer>{};
+    setMipBufferSize(buffers, 3, 16, 8, GL_RGBA);
+
+    const auto texture = Texture{
+      16, 8, Color{}, GL_RGBA, TextureMask::Off, NoEmbeddedDefaults{}, std::move(buffers)};
+    CHECK(texture.memorySize() == 4 * (16 * 8 + 8 * 4 + 4 * 2));
+  }
+
+  SECTION("dropMipLevel")
+  {
+    auto buffers = std::vector<TextureBuffer>{};
+    setMipBufferSize(buffers, 3, 16, 8, GL_RGBA);
+
+    auto texture = Texture{
+      16, 8, Color{}, GL_RGBA, TextureMask::Off, NoEmbeddedDefaults{}, std::move(buffers)};
+    CHECK(!texture.canDropMipLevel());
+
+    texture.upload(testGl);
+    CHECK(texture.canDropMipLevel());
+    CHECK(texture.droppedMipLevels() == 0);
+
+    texture.dropMipLevel(testGl);
+    CHECK(texture.isReady());
+    CHECK(texture.droppedMipLevels() == 1);
+    CHECK(texture.memorySize() == 4 * (8 * 4 + 4 * 2));
+    CHECK(texture.width() == 16);
+    CHECK(texture.height() == 8);
+    CHECK(texture.canDropMipLevel());
+
+    texture.dropMipLevel(testGl);
+    CHECK(texture.droppedMipLevels() == 2);
+    CHECK(texture.memorySize() == 4 * (4 * 2));
+    CHECK(!texture.canDropMipLevel());
+  }
+
+  SECTION("dropMipLevel converts the texture to RGBA")
+  {
+    auto buffers = std::vector<TextureBuffer>{};
+    setMipBufferSize(buffers, 3, 16, 8, GL_BGR);
+
+    auto texture = Texture{
+      16, 8, Color{}, GL_BGR, TextureMask::Off, NoEmbeddedDefaults{}, std::move(buffers)};
+    CHECK(texture.memorySize() == 3 * (16 * 8 + 8 * 4 + 4 * 2));
+
+    texture.upload(testGl);
+    texture.dropMipLevel(testGl);
+    CHECK(texture.format() == GL_RGBA);
+    CHECK(texture.memorySize() == 4 * (8 * 4 + 4 * 2));
+  }
+
+  SECTION("masked textures cannot drop mip levels")
+  {
+    auto texture = Texture{
+      16, 8, Color{}, GL_RGBA, TextureMask::On, NoEmbeddedDefaults{}, TextureBuffer{512}};
+    texture.upload(testGl);
+    CHECK(!texture.canDropMipLevel());
+  }
+}
+
+} // namespace tb::gl
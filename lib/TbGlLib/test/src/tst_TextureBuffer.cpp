@@ -0,0 +1,166 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gl/TextureBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace tb::gl
+{
+namespace
+{
+
+TextureBuffer makeRandomRgbaBuffer(const size_t width, const size_t height)
+{
+  auto randEngine = std::mt19937{};
+  auto distribution = std::uniform_int_distribution<int>{0, 255};
+
+  auto result = TextureBuffer{4 * width * height};
+  for (size_t i = 0; i < result.size(); ++i)
+  {
+    result.data()[i] = static_cast<unsigned char>(distribution(randEngine));
+  }
+  return result;
+}
+
+// Straightforward per pixel box filter to compare the optimized filter against
+TextureBufferList generateMipsReference(
+  TextureBuffer buffer, const size_t width, const size_t height)
+{
+  auto result = TextureBufferList{};
+  result.push_back(std::move(buffer));
+
+  for (size_t level = 1; level < mipChainLength(width, height); ++level)
+  {
+    const auto srcSize = sizeAtMipLevel(width, height, level - 1);
+    const auto dstSize = sizeAtMipLevel(width, height, level);
+    const auto& src = result.back();
+
+    auto dst = TextureBuffer{4 * dstSize.x() * dstSize.y()};
+    for (size_t y = 0; y < dstSize.y(); ++y)
+    {
+      for (size_t x = 0; x < dstSize.x(); ++x)
+      {
+        const size_t xs[] = {
+          std::min(2 * x, srcSize.x() - 1), std::min(2 * x + 1, srcSize.x() - 1)};
+        const size_t ys[] = {
+          std::min(2 * y, srcSize.y() - 1), std::min(2 * y + 1, srcSize.y() - 1)};
+        for (size_t c = 0; c < 4; ++c)
+        {
+          auto sum = 0u;
+          for (const auto sy : ys)
+          {
+            for (const auto sx : xs)
+            {
+              sum += src.data()[4 * (sy * srcSize.x() + sx) + c];
+            }
+          }
+          dst.data()[4 * (y * dstSize.x() + x) + c] =
+            static_cast<unsigned char>((sum + 2) / 4);
+        }
+      }
+    }
+    result.push_back(std::move(dst));
+  }
+
+  return result;
+}
+
+TextureBuffer copyBuffer(const TextureBuffer& buffer)
+{
+  auto result = TextureBuffer{buffer.size()};
+  std::memcpy(result.data(), buffer.data(), buffer.size());
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("mipChainLength")
+{
+  CHECK(mipChainLength(1, 1) == 1);
+  CHECK(mipChainLength(2, 1) == 2);
+  CHECK(mipChainLength(16, 16) == 5);
+  CHECK(mipChainLength(16, 8) == 5);
+  CHECK(mipChainLength(5, 17) == 5);
+}
+
+TEST_CASE("generateMips")
+{
+  using T = std::tuple<size_t, size_t>;
+
+  const auto [width, height] = GENERATE(values<T>({
+    {1, 1},
+    {2, 2},
+    {4, 1},
+    {1, 4},
+    {7, 3},
+    {16, 16},
+    {64, 32},
+    {33, 65},
+  }));
+
+  CAPTURE(width, height);
+
+  const auto image = makeRandomRgbaBuffer(width, height);
+
+  auto buffers = TextureBufferList{};
+  buffers.push_back(copyBuffer(image));
+  generateMips(buffers, width, height, GL_RGBA);
+
+  const auto expectedBuffers = generateMipsReference(copyBuffer(image), width, height);
+  REQUIRE(buffers.size() == expectedBuffers.size());
+
+  for (size_t level = 0; level < buffers.size(); ++level)
+  {
+    CAPTURE(level);
+
+    REQUIRE(buffers[level].size() == expectedBuffers[level].size());
+    CHECK(
+      std::memcmp(
+        buffers[level].data(), expectedBuffers[level].data(), buffers[level].size())
+      == 0);
+  }
+}
+
+TEST_CASE("TextureBuffer.benchmarkGenerateMipsReference", "[.]")
+{
+  const auto image = makeRandomRgbaBuffer(512, 512);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    generateMipsReference(copyBuffer(image), 512, 512);
+  }
+}
+
+TEST_CASE("TextureBuffer.benchmarkGenerateMips", "[.]")
+{
+  const auto image = makeRandomRgbaBuffer(512, 512);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    auto buffers = TextureBufferList{};
+    buffers.push_back(copyBuffer(image));
+    generateMips(buffers, 512, 512, GL_RGBA);
+  }
+}
+
+} // namespace tb::gl
@@ -0,0 +1,419 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fs/TestEnvironment.h"
+#include "gl/Texture.h"
+#include "gl/TextureCompression.h"
+#include "gl/TextureCompressor.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace tb::gl
+{
+namespace
+{
+
+using Rgba = std::array<unsigned char, 4>;
+using Block = std::array<unsigned char, 64>;
+
+Rgba expand565(const uint16_t color)
+{
+  const auto r = (color >> 11) & 0x1F;
+  const auto g = (color >> 5) & 0x3F;
+  const auto b = color & 0x1F;
+  return {
+    static_cast<unsigned char>((r << 3) | (r >> 2)),
+    static_cast<unsigned char>((g << 2) | (g >> 4)),
+    static_cast<unsigned char>((b << 3) | (b >> 2)),
+    0xFF};
+}
+
+// Decodes the color part of a block according to the S3TC specification
+std::array<Rgba, 16> decodeColorBlock(const unsigned char* block)
+{
+  const auto color0 = uint16_t(block[0] | (block[1] << 8));
+  const auto color1 = uint16_t(block[2] | (block[3] << 8));
+  const auto c0 = expand565(color0);
+  const auto c1 = expand565(color1);
+
+  auto palette = std::array<Rgba, 4>{c0, c1};
+  for (size_t c = 0; c < 3; ++c)
+  {
+    if (color0 > color1)
+    {
+      palette[2][c] = static_cast<unsigned char>((2 * c0[c] + c1[c]) / 3);
+      palette[3][c] = static_cast<unsigned char>((c0[c] + 2 * c1[c]) / 3);
+    }
+    else
+    {
+      palette[2][c] = static_cast<unsigned char>((c0[c] + c1[c]) / 2);
+      palette[3][c] = 0;
+    }
+  }
+  palette[2][3] = 0xFF;
+  palette[3][3] = color0 > color1 ? 0xFF : 0x00;
+
+  const auto indices = uint32_t(block[4] | (block[5] << 8) | (block[6] << 16))
+                       | (uint32_t(block[7]) << 24);
+
+  auto result = std::array<Rgba, 16>{};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    result[i] = palette[(indices >> (2 * i)) & 0x3];
+  }
+  return result;
+}
+
+std::array<unsigned char, 16> decodeAlphaBlock(const unsigned char* block)
+{
+  const auto a0 = int(block[0]);
+  const auto a1 = int(block[1]);
+
+  auto palette = std::array<int, 8>{a0, a1};
+  for (size_t i = 2; i < 8; ++i)
+  {
+    palette[i] = a0 > a1 ? (int(8 - i) * a0 + int(i - 1) * a1) / 7
+                 : i < 6 ? (int(6 - i) * a0 + int(i - 1) * a1) / 5
+                 : i == 6 ? 0
+                          : 255;
+  }
+
+  auto indices = uint64_t(0);
+  for (size_t i = 0; i < 6; ++i)
+  {
+    indices |= uint64_t(block[2 + i]) << (8 * i);
+  }
+
+  auto result = std::array<unsigned char, 16>{};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    result[i] = static_cast<unsigned char>(palette[(indices >> (3 * i)) & 0x7]);
+  }
+  return result;
+}
+
+Block makeBlock(const Rgba& color)
+{
+  auto result = Block{};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    std::memcpy(result.data() + 4 * i, color.data(), 4);
+  }
+  return result;
+}
+
+Block makeGradientBlock()
+{
+  auto result = Block{};
+  for (size_t i = 0; i < 16; ++i)
+  {
+    const auto value = static_cast<unsigned char>(i * 16);
+    result[4 * i + 0] = value;
+    result[4 * i + 1] = static_cast<unsigned char>(255 - value);
+    result[4 * i + 2] = 0x80;
+    result[4 * i + 3] = i % 2 == 0 ? 0xFF : 0x00;
+  }
+  return result;
+}
+
+int maxColorError(const Block& expected, const std::array<Rgba, 16>& actual)
+{
+  auto result = 0;
+  for (size_t i = 0; i < 16; ++i)
+  {
+    for (size_t c = 0; c < 3; ++c)
+    {
+      result = std::max(result, std::abs(int(expected[4 * i + c]) - int(actual[i][c])));
+    }
+  }
+  return result;
+}
+
+Texture makeTexture(
+  const size_t width,
+  const size_t height,
+  const TextureMask mask,
+  const unsigned char alpha,
+  const size_t mipLevels = 1)
+{
+  auto buffers = TextureBufferList{};
+  setMipBufferSize(buffers, mipLevels, width, height, GL_RGBA);
+  for (auto& buffer : buffers)
+  {
+    for (size_t i = 0; i < buffer.size(); i += 4)
+    {
+      buffer.data()[i + 0] = static_cast<unsigned char>(i % 256);
+      buffer.data()[i + 1] = static_cast<unsigned char>((i / 4) % 256);
+      buffer.data()[i + 2] = 0x40;
+      buffer.data()[i + 3] = alpha;
+    }
+  }
+
+  return Texture{
+    width, height, Color{}, GL_RGBA, mask, NoEmbeddedDefaults{}, std::move(buffers)};
+}
+
+} // namespace
+
+TEST_CASE("compressBlockBC1")
+{
+  SECTION("solid color")
+  {
+    const auto color = GENERATE(
+      Rgba{0x00, 0x00, 0x00, 0xFF},
+      Rgba{0xFF, 0xFF, 0xFF, 0xFF},
+      Rgba{0x12, 0x34, 0x56, 0xFF},
+      Rgba{0xC0, 0x80, 0x10, 0xFF});
+
+    CAPTURE(color);
+
+    const auto rgba = makeBlock(color);
+    auto block = std::array<unsigned char, 8>{};
+    compressBlockBC1(rgba.data(), block.data());
+
+    // the only error is the quantization to RGB565
+    CHECK(maxColorError(rgba, decodeColorBlock(block.data())) <= 4);
+  }
+
+  SECTION("gradient")
+  {
+    const auto rgba = makeGradientBlock();
+    auto block = std::array<unsigned char, 8>{};
+    compressBlockBC1(rgba.data(), block.data());
+
+    const auto color0 = uint16_t(block[0] | (block[1] << 8));
+    const auto color1 = uint16_t(block[2] | (block[3] << 8));
+    CHECK(color0 > color1);
+    CHECK(maxColorError(rgba, decodeColorBlock(block.data())) <= 48);
+  }
+}
+
+TEST_CASE("compressBlockBC3")
+{
+  SECTION("opaque")
+  {
+    const auto rgba = makeBlock({0x12, 0x34, 0x56, 0xFF});
+    auto block = std::array<unsigned char, 16>{};
+    compressBlockBC3(rgba.data(), block.data());
+
+    for (const auto alpha : decodeAlphaBlock(block.data()))
+    {
+      CHECK(alpha == 0xFF);
+    }
+    CHECK(maxColorError(rgba, decodeColorBlock(block.data() + 8)) <= 4);
+  }
+
+  SECTION("masked")
+  {
+    const auto rgba = makeGradientBlock();
+    auto block = std::array<unsigned char, 16>{};
+    compressBlockBC3(rgba.data(), block.data());
+
+    const auto alpha = decodeAlphaBlock(block.data());
+    for (size_t i = 0; i < 16; ++i)
+    {
+      CHECK(alpha[i] == rgba[4 * i + 3]);
+    }
+    CHECK(maxColorError(rgba, decodeColorBlock(block.data() + 8)) <= 48);
+  }
+}
+
+TEST_CASE("canCompressTexture")
+{
+  CHECK(canCompressTexture(makeTexture(16, 8, TextureMask::Off, 0xFF)));
+  CHECK_FALSE(canCompressTexture(makeTexture(6, 8, TextureMask::Off, 0xFF)));
+  CHECK_FALSE(canCompressTexture(Texture{16, 16}));
+
+  auto buffers = TextureBufferList{};
+  setMipBufferSize(buffers, 1, 16, 16, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+  CHECK_FALSE(canCompressTexture(Texture{
+    16,
+    16,
+    Color{},
+    GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+    TextureMask::Off,
+    NoEmbeddedDefaults{},
+    std::move(buffers)}));
+}
+
+TEST_CASE("compressTexture")
+{
+  SECTION("opaque texture without mipmaps")
+  {
+    const auto compressed = compressTexture(makeTexture(16, 8, TextureMask::Off, 0xFF));
+    CHECK(compressed.format() == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+    CHECK(compressed.buffersIfLoaded().size() == 5);
+    CHECK(compressed.mipLevels() == 5);
+    CHECK(compressed.memorySize() == 8 * (8 + 2 + 1 + 1 + 1));
+  }
+
+  SECTION("opaque texture with mipmaps")
+  {
+    const auto compressed =
+      compressTexture(makeTexture(48, 48, TextureMask::Off, 0xFF, 4));
+    CHECK(compressed.format() == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+    CHECK(compressed.buffersIfLoaded().size() == 4);
+
+    // 6x6 has partial blocks
+    CHECK(compressed.memorySize() == 8 * (144 + 36 + 9 + 4));
+  }
+
+  SECTION("translucent texture")
+  {
+    const auto compressed =
+      compressTexture(makeTexture(16, 16, TextureMask::Off, 0x80));
+    CHECK(compressed.format() == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+    CHECK(compressed.buffersIfLoaded().size() == 5);
+  }
+
+  SECTION("masked texture")
+  {
+    const auto compressed =
+      compressTexture(makeTexture(16, 16, TextureMask::On, 0xFF, 4));
+    CHECK(compressed.format() == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+    CHECK(compressed.mask() == TextureMask::On);
+    CHECK(compressed.buffersIfLoaded().size() == 1);
+  }
+}
+
+TEST_CASE("TextureCompressor")
+{
+  auto env = fs::TestEnvironment{};
+  const auto cachePath = env.dir() / "cache";
+
+  auto compressor = TextureCompressor{};
+
+  SECTION("Compression is disabled by default")
+  {
+    CHECK(
+      compressor.compress(makeTexture(16, 16, TextureMask::Off, 0xFF)).format()
+      == GL_RGBA);
+  }
+
+  SECTION("Textures that cannot be compressed are returned unchanged")
+  {
+    compressor.setConfig({.enabled = true});
+    CHECK(
+      compressor.compress(makeTexture(6, 6, TextureMask::Off, 0xFF)).format()
+      == GL_RGBA);
+  }
+
+  SECTION("Without a cache")
+  {
+    compressor.setConfig({.enabled = true});
+    CHECK(
+      compressor.compress(makeTexture(16, 16, TextureMask::Off, 0xFF)).format()
+      == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+    CHECK_FALSE(env.directoryExists("cache"));
+  }
+
+  SECTION("With a cache")
+  {
+    compressor.setConfig({.enabled = true, .cachePath = cachePath});
+
+    const auto compressed =
+      compressor.compress(makeTexture(16, 16, TextureMask::Off, 0x80));
+    CHECK(compressed.format() == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+    REQUIRE(env.directoryContents("cache").size() == 1);
+
+    const auto cached =
+      compressor.compress(makeTexture(16, 16, TextureMask::Off, 0x80));
+    CHECK(cached.format() == compressed.format());
+    CHECK(env.directoryContents("cache").size() == 1);
+
+    const auto& compressedBuffers = compressed.buffersIfLoaded();
+    const auto& cachedBuffers = cached.buffersIfLoaded();
+    REQUIRE(cachedBuffers.size() == compressedBuffers.size());
+    for (size_t i = 0; i < cachedBuffers.size(); ++i)
+    {
+      REQUIRE(cachedBuffers[i].size() == compressedBuffers[i].size());
+      CHECK(
+        std::memcmp(
+          cachedBuffers[i].data(), compressedBuffers[i].data(), cachedBuffers[i].size())
+        == 0);
+    }
+
+    // a different texture gets its own cache file
+    compressor.compress(makeTexture(16, 16, TextureMask::Off, 0xFF));
+    CHECK(env.directoryContents("cache").size() == 2);
+  }
+
+  SECTION("Cache file names do not depend on the platform")
+  {
+    compressor.setConfig({.enabled = true, .cachePath = cachePath});
+    compressor.compress(makeTexture(16, 16, TextureMask::Off, 0xFF));
+    CHECK(
+      env.directoryContents("cache")
+      == std::vector<std::filesystem::path>{"cache/7fc74d444422ff6e.tbtc"});
+  }
+
+  SECTION("Cache files with an invalid number of mip levels are ignored")
+  {
+    compressor.setConfig({.enabled = true, .cachePath = cachePath});
+    const auto mipLevels =
+      compressor.compress(makeTexture(16, 16, TextureMask::Off, 0xFF))
+        .buffersIfLoaded()
+        .size();
+    REQUIRE(env.directoryContents("cache").size() == 1);
+
+    const auto header = std::array<uint32_t, 4>{
+      0x43544254, 1, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, 0xFFFFFFFF};
+    env.createFile(
+      env.directoryContents("cache").front(),
+      std::string{reinterpret_cast<const char*>(header.data()), sizeof(header)});
+
+    const auto compressed =
+      compressor.compress(makeTexture(16, 16, TextureMask::Off, 0xFF));
+    CHECK(compressed.format() == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+    CHECK(compressed.buffersIfLoaded().size() == mipLevels);
+  }
+
+  SECTION("The cache is pruned when it grows beyond its maximum size")
+  {
+    compressor.setConfig({.enabled = true, .cachePath = cachePath});
+    compressor.compress(makeTexture(16, 16, TextureMask::On, 0xFF));
+    REQUIRE(env.directoryContents("cache").size() == 1);
+
+    const auto fileSize =
+      std::filesystem::file_size(env.dir() / env.directoryContents("cache").front());
+    compressor.setConfig({
+      .enabled = true,
+      .cachePath = cachePath,
+      .maxCacheSize = 2 * fileSize,
+    });
+
+    // masked textures of the same size have cache files of the same size
+    compressor.compress(makeTexture(16, 16, TextureMask::On, 0xFE));
+    CHECK(env.directoryContents("cache").size() == 2);
+
+    compressor.compress(makeTexture(16, 16, TextureMask::On, 0xFD));
+    CHECK(env.directoryContents("cache").size() == 1);
+  }
+}
+
+} // namespace tb::gl
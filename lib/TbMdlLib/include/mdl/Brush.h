@@ -34,6 +34,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
@@ -43,11 +44,14 @@ class PolyhedronMatcher;
 
 enum class MapFormat;
 
+/**
+ * A brush owns its faces, but its geometry is immutable once it has been built and is
+ * shared between copies of the brush. Copying a brush only copies its faces, and any
+ * operation that changes the shape of a brush builds new geometry.
+ */
 class Brush
 {
 private:
-  class CopyCallback;
-
   /**
    * Epsilon value to use when finding a vertex after applying a vertex operation
    */
@@ -59,7 +63,7 @@ public:
 
 private:
   std::vector<BrushFace> m_faces;
-  std::unique_ptr<BrushGeometry> m_geometry;
+  std::shared_ptr<const BrushGeometry> m_geometry;
 
   kdl_reflect_decl(Brush, m_faces);
 
@@ -85,6 +89,25 @@ private:
 public:
   const vm::bbox3d& bounds() const;
 
+  /**
+   * Returns an estimate of the number of bytes used by this brush. The geometry is
+   * included even if it is shared with other brushes.
+   */
+  size_t memoryFootprint() const;
+
+  /**
+   * Returns an estimate of the number of bytes used by this brush. The geometry is only
+   * included if it is not in the given set yet, and is then added to it. This way, the
+   * geometry shared by several brushes is only counted once.
+   */
+  size_t memoryFootprint(
+    std::unordered_set<const BrushGeometry*>& countedGeometries) const;
+
+  /**
+   * Indicates whether this brush shares its geometry with the given brush.
+   */
+  bool sharesGeometryWith(const Brush& other) const;
+
 public: // face management:
   std::optional<size_t> findFace(const std::string& materialName) const;
   std::optional<size_t> findFace(const vm::vec3d& normal) const;
@@ -249,8 +272,8 @@ private:
    */
   static std::optional<vm::mat4x4d> findTransformForUVLock(
     const PolyhedronMatcher<BrushGeometry>& matcher,
-    BrushFaceGeometry* left,
-    BrushFaceGeometry* right);
+    const BrushFaceGeometry* left,
+    const BrushFaceGeometry* right);
 
   /**
    * Helper function to apply UV lock to the face `right`.
@@ -287,8 +310,12 @@ public:
    * Subtracts the given subtrahends from `this`, returning the result but without
    * modifying `this`.
    *
+   * Subtrahends whose bounds don't intersect the bounds of `this` are skipped.
+   *
    * @param subtrahends brushes to subtract from `this`. The passed-in brushes are not
    * modified.
+   * @param mergeFragments whether to merge fragments whose union is convex into a single
+   * fragment
    * @return the subtraction result framents as Brushes, or Errors for any fragments
    * which were invalid. Note, the subtraction result should still be usable even if some
    * Errors are returned. It's a hint to the user to double check the result, and
@@ -298,7 +325,8 @@ public:
     MapFormat mapFormat,
     const vm::bbox3d& worldBounds,
     const std::string& defaultMaterialName,
-    const std::vector<const Brush*>& subtrahends) const;
+    const std::vector<const Brush*>& subtrahends,
+    bool mergeFragments = false) const;
   std::vector<Result<Brush>> subtract(
     MapFormat mapFormat,
     const vm::bbox3d& worldBounds,
@@ -94,7 +94,7 @@ private:
 
   AssetReference<gl::Material> m_materialReference;
   std::unique_ptr<UVCoordSystem> m_uvCoordSystem;
-  BrushFaceGeometry* m_geometry = nullptr;
+  const BrushFaceGeometry* m_geometry = nullptr;
 
   mutable size_t m_lineNumber = 0;
   mutable size_t m_lineCount = 0;
@@ -261,8 +261,8 @@ public:
   vm::polygon3d polygon() const;
 
 public:
-  BrushFaceGeometry* geometry() const;
-  void setGeometry(BrushFaceGeometry* geometry);
+  const BrushFaceGeometry* geometry() const;
+  void setGeometry(const BrushFaceGeometry* geometry);
 
   size_t lineNumber() const;
   void setFilePosition(size_t lineNumber, size_t lineCount) const;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Color.h"
+#include "mdl/MaterialName.h"
 
 #include "kd/reflection_decl.h"
 
@@ -38,7 +39,7 @@ public:
   static const std::string NoMaterialName;
 
 private:
-  std::string m_materialName;
+  MaterialName m_materialName;
 
   vm::vec2f m_offset = vm::vec2f{0, 0};
   vm::vec2f m_scale = vm::vec2f{1, 1};
@@ -66,6 +67,7 @@ public:
     m_color);
 
   const std::string& materialName() const;
+  const MaterialName& internedMaterialName() const;
 
   const vm::vec2f& offset() const;
   float xOffset() const;
@@ -89,6 +91,7 @@ public:
   bool valid() const;
 
   bool setMaterialName(const std::string& materialName);
+  bool setMaterialName(const MaterialName& materialName);
   bool setOffset(const vm::vec2f& offset);
   bool setXOffset(float xOffset);
   bool setYOffset(float yOffset);
@@ -27,6 +27,7 @@
 #include "mdl/Object.h"
 #include "mdl/TagType.h"
 
+#include "vm/packed_intersection.h"
 #include "vm/ray.h"
 
 #include <memory>
@@ -61,6 +62,7 @@ public:
 private:
   mutable std::unique_ptr<BrushRendererBrushCache> m_brushRendererBrushCache;
   Brush m_brush; // must be destroyed before the brush renderer cache
+  vm::packed_planes<double> m_facePlanes;
   size_t m_selectedFaceCount = 0u;
 
 public:
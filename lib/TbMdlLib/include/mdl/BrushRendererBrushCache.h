@@ -64,6 +64,7 @@ private:
   std::vector<CachedEdge> m_cachedEdges;
   std::vector<CachedFace> m_cachedFacesSortedByMaterial;
   bool m_rendererCacheValid;
+  size_t m_vertexCacheVersion;
 
 public:
   BrushRendererBrushCache();
@@ -82,6 +83,16 @@ public:
    */
   void validateVertexCache(const BrushNode& brushNode);
 
+  /**
+   * Returns a number that changes whenever the vertex cache is invalidated. Renderers
+   * that share uploaded vertices use it to detect that the vertices must be uploaded
+   * again.
+   *
+   * The versions are unique across all caches, so a brush that is allocated at the
+   * address of a deleted brush never has the version of the deleted brush.
+   */
+  size_t vertexCacheVersion() const;
+
   /**
    * Returns all vertices for all faces of the brush.
    */
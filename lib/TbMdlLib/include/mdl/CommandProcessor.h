@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -78,6 +79,13 @@ private:
    */
   std::vector<std::unique_ptr<UndoableCommand>> m_redoStack;
 
+  /**
+   * The sum of the estimated memory footprints of the commands on the undo stack.
+   */
+  size_t m_undoMemoryFootprint;
+
+  std::optional<size_t> m_undoMemoryBudget;
+
   /**
    * The time stamp of when the last command was executed.
    */
@@ -175,6 +183,20 @@ public:
    * no command can be redone.
    */
   const std::string* redoCommandName() const;
+
+  /**
+   * Returns an estimate of the number of bytes used by the commands on the undo stack.
+   */
+  size_t undoMemoryFootprint() const;
+
+  const std::optional<size_t>& undoMemoryBudget() const;
+
+  /**
+   * Limits the estimated memory used by the undo stack. Whenever the limit is exceeded,
+   * the oldest commands are discarded, but the most recent command is always kept. Pass
+   * std::nullopt to remove the limit.
+   */
+  void setUndoMemoryBudget(std::optional<size_t> undoMemoryBudget);
   /**
    * Starts a new transaction. If a transaction is currently executing, then the newly
    * started transaction becomes a nested transaction and will be added as a command to
@@ -377,6 +399,8 @@ private:
    * @return the topmost command of the undo stack
    */
   std::unique_ptr<UndoableCommand> popFromUndoStack();
+  void clearUndoStack();
+  void enforceUndoMemoryBudget();
 
   bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
@@ -19,10 +19,12 @@
 
 #pragma once
 
+#include "Result.h"
 #include "mdl/CompilationTask.h"
 
 #include "kd/reflection_decl.h"
 
+#include <string>
 #include <vector>
 
 namespace tb::mdl
@@ -37,4 +39,24 @@ struct CompilationProfile
   kdl_reflect_decl(CompilationProfile, name, workDirSpec, tasks);
 };
 
+/**
+ * Returns the indices of the enabled tasks that must have finished before a task can run,
+ * for every task of the given profile. A dependency on a disabled task is replaced by
+ * that task's own dependencies. Disabled tasks have no dependencies.
+ *
+ * Returns an error if a task depends on itself or on a task that does not exist, or if
+ * the dependencies are cyclic.
+ */
+Result<std::vector<std::vector<size_t>>> resolveTaskDependencies(
+  const CompilationProfile& profile);
+
+/**
+ * The following functions modify the tasks of a profile and update the declared task
+ * dependencies so that they still refer to the same tasks. Dependencies on a removed task
+ * are dropped.
+ */
+void insertTask(CompilationProfile& profile, size_t index, CompilationTask task);
+void removeTask(CompilationProfile& profile, size_t index);
+void swapTasks(CompilationProfile& profile, size_t index1, size_t index2);
+
 } // namespace tb::mdl
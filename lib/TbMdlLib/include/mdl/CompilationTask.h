@@ -22,18 +22,29 @@
 #include "kd/reflection_decl.h"
 
 #include <iosfwd>
+#include <optional>
 #include <string>
 #include <variant>
+#include <vector>
 
 namespace tb::mdl
 {
+
+/*
+ * Every task can declare the indices of the tasks in its profile that must have finished
+ * before it can run. A task without declared dependencies depends on its predecessor, so
+ * profiles without any declared dependencies run their tasks one after another.
+ */
+
 struct CompilationExportMap
 {
   bool enabled;
   bool stripTbProperties;
   std::string targetSpec;
+  std::optional<std::vector<size_t>> dependencies = std::nullopt;
 
-  kdl_reflect_decl(CompilationExportMap, enabled, stripTbProperties, targetSpec);
+  kdl_reflect_decl(
+    CompilationExportMap, enabled, stripTbProperties, targetSpec, dependencies);
 };
 
 struct CompilationCopyFiles
@@ -41,8 +52,9 @@ struct CompilationCopyFiles
   bool enabled;
   std::string sourceSpec;
   std::string targetSpec;
+  std::optional<std::vector<size_t>> dependencies = std::nullopt;
 
-  kdl_reflect_decl(CompilationCopyFiles, enabled, sourceSpec, targetSpec);
+  kdl_reflect_decl(CompilationCopyFiles, enabled, sourceSpec, targetSpec, dependencies);
 };
 
 struct CompilationRenameFile
@@ -50,16 +62,18 @@ struct CompilationRenameFile
   bool enabled;
   std::string sourceSpec;
   std::string targetSpec;
+  std::optional<std::vector<size_t>> dependencies = std::nullopt;
 
-  kdl_reflect_decl(CompilationRenameFile, enabled, sourceSpec, targetSpec);
+  kdl_reflect_decl(CompilationRenameFile, enabled, sourceSpec, targetSpec, dependencies);
 };
 
 struct CompilationDeleteFiles
 {
   bool enabled;
   std::string targetSpec;
+  std::optional<std::vector<size_t>> dependencies = std::nullopt;
 
-  kdl_reflect_decl(CompilationDeleteFiles, enabled, targetSpec);
+  kdl_reflect_decl(CompilationDeleteFiles, enabled, targetSpec, dependencies);
 };
 
 struct CompilationRunTool
@@ -68,9 +82,15 @@ struct CompilationRunTool
   std::string toolSpec;
   std::string parameterSpec;
   bool treatNonZeroResultCodeAsError;
+  std::optional<std::vector<size_t>> dependencies = std::nullopt;
 
   kdl_reflect_decl(
-    CompilationRunTool, enabled, toolSpec, parameterSpec, treatNonZeroResultCodeAsError);
+    CompilationRunTool,
+    enabled,
+    toolSpec,
+    parameterSpec,
+    treatNonZeroResultCodeAsError,
+    dependencies);
 };
 
 using CompilationTask = std::variant<
@@ -82,4 +102,8 @@ using CompilationTask = std::variant<
 
 std::ostream& operator<<(std::ostream& lhs, const CompilationTask& rhs);
 
+bool isEnabled(const CompilationTask& task);
+const std::optional<std::vector<size_t>>& dependencies(const CompilationTask& task);
+std::optional<std::vector<size_t>>& dependencies(CompilationTask& task);
+
 } // namespace tb::mdl
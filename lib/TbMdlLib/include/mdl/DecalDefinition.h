@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Result.h"
+#include "el/CompiledExpression.h"
 #include "el/Expression.h"
 
 #include "kd/reflection_decl.h"
@@ -47,6 +48,7 @@ class DecalDefinition
 {
 private:
   el::ExpressionNode m_expression;
+  el::CompiledExpression m_compiledExpression;
 
 public:
   DecalDefinition();
@@ -22,7 +22,9 @@
 #include "Result.h"
 #include "el/Forward.h" // IWYU pragma: keep
 #include "mdl/AssetReference.h"
+#include "mdl/DecalDefinition.h"
 #include "mdl/EntityProperties.h"
+#include "mdl/ModelSpecification.h"
 
 #include "kd/reflection_decl.h"
 
@@ -32,16 +34,15 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace tb::mdl
 {
-struct DecalSpecification;
 class Entity;
 struct EntityDefinition;
 class EntityModel;
 class EntityModelFrame;
-struct ModelSpecification;
 
 enum class SetDefaultPropertyMode
 {
@@ -108,6 +109,16 @@ private:
   mutable std::optional<vm::mat4x4d> m_cachedRotation;
   mutable std::optional<vm::mat4x4d> m_cachedModelTransformation;
 
+  /**
+   * The model and decal specifications are cached together with the keys of the
+   * properties that were read when evaluating them. They are only invalidated when one of
+   * these properties changes or when the definition changes.
+   */
+  mutable std::optional<Result<ModelSpecification>> m_cachedModelSpecification;
+  mutable std::vector<std::string> m_modelSpecificationDependencies;
+  mutable std::optional<Result<DecalSpecification>> m_cachedDecalSpecification;
+  mutable std::vector<std::string> m_decalSpecificationDependencies;
+
 public:
   Entity();
   explicit Entity(std::vector<EntityProperty> properties);
@@ -181,6 +192,10 @@ public: // property management
   std::vector<EntityProperty> numberedProperties(const std::string& property) const;
 
   void transform(const vm::mat4x4d& transformation, bool updateAngleProperty);
+
+private:
+  void invalidateCachedSpecifications();
+  void invalidateCachedSpecifications(std::string_view key);
 };
 
 } // namespace tb::mdl
@@ -19,6 +19,8 @@ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "Macros.h"
+#include "gl/IndexRangeMap.h"
 #include "gl/Material.h"
 #include "mdl/EntityModelDataResource.h"
 #include "mdl/EntityModel_Forward.h"
@@ -27,7 +29,9 @@ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 #include "kd/reflection_decl.h"
 
 #include "vm/bbox.h"
+#include "vm/packed_intersection.h"
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -83,8 +87,27 @@ enum class Orientation
 std::ostream& operator<<(std::ostream& lhs, Orientation rhs);
 
 /**
- * One frame of the model. Since frames are loaded on demand, each frame has two possible
- * states: loaded and unloaded. These states are modeled as subclasses of this class.
+ * The vertices and indices of a frame mesh.
+ */
+struct EntityModelMeshData
+{
+  std::vector<EntityModelVertex> vertices;
+  gl::IndexRangeMap indices;
+};
+
+/**
+ * Decodes the mesh of the frame with the given index. Used by model formats which keep
+ * their undecoded frames in memory and decode them on demand.
+ */
+using LoadEntityModelMesh = std::function<EntityModelMeshData(size_t frameIndex)>;
+
+/**
+ * One frame of the model.
+ *
+ * The triangles used for hit testing are either added when the meshes of the frame are
+ * added, or they are decoded using a mesh loader the first time the frame is
+ * intersected. The spacial tree that speeds up hit testing is only built when the frame
+ * is first intersected.
  */
 class EntityModelFrame
 {
@@ -95,10 +118,11 @@ private:
   size_t m_skinOffset = 0;
 
   // For hit testing
-  std::vector<vm::vec3f> m_tris;
   using TriNum = size_t;
   using SpacialTree = octree<float, TriNum>;
-  SpacialTree m_spacialTree;
+  mutable vm::packed_triangles<float> m_tris;
+  mutable std::unique_ptr<SpacialTree> m_spacialTree;
+  LoadEntityModelMesh m_loadMesh;
 
   kdl_reflect_decl(EntityModelFrame, m_index, m_name, m_bounds, m_skinOffset);
 
@@ -110,6 +134,10 @@ public:
    */
   explicit EntityModelFrame(size_t index, std::string name, const vm::bbox3f& bounds);
 
+  moveOnly(EntityModelFrame);
+
+  ~EntityModelFrame();
+
   /**
    * Returns the index of this frame.
    *
@@ -151,7 +179,18 @@ public:
   std::optional<float> intersect(const vm::ray3f& ray) const;
 
   /**
-   * Adds the given primitives to the spacial tree for this frame.
+   * Sets the mesh loader to decode the triangles of this frame with if it is
+   * intersected and no triangles have been added to it.
+   */
+  void setMeshLoader(LoadEntityModelMesh loadMesh);
+
+  /**
+   * Indicates whether the spacial tree of this frame has been built.
+   */
+  bool hasSpacialTree() const;
+
+  /**
+   * Adds the given primitives to the triangles used for hit testing this frame.
    *
    * @param vertices the vertices
    * @param primType the primitive type
@@ -164,6 +203,9 @@ public:
     gl::PrimType primType,
     size_t index,
     size_t count);
+
+private:
+  void buildSpacialTree() const;
 };
 
 class EntityModelMesh;
@@ -178,11 +220,23 @@ class EntityModelMesh;
  */
 class EntityModelSurface
 {
+public:
+  static constexpr size_t DefaultMaxLoadedMeshes = 16;
+
 private:
   std::string m_name;
-  std::vector<std::unique_ptr<EntityModelMesh>> m_meshes;
+  mutable std::vector<std::unique_ptr<EntityModelMesh>> m_meshes;
   std::unique_ptr<gl::MaterialCollection> m_skins;
 
+  LoadEntityModelMesh m_loadMesh;
+  size_t m_maxLoadedMeshes = DefaultMaxLoadedMeshes;
+
+  /**
+   * The indices of the frames whose meshes were decoded by the mesh loader, the most
+   * recently used one last.
+   */
+  mutable std::vector<size_t> m_loadedMeshFrameIndices;
+
   kdl_reflect_decl(EntityModelSurface, m_name, m_meshes, m_skins);
 
 public:
@@ -239,6 +293,22 @@ public:
     std::vector<EntityModelVertex> vertices,
     gl::MaterialIndexRangeMap indices);
 
+  /**
+   * Makes this surface decode the mesh of a frame using the given mesh loader when the
+   * mesh is first needed for rendering. Only the given number of decoded meshes are kept,
+   * and the least recently used ones are discarded when more meshes are decoded.
+   *
+   * @param loadMesh the mesh loader
+   * @param maxLoadedMeshes the maximum number of decoded meshes to keep
+   */
+  void setMeshLoader(
+    LoadEntityModelMesh loadMesh, size_t maxLoadedMeshes = DefaultMaxLoadedMeshes);
+
+  /**
+   * Returns the number of frame meshes that are currently loaded.
+   */
+  size_t loadedMeshCount() const;
+
   /**
    * Sets the given materials as skins to this surface.
    *
@@ -279,6 +349,9 @@ public:
 
   std::unique_ptr<gl::MaterialIndexRangeRenderer> buildRenderer(
     size_t skinIndex, size_t frameIndex) const;
+
+private:
+  const EntityModelMesh* loadMesh(size_t frameIndex) const;
 };
 
 /**
@@ -457,6 +530,16 @@ public:
   EntityModelData* data();
 
   const EntityModelDataResource& dataResource() const;
+
+  /**
+   * Sets the priority with which the model data is loaded, see gl::ResourcePriority.
+   */
+  void setLoadPriority(int priority) const;
+
+  /**
+   * Blocks until the model data has finished loading in the background.
+   */
+  void waitForLoading() const;
 };
 
 } // namespace mdl
@@ -90,7 +90,18 @@ public:
     Logger& logger);
   ~EntityModelManager();
 
+  /**
+   * Removes all models. Waits until the models that are being loaded in the background
+   * have finished loading, since their loaders refer to the file system.
+   */
   void clear();
+
+  /**
+   * Blocks until all models that are being loaded in the background have finished
+   * loading.
+   */
+  void waitForLoading() const;
+
   void reloadShaders(kdl::task_manager& taskManager);
 
   gl::MaterialRenderer* renderer(const ModelSpecification& spec) const;
@@ -33,9 +33,16 @@ class EntityPropertiesVariableStore : public el::VariableStore
 {
 private:
   const Entity& m_entity;
+  std::vector<std::string>* m_accessedKeys;
 
 public:
-  explicit EntityPropertiesVariableStore(const Entity& entity);
+  /**
+   * Creates a variable store for the properties of the given entity. If a vector of
+   * accessed keys is given, the key of every property that is read from this store or its
+   * clones is added to it.
+   */
+  explicit EntityPropertiesVariableStore(
+    const Entity& entity, std::vector<std::string>* accessedKeys = nullptr);
 
   VariableStore* clone() const override;
   size_t size() const override;
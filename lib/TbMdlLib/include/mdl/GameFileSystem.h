@@ -22,12 +22,18 @@
 #include "fs/VirtualFileSystem.h"
 
 #include <filesystem>
+#include <memory>
 #include <vector>
 
 namespace tb
 {
 class Logger;
 
+namespace fs
+{
+class ZipIndexCache;
+}
+
 namespace mdl
 {
 struct EnvironmentConfig;
@@ -37,6 +43,7 @@ class GameFileSystem : public fs::VirtualFileSystem
 {
 private:
   std::vector<fs::VirtualMountPointId> m_wadMountPoints;
+  std::shared_ptr<fs::ZipIndexCache> m_zipIndexCache;
 
 public:
   void initialize(
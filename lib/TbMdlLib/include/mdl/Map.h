@@ -50,6 +50,7 @@ namespace gl
 {
 class MaterialManager;
 class ResourceManager;
+class TextureCompressor;
 
 struct ProcessContext;
 } // namespace gl
@@ -111,6 +112,7 @@ private:
   std::unique_ptr<EntityDefinitionManager> m_entityDefinitionManager;
   std::unique_ptr<EntityModelManager> m_entityModelManager;
   std::unique_ptr<gl::MaterialManager> m_materialManager;
+  std::shared_ptr<gl::TextureCompressor> m_textureCompressor;
   std::unique_ptr<TagManager> m_tagManager;
 
   std::unique_ptr<EditorContext> m_editorContext;
@@ -147,6 +149,11 @@ private:
   mutable std::optional<vm::bbox3d> m_cachedSelectionBounds;
   std::optional<vm::bbox3d> m_lastSelectionBounds;
 
+  size_t m_nodeChangeBatchDepth = 0;
+  std::vector<Node*> m_batchedChangedNodes;
+  // for every open transaction, whether it opened a node change batch
+  std::vector<bool> m_transactionNodeChangeBatches;
+
 public: // notification
   Notifier<> mapWasSavedNotifier;
 
@@ -165,6 +172,17 @@ public: // notification
   Notifier<const std::vector<Node*>&> nodesWillChangeNotifier;
   Notifier<const std::vector<Node*>&> nodesDidChangeNotifier;
 
+  /**
+   * Notifies about the nodes that changed during a node change batch once the outermost
+   * batch ends. Every changed node is passed exactly once and nodes which were removed
+   * during the batch are omitted. The nodes are sorted by their addresses.
+   *
+   * Outside of a batch, this is notified immediately after nodesDidChangeNotifier.
+   * Long running transactions do not open a batch because the user observes their
+   * intermediate states, e.g. while dragging a tool.
+   */
+  Notifier<const std::vector<Node*>&> batchedNodesDidChangeNotifier;
+
   Notifier<const std::vector<Node*>&> nodeVisibilityDidChangeNotifier;
   Notifier<const std::vector<Node*>&> nodeLockingDidChangeNotifier;
 
@@ -246,6 +264,9 @@ public: // misc
   gl::MaterialManager& materialManager();
   const gl::MaterialManager& materialManager() const;
 
+  gl::TextureCompressor& textureCompressor();
+  const gl::TextureCompressor& textureCompressor() const;
+
   TagManager& tagManager();
   const TagManager& tagManager() const;
 
@@ -288,6 +309,8 @@ public: // misc
                        : std::vector<NodeType*>{};
   }
 
+  std::vector<std::string> findNumberedPropertyValues(std::string_view prefix) const;
+
   const EntityLinkManager& entityLinkManager() const;
 
 public: // game path
@@ -422,9 +445,15 @@ public: // command processing
 
   bool throwExceptionDuringCommand();
 
+  void startNodeChangeBatch();
+  void endNodeChangeBatch();
+
   bool execute(std::unique_ptr<Command>&& command);
   bool executeAndStore(std::unique_ptr<UndoableCommand>&& command);
 
+private:
+  void endTransactionNodeChangeBatch();
+
 private: // observers
   void connectObservers();
   void nodesWereAdded(const std::vector<Node*>& nodes);
@@ -69,7 +69,7 @@ bool removeVertices(
 bool snapVertices(Map& map, double snapTo);
 
 bool csgConvexMerge(Map& map);
-bool csgSubtract(Map& map);
+bool csgSubtract(Map& map, bool mergeFragments = false);
 bool csgIntersect(Map& map);
 bool csgHollow(Map& map);
 
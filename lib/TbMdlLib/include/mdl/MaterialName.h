@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <compare>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace tb::mdl
+{
+struct MaterialNameEntry;
+
+/**
+ * An interned material name.
+ *
+ * All material names are stored in a global, thread safe table, and a material name
+ * only holds a pointer to its table entry. Comparing two material names for equality,
+ * whether case sensitive or not, is therefore a pointer comparison. The entries are
+ * never removed from the table, so the strings returned by str() remain valid for the
+ * lifetime of the program.
+ */
+class MaterialName
+{
+private:
+  const MaterialNameEntry* m_entry;
+
+public:
+  /**
+   * Creates the empty material name.
+   */
+  MaterialName();
+
+  /**
+   * Interns the given name and creates a material name that refers to it.
+   */
+  explicit MaterialName(std::string_view name);
+
+  /**
+   * Returns the material name for the given name if it has already been interned, and
+   * std::nullopt otherwise. Use this to look up names without adding them to the table.
+   */
+  static std::optional<MaterialName> find(std::string_view name);
+
+  const std::string& str() const;
+  bool empty() const;
+
+  /**
+   * Returns the hash of the lower case version of this name. Material names that are
+   * equal when ignoring case have the same hash.
+   */
+  size_t caseInsensitiveHash() const;
+
+  /**
+   * Indicates whether this name is equal to the given name when ignoring case.
+   */
+  bool isEqualIgnoringCase(const MaterialName& other) const;
+
+  /**
+   * Returns the lower case version of this name.
+   */
+  MaterialName toLower() const;
+
+  friend bool operator==(const MaterialName& lhs, const MaterialName& rhs);
+  friend std::strong_ordering operator<=>(
+    const MaterialName& lhs, const MaterialName& rhs);
+
+  friend bool operator==(const MaterialName& lhs, std::string_view rhs);
+
+  friend std::ostream& operator<<(std::ostream& lhs, const MaterialName& rhs);
+};
+
+} // namespace tb::mdl
+
+template <>
+struct std::hash<tb::mdl::MaterialName>
+{
+  size_t operator()(const tb::mdl::MaterialName& materialName) const noexcept
+  {
+    return std::hash<const void*>{}(&materialName.str());
+  }
+};
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Result.h"
+#include "el/CompiledExpression.h"
 #include "el/Expression.h"
 #include "mdl/ModelSpecification.h"
 
@@ -48,6 +49,7 @@ class ModelDefinition
 {
 private:
   el::ExpressionNode m_expression;
+  el::CompiledExpression m_compiledExpression;
 
 public:
   ModelDefinition();
@@ -0,0 +1,48 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+
+namespace tb::mdl
+{
+class Map;
+
+/**
+ * Defers the batched node change notification of the given map until the outermost
+ * batch ends. Every transaction and every undo or redo runs in a batch, so this is only
+ * needed to coalesce changes across several commands that are not part of one
+ * transaction.
+ *
+ * See Map::batchedNodesDidChangeNotifier.
+ */
+class NodeChangeBatch
+{
+private:
+  Map& m_map;
+
+public:
+  explicit NodeChangeBatch(Map& map);
+  ~NodeChangeBatch();
+
+  deleteCopyAndMove(NodeChangeBatch);
+};
+
+} // namespace tb::mdl
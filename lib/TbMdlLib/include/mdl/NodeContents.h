@@ -25,6 +25,7 @@
 #include "mdl/Group.h"
 #include "mdl/Layer.h"
 
+#include <unordered_set>
 #include <variant>
 
 namespace tb::mdl
@@ -44,6 +45,13 @@ public:
 
   const std::variant<Layer, Group, Entity, Brush, BezierPatch>& get() const;
   std::variant<Layer, Group, Entity, Brush, BezierPatch>& get();
+
+  /**
+   * Returns an estimate of the number of bytes used by the contents. Brush geometry is
+   * only counted once, see Brush::memoryFootprint.
+   */
+  size_t memoryFootprint(
+    std::unordered_set<const BrushGeometry*>& countedGeometries) const;
 };
 
 } // namespace tb::mdl
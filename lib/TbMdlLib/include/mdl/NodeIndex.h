@@ -21,8 +21,11 @@
 
 #include "kd/compact_trie_forward.h"
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace tb::mdl
@@ -31,10 +34,33 @@ class Node;
 
 using NodeStringIndex = kdl::compact_trie<Node*>;
 
+struct NodeIndexStringHash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view str) const noexcept;
+};
+
+template <typename T>
+using NodeIndexStringMap =
+  std::unordered_map<std::string, T, NodeIndexStringHash, std::equal_to<>>;
+
+/**
+ * Maps entity property keys to their values and each value to the nodes that have a
+ * property with that key and value.
+ */
+using NodePropertyIndex = NodeIndexStringMap<NodeIndexStringMap<std::vector<Node*>>>;
+
+/**
+ * Indexes nodes by the strings they contain. Every string is added to a trie that
+ * supports wildcard search. Entity properties are additionally stored in a structured
+ * index that answers exact key / value queries without matching patterns.
+ */
 class NodeIndex
 {
 private:
   std::unique_ptr<NodeStringIndex> m_index;
+  NodePropertyIndex m_propertyIndex;
 
 public:
   NodeIndex();
@@ -43,19 +69,73 @@ public:
   void addNode(Node& node);
   void removeNode(Node& node);
 
+  /**
+   * Adds the given nodes, but not their descendants. This is more efficient than adding
+   * the nodes one by one.
+   */
+  void addNodes(const std::vector<Node*>& nodes);
+
+  /**
+   * Removes the given nodes, but not their descendants. This is more efficient than
+   * removing the nodes one by one.
+   */
+  void removeNodes(const std::vector<Node*>& nodes);
+
   void clear();
 
+  /**
+   * Returns the nodes that have a property with the given key and value.
+   */
+  template <typename NodeType = Node>
+  std::vector<NodeType*> findNodesWithProperty(
+    const std::string_view key, const std::string_view value) const
+  {
+    return filterNodes<NodeType>(doFindNodesWithProperty(key, value));
+  }
+
+  /**
+   * Returns the nodes that have a property with the given value, regardless of its key.
+   */
+  template <typename NodeType = Node>
+  std::vector<NodeType*> findNodesWithPropertyValue(const std::string_view value) const
+  {
+    return filterNodes<NodeType>(doFindNodesWithPropertyValue(value));
+  }
+
+  /**
+   * Returns the nodes that have a numbered property with the given prefix and value,
+   * e.g. "target", "target1" or "target2" for the prefix "target".
+   */
+  template <typename NodeType = Node>
+  std::vector<NodeType*> findNodesWithNumberedProperty(
+    const std::string_view prefix, const std::string_view value) const
+  {
+    return filterNodes<NodeType>(doFindNodesWithNumberedProperty(prefix, value));
+  }
+
+  /**
+   * Returns the sorted values of all numbered properties with the given prefix.
+   */
+  std::vector<std::string> findNumberedPropertyValues(std::string_view prefix) const;
+
   template <typename NodeType = Node>
   std::vector<NodeType*> findNodes(const std::string_view pattern) const
+  {
+    return filterNodes<NodeType>(doFindNodes(pattern));
+  }
+
+private:
+  template <typename NodeType>
+  static std::vector<NodeType*> filterNodes(std::vector<Node*> nodes)
   {
     if constexpr (std::is_same_v<NodeType, Node>)
     {
-      return doFindNodes(pattern);
+      return nodes;
     }
     else
     {
       auto result = std::vector<NodeType*>{};
-      for (auto* node : doFindNodes(pattern))
+      for (auto* node : nodes)
       {
         if (auto* nodeWithType = dynamic_cast<NodeType*>(node))
         {
@@ -66,8 +146,12 @@ public:
     }
   }
 
-private:
   std::vector<Node*> doFindNodes(std::string_view pattern) const;
+  std::vector<Node*> doFindNodesWithProperty(
+    std::string_view key, std::string_view value) const;
+  std::vector<Node*> doFindNodesWithPropertyValue(std::string_view value) const;
+  std::vector<Node*> doFindNodesWithNumberedProperty(
+    std::string_view prefix, std::string_view value) const;
 };
 
 } // namespace tb::mdl
@@ -21,8 +21,10 @@
 
 #include "kd/contracts.h"
 #include "kd/overload.h"
+#include "kd/ranges/to.h"
 #include "kd/reflection_decl.h"
 #include "kd/reflection_impl.h"
+#include "kd/task_manager.h"
 #include "kd/vector_utils.h"
 
 #include "vm/bbox.h"
@@ -34,8 +36,13 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <functional>
+#include <iterator>
 #include <optional>
+#include <ranges>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -90,6 +97,14 @@ node_address get_root(const node_address& address);
 
 node_address get_container(const node_address& address1, const node_address& address2);
 
+/**
+ * Returns the Morton code of the min corner of the given address. The codes of all
+ * addresses contained in a non-root address a form the contiguous range
+ * [get_morton_code(a), get_morton_code(a) + 8^a.size), and the children of a are ordered
+ * by their quadrant index within that range.
+ */
+std::uint64_t get_morton_code(const node_address& address);
+
 template <typename T>
 node_address get_container(const vm::bbox<T, 3>& bounds, const T min_size)
 {
@@ -362,6 +377,195 @@ private:
       node);
   }
 
+  struct build_entry
+  {
+    std::uint64_t code;
+    detail::node_address address;
+    U data;
+  };
+
+  using build_entry_iterator = typename std::vector<build_entry>::iterator;
+
+  // Orders the entries by Morton code so that the entries contained in any node form a
+  // contiguous range, and puts larger addresses first so that a node's own data precedes
+  // the data of its descendants.
+  static bool compare_build_entries(const build_entry& lhs, const build_entry& rhs)
+  {
+    return lhs.code < rhs.code
+           || (lhs.code == rhs.code && lhs.address.size > rhs.address.size);
+  }
+
+  static void sort_build_entries(
+    std::vector<build_entry>& entries, kdl::task_manager& task_manager)
+  {
+    constexpr auto min_chunk_size = std::size_t(1) << 14;
+
+    const auto max_chunk_count =
+      std::max(std::size_t(1), std::size_t(std::thread::hardware_concurrency()));
+    const auto chunk_count =
+      std::clamp(entries.size() / min_chunk_size, std::size_t(1), max_chunk_count);
+
+    auto chunk_bounds = std::vector<std::size_t>{};
+    for (std::size_t i = 0; i <= chunk_count; ++i)
+    {
+      chunk_bounds.push_back(entries.size() * i / chunk_count);
+    }
+
+    const auto at = [&](const std::size_t i) {
+      return entries.begin() + std::ptrdiff_t(chunk_bounds[i]);
+    };
+
+    // sort the chunks in parallel, then merge adjacent chunks pairwise until one remains
+    const auto chunks =
+      std::views::iota(std::size_t(0), chunk_count) | kdl::ranges::to<std::vector>();
+    auto sort_tasks = chunks | std::views::transform([&](const auto i) {
+                        return std::function{[&, i]() {
+                          std::stable_sort(at(i), at(i + 1), compare_build_entries);
+                          return i;
+                        }};
+                      });
+    task_manager.run_tasks_and_wait(sort_tasks);
+
+    while (chunk_bounds.size() > 2)
+    {
+      const auto merges =
+        std::views::iota(std::size_t(0), (chunk_bounds.size() - 1) / 2)
+        | kdl::ranges::to<std::vector>();
+      auto merge_tasks = merges | std::views::transform([&](const auto i) {
+                           return std::function{[&, i]() {
+                             std::inplace_merge(
+                               at(2 * i),
+                               at(2 * i + 1),
+                               at(2 * i + 2),
+                               compare_build_entries);
+                             return i;
+                           }};
+                         });
+      task_manager.run_tasks_and_wait(merge_tasks);
+
+      auto merged_bounds = std::vector<std::size_t>{};
+      for (std::size_t i = 0; i < chunk_bounds.size(); i += 2)
+      {
+        merged_bounds.push_back(chunk_bounds[i]);
+      }
+      if (merged_bounds.back() != chunk_bounds.back())
+      {
+        merged_bounds.push_back(chunk_bounds.back());
+      }
+      chunk_bounds = std::move(merged_bounds);
+    }
+  }
+
+  node build_node(build_entry_iterator first, const build_entry_iterator last)
+  {
+    contract_pre(first != last);
+
+    const auto address = get_container(first->address, std::prev(last)->address);
+
+    auto data = std::vector<U>{};
+    for (; first != last && first->address == address; ++first)
+    {
+      contract_assert(m_node_address_for_data.emplace(first->data, address).second);
+      data.push_back(std::move(first->data));
+    }
+
+    if (first == last)
+    {
+      return leaf_node{address, std::move(data)};
+    }
+    return inner_node{address, std::move(data), build_children(address, first, last)};
+  }
+
+  std::vector<node> build_children(
+    const detail::node_address& address,
+    build_entry_iterator first,
+    const build_entry_iterator last)
+  {
+    auto children = std::vector<node>{};
+    children.reserve(8);
+
+    for (std::size_t quadrant = 0; quadrant < 8; ++quadrant)
+    {
+      const auto child_address = get_child(address, quadrant);
+      const auto child_end = detail::get_morton_code(child_address)
+                             + (std::uint64_t(1) << (3 * child_address.size));
+      const auto child_last = std::partition_point(
+        first, last, [&](const auto& entry) { return entry.code < child_end; });
+
+      if (first == child_last)
+      {
+        children.emplace_back(leaf_node{child_address, {}});
+      }
+      else
+      {
+        children.push_back(build_node(first, child_last));
+      }
+      first = child_last;
+    }
+
+    contract_assert(first == last);
+    return children;
+  }
+
+  template <typename Sort>
+  void build_sorted(std::vector<std::pair<vm::bbox<T, 3>, U>> items, const Sort& sort)
+  {
+    clear();
+    if (items.empty())
+    {
+      return;
+    }
+
+    m_node_address_for_data.reserve(items.size());
+
+    auto root_address = std::optional<detail::node_address>{};
+    auto root_data = std::vector<U>{};
+    auto entries = std::vector<build_entry>{};
+    entries.reserve(items.size());
+
+    // grow the root address like insert does
+    const auto expand_root = [&](const detail::node_address& address) {
+      if (!root_address || !root_address->contains(address))
+      {
+        root_address = is_root(address) ? address : get_root(address);
+      }
+    };
+
+    for (auto& [bounds, data] : items)
+    {
+      contract_pre(!vm::is_nan(bounds.min) && !vm::is_nan(bounds.max));
+
+      const auto address = detail::get_container(bounds, m_min_size);
+      expand_root(address);
+      if (is_root(address))
+      {
+        root_data.push_back(std::move(data));
+      }
+      else
+      {
+        entries.push_back({detail::get_morton_code(address), address, std::move(data)});
+      }
+    }
+
+    for (const auto& data : root_data)
+    {
+      contract_assert(m_node_address_for_data.emplace(data, *root_address).second);
+    }
+
+    if (entries.empty())
+    {
+      m_root = leaf_node{*root_address, std::move(root_data)};
+    }
+    else
+    {
+      sort(entries);
+      m_root = inner_node{
+        *root_address,
+        std::move(root_data),
+        build_children(*root_address, entries.begin(), entries.end())};
+    }
+  }
+
 private:
   std::optional<node> m_root;
   T m_min_size;
@@ -458,6 +662,39 @@ public:
     return true;
   }
 
+  /**
+   * Clears this tree and builds it from the given bounds and data.
+   *
+   * Instead of inserting the items one by one, the items are sorted by the Morton codes
+   * of their addresses and the tree is built from the sorted items in one pass. The
+   * resulting tree answers all queries like a tree into which the items were inserted
+   * individually, but it is built much faster for large numbers of items.
+   *
+   * The given data must be unique.
+   *
+   * @param items the bounds and data to build the tree from
+   */
+  void build(std::vector<std::pair<vm::bbox<T, 3>, U>> items)
+  {
+    build_sorted(std::move(items), [](auto& entries) {
+      std::ranges::stable_sort(entries, compare_build_entries);
+    });
+  }
+
+  /**
+   * Clears this tree and builds it from the given bounds and data, sorting the items in
+   * parallel using the given task manager.
+   *
+   * @param items the bounds and data to build the tree from
+   * @param task_manager the task manager to use for sorting
+   */
+  void build(
+    std::vector<std::pair<vm::bbox<T, 3>, U>> items, kdl::task_manager& task_manager)
+  {
+    build_sorted(std::move(items), [&](auto& entries) {
+      sort_build_entries(entries, task_manager);
+    });
+  }
 
   /**
    * Removes the node with the given data from this tree.
@@ -633,6 +870,36 @@ public:
     }
   }
 
+  /**
+   * Finds every data item in this tree that is stored in a node whose bounds satisfy the
+   * given predicate and appends it to the given output iterator.
+   *
+   * The children of a node are only visited if the node's bounds satisfy the predicate,
+   * so the predicate must hold for a node's bounds whenever it holds for the bounds of
+   * any of its descendants.
+   *
+   * @tparam P the predicate type, a unary function that accepts a bounding box
+   * @tparam O the output iterator type
+   * @param predicate the predicate to apply to the node bounds
+   * @param out the output iterator to append to
+   */
+  template <typename P, typename O>
+  void find_if(const P& predicate, O out) const
+  {
+    if (m_root)
+    {
+      visit_node_if(
+        *m_root,
+        [&](const auto& node) {
+          const auto& data = get_data(node);
+          std::ranges::copy(data, out);
+        },
+        [&](const auto& node) {
+          return predicate(get_address(node).to_bounds(m_min_size));
+        });
+    }
+  }
+
   kdl_reflect_inline(octree, m_root, m_min_size, m_node_address_for_data);
 };
 
@@ -56,12 +56,34 @@ struct PatchGrid
   std::vector<Point> points;
   vm::bbox3d bounds;
 
+  /**
+   * The number of times each surface of the patch was subdivided to make this grid, and
+   * the flatness error of the patch, see computePatchFlatnessError.
+   */
+  size_t subdivisionsPerSurface = 0;
+  double flatnessError = 0.0;
+
   const Point& point(size_t row, size_t col) const;
 
   size_t quadRowCount() const;
   size_t quadColumnCount() const;
 
-  kdl_reflect_decl(PatchGrid, pointRowCount, pointColumnCount, points, bounds);
+  /**
+   * Returns the stride with which the points of this grid can be sampled such that the
+   * sampled grid deviates from the patch by no more than the given error. The stride is
+   * a power of two and at most 2^subdivisionsPerSurface, so that the sampled grid always
+   * contains the corners of every surface.
+   */
+  size_t lodStride(double maxError) const;
+
+  kdl_reflect_decl(
+    PatchGrid,
+    pointRowCount,
+    pointColumnCount,
+    points,
+    bounds,
+    subdivisionsPerSurface,
+    flatnessError);
 };
 
 // public for testing
@@ -70,9 +92,34 @@ std::vector<vm::vec3d> computeGridNormals(
   size_t pointRowCount,
   size_t pointColumnCount);
 
+/**
+ * Returns an upper bound of the distance between the given patch and the triangles made
+ * of the corners of its surfaces. Every subdivision of the surfaces reduces this distance
+ * by a factor of four.
+ *
+ * The error of the texture coordinates is included, weighted such that patches whose
+ * texture coordinates are not interpolated linearly across the triangles are subdivided
+ * as well.
+ */
+double computePatchFlatnessError(const BezierPatch& patch);
+
+/**
+ * Returns the smallest number of subdivisions per surface (but at most
+ * maxSubdivisionsPerSurface) such that the grid deviates from a patch with the given
+ * flatness error by no more than maxError.
+ */
+size_t computeSubdivisionsPerSurface(
+  double flatnessError, double maxError, size_t maxSubdivisionsPerSurface);
+
 // public for testing
 PatchGrid makePatchGrid(const BezierPatch& patch, size_t subdivisionsPerSurface);
 
+/**
+ * Makes a grid for the given patch, subdividing its surfaces only as often as its
+ * curvature requires.
+ */
+PatchGrid makePatchGrid(const BezierPatch& patch);
+
 class PatchNode : public Node, public Object
 {
 public:
@@ -91,6 +138,12 @@ public:
   const BezierPatch& patch() const;
   BezierPatch setPatch(BezierPatch patch);
 
+  /**
+   * Sets the patch with a grid that was already made for it, e.g. in parallel with the
+   * grids of other patches.
+   */
+  BezierPatch setPatch(BezierPatch patch, PatchGrid grid);
+
   void setMaterial(gl::Material* material);
 
   const PatchGrid& grid() const;
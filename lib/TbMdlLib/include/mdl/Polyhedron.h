@@ -1138,6 +1138,7 @@ public:
 
 private:
   static constexpr const auto MinEdgeLength = T(0.01);
+  static constexpr const auto MinPointCountForExtremePoints = size_t(32);
 
 public:
   using Vertex = Polyhedron_Vertex<T, FP, VP>;
@@ -1571,7 +1572,7 @@ public: // General purpose methods
    */
   Face* findClosestFace(
     const std::vector<vm::vec<T, 3>>& positions,
-    T maxDistance = std::numeric_limits<T>::max());
+    T maxDistance = std::numeric_limits<T>::max()) const;
 
 private:
   /**
@@ -1714,9 +1715,11 @@ private: // Convex hull; adding and removing points
    * polyhedron is that the resulting polyhedron is the convex hull of the union of the
    * polyhedron's vertices and the given points.
    *
-   * Duplicates in the given vector are discarded. Furthermore, the remaining points are
-   * sorted in descending order of their distance from the center of their bounding box.
-   * Therefore, the result of calling this method is different from the result of
+   * Duplicates in the given vector are discarded, and so are points which are closer than
+   * MinEdgeLength to another given point. For large point sets, the hull of the extreme
+   * points is built first, and points contained in it are discarded. The remaining points
+   * are added in descending order of their distance from the center of that hull.
+   * Therefore, the result of calling this method may be different from the result of
    * repeatedly calling addPoint() for every point in the given vector.
    *
    * @param points the points to add to this polyhedron
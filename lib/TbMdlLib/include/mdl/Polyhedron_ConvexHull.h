@@ -31,6 +31,7 @@
 #include "vm/segment.h"
 #include "vm/util.h"
 
+#include <algorithm>
 #include <list>
 #include <unordered_set>
 #include <vector>
@@ -52,6 +53,71 @@ T computePlaneEpsilon(const std::vector<vm::vec<T, 3>>& points)
     vm::get_max_component(size) / T(10) * vm::constants<T>::point_status_epsilon();
   return std::max(computedEpsilon, defaultEpsilon);
 }
+
+/**
+ * Removes every point that is closer than the given distance to a point that precedes it.
+ * Expects the given points to be sorted, i.e. in ascending order of their X coordinates.
+ */
+template <typename T>
+std::vector<vm::vec<T, 3>> removeNearDuplicates(
+  std::vector<vm::vec<T, 3>> points, const T minDistance)
+{
+  auto result = std::vector<vm::vec<T, 3>>{};
+  result.reserve(points.size());
+
+  for (const auto& point : points)
+  {
+    // only the last few points can be close enough since the points are sorted by X
+    const auto isNearDuplicate = std::any_of(
+      result.rbegin(),
+      std::find_if(
+        result.rbegin(),
+        result.rend(),
+        [&](const auto& other) { return point.x() - other.x() >= minDistance; }),
+      [&](const auto& other) { return vm::distance(point, other) < minDistance; });
+
+    if (!isNearDuplicate)
+    {
+      result.push_back(point);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * Returns the indices of the points that are extremal along the coordinate axes and the
+ * diagonals of the unit cube. These points lie on the boundary of the convex hull of the
+ * given points.
+ */
+template <typename T>
+std::vector<size_t> findExtremePoints(const std::vector<vm::vec<T, 3>>& points)
+{
+  static const auto directions = std::vector<vm::vec<T, 3>>{
+    {1, 0, 0},
+    {0, 1, 0},
+    {0, 0, 1},
+    {1, 1, 1},
+    {1, 1, -1},
+    {1, -1, 1},
+    {1, -1, -1},
+  };
+
+  auto result = std::vector<size_t>{};
+  result.reserve(2 * directions.size());
+
+  for (const auto& direction : directions)
+  {
+    const auto [min, max] = std::minmax_element(
+      points.begin(), points.end(), [&](const auto& lhs, const auto& rhs) {
+        return vm::dot(lhs, direction) < vm::dot(rhs, direction);
+      });
+    result.push_back(size_t(std::distance(points.begin(), min)));
+    result.push_back(size_t(std::distance(points.begin(), max)));
+  }
+
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
 } // namespace detail
 
 template <typename T, typename FP, typename VP>
@@ -60,8 +126,35 @@ void Polyhedron<T, FP, VP>::addPoints(std::vector<vm::vec<T, 3>> points)
   if (!points.empty())
   {
     points = kdl::vec_sort_and_remove_duplicates(std::move(points));
+    points = detail::removeNearDuplicates(std::move(points), MinEdgeLength);
 
     const auto planeEpsilon = detail::computePlaneEpsilon(points);
+
+    if (points.size() >= MinPointCountForExtremePoints)
+    {
+      // Start with the hull of the extreme points. It is usually large enough to contain
+      // most of the remaining points, which can then be discarded without modifying the
+      // polyhedron.
+      for (const auto index : detail::findExtremePoints(points))
+      {
+        addPoint(points[index], planeEpsilon);
+      }
+
+      // This also removes the extreme points, which are already vertices.
+      if (polyhedron())
+      {
+        std::erase_if(
+          points, [&](const auto& point) { return contains(point, planeEpsilon); });
+      }
+
+      // Add the farthest points first so that the hull grows quickly and fewer of the
+      // remaining points create vertices which are later removed again.
+      const auto center = bounds().center();
+      std::sort(points.begin(), points.end(), [&](const auto& lhs, const auto& rhs) {
+        return vm::squared_distance(lhs, center) > vm::squared_distance(rhs, center);
+      });
+    }
+
     for (const auto& point : points)
     {
       addPoint(point, planeEpsilon);
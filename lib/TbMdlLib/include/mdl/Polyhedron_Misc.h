@@ -723,7 +723,7 @@ typename Polyhedron<T, FP, VP>::Face* Polyhedron<T, FP, VP>::findFaceByPositions
 
 template <typename T, typename FP, typename VP>
 typename Polyhedron<T, FP, VP>::Face* Polyhedron<T, FP, VP>::findClosestFace(
-  const std::vector<vm::vec<T, 3>>& positions, const T maxDistance)
+  const std::vector<vm::vec<T, 3>>& positions, const T maxDistance) const
 {
   auto closestDistance = maxDistance;
   Face* closestFace = nullptr;
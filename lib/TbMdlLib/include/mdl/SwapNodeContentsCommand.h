@@ -46,6 +46,8 @@ public:
 
   bool doCollateWith(UndoableCommand& command) override;
 
+  size_t memoryFootprint() const override;
+
   deleteCopyAndMove(SwapNodeContentsCommand);
 };
 
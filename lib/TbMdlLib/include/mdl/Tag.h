@@ -30,9 +30,15 @@
 #include <string>
 #include <vector>
 
+namespace tb::gl
+{
+class Material;
+}
+
 namespace tb::mdl
 {
 class ConstTagVisitor;
+class MaterialName;
 class TagManager;
 class TagVisitor;
 
@@ -270,6 +276,37 @@ public:
   virtual size_t selectOption(const std::vector<std::string>& options) = 0;
 };
 
+/**
+ * Describes which properties of a brush face decide whether a tag matcher matches it.
+ * This allows the tag manager to evaluate a matcher once per material or per flag bit
+ * instead of once per brush face.
+ */
+enum class BrushFaceTagDependency
+{
+  /**
+   * The matcher never matches a brush face.
+   */
+  None,
+  /**
+   * The matcher only depends on the face's material name (ignoring case) and material.
+   */
+  Material,
+  /**
+   * The matcher only depends on the face's resolved surface contents, and it matches
+   * if it matches any of the bits set in them.
+   */
+  SurfaceContents,
+  /**
+   * The matcher only depends on the face's resolved surface flags, and it matches if it
+   * matches any of the bits set in them.
+   */
+  SurfaceFlags,
+  /**
+   * The matcher must be evaluated against each face.
+   */
+  Face,
+};
+
 /**
  * Decides whether a taggable object should be tagged with a particular smart tag.
  */
@@ -322,6 +359,29 @@ public:
    */
   virtual bool canDisable() const;
 
+  /**
+   * Returns which properties of a brush face this matcher depends on. The default
+   * implementation returns BrushFaceTagDependency::Face.
+   */
+  virtual BrushFaceTagDependency brushFaceTagDependency() const;
+
+  /**
+   * Evaluates this matcher against a brush face with the given material. Only called if
+   * this matcher depends on BrushFaceTagDependency::Material.
+   *
+   * @param lowerCaseMaterialName the lower case name of the material
+   * @param material the material, can be null
+   */
+  virtual bool matchesBrushFaceMaterial(
+    const MaterialName& lowerCaseMaterialName, const gl::Material* material) const;
+
+  /**
+   * Evaluates this matcher against a brush face with the given surface contents or
+   * surface flags. Only called if this matcher depends on
+   * BrushFaceTagDependency::SurfaceContents or BrushFaceTagDependency::SurfaceFlags.
+   */
+  virtual bool matchesBrushFaceFlags(int flags) const;
+
   /**
    * Returns a new copy of this tag matcher.
    */
@@ -359,6 +419,11 @@ public:
   SmartTag& operator=(const SmartTag& other);
   SmartTag& operator=(SmartTag&& other);
 
+  /**
+   * Returns the matcher of this smart tag.
+   */
+  const TagMatcher& matcher() const;
+
   /**
    * Indicates whether this smart tag matches the given taggable.
    *
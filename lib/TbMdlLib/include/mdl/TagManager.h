@@ -19,14 +19,24 @@
 
 #pragma once
 
+#include "mdl/MaterialName.h"
 #include "mdl/Tag.h"
+#include "mdl/TagType.h"
 
 #include "kd/vector_set.h"
 
+#include <array>
 #include <string>
+#include <unordered_map>
+
+namespace tb::gl
+{
+class Material;
+}
 
 namespace tb::mdl
 {
+class BrushFace;
 
 /**
  * Manages the tags used in a document and updates smart tags on taggable objects.
@@ -42,8 +52,45 @@ private:
     bool operator()(const std::string& lhs, const std::string& rhs) const;
   };
 
+  struct MaterialKey
+  {
+    MaterialName lowerCaseMaterialName;
+    const gl::Material* material;
+
+    bool operator==(const MaterialKey& other) const = default;
+  };
+
+  struct MaterialKeyHash
+  {
+    size_t operator()(const MaterialKey& key) const;
+  };
+
+  static constexpr auto FlagBits = sizeof(int) * 8;
+
   kdl::vector_set<SmartTag, TagCmp> m_smartTags;
 
+  /**
+   * The tags which must be evaluated against every brush face.
+   */
+  TagType::Type m_faceTags = TagType::NoType;
+
+  /**
+   * The tags which depend on a brush face's material, and the tags that have been
+   * computed for each material so far.
+   */
+  TagType::Type m_materialTags = TagType::NoType;
+  mutable std::unordered_map<MaterialKey, TagType::Type, MaterialKeyHash>
+    m_materialTagsCache;
+
+  /**
+   * For each bit of the surface contents and surface flags, the tags that match if the
+   * bit is set.
+   */
+  TagType::Type m_surfaceContentsTags = TagType::NoType;
+  std::array<TagType::Type, FlagBits> m_surfaceContentsTagsPerBit = {};
+  TagType::Type m_surfaceFlagsTags = TagType::NoType;
+  std::array<TagType::Type, FlagBits> m_surfaceFlagsTagsPerBit = {};
+
 public:
   /**
    * Returns a vector containing all smart tags registered with this manager.
@@ -113,8 +160,26 @@ public:
    */
   void updateTags(Taggable& taggable) const;
 
+  /**
+   * Update the smart tags of the given brush face. The tags are computed from the tags
+   * that were precomputed for the face's material and for the bits of its surface
+   * contents and flags, and only the matchers that depend on other properties of the
+   * face are evaluated.
+   *
+   * @param face the face to update
+   */
+  void updateTags(BrushFace& face) const;
+
+  /**
+   * Discards the tags computed for each material. Must be called whenever the materials
+   * are reloaded.
+   */
+  void clearMaterialTagsCache();
+
 private:
   size_t freeTagIndex();
+  void indexSmartTags();
+  TagType::Type materialTags(const BrushFace& face) const;
 };
 
 } // namespace tb::mdl
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "mdl/MaterialName.h"
 #include "mdl/Tag.h"
 #include "mdl/TagVisitor.h"
 #include "mdl/UpdateBrushFaceAttributes.h"
@@ -28,8 +29,10 @@
 #include <functional>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace tb
@@ -63,10 +66,21 @@ class MaterialNameTagMatcher : public MaterialTagMatcher
 private:
   std::string m_pattern;
 
+  /**
+   * Caches the match result for each lower case material name, since the pattern is
+   * matched ignoring case.
+   */
+  mutable std::mutex m_matchCacheMutex;
+  mutable std::unordered_map<MaterialName, bool> m_matchCache;
+
 public:
   explicit MaterialNameTagMatcher(std::string pattern);
   std::unique_ptr<TagMatcher> clone() const override;
   bool matches(const Taggable& taggable) const override;
+  BrushFaceTagDependency brushFaceTagDependency() const override;
+  bool matchesBrushFaceMaterial(
+    const MaterialName& lowerCaseMaterialName,
+    const gl::Material* material) const override;
   void appendToStream(std::ostream& str) const override;
 
 private:
@@ -84,6 +98,10 @@ public:
   explicit SurfaceParmTagMatcher(kdl::vector_set<std::string> parameters);
   std::unique_ptr<TagMatcher> clone() const override;
   bool matches(const Taggable& taggable) const override;
+  BrushFaceTagDependency brushFaceTagDependency() const override;
+  bool matchesBrushFaceMaterial(
+    const MaterialName& lowerCaseMaterialName,
+    const gl::Material* material) const override;
   void appendToStream(std::ostream& str) const override;
 
 private:
@@ -115,6 +133,7 @@ protected:
 
 public:
   bool matches(const Taggable& taggable) const override;
+  bool matchesBrushFaceFlags(int flags) const override;
   void enable(TagMatcherCallback& callback, Map& map) const override;
   void disable(TagMatcherCallback& callback, Map& map) const override;
   bool canEnable() const override;
@@ -127,6 +146,7 @@ class ContentFlagsTagMatcher : public FlagsTagMatcher
 public:
   explicit ContentFlagsTagMatcher(int flags);
   std::unique_ptr<TagMatcher> clone() const override;
+  BrushFaceTagDependency brushFaceTagDependency() const override;
 };
 
 class SurfaceFlagsTagMatcher : public FlagsTagMatcher
@@ -134,6 +154,7 @@ class SurfaceFlagsTagMatcher : public FlagsTagMatcher
 public:
   explicit SurfaceFlagsTagMatcher(int flags);
   std::unique_ptr<TagMatcher> clone() const override;
+  BrushFaceTagDependency brushFaceTagDependency() const override;
 };
 
 class EntityClassNameTagMatcher : public TagMatcher
@@ -151,6 +172,7 @@ public:
 
 public:
   bool matches(const Taggable& taggable) const override;
+  BrushFaceTagDependency brushFaceTagDependency() const override;
   void enable(TagMatcherCallback& callback, Map& map) const override;
   void disable(TagMatcherCallback& callback, Map& map) const override;
   bool canEnable() const override;
@@ -45,6 +45,12 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the number of bytes this command keeps alive while it is on
+   * the undo stack. The default implementation only accounts for the command itself.
+   */
+  virtual size_t memoryFootprint() const;
+
 protected:
   virtual bool doPerformUndo(Map& map) = 0;
 
@@ -22,6 +22,7 @@
 #include "gl/Camera.h"
 #include "mdl/BrushNode.h"
 #include "mdl/HitType.h"
+#include "mdl/Octree.h"
 #include "mdl/PickResult.h"
 
 #include "kd/contracts.h"
@@ -29,6 +30,15 @@
 #include "kd/ranges/to.h"
 #include "kd/vector_utils.h"
 
+#include "vm/bbox.h"
+#include "vm/intersection.h"
+#include "vm/polygon.h"
+#include "vm/ray.h"
+#include "vm/segment.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <map>
 #include <ranges>
@@ -45,6 +55,27 @@ namespace mdl
 {
 class Grid;
 
+namespace detail
+{
+
+inline vm::bbox3d handleBounds(const vm::vec3d& handle)
+{
+  return vm::bbox3d{handle, handle};
+}
+
+inline vm::bbox3d handleBounds(const vm::segment3d& handle)
+{
+  return vm::bbox3d{
+    vm::min(handle.start(), handle.end()), vm::max(handle.start(), handle.end())};
+}
+
+inline vm::bbox3d handleBounds(const vm::polygon3d& handle)
+{
+  return vm::bbox3d::merge_all(handle.vertices().begin(), handle.vertices().end());
+}
+
+} // namespace detail
+
 class VertexHandleManagerBase
 {
 public:
@@ -144,10 +175,25 @@ protected:
     void dec() { --count; }
   };
 
+  using HandleMap = std::map<H, HandleInfo>;
+  using HandleEntry = typename HandleMap::value_type;
+
+  /**
+   * The minimum size of the nodes of the handle tree.
+   */
+  static constexpr auto HandleTreeMinSize = 128.0;
+
   /**
    * Maps a handle position to its info.
    */
-  std::map<H, HandleInfo> m_handles;
+  HandleMap m_handles;
+
+  /**
+   * Spatial index of the entries of m_handles, keyed by the bounds of each handle. It is
+   * updated whenever a handle is added or removed and lets picking and selection avoid
+   * visiting every handle.
+   */
+  octree<double, HandleEntry*> m_handleTree{HandleTreeMinSize};
 
   /**
    * The total number of selected handles, not counting duplicates.
@@ -155,6 +201,12 @@ protected:
   size_t m_selectedHandleCount = 0;
 
 public:
+  VertexHandleManagerBaseT() = default;
+
+  // the handle tree stores pointers into m_handles
+  VertexHandleManagerBaseT(const VertexHandleManagerBaseT&) = delete;
+  VertexHandleManagerBaseT& operator=(const VertexHandleManagerBaseT&) = delete;
+
   ~VertexHandleManagerBaseT() override = default;
 
 public:
@@ -287,8 +339,14 @@ public:
    */
   void add(const Handle& handle)
   {
-    m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo
-                             // means its default constructor is called
+    // unknown value gets value constructed, which for HandleInfo means its default
+    // constructor is called
+    const auto [it, inserted] = m_handles.try_emplace(handle);
+    if (inserted)
+    {
+      m_handleTree.insert(detail::handleBounds(it->first), &*it);
+    }
+    it->second.inc();
   }
 
   /**
@@ -308,6 +366,7 @@ public:
       if (info.count == 0)
       {
         deselect(info);
+        m_handleTree.remove(&*it);
         m_handles.erase(it);
       }
       return true;
@@ -321,6 +380,7 @@ public:
    */
   void clear()
   {
+    m_handleTree.clear();
     m_handles.clear();
     m_selectedHandleCount = 0;
   }
@@ -420,8 +480,14 @@ private:
   void forEachCloseHandle(const H& otherHandle, F fun)
   {
     static const auto epsilon = 0.001 * 0.001;
-    for (auto& [handle, info] : m_handles)
+
+    auto candidates = std::vector<HandleEntry*>{};
+    m_handleTree.find_intersectors(
+      detail::handleBounds(otherHandle).expand(epsilon), std::back_inserter(candidates));
+
+    for (auto* entry : candidates)
     {
+      auto& [handle, info] = *entry;
       if (compare(otherHandle, handle, epsilon) == 0)
       {
         fun(info);
@@ -465,6 +531,69 @@ private:
     }
   }
 
+protected:
+  /**
+   * Calls the given function for every handle that might be hit by the given picking
+   * ray, that is, for every handle whose bounds might be within picking distance of the
+   * ray. Handles which are certainly not hit are skipped using the handle tree.
+   *
+   * The picking distance is the radius of the sphere that the given camera uses to pick
+   * point handles. It is proportional to the camera's perspective scaling factor, which
+   * is an affine function of the handle position. Its gradient is computed once so that
+   * the largest magnitude within the bounds of a tree node can be bounded cheaply.
+   *
+   * @tparam F the type of the function to call, which must accept a handle
+   * @param pickRay the picking ray
+   * @param camera the camera
+   * @param handleRadius the radius of the handles, pass 0 to find the handles whose
+   * bounds are hit by the ray
+   * @param fun the function to call
+   */
+  template <typename F>
+  void forEachPickableHandle(
+    const vm::ray3d& pickRay,
+    const gl::Camera& camera,
+    const double handleRadius,
+    const F& fun) const
+  {
+    // The scaling factor only depends on the distance along the view direction, so
+    // scaling(p) = scalingAtCamera + dot(scalingGradient, p - cameraPosition). The
+    // gradient is zero for orthographic cameras.
+    const auto cameraPosition = vm::vec3d{camera.position()};
+    const auto cameraDirection = vm::vec3d{camera.direction()};
+    const auto scalingAt = [&](const vm::vec3d& position) {
+      return double(camera.perspectiveScalingFactor(vm::vec3f{position}));
+    };
+    const auto scalingAtCamera = scalingAt(cameraPosition);
+    const auto scalingGradient =
+      cameraDirection * (scalingAt(cameraPosition + cameraDirection) - scalingAtCamera);
+
+    // Allow for rounding errors when the handles are picked with the float scaling
+    constexpr auto ScalingMargin = 1.01;
+
+    auto candidates = std::vector<HandleEntry*>{};
+    m_handleTree.find_if(
+      [&](const vm::bbox3d& bounds) {
+        const auto scalingAtCenter =
+          scalingAtCamera + vm::dot(scalingGradient, bounds.center() - cameraPosition);
+        const auto scalingRange = vm::dot(vm::abs(scalingGradient), bounds.size() / 2.0);
+        const auto maxScaling = ScalingMargin
+                                * std::max(
+                                  std::abs(scalingAtCenter - scalingRange),
+                                  std::abs(scalingAtCenter + scalingRange));
+
+        const auto pickBounds = bounds.expand(2.0 * handleRadius * maxScaling);
+        return pickBounds.contains(pickRay.origin)
+               || vm::intersect_ray_bbox(pickRay, pickBounds);
+      },
+      std::back_inserter(candidates));
+
+    for (const auto* entry : candidates)
+    {
+      fun(entry->first);
+    }
+  }
+
 public:
   /**
    * Applies the given picking test to all handles in this manager and adds all hits to
@@ -128,6 +128,7 @@ public: // node tree bulk updating
   void disableNodeTreeUpdates();
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
+  void rebuildNodeTree(kdl::task_manager& taskManager);
 
 private:
   void invalidateAllIssues();
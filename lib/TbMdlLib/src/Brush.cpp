@@ -22,6 +22,7 @@
 #include "mdl/BrushFace.h"
 #include "mdl/BrushGeometry.h"
 #include "mdl/MapFormat.h"
+#include "mdl/MaterialName.h"
 #include "mdl/Polyhedron.h"
 #include "mdl/Polyhedron_Matcher.h"
 #include "mdl/UVCoordSystem.h"
@@ -41,7 +42,9 @@
 #include "vm/util.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <optional>
 #include <ranges>
 #include <set>
 #include <string>
@@ -53,35 +56,16 @@ namespace tb::mdl
 
 kdl_reflect_impl(Brush);
 
-class Brush::CopyCallback : public BrushGeometry::CopyCallback
-{
-public:
-  void faceWasCopied(
-    const BrushFaceGeometry* original, BrushFaceGeometry* copy) const override
-  {
-    copy->setPayload(original->payload());
-  }
-};
-
 Brush::Brush() {}
 
 Brush::Brush(const Brush& other)
   : m_faces{other.m_faces}
-  , m_geometry{
-      other.m_geometry
-        ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback())
-        : nullptr}
+  , m_geometry{other.m_geometry}
 {
-  if (m_geometry)
+  // copied faces are not linked to any geometry, so link them to the shared geometry
+  for (size_t i = 0; i < m_faces.size(); ++i)
   {
-    for (BrushFaceGeometry* faceGeometry : m_geometry->faces())
-    {
-      if (const auto faceIndex = faceGeometry->payload())
-      {
-        BrushFace& face = m_faces[*faceIndex];
-        face.setGeometry(faceGeometry);
-      }
-    }
+    m_faces[i].setGeometry(other.m_faces[i].geometry());
   }
 }
 
@@ -172,10 +156,46 @@ const vm::bbox3d& Brush::bounds() const
   return m_geometry->bounds();
 }
 
+size_t Brush::memoryFootprint() const
+{
+  auto countedGeometries = std::unordered_set<const BrushGeometry*>{};
+  return memoryFootprint(countedGeometries);
+}
+
+size_t Brush::memoryFootprint(
+  std::unordered_set<const BrushGeometry*>& countedGeometries) const
+{
+  auto result = sizeof(Brush) + m_faces.capacity() * sizeof(BrushFace);
+  for (const auto& face : m_faces)
+  {
+    result += face.attributes().materialName().capacity();
+  }
+
+  if (m_geometry && countedGeometries.insert(m_geometry.get()).second)
+  {
+    result += sizeof(BrushGeometry) + m_geometry->vertexCount() * sizeof(BrushVertex)
+              + m_geometry->edgeCount() * (sizeof(BrushEdge) + 2 * sizeof(BrushHalfEdge))
+              + m_geometry->faceCount() * sizeof(BrushFaceGeometry);
+  }
+
+  return result;
+}
+
+bool Brush::sharesGeometryWith(const Brush& other) const
+{
+  return m_geometry != nullptr && m_geometry == other.m_geometry;
+}
+
 std::optional<size_t> Brush::findFace(const std::string& materialName) const
 {
+  const auto internedMaterialName = MaterialName::find(materialName);
+  if (!internedMaterialName)
+  {
+    return std::nullopt;
+  }
+
   return kdl::index_of(m_faces, [&](const BrushFace& face) {
-    return face.attributes().materialName() == materialName;
+    return face.attributes().internedMaterialName() == *internedMaterialName;
   });
 }
 
@@ -1012,8 +1032,8 @@ Result<void> Brush::doTransformVertices(
 
 std::optional<vm::mat4x4d> Brush::findTransformForUVLock(
   const PolyhedronMatcher<BrushGeometry>& matcher,
-  BrushFaceGeometry* left,
-  BrushFaceGeometry* right)
+  const BrushFaceGeometry* left,
+  const BrushFaceGeometry* right)
 {
   std::vector<vm::vec3d> unmovedVerts;
   std::vector<std::pair<vm::vec3d, vm::vec3d>> movedVerts;
@@ -1152,27 +1172,129 @@ Result<void> Brush::updateFacesFromGeometry(
   return updateGeometryFromFaces(worldBounds);
 }
 
+namespace
+{
+
+/**
+ * Computes the volume of the given geometry. The vertex positions are taken relative to
+ * the given origin, which should be close to the geometry to limit rounding errors far
+ * from the world origin.
+ */
+double computeVolume(const BrushGeometry& geometry, const vm::vec3d& origin)
+{
+  auto volume = 0.0;
+  for (const auto* face : geometry.faces())
+  {
+    const auto& boundary = face->boundary();
+    const auto p0 = boundary.front()->origin()->position() - origin;
+    for (const auto* halfEdge : boundary)
+    {
+      const auto p1 = halfEdge->origin()->position() - origin;
+      const auto p2 = halfEdge->next()->origin()->position() - origin;
+      volume += vm::dot(p0, vm::cross(p1, p2));
+    }
+  }
+  return volume / 6.0;
+}
+
+/**
+ * Returns the convex hull of the given fragments if it has the same volume as the
+ * fragments, i.e. if the union of the fragments is convex.
+ */
+std::optional<BrushGeometry> mergeIfConvex(
+  const BrushGeometry& lhs, const BrushGeometry& rhs)
+{
+  // relative to the volume of the convex hull
+  constexpr auto VolumeEpsilon = 1e-6;
+
+  if (!lhs.bounds().intersects(rhs.bounds()))
+  {
+    return std::nullopt;
+  }
+
+  auto merged =
+    BrushGeometry{kdl::vec_concat(lhs.vertexPositions(), rhs.vertexPositions())};
+  if (!merged.polyhedron())
+  {
+    return std::nullopt;
+  }
+
+  const auto origin = merged.vertices().front()->position();
+  const auto mergedVolume = computeVolume(merged, origin);
+  if (
+    std::abs(mergedVolume - computeVolume(lhs, origin) - computeVolume(rhs, origin))
+    > VolumeEpsilon * mergedVolume)
+  {
+    return std::nullopt;
+  }
+
+  return merged;
+}
+
+std::vector<BrushGeometry> mergeConvexUnions(std::vector<BrushGeometry> fragments)
+{
+  for (size_t i = 0; i < fragments.size(); ++i)
+  {
+    for (size_t j = i + 1; j < fragments.size();)
+    {
+      if (auto merged = mergeIfConvex(fragments[i], fragments[j]))
+      {
+        // the merged fragment may now be mergeable with fragments that were skipped
+        fragments[i] = std::move(*merged);
+        fragments = kdl::vec_erase_at(std::move(fragments), j);
+        j = i + 1;
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+
+  return fragments;
+}
+
+} // namespace
+
 std::vector<Result<Brush>> Brush::subtract(
   const MapFormat mapFormat,
   const vm::bbox3d& worldBounds,
   const std::string& defaultMaterialName,
-  const std::vector<const Brush*>& subtrahends) const
+  const std::vector<const Brush*>& subtrahends,
+  const bool mergeFragments) const
 {
   auto result = std::vector<BrushGeometry>{*m_geometry};
 
   for (const auto* subtrahend : subtrahends)
   {
+    if (!bounds().intersects(subtrahend->bounds()))
+    {
+      continue;
+    }
+
     auto nextResults = std::vector<BrushGeometry>{};
 
-    for (const BrushGeometry& fragment : result)
+    for (BrushGeometry& fragment : result)
     {
-      auto subFragments = fragment.subtract(*subtrahend->m_geometry);
-      nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
+      if (fragment.bounds().intersects(subtrahend->bounds()))
+      {
+        auto subFragments = fragment.subtract(*subtrahend->m_geometry);
+        nextResults = kdl::vec_concat(std::move(nextResults), std::move(subFragments));
+      }
+      else
+      {
+        nextResults.push_back(std::move(fragment));
+      }
     }
 
     result = std::move(nextResults);
   }
 
+  if (mergeFragments)
+  {
+    result = mergeConvexUnions(std::move(result));
+  }
+
   return result | std::views::transform([&](const auto& geometry) {
            return createBrush(
              mapFormat, worldBounds, defaultMaterialName, geometry, subtrahends);
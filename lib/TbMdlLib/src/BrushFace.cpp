@@ -749,12 +749,12 @@ vm::polygon3d BrushFace::polygon() const
   return vm::polygon3d(vertexPositions());
 }
 
-BrushFaceGeometry* BrushFace::geometry() const
+const BrushFaceGeometry* BrushFace::geometry() const
 {
   return m_geometry;
 }
 
-void BrushFace::setGeometry(BrushFaceGeometry* geometry)
+void BrushFace::setGeometry(const BrushFaceGeometry* geometry)
 {
   m_geometry = geometry;
 }
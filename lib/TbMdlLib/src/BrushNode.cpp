@@ -39,20 +39,34 @@
 #include "kd/overload.h"
 
 #include "vm/intersection.h"
+#include "vm/packed_intersection.h"
 #include "vm/util.h"
 #include "vm/vec.h"
 
 #include <algorithm>
+#include <ranges>
 #include <string>
 #include <vector>
 
 namespace tb::mdl
 {
+namespace
+{
+
+vm::packed_planes<double> packFacePlanes(const Brush& brush)
+{
+  const auto toBoundary = [](const auto& face) { return face.boundary(); };
+  return vm::packed_planes<double>{brush.faces() | std::views::transform(toBoundary)};
+}
+
+} // namespace
+
 const HitType::Type BrushNode::BrushHitType = HitType::freeType();
 
 BrushNode::BrushNode(Brush brush)
   : m_brushRendererBrushCache(std::make_unique<BrushRendererBrushCache>())
   , m_brush(std::move(brush))
+  , m_facePlanes(packFacePlanes(m_brush))
 {
   clearSelectedFaces();
 }
@@ -97,6 +111,7 @@ Brush BrushNode::setBrush(Brush brush)
 
   using std::swap;
   swap(m_brush, brush);
+  m_facePlanes = packFacePlanes(m_brush);
 
   updateSelectedFaceCount();
   invalidateIssues();
@@ -366,14 +381,8 @@ std::optional<std::tuple<double, size_t>> BrushNode::findFaceHit(
 {
   if (vm::intersect_ray_bbox(ray, logicalBounds()))
   {
-    for (size_t i = 0u; i < m_brush.faceCount(); ++i)
-    {
-      const auto& face = m_brush.face(i);
-      if (const auto distance = face.intersectWithRay(ray))
-      {
-        return std::tuple{*distance, i};
-      }
-    }
+    // the ray enters the convex brush through the face whose plane it crosses last
+    return vm::intersect_ray_convex_polyhedron(ray, m_facePlanes);
   }
   return std::nullopt;
 }
@@ -27,9 +27,20 @@
 #include "kd/contracts.h"
 
 #include <algorithm>
+#include <atomic>
 
 namespace tb::mdl
 {
+namespace
+{
+
+size_t nextVertexCacheVersion()
+{
+  static auto nextVersion = std::atomic<size_t>{0};
+  return nextVersion++;
+}
+
+} // namespace
 
 BrushRendererBrushCache::CachedFace::CachedFace(
   const mdl::BrushFace* i_face, const size_t i_indexOfFirstVertexRelativeToBrush)
@@ -42,17 +53,24 @@ BrushRendererBrushCache::CachedFace::CachedFace(
 
 BrushRendererBrushCache::BrushRendererBrushCache()
   : m_rendererCacheValid{false}
+  , m_vertexCacheVersion{nextVertexCacheVersion()}
 {
 }
 
 void BrushRendererBrushCache::invalidateVertexCache()
 {
   m_rendererCacheValid = false;
+  m_vertexCacheVersion = nextVertexCacheVersion();
   m_cachedVertices.clear();
   m_cachedEdges.clear();
   m_cachedFacesSortedByMaterial.clear();
 }
 
+size_t BrushRendererBrushCache::vertexCacheVersion() const
+{
+  return m_vertexCacheVersion;
+}
+
 void BrushRendererBrushCache::validateVertexCache(const mdl::BrushNode& brushNode)
 {
   if (m_rendererCacheValid)
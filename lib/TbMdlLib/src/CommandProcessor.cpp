@@ -29,6 +29,7 @@
 #include "kd/vector_utils.h"
 
 #include <algorithm>
+#include <iterator>
 
 namespace tb::mdl
 {
@@ -77,6 +78,16 @@ public:
       m_commands, [](const auto& command) { return command->isModification(); });
   }
 
+  size_t memoryFootprint() const override
+  {
+    auto result = sizeof(TransactionCommand);
+    for (const auto& command : m_commands)
+    {
+      result += command->memoryFootprint();
+    }
+    return result;
+  }
+
 private:
   bool doPerformDo(Map& map) override
   {
@@ -172,6 +183,7 @@ CommandProcessor::CommandProcessor(
   : m_map{map}
   , m_isCollationEnabled{true}
   , m_collationInterval{collationInterval}
+  , m_undoMemoryFootprint{0}
   , m_lastCommandTimestamp{std::chrono::time_point<std::chrono::system_clock>{}}
 {
 }
@@ -208,6 +220,25 @@ const std::string* CommandProcessor::redoCommandName() const
   return canRedo() ? &m_redoStack.back()->name() : nullptr;
 }
 
+size_t CommandProcessor::undoMemoryFootprint() const
+{
+  return m_undoMemoryFootprint;
+}
+
+const std::optional<size_t>& CommandProcessor::undoMemoryBudget() const
+{
+  return m_undoMemoryBudget;
+}
+
+void CommandProcessor::setUndoMemoryBudget(std::optional<size_t> undoMemoryBudget)
+{
+  m_undoMemoryBudget = std::move(undoMemoryBudget);
+  if (m_transactionStack.empty())
+  {
+    enforceUndoMemoryBudget();
+  }
+}
+
 void CommandProcessor::startTransaction(std::string name, const TransactionScope scope)
 {
   m_transactionStack.emplace_back(std::move(name), scope);
@@ -246,7 +277,7 @@ bool CommandProcessor::execute(std::unique_ptr<Command> command)
   const auto result = executeCommand(*command);
   if (result)
   {
-    m_undoStack.clear();
+    clearUndoStack();
     m_redoStack.clear();
   }
   return result;
@@ -294,7 +325,7 @@ void CommandProcessor::clear()
 {
   contract_pre(m_transactionStack.empty());
 
-  m_undoStack.clear();
+  clearUndoStack();
   m_redoStack.clear();
   m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
 }
@@ -430,13 +461,19 @@ bool CommandProcessor::pushToUndoStack(
   if (collatable(collate, timestamp))
   {
     auto& lastCommand = m_undoStack.back();
+    const auto lastCommandMemoryFootprint = lastCommand->memoryFootprint();
     if (lastCommand->collateWith(*command))
     {
+      m_undoMemoryFootprint -= lastCommandMemoryFootprint;
+      m_undoMemoryFootprint += lastCommand->memoryFootprint();
+      enforceUndoMemoryBudget();
       return false;
     }
   }
 
+  m_undoMemoryFootprint += command->memoryFootprint();
   m_undoStack.push_back(std::move(command));
+  enforceUndoMemoryBudget();
   return true;
 }
 
@@ -445,7 +482,33 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
   contract_pre(m_transactionStack.empty());
   contract_pre(!m_undoStack.empty());
 
-  return kdl::vec_pop_back(m_undoStack);
+  auto command = kdl::vec_pop_back(m_undoStack);
+  m_undoMemoryFootprint -= command->memoryFootprint();
+  return command;
+}
+
+void CommandProcessor::clearUndoStack()
+{
+  m_undoStack.clear();
+  m_undoMemoryFootprint = 0;
+}
+
+void CommandProcessor::enforceUndoMemoryBudget()
+{
+  contract_pre(m_transactionStack.empty());
+
+  if (!m_undoMemoryBudget || m_undoMemoryFootprint <= *m_undoMemoryBudget)
+  {
+    return;
+  }
+
+  auto it = m_undoStack.begin();
+  while (m_undoMemoryFootprint > *m_undoMemoryBudget && std::next(it) < m_undoStack.end())
+  {
+    m_undoMemoryFootprint -= (*it)->memoryFootprint();
+    ++it;
+  }
+  m_undoStack.erase(m_undoStack.begin(), it);
 }
 
 bool CommandProcessor::collatable(
@@ -28,9 +28,20 @@ namespace tb::mdl
 namespace
 {
 
+void addDependencies(el::MapType& map, const CompilationTask& task)
+{
+  if (const auto& taskDependencies = dependencies(task))
+  {
+    map["dependencies"] = el::Value{
+      *taskDependencies
+      | std::views::transform([](const auto dependency) { return el::Value{dependency}; })
+      | kdl::ranges::to<std::vector>()};
+  }
+}
+
 el::Value toValue(const CompilationTask& task)
 {
-  return el::Value{std::visit(
+  auto result = std::visit(
     kdl::overload(
       [](const CompilationExportMap& exportMap) {
         auto map = el::MapType{};
@@ -73,7 +84,10 @@ el::Value toValue(const CompilationTask& task)
         map["parameters"] = el::Value{runTool.parameterSpec};
         return map;
       }),
-    task)};
+    task);
+
+  addDependencies(result, task);
+  return el::Value{std::move(result)};
 }
 
 el::Value toValue(const std::vector<CompilationTask>& tasks)
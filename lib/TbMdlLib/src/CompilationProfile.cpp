@@ -19,11 +19,212 @@
 
 #include "mdl/CompilationProfile.h"
 
+#include "kd/contracts.h"
 #include "kd/reflection_impl.h"
+#include "kd/vector_utils.h"
+
+#include <fmt/format.h>
+
+#include <functional>
+#include <optional>
+#include <utility>
 
 namespace tb::mdl
 {
+namespace
+{
+
+std::vector<size_t> declaredDependencies(
+  const CompilationProfile& profile, const size_t index)
+{
+  if (const auto& taskDependencies = dependencies(profile.tasks[index]))
+  {
+    return *taskDependencies;
+  }
+  return index > 0 ? std::vector<size_t>{index - 1} : std::vector<size_t>{};
+}
+
+enum class VisitState
+{
+  Unvisited,
+  Visiting,
+  Visited,
+};
+
+bool hasCycle(
+  const std::vector<std::vector<size_t>>& declared,
+  const size_t index,
+  std::vector<VisitState>& visitStates)
+{
+  if (visitStates[index] == VisitState::Visiting)
+  {
+    return true;
+  }
+  if (visitStates[index] == VisitState::Visited)
+  {
+    return false;
+  }
+
+  visitStates[index] = VisitState::Visiting;
+  for (const auto dependency : declared[index])
+  {
+    if (hasCycle(declared, dependency, visitStates))
+    {
+      return true;
+    }
+  }
+  visitStates[index] = VisitState::Visited;
+  return false;
+}
+
+/**
+ * Returns the enabled tasks that a task depending on the task at the given index must
+ * wait for: the task itself if it is enabled, or its effective dependencies otherwise.
+ */
+const std::vector<size_t>& effectiveTasks(
+  const CompilationProfile& profile,
+  const std::vector<std::vector<size_t>>& declared,
+  const size_t index,
+  std::vector<std::optional<std::vector<size_t>>>& cache)
+{
+  if (!cache[index])
+  {
+    if (isEnabled(profile.tasks[index]))
+    {
+      cache[index] = std::vector<size_t>{index};
+    }
+    else
+    {
+      auto result = std::vector<size_t>{};
+      for (const auto dependency : declared[index])
+      {
+        result = kdl::vec_concat(
+          std::move(result), effectiveTasks(profile, declared, dependency, cache));
+      }
+      cache[index] = kdl::vec_sort_and_remove_duplicates(std::move(result));
+    }
+  }
+  return *cache[index];
+}
+
+void updateDependencies(
+  CompilationTask& task, const std::function<std::optional<size_t>(size_t)>& f)
+{
+  if (auto& taskDependencies = dependencies(task))
+  {
+    auto updatedDependencies = std::vector<size_t>{};
+    for (const auto dependency : *taskDependencies)
+    {
+      if (const auto updatedDependency = f(dependency))
+      {
+        updatedDependencies.push_back(*updatedDependency);
+      }
+    }
+    taskDependencies = std::move(updatedDependencies);
+  }
+}
+
+void updateDependencies(
+  CompilationProfile& profile, const std::function<std::optional<size_t>(size_t)>& f)
+{
+  for (auto& task : profile.tasks)
+  {
+    updateDependencies(task, f);
+  }
+}
+
+} // namespace
 
 kdl_reflect_impl(CompilationProfile);
 
+Result<std::vector<std::vector<size_t>>> resolveTaskDependencies(
+  const CompilationProfile& profile)
+{
+  const auto taskCount = profile.tasks.size();
+
+  auto declared = std::vector<std::vector<size_t>>{};
+  declared.reserve(taskCount);
+  for (size_t i = 0; i < taskCount; ++i)
+  {
+    declared.push_back(declaredDependencies(profile, i));
+    for (const auto dependency : declared.back())
+    {
+      if (dependency == i)
+      {
+        return Error{fmt::format("Task {} depends on itself", i)};
+      }
+      if (dependency >= taskCount)
+      {
+        return Error{fmt::format("Task {} depends on unknown task {}", i, dependency)};
+      }
+    }
+  }
+
+  auto visitStates = std::vector<VisitState>(taskCount, VisitState::Unvisited);
+  for (size_t i = 0; i < taskCount; ++i)
+  {
+    if (hasCycle(declared, i, visitStates))
+    {
+      return Error{fmt::format("Task {} has cyclic dependencies", i)};
+    }
+  }
+
+  auto cache = std::vector<std::optional<std::vector<size_t>>>(taskCount);
+  auto result = std::vector<std::vector<size_t>>(taskCount);
+  for (size_t i = 0; i < taskCount; ++i)
+  {
+    if (isEnabled(profile.tasks[i]))
+    {
+      for (const auto dependency : declared[i])
+      {
+        result[i] = kdl::vec_concat(
+          std::move(result[i]), effectiveTasks(profile, declared, dependency, cache));
+      }
+      result[i] = kdl::vec_sort_and_remove_duplicates(std::move(result[i]));
+    }
+  }
+  return result;
+}
+
+void insertTask(CompilationProfile& profile, const size_t index, CompilationTask task)
+{
+  contract_pre(index <= profile.tasks.size());
+
+  const auto f = [&](const auto dependency) -> std::optional<size_t> {
+    return dependency >= index ? dependency + 1 : dependency;
+  };
+  updateDependencies(profile, f);
+  updateDependencies(task, f);
+
+  profile.tasks.insert(
+    std::next(profile.tasks.begin(), std::ptrdiff_t(index)), std::move(task));
+}
+
+void removeTask(CompilationProfile& profile, const size_t index)
+{
+  contract_pre(index < profile.tasks.size());
+
+  profile.tasks = kdl::vec_erase_at(std::move(profile.tasks), index);
+  updateDependencies(profile, [&](const auto dependency) -> std::optional<size_t> {
+    if (dependency == index)
+    {
+      return std::nullopt;
+    }
+    return dependency > index ? dependency - 1 : dependency;
+  });
+}
+
+void swapTasks(CompilationProfile& profile, const size_t index1, const size_t index2)
+{
+  contract_pre(index1 < profile.tasks.size());
+  contract_pre(index2 < profile.tasks.size());
+
+  std::swap(profile.tasks[index1], profile.tasks[index2]);
+  updateDependencies(profile, [&](const auto dependency) {
+    return dependency == index1   ? index2
+           : dependency == index2 ? index1
+                                  : dependency;
+  });
+}
+
 } // namespace tb::mdl
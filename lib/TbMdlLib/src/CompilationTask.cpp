@@ -42,4 +42,24 @@ std::ostream& operator<<(std::ostream& lhs, const CompilationTask& rhs)
   return lhs;
 }
 
+bool isEnabled(const CompilationTask& task)
+{
+  return std::visit([](const auto& t) { return t.enabled; }, task);
+}
+
+const std::optional<std::vector<size_t>>& dependencies(const CompilationTask& task)
+{
+  return std::visit(
+    [](const auto& t) -> const std::optional<std::vector<size_t>>& {
+      return t.dependencies;
+    },
+    task);
+}
+
+std::optional<std::vector<size_t>>& dependencies(CompilationTask& task)
+{
+  return std::visit(
+    [](auto& t) -> std::optional<std::vector<size_t>>& { return t.dependencies; }, task);
+}
+
 } // namespace tb::mdl
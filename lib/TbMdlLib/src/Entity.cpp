@@ -96,6 +96,7 @@ void Entity::setProperties(std::vector<EntityProperty> properties)
   m_cachedOrigin = std::nullopt;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications();
 }
 
 const std::vector<std::string>& Entity::protectedProperties() const
@@ -149,6 +150,7 @@ void Entity::setDefinition(const EntityDefinition* definition)
 
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications();
 }
 
 const EntityModel* Entity::model() const
@@ -184,12 +186,22 @@ const EntityModelFrame* Entity::modelFrame() const
 
 Result<ModelSpecification> Entity::modelSpecification() const
 {
-  if (const auto* pointEntityDefinition = getPointEntityDefinition(definition()))
+  if (!m_cachedModelSpecification)
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointEntityDefinition->modelDefinition.modelSpecification(variableStore);
+    m_modelSpecificationDependencies.clear();
+    if (const auto* pointEntityDefinition = getPointEntityDefinition(definition()))
+    {
+      const auto variableStore =
+        EntityPropertiesVariableStore{*this, &m_modelSpecificationDependencies};
+      m_cachedModelSpecification =
+        pointEntityDefinition->modelDefinition.modelSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedModelSpecification = ModelSpecification{};
+    }
   }
-  return ModelSpecification{};
+  return *m_cachedModelSpecification;
 }
 
 const vm::mat4x4d& Entity::modelTransformation(
@@ -215,12 +227,22 @@ const vm::mat4x4d& Entity::modelTransformation(
 
 Result<DecalSpecification> Entity::decalSpecification() const
 {
-  if (const auto* pointDefinition = getPointEntityDefinition(definition()))
+  if (!m_cachedDecalSpecification)
   {
-    const auto variableStore = EntityPropertiesVariableStore{*this};
-    return pointDefinition->decalDefinition.decalSpecification(variableStore);
+    m_decalSpecificationDependencies.clear();
+    if (const auto* pointDefinition = getPointEntityDefinition(definition()))
+    {
+      const auto variableStore =
+        EntityPropertiesVariableStore{*this, &m_decalSpecificationDependencies};
+      m_cachedDecalSpecification =
+        pointDefinition->decalDefinition.decalSpecification(variableStore);
+    }
+    else
+    {
+      m_cachedDecalSpecification = DecalSpecification{};
+    }
   }
-  return DecalSpecification{};
+  return *m_cachedDecalSpecification;
 }
 
 void Entity::unsetEntityDefinitionAndModel()
@@ -234,11 +256,14 @@ void Entity::unsetEntityDefinitionAndModel()
   m_model = nullptr;
   m_cachedRotation = std::nullopt;
   m_cachedModelTransformation = std::nullopt;
+  invalidateCachedSpecifications();
 }
 
 void Entity::addOrUpdateProperty(
   std::string key, std::string value, const bool defaultToProtected)
 {
+  invalidateCachedSpecifications(key);
+
   auto it = findEntityProperty(m_properties, key);
   if (it != std::end(m_properties))
   {
@@ -283,6 +308,8 @@ void Entity::renameProperty(const std::string& oldKey, std::string newKey)
       m_properties.erase(newIt);
     }
 
+    invalidateCachedSpecifications(oldKey);
+    invalidateCachedSpecifications(newKey);
     oldIt->setKey(std::move(newKey));
 
     m_cachedClassname = std::nullopt;
@@ -297,6 +324,7 @@ void Entity::removeProperty(const std::string& key)
   const auto it = findEntityProperty(m_properties, key);
   if (it != std::end(m_properties))
   {
+    invalidateCachedSpecifications(key);
     m_properties.erase(it);
 
     m_cachedClassname = std::nullopt;
@@ -309,7 +337,12 @@ void Entity::removeProperty(const std::string& key)
 void Entity::removeNumberedProperty(const std::string& prefix)
 {
   const auto erasedPropertyCount = std::erase_if(m_properties, [&](const auto& property) {
-    return property.hasNumberedPrefix(prefix);
+    if (property.hasNumberedPrefix(prefix))
+    {
+      invalidateCachedSpecifications(property.key());
+      return true;
+    }
+    return false;
   });
 
   if (erasedPropertyCount)
@@ -472,4 +505,26 @@ void Entity::transform(const vm::mat4x4d& transformation, const bool updateAngle
   }
 }
 
+void Entity::invalidateCachedSpecifications()
+{
+  m_cachedModelSpecification = std::nullopt;
+  m_modelSpecificationDependencies.clear();
+  m_cachedDecalSpecification = std::nullopt;
+  m_decalSpecificationDependencies.clear();
+}
+
+void Entity::invalidateCachedSpecifications(const std::string_view key)
+{
+  if (kdl::vec_contains(m_modelSpecificationDependencies, key))
+  {
+    m_cachedModelSpecification = std::nullopt;
+    m_modelSpecificationDependencies.clear();
+  }
+  if (kdl::vec_contains(m_decalSpecificationDependencies, key))
+  {
+    m_cachedDecalSpecification = std::nullopt;
+    m_decalSpecificationDependencies.clear();
+  }
+}
+
 } // namespace tb::mdl
@@ -268,7 +268,7 @@ void EntityLinkManager::addLinksFrom(EntityNodeBase& sourceNode)
     auto& linkTargetsForKey = m_linkSources[&sourceNode][sourcePropertyKey];
 
     for (const auto* targetNode :
-         m_nodeIndex.findNodes<EntityNodeBase>(sourcePropertyValue))
+         m_nodeIndex.findNodesWithPropertyValue<EntityNodeBase>(sourcePropertyValue))
     {
       for (const auto& targetPropertyKey : getLinkTargetPropertyKeys(*targetNode))
       {
@@ -297,7 +297,7 @@ void EntityLinkManager::addLinksTo(EntityNodeBase& targetNode)
     auto& linkSourcesForKey = m_linkTargets[&targetNode][targetPropertyKey];
 
     for (const auto* sourceNode :
-         m_nodeIndex.findNodes<EntityNodeBase>(targetPropertyValue))
+         m_nodeIndex.findNodesWithPropertyValue<EntityNodeBase>(targetPropertyValue))
     {
       for (const auto& sourcePropertyKey : getLinkSourcePropertyKeys(*sourceNode))
       {
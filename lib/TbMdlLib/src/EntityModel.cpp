@@ -32,7 +32,7 @@
 
 #include "vm/bbox.h"
 #include "vm/bbox_io.h" // IWYU pragma: keep
-#include "vm/intersection.h"
+#include "vm/packed_intersection.h"
 
 #include <fmt/format.h>
 
@@ -80,62 +80,11 @@ std::ostream& operator<<(std::ostream& lhs, const Orientation rhs)
 }
 
 
-// EntityModelFrame
-
-kdl_reflect_impl(EntityModelFrame);
-
-EntityModelFrame::EntityModelFrame(
-  const size_t index, std::string name, const vm::bbox3f& bounds)
-  : m_index{index}
-  , m_name{std::move(name)}
-  , m_bounds{bounds}
-  , m_spacialTree{16.0f}
-{
-}
-
-size_t EntityModelFrame::index() const
-{
-  return m_index;
-}
-
-size_t EntityModelFrame::skinOffset() const
-{
-  return m_skinOffset;
-}
-
-void EntityModelFrame::setSkinOffset(const size_t skinOffset)
-{
-  m_skinOffset = skinOffset;
-}
-
-const std::string& EntityModelFrame::name() const
-{
-  return m_name;
-}
-
-const vm::bbox3f& EntityModelFrame::bounds() const
-{
-  return m_bounds;
-}
-
-std::optional<float> EntityModelFrame::intersect(const vm::ray3f& ray) const
+namespace
 {
-  auto closestDistance = std::optional<float>{};
 
-  const auto candidates = m_spacialTree.find_intersectors(ray);
-  for (const auto triNum : candidates)
-  {
-    const auto& p1 = m_tris[triNum * 3 + 0];
-    const auto& p2 = m_tris[triNum * 3 + 1];
-    const auto& p3 = m_tris[triNum * 3 + 2];
-    closestDistance =
-      vm::safe_min(closestDistance, vm::intersect_ray_triangle(ray, p1, p2, p3));
-  }
-
-  return closestDistance;
-}
-
-void EntityModelFrame::addToSpacialTree(
+void addTriangles(
+  vm::packed_triangles<float>& tris,
   const std::vector<EntityModelVertex>& vertices,
   const gl::PrimType primType,
   const size_t index,
@@ -151,23 +100,14 @@ void EntityModelFrame::addToSpacialTree(
   case gl::PrimType::Triangles: {
     contract_assert(count % 3 == 0);
 
-    m_tris.reserve(m_tris.size() + count);
+    tris.reserve(tris.size() + count / 3);
     for (size_t i = 0; i < count; i += 3)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p1 = gl::getVertexComponent<0>(vertices[index + i + 0]);
       const auto& p2 = gl::getVertexComponent<0>(vertices[index + i + 1]);
       const auto& p3 = gl::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
 
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+      tris.push_back(p1, p2, p3);
     }
     break;
   }
@@ -175,23 +115,15 @@ void EntityModelFrame::addToSpacialTree(
   case gl::PrimType::TriangleFan: {
     contract_assert(count > 2);
 
-    m_tris.reserve(m_tris.size() + (count - 2) * 3);
+    tris.reserve(tris.size() + count - 2);
 
     const auto& p1 = gl::getVertexComponent<0>(vertices[index]);
     for (size_t i = 1; i < count - 1; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p2 = gl::getVertexComponent<0>(vertices[index + i]);
       const auto& p3 = gl::getVertexComponent<0>(vertices[index + i + 1]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+
+      tris.push_back(p1, p2, p3);
     }
     break;
   }
@@ -200,31 +132,21 @@ void EntityModelFrame::addToSpacialTree(
   case gl::PrimType::TriangleStrip: {
     contract_assert(count > 2);
 
-    m_tris.reserve(m_tris.size() + (count - 2) * 3);
+    tris.reserve(tris.size() + count - 2);
     for (size_t i = 0; i < count - 2; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p1 = gl::getVertexComponent<0>(vertices[index + i + 0]);
       const auto& p2 = gl::getVertexComponent<0>(vertices[index + i + 1]);
       const auto& p3 = gl::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
 
-      const auto triIndex = m_tris.size() / 3u;
       if (i % 2 == 0)
       {
-        m_tris.push_back(p1);
-        m_tris.push_back(p2);
-        m_tris.push_back(p3);
+        tris.push_back(p1, p2, p3);
       }
       else
       {
-        m_tris.push_back(p1);
-        m_tris.push_back(p3);
-        m_tris.push_back(p2);
+        tris.push_back(p1, p3, p2);
       }
-      m_spacialTree.insert(bounds.bounds(), triIndex);
     }
     break;
   }
@@ -232,6 +154,108 @@ void EntityModelFrame::addToSpacialTree(
   }
 }
 
+} // namespace
+
+// EntityModelFrame
+
+kdl_reflect_impl(EntityModelFrame);
+
+EntityModelFrame::EntityModelFrame(
+  const size_t index, std::string name, const vm::bbox3f& bounds)
+  : m_index{index}
+  , m_name{std::move(name)}
+  , m_bounds{bounds}
+{
+}
+
+EntityModelFrame::~EntityModelFrame() = default;
+
+size_t EntityModelFrame::index() const
+{
+  return m_index;
+}
+
+size_t EntityModelFrame::skinOffset() const
+{
+  return m_skinOffset;
+}
+
+void EntityModelFrame::setSkinOffset(const size_t skinOffset)
+{
+  m_skinOffset = skinOffset;
+}
+
+const std::string& EntityModelFrame::name() const
+{
+  return m_name;
+}
+
+const vm::bbox3f& EntityModelFrame::bounds() const
+{
+  return m_bounds;
+}
+
+std::optional<float> EntityModelFrame::intersect(const vm::ray3f& ray) const
+{
+  if (!m_spacialTree)
+  {
+    buildSpacialTree();
+  }
+
+  const auto candidates = m_spacialTree->find_intersectors(ray);
+  if (const auto hit = vm::intersect_ray_triangles(ray, m_tris, candidates))
+  {
+    return std::get<0>(*hit);
+  }
+  return std::nullopt;
+}
+
+void EntityModelFrame::setMeshLoader(LoadEntityModelMesh loadMesh)
+{
+  m_loadMesh = std::move(loadMesh);
+}
+
+bool EntityModelFrame::hasSpacialTree() const
+{
+  return m_spacialTree != nullptr;
+}
+
+void EntityModelFrame::addToSpacialTree(
+  const std::vector<EntityModelVertex>& vertices,
+  const gl::PrimType primType,
+  const size_t index,
+  const size_t count)
+{
+  m_spacialTree.reset();
+  addTriangles(m_tris, vertices, primType, index, count);
+}
+
+void EntityModelFrame::buildSpacialTree() const
+{
+  if (m_tris.empty() && m_loadMesh)
+  {
+    const auto meshData = m_loadMesh(m_index);
+    meshData.indices.forEachPrimitive(
+      [&](const gl::PrimType primType, const size_t index, const size_t count) {
+        addTriangles(m_tris, meshData.vertices, primType, index, count);
+      });
+  }
+
+  m_spacialTree = std::make_unique<SpacialTree>(16.0f);
+  for (size_t i = 0; i < m_tris.size(); ++i)
+  {
+    const auto p1 = vm::vec3f{m_tris.p1(0)[i], m_tris.p1(1)[i], m_tris.p1(2)[i]};
+    const auto e1 = vm::vec3f{m_tris.e1(0)[i], m_tris.e1(1)[i], m_tris.e1(2)[i]};
+    const auto e2 = vm::vec3f{m_tris.e2(0)[i], m_tris.e2(1)[i], m_tris.e2(2)[i]};
+
+    auto bounds = vm::bbox3f::builder{};
+    bounds.add(p1);
+    bounds.add(p1 + e1);
+    bounds.add(p1 + e2);
+    m_spacialTree->insert(bounds.bounds(), i);
+  }
+}
+
 // EntityModelData::Mesh
 
 /**
@@ -261,13 +285,18 @@ public:
   /**
    * Returns a renderer that renders this mesh with the given material.
    *
+   * If the mesh can be discarded while the renderer is still in use, the renderer must
+   * hold a copy of the vertices instead of referencing them.
+   *
    * @param skin the material to use when rendering the mesh
+   * @param copyVertices whether the renderer should hold a copy of the vertices
    * @return the renderer
    */
   std::unique_ptr<gl::MaterialIndexRangeRenderer> buildRenderer(
-    const gl::Material* skin) const
+    const gl::Material* skin, const bool copyVertices) const
   {
-    const auto vertexArray = gl::VertexArray::ref(m_vertices);
+    const auto vertexArray =
+      copyVertices ? gl::VertexArray::copy(m_vertices) : gl::VertexArray::ref(m_vertices);
     return doBuildRenderer(skin, vertexArray);
   }
 
@@ -319,6 +348,18 @@ public:
       });
   }
 
+  /**
+   * Creates a new frame mesh from the given decoded mesh data. The triangles of the
+   * frame are not added to its spacial tree.
+   *
+   * @param meshData the vertices and indices
+   */
+  explicit EntityModelIndexedMesh(EntityModelMeshData meshData)
+    : EntityModelMesh{std::move(meshData.vertices)}
+    , m_indices{std::move(meshData.indices)}
+  {
+  }
+
 private:
   std::unique_ptr<gl::MaterialIndexRangeRenderer> doBuildRenderer(
     const gl::Material* skin, const gl::VertexArray& vertices) const override
@@ -437,6 +478,21 @@ void EntityModelSurface::addMesh(
     frame, std::move(vertices), std::move(indices));
 }
 
+void EntityModelSurface::setMeshLoader(
+  LoadEntityModelMesh loadMesh, const size_t maxLoadedMeshes)
+{
+  contract_pre(maxLoadedMeshes > 0);
+
+  m_loadMesh = std::move(loadMesh);
+  m_maxLoadedMeshes = maxLoadedMeshes;
+}
+
+size_t EntityModelSurface::loadedMeshCount() const
+{
+  return size_t(std::ranges::count_if(
+    m_meshes, [](const auto& mesh) { return mesh != nullptr; }));
+}
+
 void EntityModelSurface::setSkins(std::vector<gl::Material> skins)
 {
   m_skins = std::make_unique<gl::MaterialCollection>(std::move(skins));
@@ -468,8 +524,42 @@ std::unique_ptr<gl::MaterialIndexRangeRenderer> EntityModelSurface::buildRendere
   contract_pre(frameIndex < frameCount());
   contract_pre(skinIndex < skinCount());
 
-  return m_meshes[frameIndex] ? m_meshes[frameIndex]->buildRenderer(skin(skinIndex))
-                              : nullptr;
+  if (!m_loadMesh)
+  {
+    return m_meshes[frameIndex]
+             ? m_meshes[frameIndex]->buildRenderer(skin(skinIndex), false)
+             : nullptr;
+  }
+
+  const auto* mesh = loadMesh(frameIndex);
+  return mesh ? mesh->buildRenderer(skin(skinIndex), true) : nullptr;
+}
+
+const EntityModelMesh* EntityModelSurface::loadMesh(const size_t frameIndex) const
+{
+  if (const auto it = std::ranges::find(m_loadedMeshFrameIndices, frameIndex);
+      it != m_loadedMeshFrameIndices.end())
+  {
+    m_loadedMeshFrameIndices.erase(it);
+    m_loadedMeshFrameIndices.push_back(frameIndex);
+    return m_meshes[frameIndex].get();
+  }
+
+  if (m_meshes[frameIndex])
+  {
+    // the mesh was added eagerly and is never discarded
+    return m_meshes[frameIndex].get();
+  }
+
+  if (m_loadedMeshFrameIndices.size() >= m_maxLoadedMeshes)
+  {
+    m_meshes[m_loadedMeshFrameIndices.front()].reset();
+    m_loadedMeshFrameIndices.erase(m_loadedMeshFrameIndices.begin());
+  }
+
+  m_meshes[frameIndex] = std::make_unique<EntityModelIndexedMesh>(m_loadMesh(frameIndex));
+  m_loadedMeshFrameIndices.push_back(frameIndex);
+  return m_meshes[frameIndex].get();
 }
 
 // EntityModelData
@@ -636,4 +726,14 @@ const EntityModelDataResource& EntityModel::dataResource() const
   return *m_dataResource;
 }
 
+void EntityModel::setLoadPriority(const int priority) const
+{
+  m_dataResource->setPriority(priority);
+}
+
+void EntityModel::waitForLoading() const
+{
+  m_dataResource->waitForLoading();
+}
+
 } // namespace tb::mdl
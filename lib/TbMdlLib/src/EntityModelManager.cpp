@@ -56,6 +56,8 @@ EntityModelManager::~EntityModelManager()
 
 void EntityModelManager::clear()
 {
+  waitForLoading();
+
   m_renderers.clear();
   m_models.clear();
   m_rendererMismatches.clear();
@@ -65,6 +67,14 @@ void EntityModelManager::clear()
   // Remove logging because it might fail when the document is already destroyed.
 }
 
+void EntityModelManager::waitForLoading() const
+{
+  for (const auto& [path, model] : m_models)
+  {
+    model.waitForLoading();
+  }
+}
+
 void EntityModelManager::reloadShaders(kdl::task_manager& taskManager)
 {
   m_shaders.clear();
@@ -180,7 +190,10 @@ Result<EntityModel> EntityModelManager::loadModel(
     return gl::createResourceSync(std::move(resourceLoader));
   };
 
-  const auto loadMaterial = [&](const auto& materialPath) {
+  // The model data loader keeps this function, so it must only refer to objects that
+  // outlive the model
+  const auto loadMaterial = [this, &materialConfig, createResource](
+                              const auto& materialPath) {
     return mdl::loadMaterial(
              m_gameFileSystem,
              materialConfig,
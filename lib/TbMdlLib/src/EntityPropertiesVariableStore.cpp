@@ -23,19 +23,23 @@
 #include "el/Value.h"
 #include "mdl/Entity.h"
 
+#include "kd/vector_utils.h"
+
 #include <string>
 
 namespace tb::mdl
 {
 
-EntityPropertiesVariableStore::EntityPropertiesVariableStore(const Entity& entity)
+EntityPropertiesVariableStore::EntityPropertiesVariableStore(
+  const Entity& entity, std::vector<std::string>* accessedKeys)
   : m_entity{entity}
+  , m_accessedKeys{accessedKeys}
 {
 }
 
 el::VariableStore* EntityPropertiesVariableStore::clone() const
 {
-  return new EntityPropertiesVariableStore{m_entity};
+  return new EntityPropertiesVariableStore{m_entity, m_accessedKeys};
 }
 
 size_t EntityPropertiesVariableStore::size() const
@@ -45,6 +49,11 @@ size_t EntityPropertiesVariableStore::size() const
 
 el::Value EntityPropertiesVariableStore::value(const std::string& name) const
 {
+  if (m_accessedKeys && !kdl::vec_contains(*m_accessedKeys, name))
+  {
+    m_accessedKeys->push_back(name);
+  }
+
   const auto* value = m_entity.property(name);
   return value ? el::Value{*value} : el::Value{""};
 }
@@ -28,6 +28,7 @@
 #include "fs/TraversalMode.h"
 #include "fs/WadFileSystem.h"
 #include "fs/ZipFileSystem.h"
+#include "fs/ZipIndexCache.h"
 #include "mdl/EnvironmentConfig.h"
 #include "mdl/GameConfig.h"
 
@@ -50,12 +51,25 @@ void GameFileSystem::initialize(
 {
   unmountAll();
 
+  if (!m_zipIndexCache && !environmentConfig.userDataFolderPath.empty())
+  {
+    m_zipIndexCache = std::make_shared<fs::ZipIndexCache>(
+      environmentConfig.userDataFolderPath / "ArchiveIndex.bin");
+  }
+
   addDefaultAssetPaths(environmentConfig, gameConfig, logger);
 
   if (!gamePath.empty() && fs::Disk::pathInfo(gamePath) == fs::PathInfo::Directory)
   {
     addGameFileSystems(gameConfig, gamePath, additionalSearchPaths, logger);
   }
+
+  if (m_zipIndexCache)
+  {
+    m_zipIndexCache->save() | kdl::transform_error([&](auto e) {
+      logger.warn() << "Could not save archive index cache: " << e.msg;
+    });
+  }
 }
 
 void GameFileSystem::reloadWads(
@@ -126,7 +140,9 @@ void GameFileSystem::addFileSystemPath(const std::filesystem::path& path, Logger
 namespace
 {
 Result<std::unique_ptr<fs::FileSystem>> createImageFileSystem(
-  const std::string& packageFormat, const std::filesystem::path& path)
+  const std::string& packageFormat,
+  const std::filesystem::path& path,
+  const std::shared_ptr<fs::ZipIndexCache>& zipIndexCache)
 {
   const auto setMetadataAndCast = [&](auto fs) {
     fs->setMetadata(fs::makeImageFileSystemMetadata(path));
@@ -150,7 +166,8 @@ Result<std::unique_ptr<fs::FileSystem>> createImageFileSystem(
   else if (kdl::ci::str_is_equal(packageFormat, "zip"))
   {
     return fs::Disk::openFile(path) | kdl::and_then([&](auto file) {
-             return fs::createImageFileSystem<fs::ZipFileSystem>(std::move(file));
+             return fs::createImageFileSystem<fs::ZipFileSystem>(
+               std::move(file), path, zipIndexCache);
            })
            | kdl::transform(setMetadataAndCast);
   }
@@ -181,7 +198,7 @@ void GameFileSystem::addFileSystemPackages(
                      return diskFS.makeAbsolute(packagePath)
                             | kdl::and_then([&](const auto& absPackagePath) {
                                 return createImageFileSystem(
-                                  packageFormat, absPackagePath);
+                                  packageFormat, absPackagePath, m_zipIndexCache);
                               })
                             | kdl::transform([&](auto fs) {
                                 logger.info()
@@ -219,10 +236,7 @@ void GameFileSystem::mountWads(
 
 void GameFileSystem::unmountWads()
 {
-  for (const auto& id : m_wadMountPoints)
-  {
-    unmount(id);
-  }
+  unmount(m_wadMountPoints);
   m_wadMountPoints.clear();
 }
 
@@ -34,6 +34,8 @@
 #include <vm/vec.h>
 
 #include <array>
+#include <memory>
+#include <vector>
 
 namespace tb::mdl
 {
@@ -358,11 +360,21 @@ auto getVertices(const DkmFrame& frame, const std::vector<DkmMeshVertex>& meshVe
          | kdl::ranges::to<std::vector>();
 }
 
-void buildFrame(
-  EntityModelData& model,
-  EntityModelSurface& surface,
-  const DkmFrame& frame,
-  const std::vector<DkmMesh>& meshes)
+vm::bbox3f getBounds(const DkmFrame& frame, const std::vector<DkmMesh>& meshes)
+{
+  auto bounds = vm::bbox3f::builder{};
+  for (const auto& mesh : meshes)
+  {
+    for (const auto& meshVertex : mesh.vertices)
+    {
+      bounds.add(frame.vertex(meshVertex.vertexIndex));
+    }
+  }
+  return bounds.bounds();
+}
+
+EntityModelMeshData buildMeshData(
+  const DkmFrame& frame, const std::vector<DkmMesh>& meshes)
 {
   size_t vertexCount = 0;
   auto size = gl::IndexRangeMap::Size{};
@@ -373,17 +385,13 @@ void buildFrame(
     size.inc(mesh.type);
   }
 
-  auto bounds = vm::bbox3f::builder{};
-
   auto builder = gl::IndexRangeMapBuilder<EntityModelVertex::Type>{vertexCount, size};
   for (const auto& mesh : meshes)
   {
     if (!mesh.vertices.empty())
     {
-      vertexCount += mesh.vertices.size();
       const auto vertices = getVertices(frame, mesh.vertices);
 
-      bounds.add(vertices.begin(), vertices.end(), gl::GetVertexComponent<0>());
       if (mesh.type == gl::PrimType::TriangleStrip)
       {
         builder.addTriangleStrip(vertices);
@@ -395,9 +403,7 @@ void buildFrame(
     }
   }
 
-  auto& modelFrame = model.addFrame(frame.name, bounds.bounds());
-  surface.addMesh(
-    modelFrame, std::move(builder.vertices()), std::move(builder.indices()));
+  return {std::move(builder.vertices()), std::move(builder.indices())};
 }
 
 } // namespace
@@ -459,19 +465,38 @@ Result<EntityModelData> loadDkmModel(
 
     auto& surface = data.addSurface(name, frameCount);
     return loadSkins(surface, skins, fs, logger).transform([&]() {
-      const auto meshes = parseMeshes(
-        reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount);
-
+      const auto meshes = std::make_shared<const std::vector<DkmMesh>>(parseMeshes(
+        reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount));
+
+      // Keep a copy of the undecoded frames so that the frame meshes can be decoded on
+      // demand. The reader's source may not outlive this function.
+      auto frameData = std::make_shared<std::vector<char>>(frameCount * frameSize);
+      reader.subReaderFromBegin(frameOffset, frameData->size())
+        .read(frameData->data(), frameData->size());
+
+      const auto readFrame = [=](const size_t frameIndex) {
+        const auto* begin = frameData->data() + frameIndex * frameSize;
+        return parseFrame(
+          fs::Reader::from(begin, begin + frameSize), frameIndex, vertexCount, version);
+      };
+
+      // Every frame is parsed once to compute its bounds, so decoding a frame later on
+      // cannot fail.
       for (size_t i = 0; i < frameCount; ++i)
       {
-        const auto frame = parseFrame(
-          reader.subReaderFromBegin(frameOffset + i * frameSize, frameSize),
-          i,
-          vertexCount,
-          version);
+        const auto frame = readFrame(i);
+        data.addFrame(frame.name, getBounds(frame, *meshes));
+      }
 
-        buildFrame(data, surface, frame, meshes);
+      auto loadMesh = [=](const size_t frameIndex) {
+        return buildMeshData(readFrame(frameIndex), *meshes);
+      };
+
+      for (auto& frame : data.frames())
+      {
+        frame.setMeshLoader(loadMesh);
       }
+      surface.setMeshLoader(std::move(loadMesh));
 
       return std::move(data);
     });
@@ -128,6 +128,8 @@ gl::ResourceLoader<EntityModelData> makeEntityModelDataResourceLoader(
   const LoadMaterialFunc& loadMaterial,
   Logger& logger)
 {
+  // The loader runs again whenever evicted model data is used, so it must only refer to
+  // the file system and the logger, which outlive the entity model manager.
   return [&fs, materialConfig, path, loadMaterial, &logger]() {
     return loadEntityModelData(fs, materialConfig, path, loadMaterial, logger);
   };
@@ -270,7 +270,9 @@ gl::ResourceLoader<gl::Texture> makeTextureResourceLoader(
   const fs::FileSystem& fs,
   const std::optional<Palette>& palette)
 {
-  return [&, path, name, palette]() -> Result<gl::Texture> {
+  // The loader runs again whenever an evicted texture is used, so it must only refer to
+  // the file system, which outlives the material manager.
+  return [&fs, path, name, extensions, palette]() -> Result<gl::Texture> {
     return findAndLoadTexture(path, name, extensions, fs, palette)
            | kdl::or_else([&](auto e) -> Result<gl::Texture> {
                return Error{fmt::format("Could not load texture '{}': {}", path, e.msg)};
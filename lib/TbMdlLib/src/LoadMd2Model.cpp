@@ -30,6 +30,7 @@
 #include "kd/path_utils.h"
 
 #include <array>
+#include <memory>
 #include <vector>
 
 namespace tb::mdl
@@ -278,11 +279,21 @@ auto getVertices(const Md2Frame& frame, const std::vector<Md2MeshVertex>& meshVe
   return vertices;
 }
 
-void buildFrame(
-  EntityModelData& model,
-  EntityModelSurface& surface,
-  const Md2Frame& frame,
-  const std::vector<Md2Mesh>& meshes)
+vm::bbox3f getBounds(const Md2Frame& frame, const std::vector<Md2Mesh>& meshes)
+{
+  auto bounds = vm::bbox3f::builder{};
+  for (const auto& md2Mesh : meshes)
+  {
+    for (const auto& md2MeshVertex : md2Mesh.vertices)
+    {
+      bounds.add(frame.vertex(md2MeshVertex.vertexIndex));
+    }
+  }
+  return bounds.bounds();
+}
+
+EntityModelMeshData buildMeshData(
+  const Md2Frame& frame, const std::vector<Md2Mesh>& meshes)
 {
   size_t vertexCount = 0;
   auto size = gl::IndexRangeMap::Size{};
@@ -292,18 +303,13 @@ void buildFrame(
     size.inc(md2Mesh.type);
   }
 
-  auto bounds = vm::bbox3f::builder{};
-
   auto builder = gl::IndexRangeMapBuilder<EntityModelVertex::Type>{vertexCount, size};
   for (const auto& md2Mesh : meshes)
   {
     if (!md2Mesh.vertices.empty())
     {
-      vertexCount += md2Mesh.vertices.size();
       const auto vertices = getVertices(frame, md2Mesh.vertices);
 
-      bounds.add(std::begin(vertices), std::end(vertices), gl::GetVertexComponent<0>());
-
       if (md2Mesh.type == gl::PrimType::TriangleFan)
       {
         builder.addTriangleFan(vertices);
@@ -315,9 +321,7 @@ void buildFrame(
     }
   }
 
-  auto& modelFrame = model.addFrame(frame.name, bounds.bounds());
-  surface.addMesh(
-    modelFrame, std::move(builder.vertices()), std::move(builder.indices()));
+  return {std::move(builder.vertices()), std::move(builder.indices())};
 }
 
 } // namespace
@@ -384,18 +388,37 @@ Result<EntityModelData> loadMd2Model(
 
     const auto frameSize =
       6 * sizeof(float) + Md2Layout::FrameNameLength + vertexCount * 4;
-    const auto meshes = parseMeshes(
-      reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount);
-
+    const auto meshes = std::make_shared<const std::vector<Md2Mesh>>(parseMeshes(
+      reader.subReaderFromBegin(commandOffset, commandCount * 4), commandCount));
+
+    // Keep a copy of the undecoded frames so that the frame meshes can be decoded on
+    // demand. The reader's source may not outlive this function.
+    auto frameData = std::make_shared<std::vector<char>>(frameCount * frameSize);
+    reader.subReaderFromBegin(frameOffset, frameData->size())
+      .read(frameData->data(), frameData->size());
+
+    const auto readFrame = [=](const size_t frameIndex) {
+      const auto* begin = frameData->data() + frameIndex * frameSize;
+      return parseFrame(fs::Reader::from(begin, begin + frameSize), frameIndex, vertexCount);
+    };
+
+    // Every frame is parsed once to compute its bounds, so decoding a frame later on
+    // cannot fail.
     for (size_t i = 0; i < frameCount; ++i)
     {
-      const auto frame = parseFrame(
-        reader.subReaderFromBegin(frameOffset + i * frameSize, frameSize),
-        i,
-        vertexCount);
+      const auto frame = readFrame(i);
+      data.addFrame(frame.name, getBounds(frame, *meshes));
+    }
 
-      buildFrame(data, surface, frame, meshes);
+    auto loadMesh = [=](const size_t frameIndex) {
+      return buildMeshData(readFrame(frameIndex), *meshes);
+    };
+
+    for (auto& frame : data.frames())
+    {
+      frame.setMeshLoader(loadMesh);
     }
+    surface.setMeshLoader(std::move(loadMesh));
 
     return data;
   }
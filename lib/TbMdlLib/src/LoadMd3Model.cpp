@@ -25,7 +25,10 @@
 #include "gl/PrimType.h"
 
 #include "kd/path_utils.h"
-#include "kd/result_fold.h"
+#include "kd/result.h"
+
+#include <memory>
+#include <vector>
 
 namespace tb::mdl
 {
@@ -55,6 +58,20 @@ struct Md3Triangle
   size_t i1, i2, i3;
 };
 
+/**
+ * The data of a surface that is needed to decode its frame meshes on demand.
+ */
+struct Md3SurfaceData
+{
+  size_t vertexCount;
+  std::vector<Md3Triangle> triangles;
+  std::vector<vm::vec2f> uvCoords;
+
+  // the undecoded vertex positions of all frames
+  std::vector<char> vertexData;
+};
+
+using Md3SurfaceDataList = std::vector<std::shared_ptr<const Md3SurfaceData>>;
 
 auto parseShaders(fs::Reader reader, const size_t shaderCount)
 {
@@ -81,59 +98,6 @@ void loadSurfaceMaterials(
     shaderPaths | transform(loadMaterial) | kdl::ranges::to<std::vector>());
 }
 
-Result<void> parseSurfaces(
-  fs::Reader reader,
-  const size_t surfaceCount,
-  const size_t frameCount,
-  EntityModelData& model,
-  const LoadMaterialFunc& loadMaterial)
-{
-  for (size_t i = 0; i < surfaceCount; ++i)
-  {
-    const auto ident = reader.readInt<int32_t>();
-
-    if (ident != Md3Layout::Ident)
-    {
-      return Error{fmt::format("Unknown MD3 model surface ident: {}", ident)};
-    }
-
-    const auto surfaceName = reader.readString(Md3Layout::SurfaceNameLength);
-    /* const auto flags = */ reader.readInt<int32_t>();
-    /* const auto frameCount = */ reader.readSize<int32_t>();
-    const auto shaderCount = reader.readSize<int32_t>();
-    /* const auto vertexCount = */ reader.readSize<int32_t>();
-    /* const auto triangleCount = */ reader.readSize<int32_t>();
-
-    /* const auto triangleOffset = */ reader.readSize<int32_t>();
-    const auto shaderOffset = reader.readSize<int32_t>();
-    /* const auto uvOffset = */ reader.readSize<int32_t>();
-    /* const auto vertexOffset = */ reader.readSize<int32_t>();
-    const auto endOffset = reader.readSize<int32_t>();
-
-    const auto shaders = parseShaders(
-      reader.subReaderFromBegin(shaderOffset, shaderCount * Md3Layout::ShaderLength),
-      shaderCount);
-
-    auto& surface = model.addSurface(surfaceName, frameCount);
-    loadSurfaceMaterials(surface, shaders, loadMaterial);
-
-    reader = reader.subReaderFromBegin(endOffset);
-  }
-
-  return Result<void>{};
-}
-
-auto& parseFrame(fs::Reader reader, EntityModelData& model)
-{
-  const auto minBounds = reader.readVec<float, 3>();
-  const auto maxBounds = reader.readVec<float, 3>();
-  /* const auto localOrigin = */ reader.readVec<float, 3>();
-  /* const auto radius = */ reader.readFloat<float>();
-  const auto frameName = reader.readString(Md3Layout::FrameNameLength);
-
-  return model.addFrame(frameName, vm::bbox3f{minBounds, maxBounds});
-}
-
 auto parseVertexPositions(fs::Reader reader, const size_t vertexCount)
 {
   auto positions = std::vector<vm::vec3f>{};
@@ -201,16 +165,93 @@ auto parseTriangles(fs::Reader reader, const size_t triangleCount)
   return triangles;
 }
 
-void buildFrameSurface(
-  EntityModelFrame& frame,
-  EntityModelSurface& surface,
+Result<Md3SurfaceDataList> parseSurfaces(
+  fs::Reader reader,
+  const size_t surfaceCount,
+  const size_t frameCount,
+  EntityModelData& model,
+  const LoadMaterialFunc& loadMaterial)
+{
+  auto surfaceDataList = Md3SurfaceDataList{};
+  surfaceDataList.reserve(surfaceCount);
+
+  for (size_t i = 0; i < surfaceCount; ++i)
+  {
+    const auto ident = reader.readInt<int32_t>();
+
+    if (ident != Md3Layout::Ident)
+    {
+      return Error{fmt::format("Unknown MD3 model surface ident: {}", ident)};
+    }
+
+    const auto surfaceName = reader.readString(Md3Layout::SurfaceNameLength);
+    /* const auto flags = */ reader.readInt<int32_t>();
+    const auto surfaceFrameCount = reader.readSize<int32_t>();
+    const auto shaderCount = reader.readSize<int32_t>();
+    const auto vertexCount = reader.readSize<int32_t>();
+    const auto triangleCount = reader.readSize<int32_t>();
+
+    const auto triangleOffset = reader.readSize<int32_t>();
+    const auto shaderOffset = reader.readSize<int32_t>();
+    const auto uvCoordOffset = reader.readSize<int32_t>();
+    const auto vertexOffset = reader.readSize<int32_t>();
+    const auto endOffset = reader.readSize<int32_t>();
+
+    const auto shaders = parseShaders(
+      reader.subReaderFromBegin(shaderOffset, shaderCount * Md3Layout::ShaderLength),
+      shaderCount);
+
+    auto& surface = model.addSurface(surfaceName, frameCount);
+    loadSurfaceMaterials(surface, shaders, loadMaterial);
+
+    if (surfaceFrameCount > 0)
+    {
+      // Keep a copy of the undecoded vertex positions so that the frame meshes can be
+      // decoded on demand. The reader's source may not outlive the loader.
+      auto vertexData =
+        std::vector<char>(frameCount * vertexCount * Md3Layout::VertexLength);
+      reader.subReaderFromBegin(vertexOffset, vertexData.size())
+        .read(vertexData.data(), vertexData.size());
+
+      surfaceDataList.push_back(std::make_shared<const Md3SurfaceData>(Md3SurfaceData{
+        vertexCount,
+        parseTriangles(
+          reader.subReaderFromBegin(
+            triangleOffset, triangleCount * Md3Layout::TriangleLength),
+          triangleCount),
+        parseUV(
+          reader.subReaderFromBegin(uvCoordOffset, vertexCount * Md3Layout::UVLength),
+          vertexCount),
+        std::move(vertexData),
+      }));
+    }
+    else
+    {
+      surfaceDataList.push_back(nullptr);
+    }
+
+    reader = reader.subReaderFromBegin(endOffset);
+  }
+
+  return surfaceDataList;
+}
+
+auto& parseFrame(fs::Reader reader, EntityModelData& model)
+{
+  const auto minBounds = reader.readVec<float, 3>();
+  const auto maxBounds = reader.readVec<float, 3>();
+  /* const auto localOrigin = */ reader.readVec<float, 3>();
+  /* const auto radius = */ reader.readFloat<float>();
+  const auto frameName = reader.readString(Md3Layout::FrameNameLength);
+
+  return model.addFrame(frameName, vm::bbox3f{minBounds, maxBounds});
+}
+
+auto buildFrameVertices(
   const std::vector<Md3Triangle>& triangles,
   const std::vector<EntityModelVertex>& vertices)
 {
-  using Vertex = EntityModelVertex;
-
-  auto rangeMap = gl::IndexRangeMap{gl::PrimType::Triangles, 0, 3 * triangles.size()};
-  auto frameVertices = std::vector<Vertex>{};
+  auto frameVertices = std::vector<EntityModelVertex>{};
   frameVertices.reserve(3 * triangles.size());
 
   for (const auto& triangle : triangles)
@@ -222,68 +263,73 @@ void buildFrameSurface(
       continue;
     }
 
-    const auto& v1 = vertices[triangle.i1];
-    const auto& v2 = vertices[triangle.i2];
-    const auto& v3 = vertices[triangle.i3];
-
-    frameVertices.push_back(v1);
-    frameVertices.push_back(v2);
-    frameVertices.push_back(v3);
+    frameVertices.push_back(vertices[triangle.i1]);
+    frameVertices.push_back(vertices[triangle.i2]);
+    frameVertices.push_back(vertices[triangle.i3]);
   }
 
-  surface.addMesh(frame, std::move(frameVertices), std::move(rangeMap));
+  return frameVertices;
 }
 
-Result<void> parseFrameSurfaces(
-  fs::Reader reader, EntityModelFrame& frame, EntityModelData& model)
+auto decodeFrameVertices(const Md3SurfaceData& surfaceData, const size_t frameIndex)
 {
-  for (size_t i = 0; i < model.surfaceCount(); ++i)
-  {
-    const auto ident = reader.readInt<int32_t>();
+  const auto frameVertexLength = surfaceData.vertexCount * Md3Layout::VertexLength;
+  const auto* begin = surfaceData.vertexData.data() + frameIndex * frameVertexLength;
 
-    if (ident != Md3Layout::Ident)
-    {
-      return Error{fmt::format("Unknown MD3 model surface ident: {}", ident)};
-    }
+  const auto vertexPositions = parseVertexPositions(
+    fs::Reader::from(begin, begin + frameVertexLength), surfaceData.vertexCount);
+  const auto vertices = buildVertices(vertexPositions, surfaceData.uvCoords);
 
-    /* const auto surfaceName = */ reader.readString(Md3Layout::SurfaceNameLength);
-    /* const auto flags = */ reader.readInt<int32_t>();
-    const auto frameCount = reader.readSize<int32_t>();
-    /* const auto shaderCount = */ reader.readSize<int32_t>();
-    const auto vertexCount = reader.readSize<int32_t>();
-    const auto triangleCount = reader.readSize<int32_t>();
+  return buildFrameVertices(surfaceData.triangles, vertices);
+}
 
-    const auto triangleOffset = reader.readSize<int32_t>();
-    /* const auto shaderOffset = */ reader.readSize<int32_t>();
-    const auto uvCoordOffset = reader.readSize<int32_t>();
-    const auto vertexOffset = reader.readSize<int32_t>();
-    const auto endOffset = reader.readSize<int32_t>();
+EntityModelMeshData buildMeshData(std::vector<EntityModelVertex> frameVertices)
+{
+  auto indices = gl::IndexRangeMap{gl::PrimType::Triangles, 0, frameVertices.size()};
+  return {std::move(frameVertices), std::move(indices)};
+}
 
-    if (frameCount > 0)
+/**
+ * Decodes the triangles of all surfaces of the given frame. Used to hit test the frame.
+ */
+EntityModelMeshData buildFrameMeshData(
+  const Md3SurfaceDataList& surfaceDataList, const size_t frameIndex)
+{
+  auto frameVertices = std::vector<EntityModelVertex>{};
+  for (const auto& surfaceData : surfaceDataList)
+  {
+    if (surfaceData)
     {
-      const auto frameVertexLength = vertexCount * Md3Layout::VertexLength;
-      const auto frameVertexOffset = vertexOffset + frame.index() * frameVertexLength;
-
-      const auto vertexPositions = parseVertexPositions(
-        reader.subReaderFromBegin(frameVertexOffset, frameVertexLength), vertexCount);
-      const auto uvCoords = parseUV(
-        reader.subReaderFromBegin(uvCoordOffset, vertexCount * Md3Layout::UVLength),
-        vertexCount);
-      const auto vertices = buildVertices(vertexPositions, uvCoords);
-
-      const auto triangles = parseTriangles(
-        reader.subReaderFromBegin(
-          triangleOffset, triangleCount * Md3Layout::TriangleLength),
-        triangleCount);
-
-      auto& surface = model.surface(i);
-      buildFrameSurface(frame, surface, triangles, vertices);
+      const auto surfaceVertices = decodeFrameVertices(*surfaceData, frameIndex);
+      frameVertices.insert(
+        frameVertices.end(), surfaceVertices.begin(), surfaceVertices.end());
     }
+  }
 
-    reader = reader.subReaderFromBegin(endOffset);
+  return buildMeshData(std::move(frameVertices));
+}
+
+void setMeshLoaders(EntityModelData& model, Md3SurfaceDataList surfaceDataList)
+{
+  for (size_t i = 0; i < surfaceDataList.size(); ++i)
+  {
+    if (auto surfaceData = surfaceDataList[i])
+    {
+      model.surface(i).setMeshLoader([=](const size_t frameIndex) {
+        return buildMeshData(decodeFrameVertices(*surfaceData, frameIndex));
+      });
+    }
   }
 
-  return Result<void>{};
+  auto loadFrameMesh = [surfaceDataList = std::move(surfaceDataList)](
+                         const size_t frameIndex) {
+    return buildFrameMeshData(surfaceDataList, frameIndex);
+  };
+
+  for (auto& frame : model.frames())
+  {
+    frame.setMeshLoader(loadFrameMesh);
+  }
 }
 
 } // namespace
@@ -339,18 +385,17 @@ Result<EntityModelData> loadMd3Model(
              frameCount,
              data,
              loadMaterial)
-           | kdl::and_then([&]() {
-               return std::views::iota(0u, frameCount)
-                      | std::views::transform([&](const auto i) {
-                          auto& frame = parseFrame(
-                            reader.subReaderFromBegin(
-                              frameOffset + i * Md3Layout::FrameLength,
-                              Md3Layout::FrameLength),
-                            data);
-                          return parseFrameSurfaces(
-                            reader.subReaderFromBegin(surfaceOffset), frame, data);
-                        })
-                      | kdl::fold | kdl::transform([&]() { return std::move(data); });
+           | kdl::transform([&](auto surfaceDataList) {
+               for (size_t i = 0; i < frameCount; ++i)
+               {
+                 parseFrame(
+                   reader.subReaderFromBegin(
+                     frameOffset + i * Md3Layout::FrameLength, Md3Layout::FrameLength),
+                   data);
+               }
+
+               setMeshLoaders(data, std::move(surfaceDataList));
+               return std::move(data);
              });
   }
   catch (const fs::ReaderException& e)
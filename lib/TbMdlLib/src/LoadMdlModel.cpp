@@ -23,10 +23,14 @@
 #include "gl/IndexRangeMap.h"
 #include "gl/IndexRangeMapBuilder.h"
 #include "gl/Material.h"
+#include "gl/TextureBuffer.h"
 #include "mdl/Palette.h"
 
 #include "kd/path_utils.h"
 
+#include <memory>
+#include <vector>
+
 namespace tb::mdl
 {
 namespace
@@ -124,27 +128,34 @@ auto makeFrameTriangles(
   return frameTriangles;
 }
 
-void doParseFrame(
+struct MdlFrame
+{
+  std::string name;
+  std::vector<vm::vec3f> positions;
+};
+
+MdlFrame parseFrame(
   fs::Reader reader,
-  EntityModelData& model,
-  EntityModelSurface& surface,
-  const std::vector<MdlSkinTriangle>& triangles,
   const std::vector<MdlSkinVertex>& vertices,
-  const size_t skinWidth,
-  const size_t skinHeight,
   const vm::vec3f& origin,
   const vm::vec3f& scale)
 {
   reader.seekForward(MdlLayout::SimpleFrameName);
   auto name = reader.readString(MdlLayout::SimpleFrameLength);
+  auto positions = parseFrameVertices(reader, vertices, origin, scale);
 
-  const auto positions = parseFrameVertices(reader, vertices, origin, scale);
-
-  auto bounds = vm::bbox3f::builder{};
-  bounds.add(positions.begin(), positions.end());
+  return MdlFrame{std::move(name), std::move(positions)};
+}
 
+EntityModelMeshData buildMeshData(
+  const MdlFrame& frame,
+  const std::vector<MdlSkinTriangle>& triangles,
+  const std::vector<MdlSkinVertex>& vertices,
+  const size_t skinWidth,
+  const size_t skinHeight)
+{
   const auto frameTriangles =
-    makeFrameTriangles(triangles, vertices, positions, skinWidth, skinHeight);
+    makeFrameTriangles(triangles, vertices, frame.positions, skinWidth, skinHeight);
 
   auto size = gl::IndexRangeMap::Size{};
   size.inc(gl::PrimType::Triangles, frameTriangles.size());
@@ -153,59 +164,33 @@ void doParseFrame(
     gl::IndexRangeMapBuilder<EntityModelVertex::Type>{frameTriangles.size() * 3, size};
   builder.addTriangles(frameTriangles);
 
-  auto& frame = model.addFrame(std::move(name), bounds.bounds());
-  surface.addMesh(frame, std::move(builder.vertices()), std::move(builder.indices()));
+  return {std::move(builder.vertices()), std::move(builder.indices())};
 }
 
-void parseFrame(
-  fs::Reader& reader,
-  EntityModelData& model,
-  EntityModelSurface& surface,
-  const std::vector<MdlSkinTriangle>& triangles,
-  const std::vector<MdlSkinVertex>& vertices,
-  size_t skinWidth,
-  size_t skinHeight,
-  const vm::vec3f& origin,
-  const vm::vec3f& scale)
+/**
+ * Skips the next frame or frame group and returns the position of the frame's data. Of
+ * a frame group, only the first frame is used.
+ */
+size_t skipFrame(fs::Reader& reader, const size_t frameLength)
 {
-  const auto frameLength =
-    MdlLayout::SimpleFrameName + MdlLayout::SimpleFrameLength + vertices.size() * 4;
-
   const auto type = reader.readInt<int32_t>();
   if (type == 0)
   { // single frame
-    doParseFrame(
-      reader.subReaderFromCurrent(frameLength),
-      model,
-      surface,
-      triangles,
-      vertices,
-      skinWidth,
-      skinHeight,
-      origin,
-      scale);
+    const auto position = reader.position();
     reader.seekForward(frameLength);
+    return position;
   }
-  else
-  { // frame group, but we only read the first frame
-    const auto groupFrameCount = reader.readSize<int32_t>();
-    reader.seekBackward(sizeof(int32_t));
-
-    const auto frameTimeLength =
-      MdlLayout::MultiFrameTimes + groupFrameCount * sizeof(float);
-    doParseFrame(
-      reader.subReaderFromCurrent(frameTimeLength, frameLength),
-      model,
-      surface,
-      triangles,
-      vertices,
-      skinWidth,
-      skinHeight,
-      origin,
-      scale);
-
-    reader.seekForward(frameTimeLength + groupFrameCount * frameLength);
-  }
+
+  // frame group, but we only read the first frame
+  const auto groupFrameCount = reader.readSize<int32_t>();
+  reader.seekBackward(sizeof(int32_t));
+
+  const auto frameTimeLength =
+    MdlLayout::MultiFrameTimes + groupFrameCount * sizeof(float);
+  const auto position = reader.position() + frameTimeLength;
+
+  reader.seekForward(frameTimeLength + groupFrameCount * frameLength);
+  return position;
 }
 
 std::vector<MdlSkinTriangle> parseTriangles(fs::Reader& reader, size_t count)
@@ -240,6 +225,35 @@ std::vector<MdlSkinVertex> parseVertices(fs::Reader& reader, size_t count)
   return vertices;
 }
 
+gl::Material createSkinMaterial(
+  const size_t width,
+  const size_t height,
+  const Color& avgColor,
+  const gl::TextureMask mask,
+  gl::TextureBuffer rgbaImage,
+  std::string skinName)
+{
+  auto buffers = gl::TextureBufferList{};
+  buffers.push_back(std::move(rgbaImage));
+  if (mask == gl::TextureMask::Off)
+  {
+    // skins don't store any mipmaps
+    gl::generateMips(buffers, width, height, GL_RGBA);
+  }
+
+  auto texture = gl::Texture{
+    width,
+    height,
+    avgColor,
+    GL_RGBA,
+    mask,
+    gl::NoEmbeddedDefaults{},
+    std::move(buffers)};
+
+  auto textureResource = createTextureResource(std::move(texture));
+  return gl::Material{std::move(skinName), std::move(textureResource)};
+}
+
 gl::Material parseSkin(
   fs::Reader& reader,
   const size_t width,
@@ -262,17 +276,8 @@ gl::Material parseSkin(
   {
     palette.indexedToRgba(reader, size, rgbaImage, transparency, avgColor);
 
-    auto texture = gl::Texture{
-      width,
-      height,
-      avgColor,
-      GL_RGBA,
-      mask,
-      gl::NoEmbeddedDefaults{},
-      std::move(rgbaImage)};
-
-    auto textureResource = createTextureResource(std::move(texture));
-    return gl::Material{std::move(skinName), std::move(textureResource)};
+    return createSkinMaterial(
+      width, height, avgColor, mask, std::move(rgbaImage), std::move(skinName));
   }
 
   const auto pictureCount = reader.readSize<int32_t>();
@@ -281,17 +286,8 @@ gl::Material parseSkin(
   palette.indexedToRgba(reader, size, rgbaImage, transparency, avgColor);
   reader.seekForward((pictureCount - 1) * size); // skip all remaining pictures
 
-  auto texture = gl::Texture{
-    width,
-    height,
-    avgColor,
-    GL_RGBA,
-    mask,
-    gl::NoEmbeddedDefaults{},
-    std::move(rgbaImage)};
-
-  auto textureResource = createTextureResource(std::move(texture));
-  return gl::Material{std::move(skinName), std::move(textureResource)};
+  return createSkinMaterial(
+    width, height, avgColor, mask, std::move(rgbaImage), std::move(skinName));
 }
 
 void parseSkins(
@@ -368,14 +364,55 @@ Result<EntityModelData> loadMdlModel(
     reader.seekFromBegin(MdlLayout::Skins);
     parseSkins(reader, surface, skinCount, skinWidth, skinHeight, flags, name, palette);
 
-    const auto vertices = parseVertices(reader, vertexCount);
-    const auto triangles = parseTriangles(reader, triangleCount);
+    const auto vertices = std::make_shared<const std::vector<MdlSkinVertex>>(
+      parseVertices(reader, vertexCount));
+    const auto triangles = std::make_shared<const std::vector<MdlSkinTriangle>>(
+      parseTriangles(reader, triangleCount));
+
+    const auto frameLength =
+      MdlLayout::SimpleFrameName + MdlLayout::SimpleFrameLength + vertexCount * 4;
+
+    const auto framesBegin = reader.position();
+    auto frameOffsets = std::vector<size_t>{};
+    frameOffsets.reserve(frameCount);
+    for (size_t i = 0; i < frameCount; ++i)
+    {
+      frameOffsets.push_back(skipFrame(reader, frameLength) - framesBegin);
+    }
+
+    // Keep a copy of the undecoded frames so that the frame meshes can be decoded on
+    // demand. The reader's source may not outlive this function.
+    auto frameData = std::make_shared<std::vector<char>>(reader.position() - framesBegin);
+    reader.subReaderFromBegin(framesBegin, frameData->size())
+      .read(frameData->data(), frameData->size());
 
+    const auto readFrame = [=](const size_t frameIndex) {
+      const auto* begin = frameData->data() + frameOffsets[frameIndex];
+      return parseFrame(
+        fs::Reader::from(begin, begin + frameLength), *vertices, origin, scale);
+    };
+
+    // Every frame is parsed once to compute its bounds, so decoding a frame later on
+    // cannot fail.
     for (size_t i = 0; i < frameCount; ++i)
     {
-      parseFrame(
-        reader, data, surface, triangles, vertices, skinWidth, skinHeight, origin, scale);
+      auto frame = readFrame(i);
+
+      auto bounds = vm::bbox3f::builder{};
+      bounds.add(frame.positions.begin(), frame.positions.end());
+      data.addFrame(std::move(frame.name), bounds.bounds());
+    }
+
+    auto loadMesh = [=](const size_t frameIndex) {
+      return buildMeshData(
+        readFrame(frameIndex), *triangles, *vertices, skinWidth, skinHeight);
+    };
+
+    for (auto& frame : data.frames())
+    {
+      frame.setMeshLoader(loadMesh);
     }
+    surface.setMeshLoader(std::move(loadMesh));
 
     return data;
   }
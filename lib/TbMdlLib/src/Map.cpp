@@ -25,6 +25,8 @@
 #include "fs/PathInfo.h"
 #include "gl/MaterialManager.h"
 #include "gl/ResourceManager.h"
+#include "gl/TextureCompressor.h"
+#include "gl/TextureResource.h"
 #include "mdl/AssetUtils.h"
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushFace.h"
@@ -72,6 +74,7 @@
 #include "mdl/MixedBrushContentsValidator.h"
 #include "mdl/ModelUtils.h"
 #include "mdl/Node.h"
+#include "mdl/NodeChangeBatch.h"
 #include "mdl/NodeIndex.h"
 #include "mdl/NodeQueries.h"
 #include "mdl/NodeReader.h"
@@ -88,6 +91,7 @@
 #include "mdl/SoftMapBoundsValidator.h"
 #include "mdl/TagManager.h"
 #include "mdl/Transaction.h"
+#include "mdl/TransactionScope.h"
 #include "mdl/UndoableCommand.h"
 #include "mdl/UpdateLinkedGroupsCommand.h"
 #include "mdl/UpdateLinkedGroupsHelper.h"
@@ -111,6 +115,7 @@
 #include <memory>
 #include <ranges>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -151,6 +156,21 @@ auto makeCreateResource(gl::ResourceManager& resourceManager)
   };
 }
 
+auto makeCreateTextureResource(
+  gl::ResourceManager& resourceManager,
+  std::shared_ptr<const gl::TextureCompressor> textureCompressor)
+{
+  return [&, textureCompressor = std::move(textureCompressor)](auto textureLoader) {
+    // compress the texture on the worker thread that loads it
+    return makeCreateResource<gl::TextureResource>(resourceManager)(
+      [textureLoader = std::move(textureLoader), textureCompressor]() {
+        return textureLoader() | kdl::transform([&](auto texture) {
+                 return textureCompressor->compress(std::move(texture));
+               });
+      });
+  };
+}
+
 Result<std::unique_ptr<WorldNode>> loadWorldNode(
   const MapFormat mapFormat,
   const GameConfig& config,
@@ -536,6 +556,7 @@ Map::Map(
       makeCreateResource<EntityModelDataResource>(m_resourceManager),
       logger)}
   , m_materialManager{std::make_unique<gl::MaterialManager>(logger)}
+  , m_textureCompressor{std::make_shared<gl::TextureCompressor>()}
   , m_tagManager{std::make_unique<TagManager>()}
   , m_editorContext{std::make_unique<EditorContext>()}
   , m_grid{std::make_unique<Grid>(4)}
@@ -679,6 +700,16 @@ const gl::MaterialManager& Map::materialManager() const
   return *m_materialManager;
 }
 
+gl::TextureCompressor& Map::textureCompressor()
+{
+  return *m_textureCompressor;
+}
+
+const gl::TextureCompressor& Map::textureCompressor() const
+{
+  return *m_textureCompressor;
+}
+
 TagManager& Map::tagManager()
 {
   return *m_tagManager;
@@ -793,6 +824,13 @@ const CommandProcessor& Map::commandProcessor() const
   return *m_commandProcessor;
 }
 
+std::vector<std::string> Map::findNumberedPropertyValues(
+  const std::string_view prefix) const
+{
+  return m_nodeIndex ? m_nodeIndex->findNumberedPropertyValues(prefix)
+                     : std::vector<std::string>{};
+}
+
 const EntityLinkManager& Map::entityLinkManager() const
 {
   return *m_entityLinkManager;
@@ -1216,16 +1254,19 @@ void Map::loadMaterials()
     const auto wadPaths = kdl::str_split(*wadStr, ";")
                           | kdl::ranges::to<std::vector<std::filesystem::path>>();
 
+    // the textures that are still loading read from the wads that are being replaced
+    m_materialManager->waitForLoading();
     m_gameFileSystem->reloadWads(
       gameInfo().gameConfig.materialConfig.root, searchPaths, wadPaths, logger());
   }
 
   m_materialManager->clear();
+  m_tagManager->clearMaterialTagsCache();
 
   loadMaterialCollections(
     *m_gameFileSystem,
     gameInfo().gameConfig.materialConfig,
-    makeCreateResource<gl::TextureResource>(m_resourceManager),
+    makeCreateTextureResource(m_resourceManager, m_textureCompressor),
     taskManager(),
     m_logger)
     | kdl::transform([&](auto materialCollections) {
@@ -1240,6 +1281,7 @@ void Map::clearMaterials()
 {
   unsetMaterials();
   materialManager().clear();
+  m_tagManager->clearMaterialTagsCache();
 }
 
 void Map::setMaterials()
@@ -1336,6 +1378,10 @@ void Map::updateGameFileSystem()
     | std::views::transform([](const auto& mod) { return std::filesystem::path{mod}; })
     | kdl::ranges::to<std::vector>();
 
+  // the assets that are still loading read from the file system that is being replaced
+  m_materialManager->waitForLoading();
+  m_entityModelManager->waitForLoading();
+
   mdl::updateGameFileSystem(
     *m_gameFileSystem,
     environmentConfig(),
@@ -1352,28 +1398,12 @@ void Map::initializeNodeIndex()
 
 void Map::addToNodeIndex(const std::vector<Node*>& nodes, const bool recurse)
 {
-  for (auto* node : nodes)
-  {
-    m_nodeIndex->addNode(*node);
-
-    if (recurse)
-    {
-      addToNodeIndex(node->children(), true);
-    }
-  }
+  m_nodeIndex->addNodes(recurse ? collectNodesAndDescendants(nodes) : nodes);
 }
 
 void Map::removeFromNodeIndex(const std::vector<Node*>& nodes, const bool recurse)
 {
-  for (auto* node : nodes)
-  {
-    m_nodeIndex->removeNode(*node);
-
-    if (recurse)
-    {
-      removeFromNodeIndex(node->children(), true);
-    }
-  }
+  m_nodeIndex->removeNodes(recurse ? collectNodesAndDescendants(nodes) : nodes);
 }
 
 void Map::initializeEntityLinks()
@@ -1447,6 +1477,7 @@ const std::string* Map::redoCommandName() const
 
 void Map::undoCommand()
 {
+  const auto batch = NodeChangeBatch{*this};
   m_commandProcessor->undo();
   updateLinkedGroups(*this);
 
@@ -1457,6 +1488,7 @@ void Map::undoCommand()
 
 void Map::redoCommand()
 {
+  const auto batch = NodeChangeBatch{*this};
   m_commandProcessor->redo();
   updateLinkedGroups(*this);
 
@@ -1498,6 +1530,14 @@ void Map::clearRepeatableCommands()
 void Map::startTransaction(std::string name, const TransactionScope scope)
 {
   logger().debug() << "Starting transaction '" + name + "'";
+
+  const auto batchNodeChanges = scope != TransactionScope::LongRunning;
+  if (batchNodeChanges)
+  {
+    startNodeChangeBatch();
+  }
+  m_transactionNodeChangeBatches.push_back(batchNodeChanges);
+
   m_commandProcessor->startTransaction(std::move(name), scope);
   m_repeatStack->startTransaction();
 }
@@ -1521,6 +1561,7 @@ bool Map::commitTransaction()
 
   m_commandProcessor->commitTransaction();
   m_repeatStack->commitTransaction();
+  endTransactionNodeChangeBatch();
   return true;
 }
 
@@ -1531,6 +1572,7 @@ void Map::cancelTransaction()
   m_repeatStack->rollbackTransaction();
   m_commandProcessor->commitTransaction();
   m_repeatStack->commitTransaction();
+  endTransactionNodeChangeBatch();
 }
 
 bool Map::isCurrentDocumentStateObservable() const
@@ -1543,6 +1585,35 @@ bool Map::throwExceptionDuringCommand()
   return executeAndStore(std::make_unique<ThrowExceptionCommand>());
 }
 
+void Map::startNodeChangeBatch()
+{
+  ++m_nodeChangeBatchDepth;
+}
+
+void Map::endNodeChangeBatch()
+{
+  contract_pre(m_nodeChangeBatchDepth > 0);
+
+  if (--m_nodeChangeBatchDepth == 0 && !m_batchedChangedNodes.empty())
+  {
+    const auto changedNodes =
+      kdl::vec_sort_and_remove_duplicates(std::exchange(m_batchedChangedNodes, {}));
+    batchedNodesDidChangeNotifier(changedNodes);
+  }
+}
+
+void Map::endTransactionNodeChangeBatch()
+{
+  contract_pre(!m_transactionNodeChangeBatches.empty());
+
+  const auto batchNodeChanges = m_transactionNodeChangeBatches.back();
+  m_transactionNodeChangeBatches.pop_back();
+  if (batchNodeChanges)
+  {
+    endNodeChangeBatch();
+  }
+}
+
 bool Map::execute(std::unique_ptr<Command>&& command)
 {
   return m_commandProcessor->execute(std::move(command));
@@ -1666,6 +1737,15 @@ void Map::nodesWillBeRemoved(const std::vector<Node*>& nodes)
 
 void Map::nodesWereRemoved(const std::vector<Node*>& nodes)
 {
+  if (!m_batchedChangedNodes.empty())
+  {
+    // removed nodes must not be passed to observers when the batch ends
+    const auto removedNodes = collectNodesAndDescendants(nodes);
+    std::erase_if(m_batchedChangedNodes, [&](const auto* node) {
+      return std::ranges::binary_search(removedNodes, node);
+    });
+  }
+
   unsetEntityModels(nodes);
   unsetEntityDefinitions(nodes);
   unsetMaterials(nodes);
@@ -1691,6 +1771,14 @@ void Map::nodesDidChange(const std::vector<Node*>& nodes)
 
   m_selection.invalidate();
   m_cachedSelectionBounds = std::nullopt;
+
+  m_batchedChangedNodes = kdl::vec_concat(std::move(m_batchedChangedNodes), nodes);
+  if (m_nodeChangeBatchDepth == 0)
+  {
+    // not in a batch, so notify immediately
+    startNodeChangeBatch();
+    endNodeChangeBatch();
+  }
 }
 
 void Map::brushFacesDidChange(const std::vector<BrushFaceHandle>& brushFaces)
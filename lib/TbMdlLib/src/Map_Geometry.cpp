@@ -711,7 +711,7 @@ bool csgConvexMerge(Map& map)
          | kdl::is_success();
 }
 
-bool csgSubtract(Map& map)
+bool csgSubtract(Map& map, const bool mergeFragments)
 {
   const auto subtrahendNodes = std::vector<BrushNode*>{map.selection().brushes};
   if (subtrahendNodes.empty())
@@ -730,17 +730,36 @@ bool csgSubtract(Map& map)
                              })
                            | kdl::ranges::to<std::vector>();
 
+  const auto mapFormat = map.worldNode().mapFormat();
+  const auto& worldBounds = map.worldBounds();
+  const auto& materialName = map.currentMaterialName();
+
+  // Only pass the subtrahends which can affect a minuend, and subtract from the minuends
+  // in parallel.
+  auto tasks = minuendNodes | std::views::transform([&](auto* minuendNode) {
+    return std::function{[&, minuendNode]() {
+      const auto& minuend = minuendNode->brush();
+      const auto overlappingSubtrahends =
+        subtrahends | std::views::filter([&](const auto* subtrahend) {
+          return minuend.bounds().intersects(subtrahend->bounds());
+        })
+        | kdl::ranges::to<std::vector>();
+
+      return std::pair{
+        minuendNode,
+        minuend.subtract(
+          mapFormat, worldBounds, materialName, overlappingSubtrahends, mergeFragments)};
+    }};
+  });
+  auto subtractionResults = map.taskManager().run_tasks_and_wait(tasks);
+
   auto toAdd = std::map<Node*, std::vector<Node*>>{};
   auto toRemove =
     std::vector<Node*>{std::begin(subtrahendNodes), std::end(subtrahendNodes)};
 
-  return minuendNodes | std::views::transform([&](auto* minuendNode) {
-           const auto& minuend = minuendNode->brush();
-           auto currentSubtractionResults = minuend.subtract(
-             map.worldNode().mapFormat(),
-             map.worldBounds(),
-             map.currentMaterialName(),
-             subtrahends);
+  return subtractionResults | std::views::transform([&](auto& subtractionResult) {
+           auto* minuendNode = subtractionResult.first;
+           auto& currentSubtractionResults = subtractionResult.second;
 
            return currentSubtractionResults
                   | std::views::filter([](const auto r) { return r | kdl::is_success(); })
@@ -30,6 +30,7 @@
 #include "mdl/Map.h"
 #include "mdl/Map_Groups.h"
 #include "mdl/Map_Nodes.h"
+#include "mdl/MaterialName.h"
 #include "mdl/ModelUtils.h"
 #include "mdl/Node.h"
 #include "mdl/PatchNode.h"
@@ -40,7 +41,7 @@
 #include "kd/contracts.h"
 #include "kd/ranges/to.h"
 #include "kd/result_fold.h"
-#include "kd/string_compare.h"
+#include "kd/string_format.h"
 
 #include <algorithm>
 #include <ranges>
@@ -49,6 +50,24 @@
 
 namespace tb::mdl
 {
+namespace
+{
+
+/**
+ * Returns a predicate that matches brush faces whose material name is equal to the given
+ * name when ignoring case. Since every interned material name refers to its lower case
+ * version, the predicate only compares interned names.
+ */
+auto makeMaterialNameMatcher(const std::string_view materialName)
+{
+  const auto lowerCaseMaterialName = MaterialName::find(kdl::str_to_lower(materialName));
+  return [=](const BrushFace& face) {
+    return lowerCaseMaterialName
+           && face.attributes().internedMaterialName().toLower() == *lowerCaseMaterialName;
+  };
+}
+
+} // namespace
 
 void selectAllNodes(Map& map)
 {
@@ -259,14 +278,13 @@ void selectNodesWithFilePosition(Map& map, const std::vector<size_t>& positions)
 
 void selectBrushesWithMaterial(Map& map, const std::string_view materialName)
 {
+  const auto matchesMaterialName = makeMaterialNameMatcher(materialName);
   const auto brushes =
     collectSelectableNodes(std::vector<Node*>{&map.worldNode()}, map.editorContext())
     | std::views::filter([&](const auto& node) {
         return std::ranges::any_of(
-          collectSelectableBrushFaces({node}, map.editorContext()), [&](const auto& h) {
-            return kdl::ci::str_is_equal(
-              h.face().attributes().materialName(), materialName);
-          });
+          collectSelectableBrushFaces({node}, map.editorContext()),
+          [&](const auto& h) { return matchesMaterialName(h.face()); });
       })
     | kdl::ranges::to<std::vector>();
 
@@ -380,11 +398,10 @@ void selectBrushFaces(Map& map, const std::vector<BrushFaceHandle>& handles)
 
 void selectBrushFacesWithMaterial(Map& map, const std::string_view materialName)
 {
+  const auto matchesMaterialName = makeMaterialNameMatcher(materialName);
   const auto faces =
     collectSelectableBrushFaces(std::vector<Node*>{&map.worldNode()}, map.editorContext())
-    | std::views::filter([&](const auto& h) {
-        return kdl::ci::str_is_equal(h.face().attributes().materialName(), materialName);
-      })
+    | std::views::filter([&](const auto& h) { return matchesMaterialName(h.face()); })
     | kdl::ranges::to<std::vector>();
 
   auto transaction = Transaction{map, "Select Faces with Material"};
@@ -0,0 +1,170 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/MaterialName.h"
+
+#include "kd/string_format.h"
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace tb::mdl
+{
+
+struct MaterialNameEntry
+{
+  std::string name;
+  const MaterialNameEntry* lowerCaseEntry = nullptr;
+  size_t caseInsensitiveHash = 0;
+};
+
+namespace
+{
+
+class MaterialNameTable
+{
+private:
+  std::shared_mutex m_mutex;
+  std::unordered_map<std::string_view, std::unique_ptr<const MaterialNameEntry>>
+    m_entries;
+
+public:
+  static MaterialNameTable& instance()
+  {
+    static auto table = MaterialNameTable{};
+    return table;
+  }
+
+  const MaterialNameEntry* intern(const std::string_view name)
+  {
+    {
+      auto lock = std::shared_lock{m_mutex};
+      if (const auto it = m_entries.find(name); it != m_entries.end())
+      {
+        return it->second.get();
+      }
+    }
+
+    auto lock = std::unique_lock{m_mutex};
+    return doIntern(name);
+  }
+
+  const MaterialNameEntry* find(const std::string_view name)
+  {
+    auto lock = std::shared_lock{m_mutex};
+    const auto it = m_entries.find(name);
+    return it != m_entries.end() ? it->second.get() : nullptr;
+  }
+
+private:
+  const MaterialNameEntry* doIntern(const std::string_view name)
+  {
+    if (const auto it = m_entries.find(name); it != m_entries.end())
+    {
+      return it->second.get();
+    }
+
+    auto lowerCaseName = kdl::str_to_lower(name);
+    const auto* lowerCaseEntry = lowerCaseName != name ? doIntern(lowerCaseName) : nullptr;
+
+    auto entry = std::make_unique<MaterialNameEntry>();
+    entry->name = std::string{name};
+    entry->lowerCaseEntry = lowerCaseEntry ? lowerCaseEntry : entry.get();
+    entry->caseInsensitiveHash = std::hash<std::string>{}(lowerCaseName);
+
+    const auto key = std::string_view{entry->name};
+    return m_entries.emplace(key, std::move(entry)).first->second.get();
+  }
+};
+
+} // namespace
+
+MaterialName::MaterialName()
+  : MaterialName{std::string_view{}}
+{
+}
+
+MaterialName::MaterialName(const std::string_view name)
+  : m_entry{MaterialNameTable::instance().intern(name)}
+{
+}
+
+std::optional<MaterialName> MaterialName::find(const std::string_view name)
+{
+  if (const auto* entry = MaterialNameTable::instance().find(name))
+  {
+    auto result = MaterialName{};
+    result.m_entry = entry;
+    return result;
+  }
+  return std::nullopt;
+}
+
+const std::string& MaterialName::str() const
+{
+  return m_entry->name;
+}
+
+bool MaterialName::empty() const
+{
+  return m_entry->name.empty();
+}
+
+size_t MaterialName::caseInsensitiveHash() const
+{
+  return m_entry->caseInsensitiveHash;
+}
+
+bool MaterialName::isEqualIgnoringCase(const MaterialName& other) const
+{
+  return m_entry->lowerCaseEntry == other.m_entry->lowerCaseEntry;
+}
+
+MaterialName MaterialName::toLower() const
+{
+  auto result = MaterialName{};
+  result.m_entry = m_entry->lowerCaseEntry;
+  return result;
+}
+
+bool operator==(const MaterialName& lhs, const MaterialName& rhs)
+{
+  return lhs.m_entry == rhs.m_entry;
+}
+
+std::strong_ordering operator<=>(const MaterialName& lhs, const MaterialName& rhs)
+{
+  return lhs.m_entry == rhs.m_entry ? std::strong_ordering::equal
+                                    : lhs.m_entry->name <=> rhs.m_entry->name;
+}
+
+bool operator==(const MaterialName& lhs, const std::string_view rhs)
+{
+  return lhs.m_entry->name == rhs;
+}
+
+std::ostream& operator<<(std::ostream& lhs, const MaterialName& rhs)
+{
+  return lhs << rhs.m_entry->name;
+}
+
+} // namespace tb::mdl
@@ -143,16 +143,19 @@ std::optional<vm::vec3d> convertToScale(
 
 ModelDefinition::ModelDefinition()
   : m_expression{el::LiteralExpression{el::Value::Undefined}}
+  , m_compiledExpression{m_expression}
 {
 }
 
 ModelDefinition::ModelDefinition(const FileLocation& location)
   : m_expression{el::LiteralExpression{el::Value::Undefined}, location}
+  , m_compiledExpression{m_expression}
 {
 }
 
 ModelDefinition::ModelDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_compiledExpression{m_expression}
 {
 }
 
@@ -162,6 +165,7 @@ void ModelDefinition::append(ModelDefinition other)
 
   auto cases = std::vector{std::move(m_expression), std::move(other.m_expression)};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_compiledExpression = el::CompiledExpression{m_expression};
 }
 
 Result<ModelSpecification> ModelDefinition::modelSpecification(
@@ -169,7 +173,7 @@ Result<ModelSpecification> ModelDefinition::modelSpecification(
 {
   return el::withEvaluationContext(
     [&](auto& context) {
-      return convertToModel(context, m_expression.evaluate(context));
+      return convertToModel(context, m_compiledExpression.evaluate(context));
     },
     variableStore);
 }
@@ -187,7 +191,7 @@ Result<vm::vec3d> ModelDefinition::scale(
 {
   return el::withEvaluationContext(
     [&](auto& context) {
-      const auto value = m_expression.evaluate(context);
+      const auto value = m_compiledExpression.evaluate(context);
 
       switch (value.type())
       {
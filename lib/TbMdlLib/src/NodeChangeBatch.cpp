@@ -0,0 +1,38 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/NodeChangeBatch.h"
+
+#include "mdl/Map.h"
+
+namespace tb::mdl
+{
+
+NodeChangeBatch::NodeChangeBatch(Map& map)
+  : m_map{map}
+{
+  m_map.startNodeChangeBatch();
+}
+
+NodeChangeBatch::~NodeChangeBatch()
+{
+  m_map.endNodeChangeBatch();
+}
+
+} // namespace tb::mdl
@@ -55,4 +55,28 @@ std::variant<Layer, Group, Entity, Brush, BezierPatch>& NodeContents::get()
   return m_contents;
 }
 
+size_t NodeContents::memoryFootprint(
+  std::unordered_set<const BrushGeometry*>& countedGeometries) const
+{
+  return std::visit(
+    kdl::overload(
+      [](const Layer&) { return sizeof(Layer); },
+      [](const Group&) { return sizeof(Group); },
+      [](const Entity& entity) {
+        auto result = sizeof(Entity);
+        for (const auto& property : entity.properties())
+        {
+          result += sizeof(EntityProperty) + property.key().capacity()
+                    + property.value().capacity();
+        }
+        return result;
+      },
+      [&](const Brush& brush) { return brush.memoryFootprint(countedGeometries); },
+      [](const BezierPatch& patch) {
+        return sizeof(BezierPatch)
+               + patch.controlPoints().size() * sizeof(BezierPatch::Point);
+      }),
+    m_contents);
+}
+
 } // namespace tb::mdl
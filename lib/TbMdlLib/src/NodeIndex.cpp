@@ -23,6 +23,7 @@
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/Entity.h"
+#include "mdl/EntityProperties.h"
 #include "mdl/EntityNode.h"
 #include "mdl/EntityNodeBase.h"
 #include "mdl/Group.h"
@@ -36,6 +37,9 @@
 #include "kd/compact_trie.h"
 #include "kd/vector_utils.h"
 
+#include <algorithm>
+#include <tuple>
+
 namespace tb::mdl
 {
 namespace
@@ -72,8 +76,146 @@ void withPatchNode(PatchNode& patchNode, const F& f)
   f(patchNode.patch().materialName());
 }
 
+template <typename F, typename G>
+void withIndexedStrings(Node& node, const F& addString, const G& addProperty)
+{
+  const auto withProperties = [&](EntityNodeBase& entityNode) {
+    withEntityNode(entityNode, addString);
+    for (const auto& property : entityNode.entity().properties())
+    {
+      addProperty(property.key(), property.value());
+    }
+  };
+
+  node.accept(kdl::overload(
+    [&](WorldNode* worldNode) { withProperties(*worldNode); },
+    [](LayerNode*) {},
+    [&](GroupNode* groupNode) { withGroupNode(*groupNode, addString); },
+    [&](EntityNode* entityNode) { withProperties(*entityNode); },
+    [&](BrushNode* brushNode) { withBrushNode(*brushNode, addString); },
+    [&](PatchNode* patchNode) { withPatchNode(*patchNode, addString); }));
+}
+
+struct StringEntry
+{
+  std::string_view string;
+  Node* node;
+};
+
+struct PropertyEntry
+{
+  std::string_view key;
+  std::string_view value;
+  Node* node;
+};
+
+void collectEntries(
+  const std::vector<Node*>& nodes,
+  std::vector<StringEntry>& stringEntries,
+  std::vector<PropertyEntry>& propertyEntries)
+{
+  for (auto* node : nodes)
+  {
+    withIndexedStrings(
+      *node,
+      [&](const std::string_view string) {
+        stringEntries.push_back(StringEntry{string, node});
+      },
+      [&](const std::string_view key, const std::string_view value) {
+        propertyEntries.push_back(PropertyEntry{key, value, node});
+      });
+  }
+
+  // Sorting groups the entries by key and value so that each map lookup below is done
+  // once per distinct key and value instead of once per entry.
+  std::ranges::sort(stringEntries, std::less<>{}, &StringEntry::string);
+  std::ranges::sort(propertyEntries, [](const auto& lhs, const auto& rhs) {
+    return std::tie(lhs.key, lhs.value) < std::tie(rhs.key, rhs.value);
+  });
+}
+
+template <typename T>
+T& findOrInsert(NodeIndexStringMap<T>& map, const std::string_view key)
+{
+  if (const auto it = map.find(key); it != map.end())
+  {
+    return it->second;
+  }
+  return map.emplace(std::string{key}, T{}).first->second;
+}
+
+/**
+ * Calls f for every run of property entries that share a key and value. The function
+ * receives the key, the value and the nodes of the run.
+ */
+template <typename F>
+void forEachPropertyRun(const std::vector<PropertyEntry>& propertyEntries, const F& f)
+{
+  auto nodes = std::vector<Node*>{};
+  for (auto first = propertyEntries.begin(); first != propertyEntries.end();)
+  {
+    const auto last = std::find_if(first, propertyEntries.end(), [&](const auto& entry) {
+      return entry.key != first->key || entry.value != first->value;
+    });
+
+    nodes.clear();
+    std::transform(first, last, std::back_inserter(nodes), [](const auto& entry) {
+      return entry.node;
+    });
+    f(first->key, first->value, nodes);
+
+    first = last;
+  }
+}
+
+void removeFromPropertyIndex(
+  NodePropertyIndex& propertyIndex,
+  const std::string_view key,
+  const std::string_view value,
+  const std::vector<Node*>& nodes)
+{
+  if (const auto keyIt = propertyIndex.find(key); keyIt != propertyIndex.end())
+  {
+    auto& valueIndex = keyIt->second;
+    if (const auto valueIt = valueIndex.find(value); valueIt != valueIndex.end())
+    {
+      auto& indexedNodes = valueIt->second;
+      if (nodes.size() == 1)
+      {
+        if (const auto nodeIt = std::ranges::find(indexedNodes, nodes.front());
+            nodeIt != indexedNodes.end())
+        {
+          *nodeIt = indexedNodes.back();
+          indexedNodes.pop_back();
+        }
+      }
+      else
+      {
+        auto sortedNodes = kdl::vec_sort(nodes);
+        std::erase_if(indexedNodes, [&](auto* node) {
+          return std::ranges::binary_search(sortedNodes, node);
+        });
+      }
+
+      if (indexedNodes.empty())
+      {
+        valueIndex.erase(valueIt);
+        if (valueIndex.empty())
+        {
+          propertyIndex.erase(keyIt);
+        }
+      }
+    }
+  }
+}
+
 } // namespace
 
+std::size_t NodeIndexStringHash::operator()(const std::string_view str) const noexcept
+{
+  return std::hash<std::string_view>{}(str);
+}
+
 NodeIndex::NodeIndex()
   : m_index{std::make_unique<NodeStringIndex>()}
 {
@@ -83,37 +225,90 @@ NodeIndex::~NodeIndex() = default;
 
 void NodeIndex::addNode(Node& node)
 {
-  const auto addToIndex = [&](const std::string_view key) {
-    m_index->insert(key, &node);
-  };
-
-  node.accept(kdl::overload(
-    [&](WorldNode* worldNode) { withEntityNode(*worldNode, addToIndex); },
-    [](LayerNode*) {},
-    [&](GroupNode* groupNode) { withGroupNode(*groupNode, addToIndex); },
-    [&](EntityNode* entityNode) { withEntityNode(*entityNode, addToIndex); },
-    [&](BrushNode* brushNode) { withBrushNode(*brushNode, addToIndex); },
-    [&](PatchNode* patchNode) { withPatchNode(*patchNode, addToIndex); }));
+  withIndexedStrings(
+    node,
+    [&](const std::string_view string) { m_index->insert(string, &node); },
+    [&](const std::string_view key, const std::string_view value) {
+      findOrInsert(findOrInsert(m_propertyIndex, key), value).push_back(&node);
+    });
 }
 
 void NodeIndex::removeNode(Node& node)
 {
-  const auto removeFromIndex = [&](const std::string_view key) {
-    m_index->remove(key, &node);
-  };
+  withIndexedStrings(
+    node,
+    [&](const std::string_view string) { m_index->remove(string, &node); },
+    [&](const std::string_view key, const std::string_view value) {
+      removeFromPropertyIndex(m_propertyIndex, key, value, {&node});
+    });
+}
 
-  node.accept(kdl::overload(
-    [&](WorldNode* worldNode) { withEntityNode(*worldNode, removeFromIndex); },
-    [](LayerNode*) {},
-    [&](GroupNode* groupNode) { withGroupNode(*groupNode, removeFromIndex); },
-    [&](EntityNode* entityNode) { withEntityNode(*entityNode, removeFromIndex); },
-    [&](BrushNode* brushNode) { withBrushNode(*brushNode, removeFromIndex); },
-    [&](PatchNode* patchNode) { withPatchNode(*patchNode, removeFromIndex); }));
+void NodeIndex::addNodes(const std::vector<Node*>& nodes)
+{
+  auto stringEntries = std::vector<StringEntry>{};
+  auto propertyEntries = std::vector<PropertyEntry>{};
+  collectEntries(nodes, stringEntries, propertyEntries);
+
+  for (const auto& [string, node] : stringEntries)
+  {
+    m_index->insert(string, node);
+  }
+
+  NodeIndexStringMap<std::vector<Node*>>* valueIndex = nullptr;
+  auto currentKey = std::string_view{};
+  forEachPropertyRun(
+    propertyEntries,
+    [&](const auto key, const auto value, const std::vector<Node*>& runNodes) {
+      if (!valueIndex || key != currentKey)
+      {
+        valueIndex = &findOrInsert(m_propertyIndex, key);
+        currentKey = key;
+      }
+
+      auto& indexedNodes = findOrInsert(*valueIndex, value);
+      indexedNodes.insert(indexedNodes.end(), runNodes.begin(), runNodes.end());
+    });
+}
+
+void NodeIndex::removeNodes(const std::vector<Node*>& nodes)
+{
+  auto stringEntries = std::vector<StringEntry>{};
+  auto propertyEntries = std::vector<PropertyEntry>{};
+  collectEntries(nodes, stringEntries, propertyEntries);
+
+  for (const auto& [string, node] : stringEntries)
+  {
+    m_index->remove(string, node);
+  }
+
+  forEachPropertyRun(
+    propertyEntries,
+    [&](const auto key, const auto value, const std::vector<Node*>& runNodes) {
+      removeFromPropertyIndex(m_propertyIndex, key, value, runNodes);
+    });
 }
 
 void NodeIndex::clear()
 {
   m_index = std::make_unique<NodeStringIndex>();
+  m_propertyIndex.clear();
+}
+
+std::vector<std::string> NodeIndex::findNumberedPropertyValues(
+  const std::string_view prefix) const
+{
+  auto result = std::vector<std::string>{};
+  for (const auto& [key, valueIndex] : m_propertyIndex)
+  {
+    if (isNumberedProperty(prefix, key))
+    {
+      for (const auto& [value, nodes] : valueIndex)
+      {
+        result.push_back(value);
+      }
+    }
+  }
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
 }
 
 std::vector<Node*> NodeIndex::doFindNodes(const std::string_view pattern) const
@@ -123,4 +318,49 @@ std::vector<Node*> NodeIndex::doFindNodes(const std::string_view pattern) const
   return kdl::vec_sort_and_remove_duplicates(std::move(result));
 }
 
+std::vector<Node*> NodeIndex::doFindNodesWithProperty(
+  const std::string_view key, const std::string_view value) const
+{
+  if (const auto keyIt = m_propertyIndex.find(key); keyIt != m_propertyIndex.end())
+  {
+    const auto& valueIndex = keyIt->second;
+    if (const auto valueIt = valueIndex.find(value); valueIt != valueIndex.end())
+    {
+      return kdl::vec_sort_and_remove_duplicates(valueIt->second);
+    }
+  }
+  return {};
+}
+
+std::vector<Node*> NodeIndex::doFindNodesWithPropertyValue(
+  const std::string_view value) const
+{
+  auto result = std::vector<Node*>{};
+  for (const auto& [key, valueIndex] : m_propertyIndex)
+  {
+    if (const auto valueIt = valueIndex.find(value); valueIt != valueIndex.end())
+    {
+      result = kdl::vec_concat(std::move(result), valueIt->second);
+    }
+  }
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+
+std::vector<Node*> NodeIndex::doFindNodesWithNumberedProperty(
+  const std::string_view prefix, const std::string_view value) const
+{
+  auto result = std::vector<Node*>{};
+  for (const auto& [key, valueIndex] : m_propertyIndex)
+  {
+    if (isNumberedProperty(prefix, key))
+    {
+      if (const auto valueIt = valueIndex.find(value); valueIt != valueIndex.end())
+      {
+        result = kdl::vec_concat(std::move(result), valueIt->second);
+      }
+    }
+  }
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+
 } // namespace tb::mdl
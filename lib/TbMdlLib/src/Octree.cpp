@@ -36,6 +36,17 @@ namespace
          || (is_valid(x) && is_valid(y) && is_valid(z));
 }
 
+std::uint64_t spread_bits(const std::uint16_t value)
+{
+  auto x = std::uint64_t(value);
+  x = (x | (x << 32)) & 0x001f00000000ffff;
+  x = (x | (x << 16)) & 0x001f0000ff0000ff;
+  x = (x | (x << 8)) & 0x100f00f00f00f00f;
+  x = (x | (x << 4)) & 0x10c30c30c30c30c3;
+  x = (x | (x << 2)) & 0x1249249249249249;
+  return x;
+}
+
 } // namespace
 
 node_address::node_address(
@@ -149,4 +160,13 @@ node_address get_container(const node_address& address1, const node_address& add
   return container;
 }
 
+std::uint64_t get_morton_code(const node_address& address)
+{
+  // shift the coordinates so that they are non-negative and keep their order
+  const auto offset = [](const int16_t n) { return std::uint16_t(int32_t(n) + 32768); };
+
+  return spread_bits(offset(address.x)) | (spread_bits(offset(address.y)) << 1)
+         | (spread_bits(offset(address.z)) << 2);
+}
+
 } // namespace tb::mdl::detail
@@ -33,6 +33,9 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 #include <string>
@@ -63,6 +66,35 @@ Palette::Palette(std::shared_ptr<PaletteData> data)
 {
 }
 
+namespace
+{
+
+using PaletteTable = std::array<uint32_t, 256>;
+
+PaletteTable makePaletteTable(const std::vector<unsigned char>& paletteData)
+{
+  auto result = PaletteTable{};
+  std::memcpy(
+    result.data(),
+    paletteData.data(),
+    std::min(paletteData.size(), result.size() * sizeof(uint32_t)));
+  return result;
+}
+
+void lookupRgba(
+  const unsigned char* indices,
+  const size_t pixelCount,
+  const PaletteTable& table,
+  unsigned char* rgbaData)
+{
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    std::memcpy(rgbaData + 4 * i, &table[indices[i]], 4);
+  }
+}
+
+} // namespace
+
 bool Palette::indexedToRgba(
   fs::Reader& reader,
   const size_t pixelCount,
@@ -72,47 +104,46 @@ bool Palette::indexedToRgba(
 {
   contract_pre(rgbaImage.size() == 4 * pixelCount);
 
-  const unsigned char* paletteData = (transparency == PaletteTransparency::Opaque)
-                                       ? m_data->opaqueData.data()
-                                       : m_data->index255TransparentData.data();
+  const auto& paletteData = (transparency == PaletteTransparency::Opaque)
+                              ? m_data->opaqueData
+                              : m_data->index255TransparentData;
+  const auto table = makePaletteTable(paletteData);
+
+  auto indices = std::vector<unsigned char>(pixelCount);
+  reader.read(indices.data(), indices.size());
 
   // Write rgba pixels
-  auto* const rgbaData = rgbaImage.data();
-  for (size_t i = 0; i < pixelCount; ++i)
-  {
-    const int index = reader.readInt<unsigned char>();
+  lookupRgba(indices.data(), pixelCount, table, rgbaImage.data());
 
-    std::memcpy(rgbaData + (i * 4), &paletteData[index * 4], 4);
+  // Compute the average color and the transparency from a histogram of the indices
+  // rather than from the rgba pixels
+  auto histogram = std::array<size_t, 256>{};
+  for (const auto index : indices)
+  {
+    ++histogram[index];
   }
 
-  // Check average color
-  uint32_t colorSum[3] = {0, 0, 0};
-  for (size_t i = 0; i < pixelCount; ++i)
+  const auto* tableData = reinterpret_cast<const unsigned char*>(table.data());
+  uint64_t colorSum[3] = {0, 0, 0};
+  unsigned char andAlpha = 0xFF;
+  for (size_t index = 0; index < histogram.size(); ++index)
   {
-    colorSum[0] += uint32_t(rgbaData[(i * 4) + 0]);
-    colorSum[1] += uint32_t(rgbaData[(i * 4) + 1]);
-    colorSum[2] += uint32_t(rgbaData[(i * 4) + 2]);
+    if (const auto count = histogram[index]; count > 0)
+    {
+      colorSum[0] += count * uint64_t(tableData[(index * 4) + 0]);
+      colorSum[1] += count * uint64_t(tableData[(index * 4) + 1]);
+      colorSum[2] += count * uint64_t(tableData[(index * 4) + 2]);
+      andAlpha = static_cast<unsigned char>(andAlpha & tableData[(index * 4) + 3]);
+    }
   }
+
   averageColor = RgbaF{
     float(colorSum[0]) / (255.0f * float(pixelCount)),
     float(colorSum[1]) / (255.0f * float(pixelCount)),
     float(colorSum[2]) / (255.0f * float(pixelCount)),
     1.0f};
 
-  // Check for transparency
-  auto hasTransparency = false;
-  if (transparency == PaletteTransparency::Index255Transparent)
-  {
-    // Take the bitwise AND of the alpha channel of all pixels
-    unsigned char andAlpha = 0xFF;
-    for (size_t i = 0; i < pixelCount; ++i)
-    {
-      andAlpha = static_cast<unsigned char>(andAlpha & rgbaData[4 * i + 3]);
-    }
-    hasTransparency = (andAlpha != 0xFF);
-  }
-
-  return hasTransparency;
+  return transparency == PaletteTransparency::Index255Transparent && andAlpha != 0xFF;
 }
 
 bool operator==(const Palette& lhs, const Palette& rhs)
@@ -31,14 +31,37 @@
 
 #include <fmt/format.h>
 
+#include <optional>
 #include <ranges>
 #include <string>
+#include <vector>
 
 namespace tb::mdl
 {
 namespace
 {
 
+std::optional<std::vector<size_t>> toDependencies(
+  const el::EvaluationContext& context, const el::Value& value)
+{
+  if (!value.contains(context, "dependencies"))
+  {
+    return std::nullopt;
+  }
+
+  return value.at(context, "dependencies").arrayValue(context)
+         | std::views::transform([&](const auto& dependencyValue) {
+             const auto dependency = dependencyValue.integerValue(context);
+             if (dependency < 0)
+             {
+               throw ParserException{
+                 fmt::format("Invalid task dependency {}", dependency)};
+             }
+             return size_t(dependency);
+           })
+         | kdl::ranges::to<std::vector>();
+}
+
 CompilationExportMap toExportTask(
   const el::EvaluationContext& context, const el::Value& value)
 {
@@ -53,6 +76,7 @@ CompilationExportMap toExportTask(
     enabled,
     stripTbProperties,
     value.at(context, "target").stringValue(context),
+    toDependencies(context, value),
   };
 }
 
@@ -66,6 +90,7 @@ CompilationCopyFiles toCopyTask(
     enabled,
     value.at(context, "source").stringValue(context),
     value.at(context, "target").stringValue(context),
+    toDependencies(context, value),
   };
 }
 
@@ -79,6 +104,7 @@ CompilationRenameFile toRenameTask(
     enabled,
     value.at(context, "source").stringValue(context),
     value.at(context, "target").stringValue(context),
+    toDependencies(context, value),
   };
 }
 
@@ -91,6 +117,7 @@ CompilationDeleteFiles toDeleteTask(
   return {
     enabled,
     value.at(context, "target").stringValue(context),
+    toDependencies(context, value),
   };
 }
 
@@ -110,6 +137,7 @@ CompilationRunTool toToolTask(
     value.at(context, "tool").stringValue(context),
     value.at(context, "parameters").stringValue(context),
     treatNonZeroResultCodeAsError,
+    toDependencies(context, value),
   };
 }
 
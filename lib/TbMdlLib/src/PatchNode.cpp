@@ -46,7 +46,11 @@
 namespace tb::mdl
 {
 
-constexpr static size_t DefaultSubdivisionsPerSurface = 3u;
+constexpr static size_t MaxSubdivisionsPerSurface = 3u;
+
+// The maximum distance between a patch and its grid, in world units. Patches that are
+// not flat within this distance are subdivided as often as possible.
+constexpr static double MaxGridError = 1.0 / 64.0;
 
 kdl_reflect_impl(PatchGrid::Point);
 
@@ -68,8 +72,110 @@ size_t PatchGrid::quadColumnCount() const
   return pointColumnCount - 1u;
 }
 
+size_t PatchGrid::lodStride(const double maxError) const
+{
+  const auto subdivisions =
+    computeSubdivisionsPerSurface(flatnessError, maxError, subdivisionsPerSurface);
+  return size_t(1) << (subdivisionsPerSurface - subdivisions);
+}
+
 kdl_reflect_impl(PatchGrid);
 
+namespace
+{
+
+// The error of the texture coordinates is weighted such that 1/4096 of a texture repeat,
+// which is less than a texel for textures of up to 4096 pixels, counts as much as
+// MaxGridError.
+constexpr double UVErrorWeight = MaxGridError * 4096.0;
+
+/**
+ * Returns an upper bound of the distance between a biquadratic Bezier surface and the
+ * two triangles connecting its corners. The surface is given by a function that returns
+ * one of the components of its control points, e.g. the position.
+ *
+ * The distance between a quadratic Bezier curve and the line connecting its end points is
+ * at most |P0 - 2 * P1 + P2| / 4. Applying this to the control rows and then to the
+ * control columns bounds the distance between the surface and the bilinear surface
+ * spanned by its corners. The distance between that bilinear surface and the triangles
+ * is at most a quarter of its twist, which is bounded by four times the largest twist of
+ * the 2x2 blocks of control points.
+ *
+ * The three terms must be added up since they can all reach their maximum at the center
+ * of the surface. Subdividing a surface in half reduces each of them by a factor of four.
+ */
+template <typename C>
+double computeSurfaceFlatnessError(const C& component)
+{
+  auto rowError = 0.0;
+  auto colError = 0.0;
+  for (size_t i = 0u; i < 3u; ++i)
+  {
+    rowError = vm::max(
+      rowError,
+      vm::length(component(i, 0u) - 2.0 * component(i, 1u) + component(i, 2u)));
+    colError = vm::max(
+      colError,
+      vm::length(component(0u, i) - 2.0 * component(1u, i) + component(2u, i)));
+  }
+
+  auto twistError = 0.0;
+  for (size_t i = 0u; i < 2u; ++i)
+  {
+    for (size_t j = 0u; j < 2u; ++j)
+    {
+      twistError = vm::max(
+        twistError,
+        vm::length(
+          component(i, j) - component(i, j + 1u) - component(i + 1u, j)
+          + component(i + 1u, j + 1u)));
+    }
+  }
+
+  return (rowError + colError) / 4.0 + twistError;
+}
+
+} // namespace
+
+double computePatchFlatnessError(const BezierPatch& patch)
+{
+  auto error = 0.0;
+  for (size_t surfaceRow = 0u; surfaceRow < patch.surfaceRowCount(); ++surfaceRow)
+  {
+    for (size_t surfaceCol = 0u; surfaceCol < patch.surfaceColumnCount(); ++surfaceCol)
+    {
+      const auto controlPoint = [&](const size_t row, const size_t col) {
+        return patch.controlPoint(surfaceRow * 2u + row, surfaceCol * 2u + col);
+      };
+      const auto position = [&](const size_t row, const size_t col) {
+        return vm::slice<3>(controlPoint(row, col), 0);
+      };
+      const auto uvCoords = [&](const size_t row, const size_t col) {
+        return vm::slice<2>(controlPoint(row, col), 3);
+      };
+
+      error = vm::max(
+        error,
+        computeSurfaceFlatnessError(position),
+        computeSurfaceFlatnessError(uvCoords) * UVErrorWeight);
+    }
+  }
+
+  return error;
+}
+
+size_t computeSubdivisionsPerSurface(
+  double flatnessError, const double maxError, const size_t maxSubdivisionsPerSurface)
+{
+  auto subdivisionsPerSurface = size_t(0);
+  while (subdivisionsPerSurface < maxSubdivisionsPerSurface && flatnessError > maxError)
+  {
+    flatnessError /= 4.0;
+    ++subdivisionsPerSurface;
+  }
+  return subdivisionsPerSurface;
+}
+
 /**
  * Compute the normals for the given patch grid points.
  *
@@ -296,14 +402,26 @@ PatchGrid makePatchGrid(const BezierPatch& patch, const size_t subdivisionsPerSu
   }
 
   return {
-    gridPointRowCount, gridPointColumnCount, std::move(points), boundsBuilder.bounds()};
+    gridPointRowCount,
+    gridPointColumnCount,
+    std::move(points),
+    boundsBuilder.bounds(),
+    subdivisionsPerSurface,
+    computePatchFlatnessError(patch)};
+}
+
+PatchGrid makePatchGrid(const BezierPatch& patch)
+{
+  const auto subdivisionsPerSurface = computeSubdivisionsPerSurface(
+    computePatchFlatnessError(patch), MaxGridError, MaxSubdivisionsPerSurface);
+  return makePatchGrid(patch, subdivisionsPerSurface);
 }
 
 const HitType::Type PatchNode::PatchHitType = HitType::freeType();
 
 PatchNode::PatchNode(BezierPatch patch)
   : m_patch{std::move(patch)}
-  , m_grid{makePatchGrid(m_patch, DefaultSubdivisionsPerSurface)}
+  , m_grid{makePatchGrid(m_patch)}
 {
 }
 
@@ -344,7 +462,24 @@ BezierPatch PatchNode::setPatch(BezierPatch patch)
   const auto boundsChange = NotifyPhysicalBoundsChange{*this};
 
   auto previousPatch = std::exchange(m_patch, std::move(patch));
-  m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+  m_grid = makePatchGrid(m_patch);
+  return previousPatch;
+}
+
+BezierPatch PatchNode::setPatch(BezierPatch patch, PatchGrid grid)
+{
+  contract_pre(
+    grid.pointRowCount
+    == patch.surfaceRowCount() * (size_t(1) << grid.subdivisionsPerSurface) + 1u);
+  contract_pre(
+    grid.pointColumnCount
+    == patch.surfaceColumnCount() * (size_t(1) << grid.subdivisionsPerSurface) + 1u);
+
+  const auto nodeChange = NotifyNodeChange{*this};
+  const auto boundsChange = NotifyPhysicalBoundsChange{*this};
+
+  auto previousPatch = std::exchange(m_patch, std::move(patch));
+  m_grid = std::move(grid);
   return previousPatch;
 }
 
@@ -26,10 +26,14 @@
 #include "mdl/Map_World.h"
 #include "mdl/Node.h"
 #include "mdl/NodeQueries.h"
+#include "mdl/PatchNode.h"
 
 #include "kd/ranges/to.h"
+#include "kd/task_manager.h"
 
+#include <functional>
 #include <ranges>
+#include <unordered_set>
 
 namespace tb::mdl
 {
@@ -70,6 +74,27 @@ auto notifySpecialWorldProperties(
   return std::tuple{false, false, false};
 }
 
+/**
+ * Makes the grids of all patches to be swapped in parallel, in the order in which the
+ * patches appear in the given vector.
+ */
+std::vector<PatchGrid> makePatchGrids(
+  const std::vector<std::pair<Node*, NodeContents>>& nodesToSwap,
+  kdl::task_manager& taskManager)
+{
+  const auto patches =
+    nodesToSwap | std::views::transform([](const auto& pair) {
+      return std::get_if<BezierPatch>(&pair.second.get());
+    })
+    | std::views::filter([](const auto* patch) { return patch != nullptr; })
+    | kdl::ranges::to<std::vector>();
+
+  auto tasks = patches | std::views::transform([](const auto* patch) {
+                 return std::function{[=]() { return makePatchGrid(*patch); }};
+               });
+  return taskManager.run_tasks_and_wait(tasks);
+}
+
 void doSwapNodeContents(
   std::vector<std::pair<Node*, NodeContents>>& nodesToSwap, Map& map)
 {
@@ -93,6 +118,9 @@ void doSwapNodeContents(
   auto notifyMods = NotifyBeforeAndAfter{
     notifyModsChange, map.modsWillChangeNotifier, map.modsDidChangeNotifier};
 
+  auto patchGrids = makePatchGrids(nodesToSwap, map.taskManager());
+  auto nextPatchGrid = patchGrids.begin();
+
   for (auto& pair : nodesToSwap)
   {
     auto* node = pair.first;
@@ -115,8 +143,8 @@ void doSwapNodeContents(
         return NodeContents{brushNode->setBrush(std::get<Brush>(std::move(contents)))};
       },
       [&](PatchNode* patchNode) {
-        return NodeContents{
-          patchNode->setPatch(std::get<BezierPatch>(std::move(contents)))};
+        return NodeContents{patchNode->setPatch(
+          std::get<BezierPatch>(std::move(contents)), std::move(*nextPatchGrid++))};
       }));
   }
 }
@@ -164,4 +192,17 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
   return false;
 }
 
+size_t SwapNodeContentsCommand::memoryFootprint() const
+{
+  // count the geometry that is shared by several brushes only once
+  auto countedGeometries = std::unordered_set<const BrushGeometry*>{};
+
+  auto result = sizeof(SwapNodeContentsCommand);
+  for (const auto& [node, contents] : m_nodes)
+  {
+    result += sizeof(Node*) + contents.memoryFootprint(countedGeometries);
+  }
+  return result;
+}
+
 } // namespace tb::mdl
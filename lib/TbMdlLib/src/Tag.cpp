@@ -244,6 +244,21 @@ bool TagMatcher::canDisable() const
   return false;
 }
 
+BrushFaceTagDependency TagMatcher::brushFaceTagDependency() const
+{
+  return BrushFaceTagDependency::Face;
+}
+
+bool TagMatcher::matchesBrushFaceMaterial(const MaterialName&, const gl::Material*) const
+{
+  return false;
+}
+
+bool TagMatcher::matchesBrushFaceFlags(int) const
+{
+  return false;
+}
+
 std::ostream& operator<<(std::ostream& str, const TagMatcher& matcher)
 {
   matcher.appendToStream(str);
@@ -275,6 +290,11 @@ SmartTag& SmartTag::operator=(const SmartTag& other)
 
 SmartTag& SmartTag::operator=(SmartTag&& other) = default;
 
+const TagMatcher& SmartTag::matcher() const
+{
+  return *m_matcher;
+}
+
 bool SmartTag::matches(const Taggable& taggable) const
 {
   return m_matcher->matches(taggable);
@@ -19,19 +19,66 @@
 
 #include "mdl/TagManager.h"
 
+#include "Macros.h"
+#include "mdl/BrushFace.h"
 #include "mdl/Tag.h"
 #include "mdl/TagType.h"
+#include "mdl/TagVisitor.h"
 
 #include "kd/contracts.h"
+#include "kd/hash_utils.h"
 
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <bit>
 #include <stdexcept>
 #include <string>
 
 namespace tb::mdl
 {
+namespace
+{
+
+class UpdateBrushFaceTagsVisitor : public TagVisitor
+{
+private:
+  const TagManager& m_tagManager;
+  bool m_visitedBrushFace = false;
+
+public:
+  explicit UpdateBrushFaceTagsVisitor(const TagManager& tagManager)
+    : m_tagManager{tagManager}
+  {
+  }
+
+  bool visitedBrushFace() const { return m_visitedBrushFace; }
+
+  void visit(BrushFace& face) override
+  {
+    m_tagManager.updateTags(face);
+    m_visitedBrushFace = true;
+  }
+};
+
+TagType::Type flagsTags(
+  const std::array<TagType::Type, sizeof(int) * 8>& tagsPerBit, const int flags)
+{
+  auto result = TagType::NoType;
+  for (auto bits = static_cast<unsigned int>(flags); bits != 0; bits &= bits - 1)
+  {
+    result |= tagsPerBit[size_t(std::countr_zero(bits))];
+  }
+  return result;
+}
+
+} // namespace
+
+size_t TagManager::MaterialKeyHash::operator()(const MaterialKey& key) const
+{
+  return kdl::combine_hash(
+    key.lowerCaseMaterialName.caseInsensitiveHash(), kdl::hash(key.material));
+}
 
 bool TagManager::TagCmp::operator()(const SmartTag& lhs, const SmartTag& rhs) const
 {
@@ -105,21 +152,67 @@ void TagManager::registerSmartTags(const std::vector<SmartTag>& tags)
 
     it->setIndex(nextIndex);
   }
+
+  indexSmartTags();
 }
 
 void TagManager::clearSmartTags()
 {
   m_smartTags.clear();
+  indexSmartTags();
 }
 
 void TagManager::updateTags(Taggable& taggable) const
 {
+  auto visitor = UpdateBrushFaceTagsVisitor{*this};
+  taggable.accept(visitor);
+  if (!visitor.visitedBrushFace())
+  {
+    for (const auto& tag : m_smartTags)
+    {
+      tag.update(taggable);
+    }
+  }
+}
+
+void TagManager::updateTags(BrushFace& face) const
+{
+  auto tags = TagType::NoType;
+  if (m_materialTags != TagType::NoType)
+  {
+    tags |= materialTags(face);
+  }
+  if (m_surfaceContentsTags != TagType::NoType)
+  {
+    tags |= flagsTags(m_surfaceContentsTagsPerBit, face.resolvedSurfaceContents());
+  }
+  if (m_surfaceFlagsTags != TagType::NoType)
+  {
+    tags |= flagsTags(m_surfaceFlagsTagsPerBit, face.resolvedSurfaceFlags());
+  }
+
   for (const auto& tag : m_smartTags)
   {
-    tag.update(taggable);
+    if ((m_faceTags & tag.type()) != 0)
+    {
+      tag.update(face);
+    }
+    else if ((tags & tag.type()) != 0)
+    {
+      face.addTag(tag);
+    }
+    else
+    {
+      face.removeTag(tag);
+    }
   }
 }
 
+void TagManager::clearMaterialTagsCache()
+{
+  m_materialTagsCache.clear();
+}
+
 size_t TagManager::freeTagIndex()
 {
   static const size_t Bits = (sizeof(TagType::Type) * 8);
@@ -129,4 +222,72 @@ size_t TagManager::freeTagIndex()
   return index;
 }
 
+void TagManager::indexSmartTags()
+{
+  m_faceTags = TagType::NoType;
+  m_materialTags = TagType::NoType;
+  m_surfaceContentsTags = TagType::NoType;
+  m_surfaceContentsTagsPerBit.fill(TagType::NoType);
+  m_surfaceFlagsTags = TagType::NoType;
+  m_surfaceFlagsTagsPerBit.fill(TagType::NoType);
+  m_materialTagsCache.clear();
+
+  const auto indexFlags = [](const auto& tag, auto& tagsPerBit) {
+    for (size_t i = 0; i < FlagBits; ++i)
+    {
+      if (tag.matcher().matchesBrushFaceFlags(int(1u << i)))
+      {
+        tagsPerBit[i] |= tag.type();
+      }
+    }
+  };
+
+  for (const auto& tag : m_smartTags)
+  {
+    switch (tag.matcher().brushFaceTagDependency())
+    {
+    case BrushFaceTagDependency::None:
+      break;
+    case BrushFaceTagDependency::Material:
+      m_materialTags |= tag.type();
+      break;
+    case BrushFaceTagDependency::SurfaceContents:
+      m_surfaceContentsTags |= tag.type();
+      indexFlags(tag, m_surfaceContentsTagsPerBit);
+      break;
+    case BrushFaceTagDependency::SurfaceFlags:
+      m_surfaceFlagsTags |= tag.type();
+      indexFlags(tag, m_surfaceFlagsTagsPerBit);
+      break;
+    case BrushFaceTagDependency::Face:
+      m_faceTags |= tag.type();
+      break;
+      switchDefault();
+    }
+  }
+}
+
+TagType::Type TagManager::materialTags(const BrushFace& face) const
+{
+  const auto key = MaterialKey{
+    face.attributes().internedMaterialName().toLower(),
+    face.material(),
+  };
+
+  const auto [it, inserted] = m_materialTagsCache.try_emplace(key, TagType::NoType);
+  if (inserted)
+  {
+    for (const auto& tag : m_smartTags)
+    {
+      if (
+        (m_materialTags & tag.type()) != 0
+        && tag.matcher().matchesBrushFaceMaterial(key.lowerCaseMaterialName, key.material))
+      {
+        it->second |= tag.type();
+      }
+    }
+  }
+  return it->second;
+}
+
 } // namespace tb::mdl
@@ -43,6 +43,7 @@
 #include "kd/struct_io.h"
 
 #include <algorithm>
+#include <mutex>
 #include <ostream>
 #include <ranges>
 #include <vector>
@@ -172,13 +173,32 @@ std::unique_ptr<TagMatcher> MaterialNameTagMatcher::clone() const
 bool MaterialNameTagMatcher::matches(const Taggable& taggable) const
 {
   auto visitor = BrushFaceMatchVisitor{[&](const auto& face) {
-    return matchesMaterialName(face.attributes().materialName());
+    const auto lowerCaseMaterialName = face.attributes().internedMaterialName().toLower();
+
+    auto lock = std::lock_guard{m_matchCacheMutex};
+    const auto [it, inserted] = m_matchCache.try_emplace(lowerCaseMaterialName, false);
+    if (inserted)
+    {
+      it->second = matchesMaterialName(lowerCaseMaterialName.str());
+    }
+    return it->second;
   }};
 
   taggable.accept(visitor);
   return visitor.matches();
 }
 
+BrushFaceTagDependency MaterialNameTagMatcher::brushFaceTagDependency() const
+{
+  return BrushFaceTagDependency::Material;
+}
+
+bool MaterialNameTagMatcher::matchesBrushFaceMaterial(
+  const MaterialName& lowerCaseMaterialName, const gl::Material*) const
+{
+  return matchesMaterialName(lowerCaseMaterialName.str());
+}
+
 void MaterialNameTagMatcher::appendToStream(std::ostream& str) const
 {
   kdl::struct_stream{str} << "MaterialNameTagMatcher"
@@ -230,6 +250,17 @@ bool SurfaceParmTagMatcher::matches(const Taggable& taggable) const
   return visitor.matches();
 }
 
+BrushFaceTagDependency SurfaceParmTagMatcher::brushFaceTagDependency() const
+{
+  return BrushFaceTagDependency::Material;
+}
+
+bool SurfaceParmTagMatcher::matchesBrushFaceMaterial(
+  const MaterialName&, const gl::Material* material) const
+{
+  return matchesMaterial(material);
+}
+
 void SurfaceParmTagMatcher::appendToStream(std::ostream& str) const
 {
   kdl::struct_stream{str} << "SurfaceParmTagMatcher"
@@ -286,6 +317,11 @@ bool FlagsTagMatcher::matches(const Taggable& taggable) const
   return visitor.matches();
 }
 
+bool FlagsTagMatcher::matchesBrushFaceFlags(const int flags) const
+{
+  return (flags & m_flags) != 0;
+}
+
 void FlagsTagMatcher::enable(TagMatcherCallback& callback, Map& map) const
 {
   constexpr auto bits = sizeof(decltype(m_flags)) * 8;
@@ -380,6 +416,11 @@ std::unique_ptr<TagMatcher> ContentFlagsTagMatcher::clone() const
   return std::make_unique<ContentFlagsTagMatcher>(m_flags);
 }
 
+BrushFaceTagDependency ContentFlagsTagMatcher::brushFaceTagDependency() const
+{
+  return BrushFaceTagDependency::SurfaceContents;
+}
+
 SurfaceFlagsTagMatcher::SurfaceFlagsTagMatcher(const int i_flags)
   : FlagsTagMatcher{
       i_flags,
@@ -401,6 +442,11 @@ std::unique_ptr<TagMatcher> SurfaceFlagsTagMatcher::clone() const
   return std::make_unique<SurfaceFlagsTagMatcher>(m_flags);
 }
 
+BrushFaceTagDependency SurfaceFlagsTagMatcher::brushFaceTagDependency() const
+{
+  return BrushFaceTagDependency::SurfaceFlags;
+}
+
 EntityClassNameTagMatcher::EntityClassNameTagMatcher(
   std::string pattern, std::string material)
   : m_pattern{std::move(pattern)}
@@ -430,6 +476,11 @@ bool EntityClassNameTagMatcher::matches(const Taggable& taggable) const
   return visitor.matches();
 }
 
+BrushFaceTagDependency EntityClassNameTagMatcher::brushFaceTagDependency() const
+{
+  return BrushFaceTagDependency::None;
+}
+
 void EntityClassNameTagMatcher::enable(TagMatcherCallback& callback, Map& map) const
 {
   if (!map.selection().hasOnlyBrushes())
@@ -79,6 +79,11 @@ bool UndoableCommand::collateWith(UndoableCommand& command)
   return false;
 }
 
+size_t UndoableCommand::memoryFootprint() const
+{
+  return sizeof(UndoableCommand);
+}
+
 bool UndoableCommand::doCollateWith(UndoableCommand&)
 {
   return false;
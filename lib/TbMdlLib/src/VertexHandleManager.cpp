@@ -41,15 +41,14 @@ void VertexHandleManager::pick(
   const double handleRadius,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  forEachPickableHandle(pickRay, camera, handleRadius, [&](const auto& position) {
     if (const auto distance = camera.pickPointHandle(pickRay, position, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *distance);
       const auto error = vm::squared_distance(pickRay, position).distance;
       pickResult.addHit(Hit(HandleHitType, *distance, hitPoint, position, error));
     }
-  }
+  });
 }
 
 void VertexHandleManager::addHandles(const BrushNode* brushNode)
@@ -91,8 +90,8 @@ void EdgeHandleManager::pickGridHandle(
   const Grid& grid,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  // the closest point of an edge must be within picking distance of the ray
+  forEachPickableHandle(pickRay, camera, handleRadius, [&](const auto& position) {
     if (
       const auto edgeDist = camera.pickLineSegmentHandle(pickRay, position, handleRadius))
     {
@@ -110,7 +109,7 @@ void EdgeHandleManager::pickGridHandle(
         }
       }
     }
-  }
+  });
 }
 
 void EdgeHandleManager::pickCenterHandle(
@@ -119,8 +118,7 @@ void EdgeHandleManager::pickCenterHandle(
   const double handleRadius,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  forEachPickableHandle(pickRay, camera, handleRadius, [&](const auto& position) {
     const auto pointHandle = position.center();
 
     if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
@@ -128,7 +126,7 @@ void EdgeHandleManager::pickCenterHandle(
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(Hit{HandleHitType, *pointDist, hitPoint, position});
     }
-  }
+  });
 }
 
 void EdgeHandleManager::addHandles(const BrushNode* brushNode)
@@ -170,8 +168,8 @@ void FaceHandleManager::pickGridHandle(
   const Grid& grid,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  // the ray must hit the face itself, so there is no need to account for the radius
+  forEachPickableHandle(pickRay, camera, 0.0, [&](const auto& position) {
     if (
       const auto plane =
         vm::from_points(position.vertices().begin(), position.vertices().end()))
@@ -193,7 +191,7 @@ void FaceHandleManager::pickGridHandle(
         }
       }
     }
-  }
+  });
 }
 
 void FaceHandleManager::pickCenterHandle(
@@ -202,8 +200,7 @@ void FaceHandleManager::pickCenterHandle(
   const double handleRadius,
   PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
-  {
+  forEachPickableHandle(pickRay, camera, handleRadius, [&](const auto& position) {
     const auto pointHandle = position.center();
 
     if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
@@ -211,7 +208,7 @@ void FaceHandleManager::pickCenterHandle(
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(Hit{HandleHitType, *pointDist, hitPoint, position});
     }
-  }
+  });
 }
 
 void FaceHandleManager::addHandles(const BrushNode* brushNode)
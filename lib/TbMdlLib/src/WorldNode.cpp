@@ -35,13 +35,52 @@
 #include "kd/k.h"
 #include "kd/overload.h"
 
+#include "vm/bbox.h"
 #include "vm/bbox_io.h" // IWYU pragma: keep
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
 {
+namespace
+{
+
+std::vector<std::pair<vm::bbox3d, Node*>> collectNodeTreeItems(WorldNode& worldNode)
+{
+  auto items = std::vector<std::pair<vm::bbox3d, Node*>>{};
+  const auto addNode = [&](auto* node) {
+    if (node->shouldAddToSpacialIndex())
+    {
+      items.emplace_back(node->physicalBounds(), node);
+    }
+  };
+
+  worldNode.accept(kdl::overload(
+    [&](auto&& thisLambda, WorldNode* world) {
+      addNode(world);
+      world->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, LayerNode* layer) {
+      addNode(layer);
+      layer->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, GroupNode* group) {
+      addNode(group);
+      group->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, EntityNode* entity) {
+      addNode(entity);
+      entity->visitChildren(thisLambda);
+    },
+    [&](BrushNode* brush) { addNode(brush); },
+    [&](PatchNode* patch) { addNode(patch); }));
+
+  return items;
+}
+
+} // namespace
 
 WorldNode::WorldNode(
   EntityPropertyConfig entityPropertyConfig, Entity entity, const MapFormat mapFormat)
@@ -206,39 +245,12 @@ void WorldNode::enableNodeTreeUpdates()
 
 void WorldNode::rebuildNodeTree()
 {
-  auto nodes = std::vector<Node*>{};
-  const auto addNode = [&](auto* node) {
-    if (node->shouldAddToSpacialIndex())
-    {
-      nodes.push_back(node);
-    }
-  };
-
-  accept(kdl::overload(
-    [&](auto&& thisLambda, WorldNode* world) {
-      addNode(world);
-      world->visitChildren(thisLambda);
-    },
-    [&](auto&& thisLambda, LayerNode* layer) {
-      addNode(layer);
-      layer->visitChildren(thisLambda);
-    },
-    [&](auto&& thisLambda, GroupNode* group) {
-      addNode(group);
-      group->visitChildren(thisLambda);
-    },
-    [&](auto&& thisLambda, EntityNode* entity) {
-      addNode(entity);
-      entity->visitChildren(thisLambda);
-    },
-    [&](BrushNode* brush) { addNode(brush); },
-    [&](PatchNode* patch) { addNode(patch); }));
+  m_nodeTree->build(collectNodeTreeItems(*this));
+}
 
-  m_nodeTree->clear();
-  for (auto* node : nodes)
-  {
-    contract_assert(m_nodeTree->insert(node->physicalBounds(), node));
-  }
+void WorldNode::rebuildNodeTree(kdl::task_manager& taskManager)
+{
+  m_nodeTree->build(collectNodeTreeItems(*this), taskManager);
 }
 
 void WorldNode::invalidateAllIssues()
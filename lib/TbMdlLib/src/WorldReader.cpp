@@ -175,7 +175,7 @@ Result<std::unique_ptr<WorldNode>> WorldReader::read(
   return readEntities(worldBounds, status, taskManager) | kdl::transform([&]() {
            sanitizeLayerSortIndicies(*m_worldNode, status);
            setLinkIds(*m_worldNode, status);
-           m_worldNode->rebuildNodeTree();
+           m_worldNode->rebuildNodeTree(taskManager);
            m_worldNode->enableNodeTreeUpdates();
            return std::move(m_worldNode);
          });
@@ -44,6 +44,7 @@
 #include <algorithm>
 #include <ranges>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -342,6 +343,50 @@ TEST_CASE("Brush")
     }
   }
 
+  SECTION("copy")
+  {
+    const auto worldBounds = vm::bbox3d{4096.0};
+
+    const auto brushBuilder = BrushBuilder{MapFormat::Valve, worldBounds};
+    auto brush = brushBuilder.createCube(64.0, "material") | kdl::value();
+
+    auto copy = brush;
+    CHECK(copy == brush);
+    CHECK(copy.sharesGeometryWith(brush));
+    CHECK(copy.memoryFootprint() == brush.memoryFootprint());
+
+    SECTION("Shared geometry is counted once")
+    {
+      auto countedGeometries = std::unordered_set<const BrushGeometry*>{};
+      const auto brushFootprint = brush.memoryFootprint(countedGeometries);
+      const auto copyFootprint = copy.memoryFootprint(countedGeometries);
+
+      CHECK(brushFootprint == brush.memoryFootprint());
+      CHECK(copyFootprint < brushFootprint);
+      CHECK(countedGeometries.size() == 1);
+    }
+
+    SECTION("Changing face attributes keeps the geometry shared")
+    {
+      auto attributes = copy.face(0).attributes();
+      attributes.setXOffset(16.0f);
+      copy.face(0).setAttributes(attributes);
+
+      CHECK(copy.sharesGeometryWith(brush));
+      CHECK(copy.face(0).vertexPositions() == brush.face(0).vertexPositions());
+    }
+
+    SECTION("Transforming the copy detaches its geometry")
+    {
+      REQUIRE(
+        copy.transform(worldBounds, vm::translation_matrix(vm::vec3d{16, 0, 0}), false));
+
+      CHECK_FALSE(copy.sharesGeometryWith(brush));
+      CHECK(brush.bounds() == vm::bbox3d{32.0});
+      CHECK(copy.bounds() == vm::bbox3d{{-16, -32, -32}, {48, 32, 32}});
+    }
+  }
+
   SECTION("cloneFaceAttributesFrom")
   {
     const auto worldBounds = vm::bbox3d{4096.0};
@@ -2466,6 +2511,57 @@ TEST_CASE("Brush")
         | kdl::value();
       CHECK(fragments.empty());
     }
+
+    SECTION("Subtract and merge fragments")
+    {
+      const auto worldBounds = vm::bbox3d{65536.0};
+      auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+      // the volumes of the fragments are compared relative to their size
+      using T = std::tuple<vm::vec3d, double>;
+      const auto [offset, size] = GENERATE(values<T>({
+        {{0, 0, 0}, 64},
+        {{0.5, 0.5, 0.5}, 64},
+        {{30000, -30000, 30000}, 64},
+        {{0, 0, 0}, 0.25},
+      }));
+      CAPTURE(offset, size);
+
+      const auto makeCuboid = [&](const vm::vec3d& min, const vm::vec3d& max) {
+        return builder.createCuboid(
+                 vm::bbox3d{offset + size * min, offset + size * max}, "material")
+               | kdl::value();
+      };
+
+      const auto minuend = makeCuboid({0, 0, 0}, {1, 1, 1});
+      const auto subtrahend1 = makeCuboid({0.5, 0.5, 0}, {1, 1, 1});
+      const auto subtrahend2 = makeCuboid({0, 0.5, 0}, {0.5, 1, 1});
+
+      SECTION("Fragments whose union is convex are merged")
+      {
+        const auto fragments =
+          minuend.subtract(
+            MapFormat::Standard,
+            worldBounds,
+            "material",
+            {&subtrahend1, &subtrahend2},
+            true)
+          | kdl::fold | kdl::value();
+        REQUIRE(fragments.size() == 1u);
+        CHECK(
+          fragments.front().bounds()
+          == vm::bbox3d{offset, offset + size * vm::vec3d{1, 0.5, 1}});
+      }
+
+      SECTION("Fragments whose union is not convex are not merged")
+      {
+        const auto fragments =
+          minuend.subtract(
+            MapFormat::Standard, worldBounds, "material", {&subtrahend1}, true)
+          | kdl::fold | kdl::value();
+        CHECK(fragments.size() == 2u);
+      }
+    }
   }
 }
 
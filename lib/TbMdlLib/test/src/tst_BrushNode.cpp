@@ -24,6 +24,7 @@
 #include "mdl/BrushFaceHandle.h"
 #include "mdl/BrushNode.h"
 #include "mdl/CatchConfig.h"
+#include "mdl/CircleShape.h"
 #include "mdl/EditorContext.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
@@ -38,12 +39,18 @@
 #include "kd/result.h"
 
 #include "vm/approx.h"
+#include "vm/ray.h"
+#include "vm/ray_io.h" // IWYU pragma: keep
+#include "vm/vec.h"
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 namespace tb::mdl
 {
@@ -290,6 +297,83 @@ TEST_CASE("BrushNode")
     CHECK(hits2.empty());
   }
 
+  SECTION("pick brush with many faces")
+  {
+    const auto worldBounds = vm::bbox3d{4096.0};
+    const auto editorContext = EditorContext{};
+
+    // the face planes are intersected in blocks of 16
+    const auto sideCount = GENERATE(14u, 15u, 30u, 40u);
+
+    auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+    auto brush = BrushNode{
+      builder.createCylinder(
+        vm::bbox3d{{-32, -32, -32}, {32, 32, 32}},
+        EdgeAlignedCircle{sideCount},
+        vm::axis::z,
+        "some_material")
+      | kdl::value()};
+    REQUIRE(brush.brush().faceCount() == sideCount + 2);
+
+    const auto findHitByFace = [&](const vm::ray3d& ray) {
+      for (size_t i = 0; i < brush.brush().faceCount(); ++i)
+      {
+        if (const auto distance = brush.brush().face(i).intersectWithRay(ray))
+        {
+          return std::optional{std::tuple{*distance, i}};
+        }
+      }
+      return std::optional<std::tuple<double, size_t>>{};
+    };
+
+    const auto makePoints = [](const std::vector<double>& coords) {
+      auto result = std::vector<vm::vec3d>{};
+      for (const auto x : coords)
+      {
+        for (const auto y : coords)
+        {
+          for (const auto z : coords)
+          {
+            result.emplace_back(x, y, z);
+          }
+        }
+      }
+      return result;
+    };
+
+    const auto origins = makePoints({-96.0, -40.0, 0.0, 40.0, 96.0});
+    const auto targets = makePoints({-40.0, -12.0, 0.0, 24.0, 40.0});
+
+    // offset the targets so that the rays don't just graze the brush edges
+    const auto offset = vm::vec3d{0.3, 0.7, -0.5};
+
+    for (const auto& origin : origins)
+    {
+      for (const auto& target : targets)
+      {
+        const auto ray = vm::ray3d{origin, vm::normalize(target + offset - origin)};
+        CAPTURE(ray);
+
+        auto hits = PickResult{};
+        brush.pick(editorContext, ray, hits);
+
+        if (const auto expected = findHitByFace(ray))
+        {
+          const auto [distance, faceIndex] = *expected;
+          REQUIRE(hits.size() == 1u);
+
+          const auto& hit = hits.all().front();
+          CHECK(hit.distance() == vm::approx(distance));
+          CHECK(hitToFaceHandle(hit)->faceIndex() == faceIndex);
+        }
+        else
+        {
+          CHECK(hits.empty());
+        }
+      }
+    }
+  }
+
   SECTION("clone")
   {
     const auto worldBounds = vm::bbox3d{4096.0};
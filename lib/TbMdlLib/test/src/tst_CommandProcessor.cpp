@@ -251,6 +251,25 @@ public:
   bool doPerformUndo(Map&) override { return true; }
 };
 
+class FixedFootprintCommand : public UndoableCommand
+{
+private:
+  size_t m_memoryFootprint;
+
+public:
+  FixedFootprintCommand(std::string name, const size_t memoryFootprint)
+    : UndoableCommand{std::move(name), true}
+    , m_memoryFootprint{memoryFootprint}
+  {
+  }
+
+  size_t memoryFootprint() const override { return m_memoryFootprint; }
+
+  bool doPerformDo(Map&) override { return true; }
+
+  bool doPerformUndo(Map&) override { return true; }
+};
+
 } // namespace
 
 TEST_CASE("CommandProcessor")
@@ -961,4 +980,76 @@ TEST_CASE("CommandProcessor")
   }
 }
 
+TEST_CASE("CommandProcessor.undoMemoryBudget")
+{
+  auto fixture = MapFixture{};
+  auto& map = fixture.create();
+
+  auto commandProcessor = CommandProcessor{map};
+  commandProcessor.setIsCollationEnabled(false);
+
+  CHECK(commandProcessor.undoMemoryFootprint() == 0);
+  CHECK(commandProcessor.undoMemoryBudget() == std::nullopt);
+
+  commandProcessor.executeAndStore(std::make_unique<FixedFootprintCommand>("1", 100));
+  commandProcessor.executeAndStore(std::make_unique<FixedFootprintCommand>("2", 100));
+  commandProcessor.executeAndStore(std::make_unique<FixedFootprintCommand>("3", 100));
+  CHECK(commandProcessor.undoMemoryFootprint() == 300);
+
+  SECTION("Undo and redo update the footprint")
+  {
+    commandProcessor.undo();
+    CHECK(commandProcessor.undoMemoryFootprint() == 200);
+
+    commandProcessor.redo();
+    CHECK(commandProcessor.undoMemoryFootprint() == 300);
+  }
+
+  SECTION("Clearing resets the footprint")
+  {
+    commandProcessor.clear();
+    CHECK(commandProcessor.undoMemoryFootprint() == 0);
+  }
+
+  SECTION("Setting a budget discards the oldest commands")
+  {
+    commandProcessor.setUndoMemoryBudget(250);
+    CHECK(commandProcessor.undoMemoryFootprint() == 200);
+    CHECK(*commandProcessor.undoCommandName() == "3");
+
+    commandProcessor.undo();
+    CHECK(*commandProcessor.undoCommandName() == "2");
+
+    commandProcessor.undo();
+    CHECK_FALSE(commandProcessor.canUndo());
+  }
+
+  SECTION("Storing a command discards the oldest commands")
+  {
+    commandProcessor.setUndoMemoryBudget(300);
+    commandProcessor.executeAndStore(std::make_unique<FixedFootprintCommand>("4", 150));
+    CHECK(commandProcessor.undoMemoryFootprint() == 250);
+    CHECK(*commandProcessor.undoCommandName() == "4");
+
+    commandProcessor.undo();
+    commandProcessor.undo();
+    CHECK_FALSE(commandProcessor.canUndo());
+  }
+
+  SECTION("The most recent command is kept even if it exceeds the budget")
+  {
+    commandProcessor.setUndoMemoryBudget(50);
+    CHECK(commandProcessor.undoMemoryFootprint() == 100);
+    CHECK(*commandProcessor.undoCommandName() == "3");
+  }
+
+  SECTION("Removing the budget keeps all commands")
+  {
+    commandProcessor.setUndoMemoryBudget(300);
+    commandProcessor.setUndoMemoryBudget(std::nullopt);
+    commandProcessor.executeAndStore(std::make_unique<FixedFootprintCommand>("4", 100));
+    CHECK(commandProcessor.undoMemoryFootprint() == 400);
+  }
+}
+
 } // namespace tb::mdl
@@ -258,6 +258,48 @@ TEST_CASE("toValue")
         enabled,
         treatNonZeroResultCodeAsError)));
   }
+
+  SECTION("task dependencies")
+  {
+    CHECK(
+      toValue(CompilationConfig{{
+        {"name",
+         "workDirSpec",
+         {
+           CompilationDeleteFiles{true, "targetSpec", std::vector<size_t>{}},
+           CompilationDeleteFiles{true, "targetSpec", std::vector<size_t>{0, 2}},
+           CompilationDeleteFiles{true, "targetSpec"},
+         }},
+      }})
+      == parse(R"({
+        "version": 1.0,
+        "profiles": [
+          {
+            "name": "name",
+            "workdir": "workDirSpec",
+            "tasks": [
+              {
+                "type": "delete",
+                "enabled": true,
+                "target": "targetSpec",
+                "dependencies": []
+              },
+              {
+                "type": "delete",
+                "enabled": true,
+                "target": "targetSpec",
+                "dependencies": [0, 2]
+              },
+              {
+                "type": "delete",
+                "enabled": true,
+                "target": "targetSpec"
+              }
+            ]
+          }
+        ]
+      })"));
+  }
 }
 
 } // namespace tb::mdl
@@ -0,0 +1,185 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/CatchConfig.h"
+#include "mdl/CompilationProfile.h"
+#include "mdl/CompilationTask.h"
+
+#include "kd/k.h"
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+CompilationTask makeTask(
+  const bool enabled, std::optional<std::vector<size_t>> dependencies = std::nullopt)
+{
+  return CompilationDeleteFiles{enabled, "target", std::move(dependencies)};
+}
+
+CompilationProfile makeProfile(std::vector<CompilationTask> tasks)
+{
+  return CompilationProfile{"name", "workDir", std::move(tasks)};
+}
+
+using Dependencies = std::vector<std::vector<size_t>>;
+
+} // namespace
+
+TEST_CASE("resolveTaskDependencies")
+{
+  SECTION("Tasks without declared dependencies depend on their predecessor")
+  {
+    CHECK(
+      resolveTaskDependencies(makeProfile({
+        makeTask(K(enabled)),
+        makeTask(K(enabled)),
+        makeTask(K(enabled)),
+      }))
+      == Dependencies{{}, {0}, {1}});
+  }
+
+  SECTION("Declared dependencies")
+  {
+    CHECK(
+      resolveTaskDependencies(makeProfile({
+        makeTask(K(enabled)),
+        makeTask(K(enabled), std::vector<size_t>{}),
+        makeTask(K(enabled), std::vector<size_t>{1, 0}),
+        makeTask(K(enabled), std::vector<size_t>{0, 0}),
+      }))
+      == Dependencies{{}, {}, {0, 1}, {0}});
+  }
+
+  SECTION("Dependencies on later tasks")
+  {
+    CHECK(
+      resolveTaskDependencies(makeProfile({
+        makeTask(K(enabled), std::vector<size_t>{1}),
+        makeTask(K(enabled), std::vector<size_t>{}),
+      }))
+      == Dependencies{{1}, {}});
+  }
+
+  SECTION("Dependencies on disabled tasks are replaced by their dependencies")
+  {
+    CHECK(
+      resolveTaskDependencies(makeProfile({
+        makeTask(K(enabled)),
+        makeTask(!K(enabled), std::vector<size_t>{}),
+        makeTask(K(enabled), std::vector<size_t>{}),
+        makeTask(!K(enabled), std::vector<size_t>{0, 2}),
+        makeTask(!K(enabled)),
+        makeTask(K(enabled)),
+        makeTask(K(enabled), std::vector<size_t>{1}),
+      }))
+      == Dependencies{{}, {}, {}, {}, {}, {0, 2}, {}});
+  }
+
+  SECTION("Invalid dependencies")
+  {
+    CHECK(resolveTaskDependencies(makeProfile({
+                                    makeTask(K(enabled), std::vector<size_t>{0}),
+                                  }))
+            .is_error());
+
+    CHECK(resolveTaskDependencies(makeProfile({
+                                    makeTask(K(enabled), std::vector<size_t>{1}),
+                                  }))
+            .is_error());
+  }
+
+  SECTION("Cyclic dependencies")
+  {
+    CHECK(resolveTaskDependencies(makeProfile({
+                                    makeTask(K(enabled), std::vector<size_t>{2}),
+                                    makeTask(K(enabled)),
+                                    makeTask(!K(enabled)),
+                                  }))
+            .is_error());
+  }
+}
+
+TEST_CASE("insertTask")
+{
+  auto profile = makeProfile({
+    makeTask(K(enabled)),
+    makeTask(K(enabled), std::vector<size_t>{0}),
+    makeTask(K(enabled), std::vector<size_t>{0, 1}),
+  });
+
+  insertTask(profile, 1, makeTask(!K(enabled)));
+  insertTask(profile, 4, makeTask(!K(enabled), std::vector<size_t>{0, 2}));
+
+  CHECK(
+    profile.tasks
+    == std::vector<CompilationTask>{
+      makeTask(K(enabled)),
+      makeTask(!K(enabled)),
+      makeTask(K(enabled), std::vector<size_t>{0}),
+      makeTask(K(enabled), std::vector<size_t>{0, 2}),
+      makeTask(!K(enabled), std::vector<size_t>{0, 2}),
+    });
+}
+
+TEST_CASE("removeTask")
+{
+  auto profile = makeProfile({
+    makeTask(K(enabled)),
+    makeTask(!K(enabled)),
+    makeTask(K(enabled), std::vector<size_t>{0, 1}),
+    makeTask(K(enabled), std::vector<size_t>{2}),
+  });
+
+  removeTask(profile, 1);
+
+  CHECK(
+    profile.tasks
+    == std::vector<CompilationTask>{
+      makeTask(K(enabled)),
+      makeTask(K(enabled), std::vector<size_t>{0}),
+      makeTask(K(enabled), std::vector<size_t>{1}),
+    });
+}
+
+TEST_CASE("swapTasks")
+{
+  auto profile = makeProfile({
+    makeTask(K(enabled)),
+    makeTask(!K(enabled)),
+    makeTask(K(enabled), std::vector<size_t>{0, 1}),
+  });
+
+  swapTasks(profile, 0, 1);
+
+  CHECK(
+    profile.tasks
+    == std::vector<CompilationTask>{
+      makeTask(!K(enabled)),
+      makeTask(K(enabled)),
+      makeTask(K(enabled), std::vector<size_t>{1, 0}),
+    });
+}
+
+} // namespace tb::mdl
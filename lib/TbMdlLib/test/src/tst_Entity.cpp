@@ -211,6 +211,74 @@ TEST_CASE("EntityTest")
     CHECK(entity.modelSpecification() == ModelSpecification{"maps/b_shell1.bsp", 0, 0});
   }
 
+  SECTION("modelSpecification is cached until a property it reads changes")
+  {
+    auto definition = EntityDefinition{
+      "some_name",
+      Color{},
+      "",
+      {},
+      PointEntityDefinition{
+        vm::bbox3d{32.0},
+        ModelDefinition{el::parseExpression(el::ParseMode::Strict, R"({{
+          spawnflags == 1 -> "maps/b_shell1.bsp",
+                             "maps/b_shell0.bsp"
+        }})")
+                          .value()},
+        {},
+      },
+    };
+
+    auto entity = Entity{};
+    entity.setDefinition(&definition);
+    REQUIRE(entity.modelSpecification() == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+
+    // change the expression behind the entity's back to observe whether it is evaluated
+    definition.pointEntityDefinition->modelDefinition = ModelDefinition{
+      el::parseExpression(el::ParseMode::Strict, R"("maps/b_shell2.bsp")").value()};
+
+    SECTION("Changing another property keeps the cached specification")
+    {
+      entity.addOrUpdateProperty("target", "some_target");
+      entity.renameProperty("target", "targetname");
+      entity.removeProperty("targetname");
+      CHECK(
+        entity.modelSpecification() == ModelSpecification{"maps/b_shell0.bsp", 0, 0});
+    }
+
+    SECTION("Adding a property that was read invalidates the cached specification")
+    {
+      entity.addOrUpdateProperty(EntityPropertyKeys::Spawnflags, "1");
+      CHECK(
+        entity.modelSpecification() == ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+    }
+
+    SECTION("Renaming a property to a key that was read invalidates the cache")
+    {
+      entity.addOrUpdateProperty("target", "1");
+      entity.renameProperty("target", EntityPropertyKeys::Spawnflags);
+      CHECK(
+        entity.modelSpecification() == ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+    }
+
+    SECTION("Setting the properties invalidates the cached specification")
+    {
+      entity.setProperties({});
+      CHECK(
+        entity.modelSpecification() == ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+    }
+
+    SECTION("Setting the definition invalidates the cached specification")
+    {
+      entity.setDefinition(nullptr);
+      CHECK(entity.modelSpecification() == ModelSpecification{});
+
+      entity.setDefinition(&definition);
+      CHECK(
+        entity.modelSpecification() == ModelSpecification{"maps/b_shell2.bsp", 0, 0});
+    }
+  }
+
   SECTION("decalSpecification")
   {
     const auto decalExpression =
@@ -234,6 +302,9 @@ TEST_CASE("EntityTest")
 
     entity.addOrUpdateProperty("texture", "decal1");
     CHECK(entity.decalSpecification() == DecalSpecification{"decal1"});
+
+    entity.removeProperty("texture");
+    CHECK(entity.decalSpecification() == DecalSpecification{""});
   }
 
   SECTION("unsetEntityDefinitionAndModel")
@@ -37,6 +37,8 @@
 #include "vm/bbox.h"
 #include "vm/intersection.h"
 
+#include <fmt/format.h>
+
 #include <filesystem>
 
 #include <catch2/catch_test_macros.hpp>
@@ -165,6 +167,74 @@ TEST_CASE("EntityModel")
     CHECK(renderer1 != nullptr);
     CHECK(renderer2 != nullptr);
   }
+
+  SECTION("mesh loader")
+  {
+    auto modelData = EntityModelData{PitchType::Normal, Orientation::Oriented};
+    for (size_t i = 0; i < 4; ++i)
+    {
+      modelData.addFrame(fmt::format("frame {}", i), vm::bbox3f{0, 8});
+    }
+
+    auto& surface = modelData.addSurface("surface", 4);
+
+    auto materials = std::vector<gl::Material>{};
+    materials.push_back(makeDummyMaterial("skin"));
+    surface.setSkins(std::move(materials));
+
+    auto loadedFrameIndices = std::vector<size_t>{};
+    const auto loadMesh = [&](const size_t frameIndex) {
+      loadedFrameIndices.push_back(frameIndex);
+
+      auto builder = gl::IndexRangeMapBuilder<EntityModelVertex::Type>{
+        3, [] {
+          auto size = gl::IndexRangeMap::Size{};
+          size.inc(gl::PrimType::Triangles, 1);
+          return size;
+        }()};
+      builder.addTriangle(
+        EntityModelVertex{vm::vec3f{-1, -1, 0}, vm::vec2f{0, 0}},
+        EntityModelVertex{vm::vec3f{1, -1, 0}, vm::vec2f{0, 0}},
+        EntityModelVertex{vm::vec3f{0, 1, 0}, vm::vec2f{0, 0}});
+      return EntityModelMeshData{builder.vertices(), builder.indices()};
+    };
+
+    surface.setMeshLoader(loadMesh, 2);
+    for (auto& frame : modelData.frames())
+    {
+      frame.setMeshLoader(loadMesh);
+    }
+
+    CHECK(surface.loadedMeshCount() == 0);
+
+    SECTION("meshes are loaded when rendering and the least recently used is discarded")
+    {
+      CHECK(modelData.buildRenderer(0, 0) != nullptr);
+      CHECK(modelData.buildRenderer(0, 1) != nullptr);
+      CHECK(modelData.buildRenderer(0, 0) != nullptr);
+      CHECK(loadedFrameIndices == std::vector<size_t>{0, 1});
+      CHECK(surface.loadedMeshCount() == 2);
+
+      CHECK(modelData.buildRenderer(0, 2) != nullptr);
+      CHECK(surface.loadedMeshCount() == 2);
+
+      CHECK(modelData.buildRenderer(0, 0) != nullptr);
+      CHECK(modelData.buildRenderer(0, 1) != nullptr);
+      CHECK(loadedFrameIndices == std::vector<size_t>{0, 1, 2, 1});
+    }
+
+    SECTION("spacial tree is built when the frame is intersected")
+    {
+      const auto& frame = modelData.frames().at(3);
+      CHECK_FALSE(frame.hasSpacialTree());
+
+      const auto ray = vm::ray3f{{0, 0, 8}, {0, 0, -1}};
+      CHECK(std::optional{8.0f} == vm::optional_approx(frame.intersect(ray)));
+      CHECK(frame.hasSpacialTree());
+      CHECK(loadedFrameIndices == std::vector<size_t>{3});
+      CHECK(surface.loadedMeshCount() == 0);
+    }
+  }
 }
 
 
@@ -21,6 +21,7 @@
 #include "fs/DiskFileSystem.h"
 #include "fs/Reader.h"
 #include "fs/VirtualFileSystem.h"
+#include "gl/MaterialIndexRangeRenderer.h"
 #include "mdl/CatchConfig.h"
 #include "mdl/GameConfig.h"
 #include "mdl/LoadMaterialCollections.h"
@@ -32,6 +33,8 @@
 #include "kd/task_manager.h"
 
 #include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
 
 #include <filesystem>
 #include <memory>
@@ -157,6 +160,20 @@ TEST_CASE("loadMd3Model (Regression)", "[regression]")
       | kdl::transform([](const auto& modelData) {
           CHECK(modelData.frameCount() == 30u);
           CHECK(modelData.surfaceCount() == 2u);
+
+          // frame meshes are only decoded on demand
+          for (const auto& surface : modelData.surfaces())
+          {
+            CHECK(surface.loadedMeshCount() == 0u);
+          }
+
+          const auto& frame = modelData.frames().back();
+          const auto ray = vm::ray3f{
+            frame.bounds().center() + vm::vec3f{0, 0, 100}, vm::vec3f{0, 0, -1}};
+          CHECK(frame.intersect(ray) != std::nullopt);
+
+          CHECK(modelData.buildRenderer(0, 29) != nullptr);
+          CHECK(modelData.surfaces().front().loadedMeshCount() == 1u);
         })
       | kdl::transform_error([](const auto& e) { FAIL(e); });
   }
@@ -28,6 +28,9 @@
 
 #include "kd/result.h"
 
+#include "vm/ray.h"
+#include "vm/vec.h"
+
 #include <catch2/catch_test_macros.hpp>
 
 namespace tb::mdl
@@ -58,6 +61,15 @@ TEST_CASE("loadMdlModel")
           const auto& surface = surfaces.front();
           CHECK(surface.skinCount() == 3u);
           CHECK(surface.frameCount() == 1u);
+
+          // frame meshes are only decoded on demand
+          CHECK(surface.loadedMeshCount() == 0u);
+
+          const auto& frame = modelData.frames().front();
+          const auto ray = vm::ray3f{
+            frame.bounds().center() + vm::vec3f{0, 0, 100}, vm::vec3f{0, 0, -1}};
+          CHECK(frame.intersect(ray) != std::nullopt);
+          CHECK(surface.loadedMeshCount() == 0u);
         })
       | kdl::transform_error([](const auto& e) { FAIL(e); });
   }
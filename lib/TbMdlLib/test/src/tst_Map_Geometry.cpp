@@ -1256,6 +1256,50 @@ TEST_CASE("Map_Geometry")
       CHECK(remainderNode2->logicalBounds() == expectedBBox2);
     }
 
+    SECTION("Merge fragments")
+    {
+      auto& map = fixture.create();
+      const auto builder = BrushBuilder{map.worldNode().mapFormat(), map.worldBounds()};
+
+      auto* entityNode = new EntityNode{Entity{}};
+      addNodes(map, {{parentForNodes(map), {entityNode}}});
+
+      auto* minuendNode = new BrushNode{
+        builder.createCuboid(
+          vm::bbox3d{vm::vec3d{0, 0, 0}, vm::vec3d{64, 64, 64}}, "material")
+        | kdl::value()};
+      auto* subtrahendNode1 = new BrushNode{
+        builder.createCuboid(
+          vm::bbox3d{vm::vec3d{32, 32, 0}, vm::vec3d{64, 64, 64}}, "material")
+        | kdl::value()};
+      auto* subtrahendNode2 = new BrushNode{
+        builder.createCuboid(
+          vm::bbox3d{vm::vec3d{0, 32, 0}, vm::vec3d{32, 64, 64}}, "material")
+        | kdl::value()};
+
+      // this one doesn't touch the minuend
+      auto* subtrahendNode3 = new BrushNode{
+        builder.createCuboid(
+          vm::bbox3d{vm::vec3d{128, 128, 128}, vm::vec3d{192, 192, 192}}, "material")
+        | kdl::value()};
+
+      addNodes(
+        map,
+        {{entityNode,
+          {minuendNode, subtrahendNode1, subtrahendNode2, subtrahendNode3}}});
+
+      selectNodes(map, {subtrahendNode1, subtrahendNode2, subtrahendNode3});
+      CHECK(csgSubtract(map, true));
+      REQUIRE(entityNode->children().size() == 1u);
+
+      auto* remainderNode = dynamic_cast<BrushNode*>(entityNode->children()[0]);
+      REQUIRE(remainderNode != nullptr);
+      CHECK(
+        remainderNode->logicalBounds()
+        == vm::bbox3d{vm::vec3d{0, 0, 0}, vm::vec3d{64, 32, 64}});
+      CHECK(remainderNode->brush().faceCount() == 6u);
+    }
+
     SECTION("Undo restores selection")
     {
       auto& map = fixture.create();
@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/CatchConfig.h"
+#include "mdl/MaterialName.h"
+
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+
+TEST_CASE("MaterialName")
+{
+  SECTION("Default constructed name is empty")
+  {
+    CHECK(MaterialName{}.empty());
+    CHECK(MaterialName{}.str() == "");
+    CHECK(MaterialName{} == MaterialName{""});
+  }
+
+  SECTION("Equal names are interned once")
+  {
+    const auto name1 = MaterialName{"e1u1/Brlava"};
+    const auto name2 = MaterialName{std::string{"e1u1/"} + "Brlava"};
+
+    CHECK(name1 == name2);
+    CHECK(&name1.str() == &name2.str());
+    CHECK(name1.str() == "e1u1/Brlava");
+    CHECK(name1 == std::string_view{"e1u1/Brlava"});
+  }
+
+  SECTION("Comparing names")
+  {
+    const auto name1 = MaterialName{"e1u1/Brlava"};
+    const auto name2 = MaterialName{"E1U1/BRLAVA"};
+    const auto name3 = MaterialName{"e1u1/brwater"};
+
+    CHECK(name1 != name2);
+    CHECK(name1.isEqualIgnoringCase(name2));
+    CHECK(name1.caseInsensitiveHash() == name2.caseInsensitiveHash());
+    CHECK_FALSE(name1.isEqualIgnoringCase(name3));
+
+    CHECK(name1.toLower() == MaterialName{"e1u1/brlava"});
+    CHECK(name2.toLower() == name1.toLower());
+
+    CHECK(name2 < name1);
+    CHECK(name1 < name3);
+  }
+
+  SECTION("find")
+  {
+    CHECK(MaterialName::find("some/material_that_is_never_interned") == std::nullopt);
+
+    const auto name = MaterialName{"some/Interned_Material"};
+    CHECK(MaterialName::find("some/Interned_Material") == name);
+    CHECK(MaterialName::find("some/interned_material") == name.toLower());
+  }
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,206 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Observer.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Map.h"
+#include "mdl/MapFixture.h"
+#include "mdl/Map_Geometry.h"
+#include "mdl/Map_Nodes.h"
+#include "mdl/Map_Selection.h"
+#include "mdl/NodeChangeBatch.h"
+#include "mdl/TestFactory.h"
+#include "mdl/Transaction.h"
+#include "mdl/TransactionScope.h"
+
+#include "kd/vector_utils.h"
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+
+TEST_CASE("NodeChangeBatch")
+{
+  auto fixture = MapFixture{};
+  auto& map = fixture.create();
+
+  auto* brushNode1 = createBrushNode(map);
+  auto* brushNode2 = createBrushNode(map);
+  addNodes(map, {{parentForNodes(map), {brushNode1, brushNode2}}});
+
+  auto nodesDidChange = Observer<std::vector<Node*>>{map.nodesDidChangeNotifier};
+  auto batchedNodesDidChange =
+    Observer<std::vector<Node*>>{map.batchedNodesDidChangeNotifier};
+
+  const auto sorted = [](std::vector<Node*> nodes) {
+    return kdl::vec_sort(std::move(nodes));
+  };
+
+  SECTION("Notifies immediately outside of a batch")
+  {
+    selectNodes(map, {brushNode1});
+    translateSelection(map, {16, 0, 0});
+
+    CHECK(nodesDidChange.notifications.size() == 1);
+    CHECK(
+      batchedNodesDidChange.notifications
+      == std::vector<std::vector<Node*>>{{brushNode1}});
+  }
+
+  SECTION("Coalesces changes in a transaction")
+  {
+    auto transaction = Transaction{map, "test"};
+
+    selectNodes(map, {brushNode1});
+    translateSelection(map, {16, 0, 0});
+    translateSelection(map, {16, 0, 0});
+
+    deselectAll(map);
+    selectNodes(map, {brushNode1, brushNode2});
+    translateSelection(map, {16, 0, 0});
+
+    CHECK(nodesDidChange.notifications.size() == 3);
+    CHECK(batchedNodesDidChange.notifications.empty());
+
+    transaction.commit();
+
+    CHECK(
+      batchedNodesDidChange.notifications
+      == std::vector<std::vector<Node*>>{sorted({brushNode1, brushNode2})});
+  }
+
+  SECTION("Notifies immediately in a long running transaction")
+  {
+    // the map renderer observes the batched notifier, so it must see the intermediate
+    // states of a tool drag
+    map.startTransaction("drag", TransactionScope::LongRunning);
+
+    selectNodes(map, {brushNode1});
+    translateSelection(map, {16, 0, 0});
+
+    CHECK(
+      batchedNodesDidChange.notifications
+      == std::vector<std::vector<Node*>>{{brushNode1}});
+
+    translateSelection(map, {16, 0, 0});
+
+    CHECK(
+      batchedNodesDidChange.notifications
+      == std::vector<std::vector<Node*>>{{brushNode1}, {brushNode1}});
+
+    SECTION("Coalesces changes in a nested transaction")
+    {
+      {
+        auto transaction = Transaction{map, "nested"};
+        translateSelection(map, {16, 0, 0});
+        translateSelection(map, {16, 0, 0});
+
+        CHECK(batchedNodesDidChange.notifications.size() == 2);
+        transaction.commit();
+      }
+
+      CHECK(batchedNodesDidChange.notifications.size() == 3);
+    }
+
+    map.commitTransaction();
+
+    SECTION("Batches changes again after the transaction ends")
+    {
+      batchedNodesDidChange.reset();
+      {
+        auto transaction = Transaction{map, "test"};
+        translateSelection(map, {16, 0, 0});
+        translateSelection(map, {16, 0, 0});
+        CHECK(batchedNodesDidChange.notifications.empty());
+        transaction.commit();
+      }
+
+      CHECK(batchedNodesDidChange.notifications.size() == 1);
+    }
+  }
+
+  SECTION("Coalesces changes in nested batches")
+  {
+    {
+      const auto outerBatch = NodeChangeBatch{map};
+      selectNodes(map, {brushNode1});
+      translateSelection(map, {16, 0, 0});
+
+      {
+        const auto innerBatch = NodeChangeBatch{map};
+        deselectAll(map);
+        selectNodes(map, {brushNode2});
+        translateSelection(map, {16, 0, 0});
+      }
+
+      CHECK(batchedNodesDidChange.notifications.empty());
+    }
+
+    CHECK(
+      batchedNodesDidChange.notifications
+      == std::vector<std::vector<Node*>>{sorted({brushNode1, brushNode2})});
+  }
+
+  SECTION("Omits nodes that were removed during the batch")
+  {
+    {
+      const auto batch = NodeChangeBatch{map};
+      selectNodes(map, {brushNode1, brushNode2});
+      translateSelection(map, {16, 0, 0});
+      removeNodes(map, {brushNode1});
+    }
+
+    CHECK(
+      batchedNodesDidChange.notifications
+      == std::vector<std::vector<Node*>>{{brushNode2}});
+  }
+
+  SECTION("Coalesces changes when undoing a transaction")
+  {
+    {
+      auto transaction = Transaction{map, "test"};
+      selectNodes(map, {brushNode1});
+      translateSelection(map, {16, 0, 0});
+      translateSelection(map, {16, 0, 0});
+      transaction.commit();
+    }
+
+    batchedNodesDidChange.reset();
+    map.undoCommand();
+
+    CHECK(
+      batchedNodesDidChange.notifications
+      == std::vector<std::vector<Node*>>{{brushNode1}});
+  }
+
+  SECTION("Does not notify if nothing changed")
+  {
+    {
+      const auto batch = NodeChangeBatch{map};
+      selectNodes(map, {brushNode1});
+    }
+
+    CHECK(batchedNodesDidChange.notifications.empty());
+  }
+}
+
+} // namespace tb::mdl
@@ -195,6 +195,112 @@ TEST_CASE("NodeIndex")
     }
   }
 
+  SECTION("Finding nodes by property")
+  {
+    auto entityNode1 = EntityNode{Entity{{
+      {"targetname", "door"},
+      {"target", "light"},
+    }}};
+    auto entityNode2 = EntityNode{Entity{{
+      {"target2", "door"},
+      {"killtarget", "light"},
+    }}};
+    auto worldNode = WorldNode{{}, {{"message", "door"}}, MapFormat::Quake3};
+    auto groupNode = GroupNode{Group{"door"}};
+
+    i.addNode(entityNode1);
+    i.addNode(entityNode2);
+    i.addNode(worldNode);
+    i.addNode(groupNode);
+
+    CHECK_THAT(
+      i.findNodesWithProperty("targetname", "door"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1}));
+    CHECK_THAT(
+      i.findNodesWithProperty("targetname", "light"),
+      UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(
+      i.findNodesWithProperty("target", "door"), UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(
+      i.findNodesWithProperty<WorldNode>("message", "door"),
+      UnorderedEquals(std::vector<WorldNode*>{&worldNode}));
+
+    CHECK_THAT(
+      i.findNodesWithPropertyValue("door"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2, &worldNode}));
+    CHECK_THAT(
+      i.findNodesWithPropertyValue<EntityNode>("door"),
+      UnorderedEquals(std::vector<EntityNode*>{&entityNode1, &entityNode2}));
+    CHECK_THAT(
+      i.findNodesWithPropertyValue("targetname"), UnorderedEquals(std::vector<Node*>{}));
+
+    CHECK_THAT(
+      i.findNodesWithNumberedProperty("target", "door"),
+      UnorderedEquals(std::vector<Node*>{&entityNode2}));
+    CHECK_THAT(
+      i.findNodesWithNumberedProperty("target", "light"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1}));
+
+    CHECK(
+      i.findNumberedPropertyValues("target")
+      == std::vector<std::string>{"door", "light"});
+    CHECK(i.findNumberedPropertyValues("targetname") == std::vector<std::string>{"door"});
+    CHECK(i.findNumberedPropertyValues("origin") == std::vector<std::string>{});
+
+    i.removeNode(entityNode1);
+
+    CHECK_THAT(
+      i.findNodesWithProperty("targetname", "door"),
+      UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(
+      i.findNodesWithPropertyValue("door"),
+      UnorderedEquals(std::vector<Node*>{&entityNode2, &worldNode}));
+    CHECK(i.findNumberedPropertyValues("target") == std::vector<std::string>{"door"});
+  }
+
+  SECTION("Adding and removing nodes in bulk")
+  {
+    auto entityNode1 = EntityNode{Entity{{
+      {"classname", "light"},
+      {"targetname", "lamp"},
+    }}};
+    auto entityNode2 = EntityNode{Entity{{
+      {"classname", "light"},
+      {"target", "lamp"},
+    }}};
+    auto entityNode3 = EntityNode{Entity{{
+      {"classname", "info_null"},
+    }}};
+    auto groupNode = GroupNode{Group{"lamp_group"}};
+
+    i.addNodes({&entityNode1, &entityNode2, &entityNode3, &groupNode});
+
+    CHECK_THAT(
+      i.findNodesWithProperty("classname", "light"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2}));
+    CHECK_THAT(
+      i.findNodes("lamp*"),
+      UnorderedEquals(std::vector<Node*>{&entityNode1, &entityNode2, &groupNode}));
+
+    i.removeNodes({&entityNode1, &entityNode3});
+
+    CHECK_THAT(
+      i.findNodesWithProperty("classname", "light"),
+      UnorderedEquals(std::vector<Node*>{&entityNode2}));
+    CHECK_THAT(
+      i.findNodesWithProperty("classname", "info_null"),
+      UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(
+      i.findNodes("lamp*"),
+      UnorderedEquals(std::vector<Node*>{&entityNode2, &groupNode}));
+
+    i.removeNode(entityNode2);
+    i.removeNodes({&groupNode});
+
+    CHECK_THAT(i.findNodes("*"), UnorderedEquals(std::vector<Node*>{}));
+    CHECK(i.findNumberedPropertyValues("classname") == std::vector<std::string>{});
+  }
+
   SECTION("clear")
   {
     auto entityNode = EntityNode{Entity{{
@@ -209,6 +315,9 @@ TEST_CASE("NodeIndex")
     i.clear();
 
     CHECK_THAT(i.findNodes("some_key"), UnorderedEquals(std::vector<Node*>{}));
+    CHECK_THAT(
+      i.findNodesWithProperty("some_key", "a_value"),
+      UnorderedEquals(std::vector<Node*>{}));
   }
 }
 
@@ -20,6 +20,14 @@
 #include "mdl/CatchConfig.h"
 #include "mdl/Octree.h"
 
+#include "kd/task_manager.h"
+#include "kd/vector_utils.h"
+
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 
 namespace tb::mdl
@@ -226,6 +234,20 @@ TEST_CASE("node_address")
     CHECK(
       get_container({{-42, -42, -42}, {2, 2, 2}}, 32.0) == node_address{-2, -2, -2, 2});
   }
+
+  SECTION("get_morton_code")
+  {
+    const auto parent = node_address{-4, 0, 4, 2};
+    const auto code = get_morton_code(parent);
+    for (size_t quadrant = 0; quadrant < 8; ++quadrant)
+    {
+      CHECK(get_morton_code(get_child(parent, quadrant)) == code + quadrant * 8);
+    }
+
+    CHECK(get_morton_code({-1, -1, -1, 0}) < get_morton_code({0, 0, 0, 0}));
+    CHECK(get_morton_code({1, 0, 0, 0}) < get_morton_code({0, 1, 0, 0}));
+    CHECK(get_morton_code({0, 1, 0, 0}) < get_morton_code({0, 0, 1, 0}));
+  }
 }
 } // namespace detail
 
@@ -553,6 +575,134 @@ TEST_CASE("octree.insert_duplicate")
   CHECK_FALSE(tree.empty());
 }
 
+TEST_CASE("octree.build")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("empty tree")
+  {
+    REQUIRE(tree.insert({{1, 1, 1}, {2, 2, 2}}, 1));
+
+    tree.build({});
+    CHECK(tree == octree<double, int>{32.0});
+  }
+
+  SECTION("only root data")
+  {
+    tree.build({
+      {{{-2, 0, 0}, {5, 3, 6}}, 1},
+      {{{-33, -32, -32}, {32, 32, 32}}, 2},
+      {{{-32, -32, -32}, {32, 32, 32}}, 3},
+    });
+    CHECK(tree == octree<double, int>{32.0, leaf_node{{-2, -2, -2, 2}, {1, 2, 3}}});
+  }
+
+  SECTION("nested data")
+  {
+    tree.build({
+      {{{1, 1, 1}, {2, 2, 2}}, 1},
+      {{{1, 1, 1}, {40, 40, 40}}, 3},
+      {{{1, 1, 1}, {2, 2, 2}}, 2},
+    });
+    CHECK(
+      tree
+      == octree<double, int>{
+        32.0,
+        inner_node{
+          {-2, -2, -2, 2},
+          {},
+          kdl::vec_from(
+            node{leaf_node{{-2, -2, -2, 1}, {}}},
+            node{leaf_node{{0, -2, -2, 1}, {}}},
+            node{leaf_node{{-2, 0, -2, 1}, {}}},
+            node{leaf_node{{0, 0, -2, 1}, {}}},
+            node{leaf_node{{-2, -2, 0, 1}, {}}},
+            node{leaf_node{{0, -2, 0, 1}, {}}},
+            node{leaf_node{{-2, 0, 0, 1}, {}}},
+            node{inner_node{
+              {0, 0, 0, 1},
+              {3},
+              kdl::vec_from(
+                node{leaf_node{{0, 0, 0, 0}, {1, 2}}},
+                node{leaf_node{{1, 0, 0, 0}, {}}},
+                node{leaf_node{{0, 1, 0, 0}, {}}},
+                node{leaf_node{{1, 1, 0, 0}, {}}},
+                node{leaf_node{{0, 0, 1, 0}, {}}},
+                node{leaf_node{{1, 0, 1, 0}, {}}},
+                node{leaf_node{{0, 1, 1, 0}, {}}},
+                node{leaf_node{{1, 1, 1, 0}, {}}})}})}});
+  }
+
+  SECTION("random data")
+  {
+    auto rng = std::mt19937{1};
+    auto position = std::uniform_real_distribution<double>{-4096.0, 4096.0};
+    auto extent = std::uniform_real_distribution<double>{1.0, 256.0};
+
+    auto items = std::vector<std::pair<vm::bbox3d, int>>{};
+    for (int i = 0; i < 40000; ++i)
+    {
+      const auto min = vm::vec3d{position(rng), position(rng), position(rng)};
+      const auto max = min + vm::vec3d{extent(rng), extent(rng), extent(rng)};
+      items.emplace_back(vm::bbox3d{min, max}, i);
+    }
+
+    auto insertedTree = octree<double, int>{32.0};
+    for (const auto& [bounds, data] : items)
+    {
+      REQUIRE(insertedTree.insert(bounds, data));
+    }
+
+    tree.build(items);
+
+    SECTION("queries find the same data as in a tree built by inserting")
+    {
+      for (std::size_t i = 0; i < 100; ++i)
+      {
+        const auto point = vm::vec3d{position(rng), position(rng), position(rng)};
+        const auto bbox = vm::bbox3d{point, point + vm::vec3d::fill(extent(rng))};
+        const auto ray =
+          vm::ray3d{point, vm::normalize(vm::vec3d{position(rng), position(rng), 1.0})};
+
+        CHECK(
+          kdl::vec_sort(tree.find_containers(point))
+          == kdl::vec_sort(insertedTree.find_containers(point)));
+        CHECK(
+          kdl::vec_sort(tree.find_intersectors(bbox))
+          == kdl::vec_sort(insertedTree.find_intersectors(bbox)));
+        CHECK(
+          kdl::vec_sort(tree.find_intersectors(ray))
+          == kdl::vec_sort(insertedTree.find_intersectors(ray)));
+      }
+    }
+
+    SECTION("data can be updated and removed")
+    {
+      for (const auto& [bounds, data] : items)
+      {
+        CHECK(tree.contains(data));
+        tree.update(bounds.translate(vm::vec3d{64, 64, 64}), data);
+      }
+
+      for (const auto& [bounds, data] : items)
+      {
+        CHECK(tree.remove(data));
+      }
+      CHECK(tree.empty());
+    }
+
+    SECTION("building in parallel builds the same tree")
+    {
+      auto taskManager = kdl::task_manager{4};
+
+      auto parallelTree = octree<double, int>{32.0};
+      parallelTree.build(items, taskManager);
+
+      CHECK(parallelTree == tree);
+    }
+  }
+}
+
 TEST_CASE("octree.contains")
 {
   auto tree = octree<double, int>{32.0};
@@ -676,6 +826,49 @@ TEST_CASE("octree.find_intersectors-bbox")
   }
 }
 
+TEST_CASE("octree.find_if")
+{
+  auto tree = octree<double, int>{32.0};
+
+  const auto findIntersectors = [&](const vm::bbox3d& bbox) {
+    auto result = std::vector<int>{};
+    tree.find_if(
+      [&](const auto& bounds) { return bbox.intersects(bounds); },
+      std::back_inserter(result));
+    return kdl::vec_sort(std::move(result));
+  };
+
+  SECTION("empty tree")
+  {
+    CHECK(findIntersectors(vm::bbox3d{{0, 0, 0}, {1, 1, 1}}).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    REQUIRE(tree.insert({{32, 32, 32}, {64, 64, 64}}, 1));
+    REQUIRE(tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2));
+    REQUIRE(tree.insert({{-8, -8, -8}, {8, 8, 8}}, 3));
+
+    // only the root data is found
+    CHECK(findIntersectors(vm::bbox3d{{0, 0, 0}, {1, 1, 1}}) == std::vector<int>{3});
+
+    // the root data and one leaf are found
+    CHECK(
+      findIntersectors(vm::bbox3d{{40, 40, 40}, {48, 48, 48}})
+      == std::vector<int>{1, 3});
+
+    // everything is found
+    CHECK(
+      findIntersectors(vm::bbox3d{{-48, -48, -48}, {48, 48, 48}})
+      == std::vector<int>{1, 2, 3});
+
+    // nothing is found if the predicate never holds
+    auto result = std::vector<int>{};
+    tree.find_if([](const auto&) { return false; }, std::back_inserter(result));
+    CHECK(result.empty());
+  }
+}
+
 TEST_CASE("octree.find_containers")
 {
   auto tree = octree<double, int>{32.0};
@@ -19,16 +19,95 @@
 
 #include "Result.h"
 #include "fs/DiskIO.h"
+#include "fs/Reader.h"
+#include "gl/TextureBuffer.h"
 #include "mdl/CatchConfig.h"
 #include "mdl/Palette.h"
 
 #include "kd/result.h"
 
+#include <algorithm>
+#include <cstring>
+#include <random>
+
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 
 namespace tb::mdl
 {
+namespace
+{
+
+std::vector<unsigned char> makeTestPaletteData()
+{
+  auto data = std::vector<unsigned char>(768);
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<unsigned char>((i * 37) % 256);
+  }
+  return data;
+}
+
+std::vector<unsigned char> makeRandomIndices(const size_t count)
+{
+  auto randEngine = std::mt19937{};
+  auto distribution = std::uniform_int_distribution<int>{0, 255};
+
+  auto result = std::vector<unsigned char>(count);
+  for (auto& index : result)
+  {
+    index = static_cast<unsigned char>(distribution(randEngine));
+  }
+  return result;
+}
+
+std::vector<unsigned char> makeRgbaPaletteData(
+  const std::vector<unsigned char>& rgbData, const PaletteTransparency transparency)
+{
+  auto result = std::vector<unsigned char>(1024);
+  for (size_t i = 0; i < 256; ++i)
+  {
+    result[4 * i + 0] = rgbData[3 * i + 0];
+    result[4 * i + 1] = rgbData[3 * i + 1];
+    result[4 * i + 2] = rgbData[3 * i + 2];
+    result[4 * i + 3] =
+      (i == 255 && transparency == PaletteTransparency::Index255Transparent) ? 0x00
+                                                                             : 0xFF;
+  }
+  return result;
+}
+
+// Straightforward per pixel conversion to compare the optimized conversion against
+bool indexedToRgbaReference(
+  const std::vector<unsigned char>& paletteData,
+  const std::vector<unsigned char>& indices,
+  gl::TextureBuffer& rgbaImage,
+  Color& averageColor)
+{
+  auto* const rgbaData = rgbaImage.data();
+  uint32_t colorSum[3] = {0, 0, 0};
+  unsigned char andAlpha = 0xFF;
+  for (size_t i = 0; i < indices.size(); ++i)
+  {
+    const auto* pixel = &paletteData[size_t(indices[i]) * 4];
+    std::memcpy(rgbaData + (i * 4), pixel, 4);
+    colorSum[0] += uint32_t(pixel[0]);
+    colorSum[1] += uint32_t(pixel[1]);
+    colorSum[2] += uint32_t(pixel[2]);
+    andAlpha = static_cast<unsigned char>(andAlpha & pixel[3]);
+  }
+
+  const auto pixelCount = float(indices.size());
+  averageColor = RgbaF{
+    float(colorSum[0]) / (255.0f * pixelCount),
+    float(colorSum[1]) / (255.0f * pixelCount),
+    float(colorSum[2]) / (255.0f * pixelCount),
+    1.0f};
+
+  return andAlpha != 0xFF;
+}
+
+} // namespace
 
 TEST_CASE("makePalette")
 {
@@ -216,4 +295,81 @@ TEST_CASE("loadPalette")
   CHECK(loadPalette(*file, filePath) == expectedPalette);
 }
 
+TEST_CASE("Palette.indexedToRgba")
+{
+  const auto paletteData = makeTestPaletteData();
+  const auto palette = makePalette(paletteData, PaletteColorFormat::Rgb) | kdl::value();
+
+  const auto pixelCount =
+    GENERATE(size_t(1), size_t(7), size_t(8), size_t(67), size_t(4096));
+  const auto transparency =
+    GENERATE(PaletteTransparency::Opaque, PaletteTransparency::Index255Transparent);
+
+  CAPTURE(pixelCount, transparency);
+
+  auto indices = makeRandomIndices(pixelCount);
+
+  SECTION("without index 255")
+  {
+    std::replace(indices.begin(), indices.end(), 255, 254);
+  }
+
+  SECTION("with index 255")
+  {
+    indices.back() = 255;
+  }
+
+  const auto expectedPaletteData = makeRgbaPaletteData(paletteData, transparency);
+
+  auto expectedImage = gl::TextureBuffer{4 * pixelCount};
+  auto expectedAverageColor = Color{RgbaF{}};
+  const auto expectedTransparency = indexedToRgbaReference(
+    expectedPaletteData, indices, expectedImage, expectedAverageColor);
+
+  auto reader = fs::Reader::from(
+    reinterpret_cast<const char*>(indices.data()),
+    reinterpret_cast<const char*>(indices.data() + indices.size()));
+  auto image = gl::TextureBuffer{4 * pixelCount};
+  auto averageColor = Color{RgbaF{}};
+
+  CHECK(
+    palette.indexedToRgba(reader, pixelCount, image, transparency, averageColor)
+    == expectedTransparency);
+  CHECK(reader.eof());
+  CHECK(std::memcmp(image.data(), expectedImage.data(), image.size()) == 0);
+  CHECK(averageColor == expectedAverageColor);
+}
+
+TEST_CASE("Palette.benchmarkIndexedToRgbaReference", "[.]")
+{
+  const auto paletteData =
+    makeRgbaPaletteData(makeTestPaletteData(), PaletteTransparency::Opaque);
+  const auto indices = makeRandomIndices(256 * 256);
+
+  auto image = gl::TextureBuffer{4 * indices.size()};
+  auto averageColor = Color{RgbaF{}};
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    indexedToRgbaReference(paletteData, indices, image, averageColor);
+  }
+}
+
+TEST_CASE("Palette.benchmarkIndexedToRgba", "[.]")
+{
+  const auto palette =
+    makePalette(makeTestPaletteData(), PaletteColorFormat::Rgb) | kdl::value();
+  const auto indices = makeRandomIndices(256 * 256);
+
+  auto image = gl::TextureBuffer{4 * indices.size()};
+  auto averageColor = Color{RgbaF{}};
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    auto reader = fs::Reader::from(
+      reinterpret_cast<const char*>(indices.data()),
+      reinterpret_cast<const char*>(indices.data() + indices.size()));
+    palette.indexedToRgba(
+      reader, indices.size(), image, PaletteTransparency::Opaque, averageColor);
+  }
+}
+
 } // namespace tb::mdl
@@ -492,6 +492,54 @@ TEST_CASE("CompilationConfigParser")
          }},
       }});
   }
+
+  SECTION("parseTaskDependencies")
+  {
+    const auto config = R"(
+{
+  'version': 1,
+  'profiles': [
+    {
+      'name' : 'A profile',
+      'workdir' : '',
+      'tasks': [
+        { 'type' : 'delete', 'target' : 'first', 'dependencies' : [] },
+        { 'type' : 'delete', 'target' : 'second', 'dependencies' : [0, 2] },
+        { 'type' : 'delete', 'target' : 'third' }
+      ]
+    }
+  ]
+})";
+
+    CHECK(
+      parseCompilationConfig(config)
+      == mdl::CompilationConfig{{
+        {"A profile",
+         "",
+         {
+           mdl::CompilationDeleteFiles{K(enabled), "first", std::vector<size_t>{}},
+           mdl::CompilationDeleteFiles{K(enabled), "second", std::vector<size_t>{0, 2}},
+           mdl::CompilationDeleteFiles{K(enabled), "third"},
+         }},
+      }});
+  }
+
+  SECTION("parseNegativeTaskDependency")
+  {
+    const auto config = R"(
+{
+  'version': 1,
+  'profiles': [
+    {
+      'name' : 'A profile',
+      'workdir' : '',
+      'tasks': [ { 'type' : 'delete', 'target' : 'first', 'dependencies' : [-1] } ]
+    }
+  ]
+})";
+
+    CHECK(parseCompilationConfig(config).is_error());
+  }
 }
 
 } // namespace tb::mdl
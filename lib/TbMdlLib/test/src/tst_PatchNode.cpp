@@ -169,6 +169,225 @@ TEST_CASE("PatchNode.makePatchGrid")
                 })));
 }
 
+namespace
+{
+
+// clang-format off
+const auto flatPatch = BezierPatch{5, 5, {
+  {0.0, 4.0, 0.0}, {1.0, 4.0, 0.0}, {2.0, 4.0, 0.0}, {3.0, 4.0, 0.0}, {4.0, 4.0, 0.0},
+  {0.0, 3.0, 0.0}, {1.0, 3.0, 0.0}, {2.0, 3.0, 0.0}, {3.0, 3.0, 0.0}, {4.0, 3.0, 0.0},
+  {0.0, 2.0, 0.0}, {1.0, 2.0, 0.0}, {2.0, 2.0, 0.0}, {3.0, 2.0, 0.0}, {4.0, 2.0, 0.0},
+  {0.0, 1.0, 0.0}, {1.0, 1.0, 0.0}, {2.0, 1.0, 0.0}, {3.0, 1.0, 0.0}, {4.0, 1.0, 0.0},
+  {0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {2.0, 0.0, 0.0}, {3.0, 0.0, 0.0}, {4.0, 0.0, 0.0},
+}, "material"};
+
+const auto hillPatch = BezierPatch{3, 3, {
+  {0.0, 2.0, 0.0}, {1.0, 2.0, 0.0}, {2.0, 2.0, 0.0},
+  {0.0, 1.0, 0.0}, {1.0, 1.0, 4.0}, {2.0, 1.0, 0.0},
+  {0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {2.0, 0.0, 0.0},
+}, "material"};
+
+const auto twistedPatch = BezierPatch{3, 3, {
+  {0.0, 2.0, 0.0}, {1.0, 2.0, 0.5}, {2.0, 2.0, 1.0},
+  {0.0, 1.0, 0.5}, {1.0, 1.0, 0.5}, {2.0, 1.0, 0.5},
+  {0.0, 0.0, 1.0}, {1.0, 0.0, 0.5}, {2.0, 0.0, 0.0},
+}, "material"};
+
+// the edge midpoints are raised by 1 and the center by 2, so that the center of the
+// surface is raised by 1
+const auto domePatch = BezierPatch{3, 3, {
+  {0.0, 2.0, 0.0}, {1.0, 2.0, 1.0}, {2.0, 2.0, 0.0},
+  {0.0, 1.0, 1.0}, {1.0, 1.0, 2.0}, {2.0, 1.0, 1.0},
+  {0.0, 0.0, 0.0}, {1.0, 0.0, 1.0}, {2.0, 0.0, 0.0},
+}, "material"};
+
+const auto irregularPatch = BezierPatch{3, 5, {
+  {0.0, 2.0, 0.0, 0.0, 0.0}, {1.0, 2.5, 1.0, 0.5, 0.0}, {2.0, 2.0, -1.0, 1.0, 0.0}, {3.0, 1.5, 0.5, 1.5, 0.0}, {4.0, 2.0, 3.0, 2.0, 0.0},
+  {0.5, 1.0, 1.0, 0.0, 0.5}, {1.0, 1.0, 3.0, 0.5, 0.5}, {2.5, 1.0,  0.0, 1.0, 0.5}, {3.0, 1.0, 2.0, 1.5, 0.5}, {4.0, 1.5, 0.0, 2.0, 0.5},
+  {0.0, 0.0, 0.0, 0.0, 1.0}, {1.0, 0.5, 2.0, 0.5, 1.0}, {2.0, 0.0,  1.0, 1.0, 1.0}, {3.0, 0.0, 0.0, 1.5, 1.0}, {4.0, 0.0, 1.0, 2.0, 1.0},
+}, "material"};
+// clang-format on
+
+/**
+ * Returns the largest distance between the given patch and the triangles of a grid with
+ * the given number of subdivisions per surface, as they are rendered. The distance is
+ * measured by sampling the patch.
+ */
+double measureGridError(const BezierPatch& patch, const size_t subdivisionsPerSurface)
+{
+  constexpr auto SamplesPerQuad = size_t(16);
+
+  const auto grid = makePatchGrid(patch, subdivisionsPerSurface);
+  const auto samples = patch.evaluate(subdivisionsPerSurface + 4u);
+  const auto sampleColumnCount = grid.quadColumnCount() * SamplesPerQuad + 1u;
+
+  auto error = 0.0;
+  for (size_t row = 0u; row < grid.quadRowCount(); ++row)
+  {
+    for (size_t col = 0u; col < grid.quadColumnCount(); ++col)
+    {
+      const auto& p0 = grid.point(row, col).position;
+      const auto& p1 = grid.point(row, col + 1u).position;
+      const auto& p2 = grid.point(row + 1u, col + 1u).position;
+      const auto& p3 = grid.point(row + 1u, col).position;
+
+      for (size_t i = 0u; i <= SamplesPerQuad; ++i)
+      {
+        for (size_t j = 0u; j <= SamplesPerQuad; ++j)
+        {
+          const auto v = double(i) / double(SamplesPerQuad);
+          const auto u = double(j) / double(SamplesPerQuad);
+
+          // the quads are split along the diagonal from p0 to p2
+          const auto trianglePoint = u >= v ? p0 + u * (p1 - p0) + v * (p2 - p1)
+                                            : p0 + v * (p3 - p0) + u * (p2 - p3);
+
+          const auto sampleIndex = (row * SamplesPerQuad + i) * sampleColumnCount
+                                   + col * SamplesPerQuad + j;
+          const auto patchPoint = vm::slice<3>(samples[sampleIndex], 0);
+          error = vm::max(error, vm::distance(trianglePoint, patchPoint));
+        }
+      }
+    }
+  }
+
+  return error;
+}
+
+} // namespace
+
+TEST_CASE("PatchNode.computePatchFlatnessError")
+{
+  CHECK(computePatchFlatnessError(flatPatch) == 0.0);
+  CHECK(computePatchFlatnessError(hillPatch) == vm::approx{8.0});
+  CHECK(computePatchFlatnessError(twistedPatch) == vm::approx{0.5});
+  CHECK(computePatchFlatnessError(domePatch) == vm::approx{1.0});
+
+  SECTION("Bounds the distance between the patch and its grid")
+  {
+    const auto patch = GENERATE(
+      flatPatch, hillPatch, twistedPatch, domePatch, irregularPatch);
+    const auto subdivisionsPerSurface = GENERATE(0u, 1u, 2u, 3u);
+
+    const auto flatnessError = computePatchFlatnessError(patch);
+    const auto maxError =
+      flatnessError / double(size_t(1) << (2u * subdivisionsPerSurface));
+
+    CAPTURE(patch, subdivisionsPerSurface);
+    CHECK(measureGridError(patch, subdivisionsPerSurface) <= maxError + 1e-9);
+  }
+
+  SECTION("Includes texture coordinates")
+  {
+    auto distortedPatch = flatPatch;
+    auto controlPoint = distortedPatch.controlPoint(1, 1);
+    controlPoint[3] += 0.5;
+    distortedPatch.setControlPoint(1, 1, controlPoint);
+
+    CHECK(computePatchFlatnessError(distortedPatch) > 0.0);
+    CHECK(makePatchGrid(distortedPatch).subdivisionsPerSurface > 0u);
+  }
+}
+
+TEST_CASE("PatchNode.computeSubdivisionsPerSurface")
+{
+  CHECK(computeSubdivisionsPerSurface(0.0, 0.25, 3) == 0);
+  CHECK(computeSubdivisionsPerSurface(2.0, 2.0, 3) == 0);
+  CHECK(computeSubdivisionsPerSurface(2.0, 0.5, 3) == 1);
+  CHECK(computeSubdivisionsPerSurface(2.0, 0.25, 3) == 2);
+  CHECK(computeSubdivisionsPerSurface(2.0, 0.01, 3) == 3);
+  CHECK(computeSubdivisionsPerSurface(2.0, 0.01, 1) == 1);
+}
+
+TEST_CASE("PatchNode.makeAdaptivePatchGrid")
+{
+  SECTION("Flat patches are not subdivided")
+  {
+    const auto grid = makePatchGrid(flatPatch);
+    CHECK(grid.subdivisionsPerSurface == 0);
+    CHECK(grid.pointRowCount == 3);
+    CHECK(grid.pointColumnCount == 3);
+    CHECK(grid.bounds == flatPatch.bounds());
+  }
+
+  SECTION("Curved patches are subdivided until they are flat enough")
+  {
+    auto shallowHillPatch = hillPatch;
+    shallowHillPatch.setControlPoint(1, 1, {1.0, 1.0, 0.1});
+
+    const auto grid = makePatchGrid(shallowHillPatch);
+    CHECK(grid.subdivisionsPerSurface == 2);
+    CHECK(grid.flatnessError == vm::approx{0.2});
+    CHECK(grid == makePatchGrid(shallowHillPatch, 2));
+  }
+
+  SECTION("Grids are within 1/64 units of the patch")
+  {
+    auto shallowDomePatch = domePatch;
+    for (size_t row = 0u; row < shallowDomePatch.pointRowCount(); ++row)
+    {
+      for (size_t col = 0u; col < shallowDomePatch.pointColumnCount(); ++col)
+      {
+        auto controlPoint = shallowDomePatch.controlPoint(row, col);
+        controlPoint[2] /= 8.0;
+        shallowDomePatch.setControlPoint(row, col, controlPoint);
+      }
+    }
+
+    const auto grid = makePatchGrid(shallowDomePatch);
+    CHECK(grid.subdivisionsPerSurface == 2);
+    CHECK(measureGridError(shallowDomePatch, grid.subdivisionsPerSurface) <= 1.0 / 64.0);
+  }
+
+  SECTION("Subdivisions are limited")
+  {
+    CHECK(makePatchGrid(hillPatch).subdivisionsPerSurface == 3);
+  }
+}
+
+TEST_CASE("PatchGrid.lodStride")
+{
+  const auto grid = makePatchGrid(hillPatch, 2);
+
+  CHECK(grid.lodStride(8.0) == 4);
+  CHECK(grid.lodStride(2.0) == 2);
+  CHECK(grid.lodStride(0.5) == 1);
+  CHECK(grid.lodStride(0.0) == 1);
+
+  // a coarser grid is a subset of the finer grid
+  const auto coarseGrid = makePatchGrid(hillPatch, 1);
+  for (size_t row = 0u; row < coarseGrid.pointRowCount; ++row)
+  {
+    for (size_t col = 0u; col < coarseGrid.pointColumnCount; ++col)
+    {
+      CHECK(
+        coarseGrid.point(row, col).position
+        == vm::approx{grid.point(row * 2u, col * 2u).position});
+    }
+  }
+}
+
+TEST_CASE("PatchNode.setPatch")
+{
+  auto patchNode = PatchNode{flatPatch};
+  CHECK(patchNode.grid() == makePatchGrid(flatPatch));
+
+  SECTION("Makes the grid")
+  {
+    CHECK(patchNode.setPatch(hillPatch) == flatPatch);
+    CHECK(patchNode.patch() == hillPatch);
+    CHECK(patchNode.grid() == makePatchGrid(hillPatch));
+  }
+
+  SECTION("Uses the given grid")
+  {
+    const auto grid = makePatchGrid(hillPatch, 1);
+    CHECK(patchNode.setPatch(hillPatch, grid) == flatPatch);
+    CHECK(patchNode.patch() == hillPatch);
+    CHECK(patchNode.grid() == grid);
+  }
+}
+
 TEST_CASE("PatchNode.pickFlatPatch")
 {
   using P = BezierPatch::Point;
@@ -28,6 +28,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <random>
 #include <set>
 
 #include <catch2/catch_test_macros.hpp>
@@ -95,6 +96,69 @@ bool findAndRemove(
   return false;
 }
 
+std::vector<vm::vec3d> makeRandomPoints(std::mt19937& rng, const size_t count)
+{
+  // use the raw generator output so that the points are the same on all platforms
+  const auto makeCoordinate = [&]() { return double(rng() % 12801u) / 100.0 - 64.0; };
+
+  auto result = std::vector<vm::vec3d>{};
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.emplace_back(makeCoordinate(), makeCoordinate(), makeCoordinate());
+  }
+  return result;
+}
+
+struct ConvexHullInfo
+{
+  std::vector<vm::vec3d> vertices;
+  size_t faceCount;
+};
+
+/**
+ * Computes the vertices and faces of the convex hull of the given points by checking every
+ * triangle. Assumes that no four points are coplanar, so every face is a triangle.
+ */
+ConvexHullInfo computeConvexHullByBruteForce(const std::vector<vm::vec3d>& points)
+{
+  auto vertexIndices = std::set<size_t>{};
+  auto faceCount = size_t(0);
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    for (size_t j = i + 1; j < points.size(); ++j)
+    {
+      for (size_t k = j + 1; k < points.size(); ++k)
+      {
+        const auto normal = vm::cross(points[j] - points[i], points[k] - points[i]);
+
+        auto above = false;
+        auto below = false;
+        for (size_t l = 0; l < points.size() && !(above && below); ++l)
+        {
+          if (l != i && l != j && l != k)
+          {
+            const auto distance = vm::dot(normal, points[l] - points[i]);
+            above = above || distance > 0.0;
+            below = below || distance < 0.0;
+          }
+        }
+
+        if (!above || !below)
+        {
+          vertexIndices.insert({i, j, k});
+          ++faceCount;
+        }
+      }
+    }
+  }
+
+  auto vertices = std::vector<vm::vec3d>{};
+  std::ranges::transform(
+    vertexIndices, std::back_inserter(vertices), [&](const auto i) { return points[i]; });
+  return {std::move(vertices), faceCount};
+}
+
 } // namespace
 
 TEST_CASE("Polyhedron")
@@ -1386,6 +1450,37 @@ TEST_CASE("Polyhedron")
       },
       cube));
   }
+
+  SECTION("convexHullOfRandomPoints")
+  {
+    // Small point sets are added incrementally, while larger ones are added starting with
+    // their extreme points. Both must yield the same hull.
+    auto rng = std::mt19937{};
+    for (const auto pointCount : {size_t(8), size_t(24), size_t(48), size_t(96)})
+    {
+      for (size_t i = 0; i < 8; ++i)
+      {
+        CAPTURE(pointCount, i);
+
+        const auto points = makeRandomPoints(rng, pointCount);
+        const auto expected = computeConvexHullByBruteForce(points);
+
+        // exact and near duplicates must not change the result
+        auto pointsWithDuplicates = points;
+        for (const auto& point : points)
+        {
+          pointsWithDuplicates.push_back(point);
+          pointsWithDuplicates.push_back(point + vm::vec3d{0.001, 0.0, 0.0});
+        }
+
+        const auto p = Polyhedron3d{pointsWithDuplicates};
+        CHECK(p.vertexCount() == expected.vertices.size());
+        CHECK(p.hasAllVertices(expected.vertices, 0.0));
+        CHECK(p.faceCount() == expected.faceCount);
+        CHECK(p.edgeCount() == expected.faceCount * 3 / 2);
+      }
+    }
+  }
 }
 
 TEST_CASE("Polyhedron (Regression)", "[regression]")
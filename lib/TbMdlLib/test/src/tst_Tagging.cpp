@@ -18,11 +18,14 @@
  */
 
 #include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/CatchConfig.h"
 #include "mdl/LayerNode.h"
 #include "mdl/MapFormat.h"
 #include "mdl/Tag.h"
+#include "mdl/TagManager.h"
+#include "mdl/TagMatcher.h"
 #include "mdl/WorldNode.h"
 
 #include "kd/result.h"
@@ -66,4 +69,53 @@ TEST_CASE("TaggingTest.testTagBrush")
   CHECK_FALSE(brushNode->hasTag(tag2));
 }
 
+TEST_CASE("TaggingTest.testUpdateBrushFaceTags")
+{
+  const auto worldBounds = vm::bbox3d{4096.0};
+
+  auto tagManager = TagManager{};
+  tagManager.registerSmartTags({
+    SmartTag{"water", {}, std::make_unique<MaterialNameTagMatcher>("*water*")},
+    SmartTag{"clip", {}, std::make_unique<ContentFlagsTagMatcher>(1 << 1)},
+    SmartTag{"sky", {}, std::make_unique<SurfaceFlagsTagMatcher>((1 << 2) | (1 << 4))},
+    SmartTag{"trigger", {}, std::make_unique<EntityClassNameTagMatcher>("trigger*", "")},
+  });
+
+  const auto& water = tagManager.smartTag("water");
+  const auto& clip = tagManager.smartTag("clip");
+  const auto& sky = tagManager.smartTag("sky");
+  const auto& trigger = tagManager.smartTag("trigger");
+
+  auto builder = BrushBuilder{MapFormat::Quake2, worldBounds};
+  auto brush = builder.createCube(64.0, "e1u1/WATER1") | kdl::value();
+  auto& face = brush.face(0);
+
+  tagManager.updateTags(face);
+  CHECK(face.hasTag(water));
+  CHECK_FALSE(face.hasTag(clip));
+  CHECK_FALSE(face.hasTag(sky));
+  CHECK_FALSE(face.hasTag(trigger));
+
+  auto attributes = face.attributes();
+  attributes.setMaterialName("e1u1/lava1");
+  attributes.setSurfaceContents(1 << 1 | 1 << 3);
+  attributes.setSurfaceFlags(1 << 4);
+  face.setAttributes(attributes);
+
+  tagManager.updateTags(face);
+  CHECK_FALSE(face.hasTag(water));
+  CHECK(face.hasTag(clip));
+  CHECK(face.hasTag(sky));
+  CHECK_FALSE(face.hasTag(trigger));
+
+  attributes.setMaterialName("e1u1/Water2");
+  attributes.setSurfaceContents(1 << 3);
+  face.setAttributes(attributes);
+
+  face.updateTags(tagManager);
+  CHECK(face.hasTag(water));
+  CHECK_FALSE(face.hasTag(clip));
+  CHECK(face.hasTag(sky));
+}
+
 } // namespace tb::mdl
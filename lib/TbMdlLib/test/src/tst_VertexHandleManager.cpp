@@ -0,0 +1,193 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gl/OrthographicCamera.h"
+#include "gl/PerspectiveCamera.h"
+#include "mdl/CatchConfig.h"
+#include "mdl/PickResult.h"
+#include "mdl/VertexHandleManager.h"
+
+#include "kd/vector_utils.h"
+
+#include "vm/vec.h"
+#include "vm/vec_io.h" // IWYU pragma: keep
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::mdl
+{
+namespace
+{
+
+std::vector<vm::vec3d> pickedHandles(
+  const VertexHandleManager& manager,
+  const vm::ray3d& pickRay,
+  const gl::Camera& camera,
+  const double handleRadius)
+{
+  auto pickResult = PickResult{};
+  manager.pick(pickRay, camera, handleRadius, pickResult);
+
+  auto result = std::vector<vm::vec3d>{};
+  for (const auto& hit : pickResult.all())
+  {
+    result.push_back(hit.target<vm::vec3d>());
+  }
+  return kdl::vec_sort(std::move(result));
+}
+
+std::vector<vm::vec3d> pickedHandlesByBruteForce(
+  const VertexHandleManager& manager,
+  const vm::ray3d& pickRay,
+  const gl::Camera& camera,
+  const double handleRadius)
+{
+  auto result = std::vector<vm::vec3d>{};
+  for (const auto& handle : manager.allHandles())
+  {
+    if (camera.pickPointHandle(pickRay, handle, handleRadius))
+    {
+      result.push_back(handle);
+    }
+  }
+  return kdl::vec_sort(std::move(result));
+}
+
+} // namespace
+
+TEST_CASE("VertexHandleManager")
+{
+  auto manager = VertexHandleManager{};
+
+  SECTION("add and remove")
+  {
+    manager.add({0, 0, 0});
+    manager.add({0, 0, 0});
+    manager.add({64, 0, 0});
+
+    CHECK(manager.totalHandleCount() == 2);
+    CHECK(manager.contains({0, 0, 0}));
+    CHECK(manager.contains({64, 0, 0}));
+
+    CHECK(manager.remove({0, 0, 0}));
+    CHECK(manager.contains({0, 0, 0}));
+
+    CHECK(manager.remove({0, 0, 0}));
+    CHECK_FALSE(manager.contains({0, 0, 0}));
+    CHECK_FALSE(manager.remove({0, 0, 0}));
+    CHECK(manager.totalHandleCount() == 1);
+
+    manager.clear();
+    CHECK(manager.totalHandleCount() == 0);
+    CHECK_FALSE(manager.contains({64, 0, 0}));
+  }
+
+  SECTION("select close handles")
+  {
+    manager.add({32, 32, 32});
+    manager.add({32, 32, 64});
+
+    manager.select(vm::vec3d{32, 32, 32.0000001});
+    CHECK(manager.selected({32, 32, 32}));
+    CHECK_FALSE(manager.selected({32, 32, 64}));
+    CHECK(manager.selectedHandleCount() == 1);
+
+    manager.select(vm::vec3d{32, 32, 32.1});
+    CHECK(manager.selectedHandleCount() == 1);
+
+    manager.deselect(vm::vec3d{32, 32, 31.9999999});
+    CHECK_FALSE(manager.selected({32, 32, 32}));
+    CHECK(manager.selectedHandleCount() == 0);
+
+    manager.select(vm::vec3d{32, 32, 64});
+    CHECK(manager.remove({32, 32, 64}));
+    CHECK(manager.selectedHandleCount() == 0);
+  }
+
+  SECTION("pick")
+  {
+    // far from the origin, the scaling factor is subject to larger rounding errors
+    for (const auto& offset : std::vector<vm::vec3d>{{0, 0, 0}, {16384, -16384, 8192}})
+    {
+      CAPTURE(offset);
+
+      manager.clear();
+      for (int x = -96; x <= 96; x += 16)
+      {
+        for (int y = -96; y <= 96; y += 16)
+        {
+          for (int z = -96; z <= 96; z += 16)
+          {
+            manager.add(offset + vm::vec3d{double(x), double(y), double(z)});
+          }
+        }
+      }
+
+      const auto viewport = gl::Camera::Viewport{0, 0, 800, 600};
+      const auto relativePosition = vm::vec3f{-300, -200, 150};
+      const auto position = vm::vec3f{offset} + relativePosition;
+      const auto direction = vm::normalize(-relativePosition);
+      const auto up =
+        vm::normalize(vm::cross(vm::cross(direction, vm::vec3f{0, 0, 1}), direction));
+
+      auto cameras = std::vector<std::unique_ptr<gl::Camera>>{};
+      cameras.push_back(std::make_unique<gl::PerspectiveCamera>(
+        90.0f, 1.0f, 8000.0f, viewport, position, direction, up));
+      cameras.push_back(std::make_unique<gl::OrthographicCamera>(
+        1.0f, 8000.0f, viewport, position, direction, up));
+
+      const auto handleRadius = 3.0;
+      for (const auto& camera : cameras)
+      {
+        CAPTURE(camera->projectionType());
+
+        for (const auto& relativeTarget : std::vector<vm::vec3d>{
+               {0, 0, 0},
+               {16, 16, 16},
+               {-96, 96, -96},
+               {96, -96, 96},
+               {2, 1, -1},
+               {-45, 3, 7},
+               {8, 8, 8},
+               {500, 500, 500},
+             })
+        {
+          const auto target = offset + relativeTarget;
+          CAPTURE(target);
+
+          const auto pickRay = vm::ray3d{camera->pickRay(vm::vec3f{target})};
+          const auto picked = pickedHandles(manager, pickRay, *camera, handleRadius);
+          CHECK(
+            picked == pickedHandlesByBruteForce(manager, pickRay, *camera, handleRadius));
+
+          if (manager.contains(target))
+          {
+            CHECK(std::ranges::find(picked, target) != picked.end());
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace tb::mdl
@@ -34,6 +34,7 @@
 #include "mdl/WorldNode.h"
 
 #include "kd/result.h"
+#include "kd/task_manager.h"
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
@@ -280,12 +281,25 @@ TEST_CASE("WorldNodeTest.rebuildNodeTree")
   REQUIRE(nodeTree.contains(brushNode));
   REQUIRE(nodeTree.contains(patchNode));
 
-  worldNode.rebuildNodeTree();
+  SECTION("sequentially")
+  {
+    worldNode.rebuildNodeTree();
+  }
+
+  SECTION("in parallel")
+  {
+    auto taskManager = kdl::task_manager{};
+    worldNode.rebuildNodeTree(taskManager);
+  }
+
   CHECK_FALSE(nodeTree.contains(layerNode));
   CHECK_FALSE(nodeTree.contains(groupNode));
   CHECK(nodeTree.contains(entityNode));
   CHECK(nodeTree.contains(brushNode));
   CHECK(nodeTree.contains(patchNode));
+  CHECK_THAT(
+    nodeTree.find_containers(vm::vec3d{0, 0, 0}),
+    UnorderedEquals(std::vector<Node*>{entityNode, brushNode, patchNode}));
 }
 
 TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
@@ -77,6 +77,7 @@ inline auto PortalFileBorderColor =
 inline auto PortalFileFillColor =
   Preference<Color>{"render/Colors/Portal file fill", RgbaF{1.0f, 0.4f, 0.4f, 0.2f}};
 inline auto ShowFPS = Preference<bool>{"render/Show FPS", false};
+inline auto ShowFrameProfile = Preference<bool>{"render/Show frame profile", false};
 
 Preference<Color>& axisColor(vm::axis::type axis);
 
@@ -204,9 +205,14 @@ inline auto GridColor2D =
 inline auto TextureMinFilter = Preference<int>{"render/Texture mode min filter", 0x2700};
 inline auto TextureMagFilter = Preference<int>{"render/Texture mode mag filter", 0x2600};
 inline auto EnableMSAA = Preference<bool>{"render/Enable multisampling", true};
+// in megabytes, 0 means unlimited
+inline auto TextureMemoryBudget = Preference<int>{"render/Texture memory budget", 0};
+inline auto CompressTextures = Preference<bool>{"render/Compress textures", false};
 
 inline auto AlignmentLock = Preference<bool>{"Editor/Texture lock", true};
 inline auto UVLock = Preference<bool>{"Editor/UV lock", false};
+// in megabytes, 0 means unlimited
+inline auto UndoMemoryBudget = Preference<int>{"Editor/Undo memory budget", 0};
 
 inline auto RendererFontPath = Preference<std::filesystem::path>{
   "render/Font name", "fonts/SourceSansPro-Regular.otf"};
@@ -306,6 +312,10 @@ inline constexpr auto EntityLinkModeNone = "none";
 inline auto EntityLinkMode =
   Preference<std::string>{"Map view/Entity link mode", EntityLinkModeDirect};
 
+// the maximum number of compilation tasks to run concurrently, 0 means the number of
+// hardware threads
+inline auto CompilationJobLimit = Preference<int>{"Compilation/Job limit", 0};
+
 std::vector<Preference<Color>*> colorPreferences();
 
 std::vector<Preference<QKeySequence>*> keyPreferences();
@@ -23,6 +23,7 @@
 #include "Macros.h"
 #include "mdl/BrushGeometry.h"
 #include "render/AllocationTracker.h"
+#include "render/BrushVertexStore.h"
 #include "render/EdgeRenderer.h"
 #include "render/FaceRenderer.h"
 
@@ -150,7 +151,11 @@ private:
   std::unordered_set<const mdl::BrushNode*> m_allBrushes;
   std::unordered_set<const mdl::BrushNode*> m_invalidBrushes;
 
-  std::shared_ptr<BrushVertexArray> m_vertexArray;
+  /**
+   * Holds the brush vertices. The store can be shared with other brush renderers so that
+   * moving a brush between them does not upload its vertices again.
+   */
+  std::shared_ptr<BrushVertexStore> m_vertexStore;
   std::shared_ptr<BrushIndexArray> m_edgeIndices;
 
   using MaterialToBrushIndicesMap =
@@ -177,16 +182,20 @@ private:
 
 public:
   template <typename FilterT>
-  explicit BrushRenderer(FilterT filter)
+  explicit BrushRenderer(
+    FilterT filter,
+    std::shared_ptr<BrushVertexStore> vertexStore = std::make_shared<BrushVertexStore>())
     : m_filter{std::make_unique<FilterT>(std::move(filter))}
+    , m_vertexStore{std::move(vertexStore)}
   {
     clear();
   }
 
   BrushRenderer();
+  ~BrushRenderer();
 
   /**
-   * Remove all brushes.
+   * Remove all brushes and release their vertices.
    */
   void clear();
 
@@ -297,6 +306,7 @@ private:
   bool shouldDrawFaceInTransparentPass(
     const mdl::BrushNode& brushNode, const mdl::BrushFace& face) const;
   void validateBrush(const mdl::BrushNode& brushNode);
+  void freeUnusedVertices();
 
 public:
   /**
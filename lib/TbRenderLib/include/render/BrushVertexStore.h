@@ -0,0 +1,139 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+#include "render/AllocationTracker.h"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace tb
+{
+namespace mdl
+{
+class BrushNode;
+}
+
+namespace render
+{
+class BrushVertexArray;
+
+/**
+ * Stores the vertices of brushes in a single vertex array that can be shared by several
+ * brush renderers.
+ *
+ * A brush's vertices are uploaded once and reference counted by the renderers that draw
+ * the brush. Moving a brush from one renderer to another, e.g. when it is selected or
+ * locked, therefore only rewrites the index arrays of these renderers. The vertices are
+ * uploaded again only when the brush's vertex cache changes.
+ *
+ * Such a move releases the brush in one renderer before the other renderer acquires it.
+ * Blocks that are no longer used are therefore kept until freeUnusedBlocks() is called,
+ * which the owner of the store does once all renderers have been validated.
+ */
+class BrushVertexStore
+{
+private:
+  struct BrushEntry
+  {
+    AllocationTracker::Block* block;
+    std::size_t vertexCacheVersion;
+  };
+
+  struct BlockEntry
+  {
+    const mdl::BrushNode* brushNode;
+    std::size_t refCount;
+  };
+
+  std::shared_ptr<BrushVertexArray> m_vertexArray;
+
+  /**
+   * Maps each brush to the block holding its current vertices.
+   */
+  std::unordered_map<const mdl::BrushNode*, BrushEntry> m_brushes;
+
+  /**
+   * Maps every allocated block to the brush it was uploaded for and the number of
+   * renderers using it. A block whose brush has changed remains allocated until the last
+   * renderer releases it.
+   */
+  std::unordered_map<AllocationTracker::Block*, BlockEntry> m_blocks;
+
+  /**
+   * Blocks whose reference count dropped to zero. A block may have been acquired again
+   * since, or it may be listed more than once.
+   */
+  std::vector<AllocationTracker::Block*> m_unusedBlocks;
+
+  std::size_t m_uploadedVertexCount = 0;
+
+public:
+  BrushVertexStore();
+  ~BrushVertexStore();
+
+  const std::shared_ptr<BrushVertexArray>& vertexArray() const;
+
+  /**
+   * Returns the block holding the current vertices of the given brush, uploading them if
+   * necessary. Every call must be balanced by a call to release().
+   */
+  AllocationTracker::Block* acquire(const mdl::BrushNode& brushNode);
+
+  /**
+   * Releases a block returned by acquire(). A block that is no longer used is freed by
+   * the next call to freeUnusedBlocks() unless it is acquired again before that. A block
+   * holding outdated vertices is freed immediately.
+   */
+  void release(AllocationTracker::Block* block);
+
+  /**
+   * Frees all blocks that are no longer used.
+   */
+  void freeUnusedBlocks();
+
+  /**
+   * Returns the block holding the current vertices of the given brush, or nullptr if the
+   * brush's vertices were not uploaded yet.
+   */
+  const AllocationTracker::Block* findBlock(const mdl::BrushNode& brushNode) const;
+
+  /**
+   * Returns the number of blocks that are currently allocated, including the unused
+   * blocks that were not freed yet.
+   */
+  std::size_t blockCount() const;
+
+  /**
+   * Returns the total number of vertices that were uploaded by this store.
+   */
+  std::size_t uploadedVertexCount() const;
+
+private:
+  void freeBlock(AllocationTracker::Block* block);
+
+  deleteCopyAndMove(BrushVertexStore);
+};
+
+} // namespace render
+} // namespace tb
@@ -44,6 +44,7 @@ struct SelectionChange;
 
 namespace render
 {
+class BrushVertexStore;
 class EntityDecalRenderer;
 class EntityLinkRenderer;
 class GroupLinkRenderer;
@@ -56,6 +57,8 @@ class MapRenderer
 private:
   mdl::Map& m_map;
 
+  // shared by the brush renderers of the default, selection and locked renderers
+  std::shared_ptr<BrushVertexStore> m_brushVertexStore;
   std::unique_ptr<ObjectRenderer> m_defaultRenderer;
   std::unique_ptr<ObjectRenderer> m_selectionRenderer;
   std::unique_ptr<ObjectRenderer> m_lockedRenderer;
@@ -26,6 +26,7 @@
 #include "render/GroupRenderer.h"
 #include "render/PatchRenderer.h"
 
+#include <memory>
 #include <vector>
 
 namespace tb
@@ -68,10 +69,11 @@ public:
     Logger& logger,
     mdl::EntityModelManager& entityModelManager,
     const mdl::EditorContext& editorContext,
-    const BrushFilterT& brushFilter)
+    const BrushFilterT& brushFilter,
+    std::shared_ptr<BrushVertexStore> brushVertexStore)
     : m_groupRenderer{editorContext}
     , m_entityRenderer{logger, entityModelManager, editorContext}
-    , m_brushRenderer{brushFilter}
+    , m_brushRenderer{brushFilter, std::move(brushVertexStore)}
     , m_patchRenderer{editorContext}
   {
   }
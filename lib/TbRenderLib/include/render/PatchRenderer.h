@@ -26,12 +26,16 @@
 
 #include "kd/vector_set.h"
 
+#include <unordered_map>
+
 namespace tb
 {
 namespace gl
 {
+class Camera;
 class Gl;
-}
+class Material;
+} // namespace gl
 
 namespace mdl
 {
@@ -49,10 +53,37 @@ class PatchRenderer : public IndexedRenderable
 private:
   const mdl::EditorContext& m_editorContext;
 
+  struct PatchState
+  {
+    // the material of the batch that contains the patch
+    const gl::Material* material = nullptr;
+    // the stride with which the grid of the patch is sampled
+    size_t lodStride = 1;
+  };
+
+  /**
+   * The patches are batched by material so that changing the level of detail of a patch
+   * only rebuilds the mesh of its batch.
+   *
+   * The level of detail is determined by the 3D view. Orthographic views render a
+   * separate mesh that samples every point of the grids. It is only built once such a
+   * view renders faces.
+   */
+  struct MaterialBatch
+  {
+    kdl::vector_set<const mdl::PatchNode*> patchNodes;
+    gl::MaterialIndexArrayRenderer meshRenderer;
+    gl::MaterialIndexArrayRenderer fullDetailMeshRenderer;
+    bool valid = false;
+    bool fullDetailValid = false;
+  };
+
+  // false if the patches must be batched again, e.g. because their visibility changed
   bool m_valid = true;
-  kdl::vector_set<const mdl::PatchNode*> m_patchNodes;
+  bool m_edgesValid = true;
+  std::unordered_map<const mdl::PatchNode*, PatchState> m_patches;
+  std::unordered_map<const gl::Material*, MaterialBatch> m_materialBatches;
 
-  gl::MaterialIndexArrayRenderer m_patchMeshRenderer;
   DirectEdgeRenderer m_edgeRenderer;
 
   Color m_defaultColor;
@@ -122,7 +153,14 @@ public:
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
 
 private:
-  void validate();
+  /**
+   * Determines with which stride the grid of each patch is sampled when building the
+   * mesh, depending on its distance to the given camera. Invalidates the batches of the
+   * patches whose stride has changed.
+   */
+  void updateLevelsOfDetail(const gl::Camera& camera);
+  void invalidateBatch(const gl::Material* material);
+  void validate(bool fullDetail);
 
 private: // implement IndexedRenderable interface
   void prepare(gl::Gl& gl, gl::VboManager& vboManager) override;
@@ -19,6 +19,7 @@
 
 #include "render/BrushRenderer.h"
 
+#include "FrameProfiler.h"
 #include "gl/Material.h"
 #include "mdl/Brush.h"
 #include "mdl/BrushFace.h"
@@ -32,7 +33,6 @@
 
 #include "kd/contracts.h"
 
-#include <cstring>
 #include <vector>
 
 namespace tb::render
@@ -169,10 +169,19 @@ BrushRenderer::Filter::RenderSettings BrushRenderer::NoFilter::markFaces(
 
 BrushRenderer::BrushRenderer()
   : m_filter{std::make_unique<NoFilter>()}
+  , m_vertexStore{std::make_shared<BrushVertexStore>()}
 {
   clear();
 }
 
+BrushRenderer::~BrushRenderer()
+{
+  for (const auto& [brushNode, info] : m_brushInfo)
+  {
+    m_vertexStore->release(info.vertexHolderKey);
+  }
+}
+
 void BrushRenderer::invalidate()
 {
   for (auto* brushNode : m_allBrushes)
@@ -228,19 +237,24 @@ bool BrushRenderer::valid() const
 
 void BrushRenderer::clear()
 {
+  for (const auto& [brushNode, info] : m_brushInfo)
+  {
+    m_vertexStore->release(info.vertexHolderKey);
+  }
+  freeUnusedVertices();
+
   m_brushInfo.clear();
   m_allBrushes.clear();
   m_invalidBrushes.clear();
 
-  m_vertexArray = std::make_shared<BrushVertexArray>();
   m_edgeIndices = std::make_shared<BrushIndexArray>();
   m_transparentFaces = std::make_shared<MaterialToBrushIndicesMap>();
   m_opaqueFaces = std::make_shared<MaterialToBrushIndicesMap>();
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  const auto& vertexArray = m_vertexStore->vertexArray();
+  m_opaqueFaceRenderer = FaceRenderer{vertexArray, m_opaqueFaces, m_faceColor};
+  m_transparentFaceRenderer = FaceRenderer{vertexArray, m_transparentFaces, m_faceColor};
+  m_edgeRenderer = IndexedEdgeRenderer{vertexArray, m_edgeIndices};
 }
 
 void BrushRenderer::setFaceColor(const Color& faceColor)
@@ -381,18 +395,33 @@ void BrushRenderer::validate()
 {
   contract_pre(!valid());
 
+  const auto profileScope = ProfileScope{"Validate brushes"};
+  FrameProfiler::instance().count(
+    FrameCounter::BrushesValidated, m_invalidBrushes.size());
+
   for (auto* brushNode : m_invalidBrushes)
   {
     validateBrush(*brushNode);
   }
   m_invalidBrushes.clear();
+  freeUnusedVertices();
 
   contract_assert(valid());
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  const auto& vertexArray = m_vertexStore->vertexArray();
+  m_opaqueFaceRenderer = FaceRenderer{vertexArray, m_opaqueFaces, m_faceColor};
+  m_transparentFaceRenderer = FaceRenderer{vertexArray, m_transparentFaces, m_faceColor};
+  m_edgeRenderer = IndexedEdgeRenderer{vertexArray, m_edgeIndices};
+}
+
+void BrushRenderer::freeUnusedVertices()
+{
+  // A shared store is cleaned up by its owner because another renderer may still take
+  // back the blocks that this renderer has released.
+  if (m_vertexStore.use_count() == 1)
+  {
+    m_vertexStore->freeUnusedBlocks();
+  }
 }
 
 static size_t triIndicesCountForPolygon(const size_t vertexCount)
@@ -532,18 +561,12 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
 
   BrushInfo& info = m_brushInfo[&brushNode];
 
-  // collect vertices
-  auto& brushCache = brushNode.brushRendererBrushCache();
-  brushCache.validateVertexCache(brushNode);
-  const auto& cachedVertices = brushCache.cachedVertices();
-  contract_assert(!cachedVertices.empty());
-
-  contract_assert(m_vertexArray != nullptr);
-  auto [vertBlock, dest] =
-    m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
-  std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
+  // collect vertices, they are only uploaded if the vertex store doesn't have them yet
+  auto* vertBlock = m_vertexStore->acquire(brushNode);
   info.vertexHolderKey = vertBlock;
 
+  const auto& brushCache = brushNode.brushRendererBrushCache();
+
   const auto brushVerticesStartIndex = static_cast<GLuint>(vertBlock->pos);
 
   // insert edge indices into VBO
@@ -718,7 +741,7 @@ void BrushRenderer::removeBrushFromVbo(const mdl::BrushNode& brushNode)
   const auto& info = it->second;
 
   // update Vbo's
-  m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
+  m_vertexStore->release(info.vertexHolderKey);
   if (info.edgeIndicesKey != nullptr)
   {
     m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
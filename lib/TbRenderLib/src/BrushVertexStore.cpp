@@ -0,0 +1,145 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "render/BrushVertexStore.h"
+
+#include "mdl/BrushNode.h"
+#include "mdl/BrushRendererBrushCache.h"
+#include "render/BrushRendererArrays.h"
+
+#include "kd/contracts.h"
+
+#include <cstring>
+
+namespace tb::render
+{
+
+BrushVertexStore::BrushVertexStore()
+  : m_vertexArray{std::make_shared<BrushVertexArray>()}
+{
+}
+
+BrushVertexStore::~BrushVertexStore() = default;
+
+const std::shared_ptr<BrushVertexArray>& BrushVertexStore::vertexArray() const
+{
+  return m_vertexArray;
+}
+
+AllocationTracker::Block* BrushVertexStore::acquire(const mdl::BrushNode& brushNode)
+{
+  auto& brushCache = brushNode.brushRendererBrushCache();
+  brushCache.validateVertexCache(brushNode);
+
+  const auto vertexCacheVersion = brushCache.vertexCacheVersion();
+  if (const auto it = m_brushes.find(&brushNode); it != m_brushes.end())
+  {
+    auto* block = it->second.block;
+    if (it->second.vertexCacheVersion == vertexCacheVersion)
+    {
+      // this may take back a block that is no longer used, but was not freed yet
+      ++m_blocks.at(block).refCount;
+      return block;
+    }
+
+    // The brush has changed. The old block is freed once the renderers that still use it
+    // have released it.
+    m_brushes.erase(it);
+    if (m_blocks.at(block).refCount == 0)
+    {
+      freeBlock(block);
+    }
+  }
+
+  const auto& cachedVertices = brushCache.cachedVertices();
+  contract_assert(!cachedVertices.empty());
+
+  auto [block, dest] = m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
+  std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
+  m_uploadedVertexCount += cachedVertices.size();
+
+  m_brushes.emplace(&brushNode, BrushEntry{block, vertexCacheVersion});
+  m_blocks.emplace(block, BlockEntry{&brushNode, 1});
+  return block;
+}
+
+void BrushVertexStore::release(AllocationTracker::Block* block)
+{
+  const auto it = m_blocks.find(block);
+  contract_pre(it != m_blocks.end());
+
+  auto& [brushNode, refCount] = it->second;
+  contract_pre(refCount > 0);
+
+  if (--refCount > 0)
+  {
+    return;
+  }
+
+  if (const auto brushIt = m_brushes.find(brushNode);
+      brushIt != m_brushes.end() && brushIt->second.block == block)
+  {
+    // keep the block so that another renderer can take it back
+    m_unusedBlocks.push_back(block);
+  }
+  else
+  {
+    freeBlock(block);
+  }
+}
+
+void BrushVertexStore::freeUnusedBlocks()
+{
+  for (auto* block : m_unusedBlocks)
+  {
+    // an unused block always holds the current vertices of its brush
+    if (const auto it = m_blocks.find(block);
+        it != m_blocks.end() && it->second.refCount == 0)
+    {
+      m_brushes.erase(it->second.brushNode);
+      freeBlock(block);
+    }
+  }
+  m_unusedBlocks.clear();
+}
+
+const AllocationTracker::Block* BrushVertexStore::findBlock(
+  const mdl::BrushNode& brushNode) const
+{
+  const auto it = m_brushes.find(&brushNode);
+  return it != m_brushes.end() ? it->second.block : nullptr;
+}
+
+std::size_t BrushVertexStore::blockCount() const
+{
+  return m_blocks.size();
+}
+
+std::size_t BrushVertexStore::uploadedVertexCount() const
+{
+  return m_uploadedVertexCount;
+}
+
+void BrushVertexStore::freeBlock(AllocationTracker::Block* block)
+{
+  m_vertexArray->deleteVerticesWithKey(block);
+  m_blocks.erase(block);
+}
+
+} // namespace tb::render
@@ -19,6 +19,7 @@
 
 #include "render/MapRenderer.h"
 
+#include "FrameProfiler.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "gl/MaterialManager.h"
@@ -39,6 +40,7 @@
 #include "mdl/SelectionChange.h"
 #include "mdl/WorldNode.h"
 #include "render/BrushRenderer.h"
+#include "render/BrushVertexStore.h"
 #include "render/EntityDecalRenderer.h"
 #include "render/EntityLinkRenderer.h"
 #include "render/GroupLinkRenderer.h"
@@ -159,31 +161,37 @@ public:
   }
 };
 
-std::unique_ptr<ObjectRenderer> createDefaultRenderer(mdl::Map& map)
+std::unique_ptr<ObjectRenderer> createDefaultRenderer(
+  mdl::Map& map, std::shared_ptr<BrushVertexStore> brushVertexStore)
 {
   return std::make_unique<ObjectRenderer>(
     map.logger(),
     map.entityModelManager(),
     map.editorContext(),
-    UnselectedBrushRendererFilter{map.editorContext()});
+    UnselectedBrushRendererFilter{map.editorContext()},
+    std::move(brushVertexStore));
 }
 
-std::unique_ptr<ObjectRenderer> createSelectionRenderer(mdl::Map& map)
+std::unique_ptr<ObjectRenderer> createSelectionRenderer(
+  mdl::Map& map, std::shared_ptr<BrushVertexStore> brushVertexStore)
 {
   return std::make_unique<ObjectRenderer>(
     map.logger(),
     map.entityModelManager(),
     map.editorContext(),
-    SelectedBrushRendererFilter{map.editorContext()});
+    SelectedBrushRendererFilter{map.editorContext()},
+    std::move(brushVertexStore));
 }
 
-std::unique_ptr<ObjectRenderer> createLockRenderer(mdl::Map& map)
+std::unique_ptr<ObjectRenderer> createLockRenderer(
+  mdl::Map& map, std::shared_ptr<BrushVertexStore> brushVertexStore)
 {
   return std::make_unique<ObjectRenderer>(
     map.logger(),
     map.entityModelManager(),
     map.editorContext(),
-    LockedBrushRendererFilter{map.editorContext()});
+    LockedBrushRendererFilter{map.editorContext()},
+    std::move(brushVertexStore));
 }
 
 std::unique_ptr<EntityDecalRenderer> createEntityDecalRenderer(mdl::Map& map)
@@ -195,9 +203,10 @@ std::unique_ptr<EntityDecalRenderer> createEntityDecalRenderer(mdl::Map& map)
 
 MapRenderer::MapRenderer(mdl::Map& map)
   : m_map{map}
-  , m_defaultRenderer{createDefaultRenderer(m_map)}
-  , m_selectionRenderer{createSelectionRenderer(m_map)}
-  , m_lockedRenderer{createLockRenderer(m_map)}
+  , m_brushVertexStore{std::make_shared<BrushVertexStore>()}
+  , m_defaultRenderer{createDefaultRenderer(m_map, m_brushVertexStore)}
+  , m_selectionRenderer{createSelectionRenderer(m_map, m_brushVertexStore)}
+  , m_lockedRenderer{createLockRenderer(m_map, m_brushVertexStore)}
   , m_entityDecalRenderer{createEntityDecalRenderer(m_map)}
   , m_entityLinkRenderer{std::make_unique<EntityLinkRenderer>(m_map)}
   , m_groupLinkRenderer{std::make_unique<GroupLinkRenderer>(m_map)}
@@ -231,6 +240,8 @@ void MapRenderer::restoreSelectionColors()
 
 void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
+  const auto profileScope = ProfileScope{"Collect map renderables"};
+
   setupGL(renderBatch);
   renderEntityDecals(renderContext, renderBatch);
   renderEntityLinks(renderContext, renderBatch);
@@ -243,6 +254,10 @@ void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
   renderDefaultTransparent(renderContext, renderBatch);
   renderLockedTransparent(renderContext, renderBatch);
   renderSelectionTransparent(renderContext, renderBatch);
+
+  // all brush renderers are valid now, so none of them will take back the vertices of
+  // a brush that was moved between them
+  m_brushVertexStore->freeUnusedBlocks();
 }
 
 class SetupGL : public Renderable
@@ -652,7 +667,7 @@ void MapRenderer::connectObservers()
   m_notifierConnection +=
     m_map.nodesWereRemovedNotifier.connect(this, &MapRenderer::nodesWereRemoved);
   m_notifierConnection +=
-    m_map.nodesDidChangeNotifier.connect(this, &MapRenderer::nodesDidChange);
+    m_map.batchedNodesDidChangeNotifier.connect(this, &MapRenderer::nodesDidChange);
   m_notifierConnection += m_map.nodeVisibilityDidChangeNotifier.connect(
     this, &MapRenderer::nodeVisibilityDidChange);
   m_notifierConnection +=
@@ -682,6 +697,8 @@ void MapRenderer::connectObservers()
 
 void MapRenderer::nodesWereAdded(const std::vector<mdl::Node*>& nodes)
 {
+  const auto profileScope = ProfileScope{"Update map renderers"};
+
   for (auto* node : nodes)
   {
     // The nodes passed in don't include recursive children, so we need to visit them
@@ -694,6 +711,8 @@ void MapRenderer::nodesWereAdded(const std::vector<mdl::Node*>& nodes)
 
 void MapRenderer::nodesWereRemoved(const std::vector<mdl::Node*>& nodes)
 {
+  const auto profileScope = ProfileScope{"Update map renderers"};
+
   for (auto* node : nodes)
   {
     // The nodes passed in don't include recursive children, so we need to visit them
@@ -706,6 +725,8 @@ void MapRenderer::nodesWereRemoved(const std::vector<mdl::Node*>& nodes)
 
 void MapRenderer::nodesDidChange(const std::vector<mdl::Node*>& nodes)
 {
+  const auto profileScope = ProfileScope{"Update map renderers"};
+
   for (auto* node : mdl::collectNodesAndAncestors(nodes))
   {
     // We update the ancestors along with the nodes, i.e. the world node. So, don't update
@@ -749,6 +770,8 @@ void MapRenderer::groupWasClosed()
 
 void MapRenderer::selectionDidChange(const mdl::SelectionChange& selectionChange)
 {
+  const auto profileScope = ProfileScope{"Update map renderers"};
+
   for (const auto& face : selectionChange.deselectedBrushFaces)
   {
     updateAndInvalidateNode(*face.node());
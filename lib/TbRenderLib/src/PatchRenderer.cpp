@@ -38,15 +38,34 @@
 #include "render/RenderContext.h"
 
 #include "kd/contracts.h"
-#include "kd/ranges/to.h"
-#include "kd/vector_utils.h"
 
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <cmath>
 #include <ranges>
 
 namespace tb::render
 {
+namespace
+{
+
+// The maximum distance between a patch and its rendered mesh, in pixels.
+constexpr auto MaxLodPixelError = 0.5f;
+
+size_t lodStride(const mdl::PatchNode& patchNode, const gl::Camera& camera)
+{
+  const auto& grid = patchNode.grid();
+
+  // the point of the patch bounds closest to the camera
+  const auto closestPoint = vm::vec3f{vm::max(
+    grid.bounds.min, vm::min(grid.bounds.max, vm::vec3d{camera.position()}))};
+  const auto unitsPerPixel = std::abs(camera.perspectiveScalingFactor(closestPoint));
+
+  return grid.lodStride(double(MaxLodPixelError * unitsPerPixel));
+}
+
+} // namespace
 
 PatchRenderer::PatchRenderer(const mdl::EditorContext& editorContext)
   : m_editorContext{editorContext}
@@ -105,39 +124,70 @@ void PatchRenderer::invalidate()
 
 void PatchRenderer::clear()
 {
-  m_patchNodes.clear();
+  m_patches.clear();
+  m_materialBatches.clear();
   invalidate();
 }
 
 void PatchRenderer::addPatch(const mdl::PatchNode* patchNode)
 {
-  if (m_patchNodes.insert(patchNode).second)
+  const auto* material = patchNode->patch().material();
+  if (m_patches.emplace(patchNode, PatchState{material}).second)
   {
-    invalidate();
+    m_materialBatches[material].patchNodes.insert(patchNode);
+    invalidateBatch(material);
+    m_edgesValid = false;
   }
 }
 
 void PatchRenderer::removePatch(const mdl::PatchNode* patchNode)
 {
-  if (auto it = m_patchNodes.find(patchNode); it != std::end(m_patchNodes))
+  if (auto it = m_patches.find(patchNode); it != std::end(m_patches))
   {
-    m_patchNodes.erase(it);
-    invalidate();
+    const auto* material = it->second.material;
+    m_materialBatches[material].patchNodes.erase(patchNode);
+    invalidateBatch(material);
+    m_edgesValid = false;
+
+    m_patches.erase(it);
   }
 }
 
-void PatchRenderer::invalidatePatch(const mdl::PatchNode*)
+void PatchRenderer::invalidatePatch(const mdl::PatchNode* patchNode)
 {
-  invalidate();
+  if (auto it = m_patches.find(patchNode); it != std::end(m_patches))
+  {
+    auto& patchState = it->second;
+
+    // move the patch to another batch if its material has changed
+    const auto* material = patchNode->patch().material();
+    if (material != patchState.material)
+    {
+      m_materialBatches[patchState.material].patchNodes.erase(patchNode);
+      invalidateBatch(patchState.material);
+
+      m_materialBatches[material].patchNodes.insert(patchNode);
+      patchState.material = material;
+    }
+
+    invalidateBatch(material);
+    m_edgesValid = false;
+  }
 }
 
 void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch)
 {
-  if (!m_valid)
+  // This renderer is shared by all views, so only the 3D view determines the level of
+  // detail. Otherwise, the views would rebuild the mesh for each other on every frame.
+  // Orthographic views render faces with full detail instead.
+  const auto fullDetail = renderContext.camera().orthographicProjection();
+  if (!fullDetail)
   {
-    validate();
+    updateLevelsOfDetail(renderContext.camera());
   }
 
+  validate(fullDetail && renderContext.showFaces());
+
   if (renderContext.showFaces())
   {
     renderBatch.add(this);
@@ -153,22 +203,56 @@ void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
   }
 }
 
+void PatchRenderer::updateLevelsOfDetail(const gl::Camera& camera)
+{
+  for (auto& [patchNode, patchState] : m_patches)
+  {
+    if (const auto stride = lodStride(*patchNode, camera); stride != patchState.lodStride)
+    {
+      patchState.lodStride = stride;
+
+      // the full detail mesh does not depend on the stride
+      m_materialBatches[patchState.material].valid = false;
+    }
+  }
+}
+
+void PatchRenderer::invalidateBatch(const gl::Material* material)
+{
+  auto& materialBatch = m_materialBatches[material];
+  materialBatch.valid = false;
+  materialBatch.fullDetailValid = false;
+}
+
+template <typename L>
 static gl::MaterialIndexArrayRenderer buildMeshRenderer(
   const std::vector<const mdl::PatchNode*>& patchNodes,
+  const L& getLodStride,
   const mdl::EditorContext& editorContext)
 {
+  // the stride is outdated if the patch has changed since it was determined
+  const auto lodStride = [&](const size_t i) {
+    const auto& grid = patchNodes[i]->grid();
+    const auto maxStride = size_t(1) << grid.subdivisionsPerSurface;
+    return std::min(getLodStride(patchNodes[i]), maxStride);
+  };
+
   size_t vertexCount = 0u;
   auto indexArrayMapSize = gl::MaterialIndexArrayMap::Size{};
 
-  for (const auto* patchNode : patchNodes)
+  for (size_t i = 0u; i < patchNodes.size(); ++i)
   {
+    const auto* patchNode = patchNodes[i];
     if (editorContext.visible(*patchNode))
     {
-      vertexCount += patchNode->grid().pointRowCount * patchNode->grid().pointColumnCount;
+      const auto& grid = patchNode->grid();
+      const auto stride = lodStride(i);
+      const auto quadRowCount = grid.quadRowCount() / stride;
+      const auto quadColumnCount = grid.quadColumnCount() / stride;
+      vertexCount += (quadRowCount + 1u) * (quadColumnCount + 1u);
 
       const auto* material = patchNode->patch().material();
-      const auto quadCount =
-        patchNode->grid().quadRowCount() * patchNode->grid().quadColumnCount();
+      const auto quadCount = quadRowCount * quadColumnCount;
       indexArrayMapSize.inc(material, gl::PrimType::Triangles, 6u * quadCount);
     }
   }
@@ -180,27 +264,34 @@ static gl::MaterialIndexArrayRenderer buildMeshRenderer(
   auto indexArrayMapBuilder = gl::MaterialIndexArrayMapBuilder{indexArrayMapSize};
   using Index = gl::MaterialIndexArrayMapBuilder::Index;
 
-  for (const auto* patchNode : patchNodes)
+  for (size_t i = 0u; i < patchNodes.size(); ++i)
   {
+    const auto* patchNode = patchNodes[i];
     if (editorContext.visible(*patchNode))
     {
       const auto vertexOffset = vertices.size();
 
+      // sample every stride-th point of the grid
       const auto& grid = patchNode->grid();
-      auto gridVertices =
-        grid.points | std::views::transform([](const auto& p) {
-          return Vertex{
-            vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.uvCoords}};
-        })
-        | kdl::ranges::to<std::vector>();
-      vertices = kdl::vec_concat(std::move(vertices), std::move(gridVertices));
+      const auto stride = lodStride(i);
+      const auto quadRowCount = grid.quadRowCount() / stride;
+      const auto quadColumnCount = grid.quadColumnCount() / stride;
+      for (size_t row = 0u; row <= quadRowCount; ++row)
+      {
+        for (size_t col = 0u; col <= quadColumnCount; ++col)
+        {
+          const auto& p = grid.point(row * stride, col * stride);
+          vertices.emplace_back(
+            vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.uvCoords});
+        }
+      }
 
       const auto* material = patchNode->patch().material();
 
-      const auto pointsPerRow = grid.pointColumnCount;
-      for (size_t row = 0u; row < grid.quadRowCount(); ++row)
+      const auto pointsPerRow = quadColumnCount + 1u;
+      for (size_t row = 0u; row < quadRowCount; ++row)
       {
-        for (size_t col = 0u; col < grid.quadColumnCount(); ++col)
+        for (size_t col = 0u; col < quadColumnCount; ++col)
         {
           const auto i0 = vertexOffset + row * pointsPerRow + col;
           const auto i1 = vertexOffset + row * pointsPerRow + col + 1u;
@@ -230,9 +321,9 @@ static gl::MaterialIndexArrayRenderer buildMeshRenderer(
     std::move(indexArrayMapBuilder.ranges())};
 }
 
+template <typename P>
 static DirectEdgeRenderer buildEdgeRenderer(
-  const std::vector<const mdl::PatchNode*>& patchNodes,
-  const mdl::EditorContext& editorContext)
+  const P& patchNodes, const mdl::EditorContext& editorContext)
 {
   size_t vertexCount = 0u;
   auto indexRangeMapSize = gl::IndexRangeMap::Size{};
@@ -303,20 +394,64 @@ static DirectEdgeRenderer buildEdgeRenderer(
   return DirectEdgeRenderer{std::move(vertexArray), std::move(indexRangeMap)};
 }
 
-void PatchRenderer::validate()
+void PatchRenderer::validate(const bool fullDetail)
 {
   if (!m_valid)
   {
-    m_patchMeshRenderer = buildMeshRenderer(m_patchNodes.get_data(), m_editorContext);
-    m_edgeRenderer = buildEdgeRenderer(m_patchNodes.get_data(), m_editorContext);
+    // batch all patches again since their materials may have changed
+    m_materialBatches.clear();
+    for (auto& [patchNode, patchState] : m_patches)
+    {
+      patchState.material = patchNode->patch().material();
+      m_materialBatches[patchState.material].patchNodes.insert(patchNode);
+    }
 
+    m_edgesValid = false;
     m_valid = true;
   }
+
+  std::erase_if(m_materialBatches, [](const auto& entry) {
+    return entry.second.patchNodes.empty();
+  });
+
+  const auto getLodStride = [&](const auto* patchNode) {
+    return m_patches.at(patchNode).lodStride;
+  };
+  const auto getFullDetailStride = [](const auto*) { return size_t(1); };
+
+  for (auto& [material, materialBatch] : m_materialBatches)
+  {
+    if (fullDetail)
+    {
+      if (!materialBatch.fullDetailValid)
+      {
+        materialBatch.fullDetailMeshRenderer = buildMeshRenderer(
+          materialBatch.patchNodes.get_data(), getFullDetailStride, m_editorContext);
+        materialBatch.fullDetailValid = true;
+      }
+    }
+    else if (!materialBatch.valid)
+    {
+      materialBatch.meshRenderer = buildMeshRenderer(
+        materialBatch.patchNodes.get_data(), getLodStride, m_editorContext);
+      materialBatch.valid = true;
+    }
+  }
+
+  if (!m_edgesValid)
+  {
+    m_edgeRenderer = buildEdgeRenderer(m_patches | std::views::keys, m_editorContext);
+    m_edgesValid = true;
+  }
 }
 
 void PatchRenderer::prepare(gl::Gl& gl, gl::VboManager& vboManager)
 {
-  m_patchMeshRenderer.prepare(gl, vboManager);
+  for (auto& [material, materialBatch] : m_materialBatches)
+  {
+    materialBatch.meshRenderer.prepare(gl, vboManager);
+    materialBatch.fullDetailMeshRenderer.prepare(gl, vboManager);
+  }
 }
 
 namespace
@@ -420,7 +555,13 @@ void PatchRenderer::render(RenderContext& context)
   }
   */
 
-  m_patchMeshRenderer.render(gl, shader.program(), func);
+  const auto fullDetail = context.camera().orthographicProjection();
+  for (auto& [material, materialBatch] : m_materialBatches)
+  {
+    auto& meshRenderer =
+      fullDetail ? materialBatch.fullDetailMeshRenderer : materialBatch.meshRenderer;
+    meshRenderer.render(gl, shader.program(), func);
+  }
 
   /*
   if (m_alpha < 1.0f) {
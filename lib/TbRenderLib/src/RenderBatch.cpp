@@ -19,6 +19,7 @@
 
 #include "render/RenderBatch.h"
 
+#include "FrameProfiler.h"
 #include "gl/VboManager.h"
 #include "render/RenderContext.h"
 #include "render/Renderable.h"
@@ -118,6 +119,8 @@ void RenderBatch::doAdd(Renderable* renderable)
 
 void RenderBatch::prepareRenderables(gl::Gl& gl)
 {
+  const auto profileScope = ProfileScope{"Prepare renderables"};
+
   for (auto* renderable : m_directRenderables)
   {
     renderable->prepare(gl, m_vboManager);
@@ -130,6 +133,8 @@ void RenderBatch::prepareRenderables(gl::Gl& gl)
 
 void RenderBatch::renderRenderables(RenderContext& renderContext)
 {
+  const auto profileScope = ProfileScope{"Render renderables"};
+
   for (auto* renderable : m_batch)
   {
     renderable->render(renderContext);
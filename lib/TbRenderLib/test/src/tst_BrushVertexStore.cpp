@@ -0,0 +1,181 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/MapFormat.h"
+#include "render/BrushRenderer.h"
+#include "render/BrushVertexStore.h"
+
+#include <memory>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace tb::render
+{
+
+TEST_CASE("BrushVertexStore")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Quake3, worldBounds};
+
+  auto brushNode1 = mdl::BrushNode{builder.createCube(64.0, "material").value()};
+  auto brushNode2 = mdl::BrushNode{builder.createCube(32.0, "material").value()};
+
+  auto store = BrushVertexStore{};
+  REQUIRE(store.blockCount() == 0);
+
+  SECTION("Acquiring a brush twice shares its vertices")
+  {
+    auto* block1 = store.acquire(brushNode1);
+    auto* block2 = store.acquire(brushNode1);
+    CHECK(block1 == block2);
+    CHECK(store.blockCount() == 1);
+
+    auto* block3 = store.acquire(brushNode2);
+    CHECK(block3 != block1);
+    CHECK(store.blockCount() == 2);
+
+    store.release(block1);
+    CHECK(store.blockCount() == 2);
+
+    store.release(block2);
+    CHECK(store.blockCount() == 2);
+
+    store.freeUnusedBlocks();
+    CHECK(store.blockCount() == 1);
+    CHECK(store.findBlock(brushNode1) == nullptr);
+
+    // the brush must be uploaded again after its last block was freed
+    const auto uploadedVertexCount = store.uploadedVertexCount();
+    auto* block4 = store.acquire(brushNode1);
+    CHECK(store.blockCount() == 2);
+    CHECK(store.uploadedVertexCount() > uploadedVertexCount);
+
+    store.release(block3);
+    store.release(block4);
+    store.freeUnusedBlocks();
+    CHECK(store.blockCount() == 0);
+  }
+
+  SECTION("Released blocks can be acquired again until they are freed")
+  {
+    auto* block1 = store.acquire(brushNode1);
+    const auto uploadedVertexCount = store.uploadedVertexCount();
+
+    store.release(block1);
+    CHECK(store.blockCount() == 1);
+
+    auto* block2 = store.acquire(brushNode1);
+    CHECK(block2 == block1);
+    CHECK(store.uploadedVertexCount() == uploadedVertexCount);
+
+    // the block is in use again, so it is not freed
+    store.freeUnusedBlocks();
+    CHECK(store.blockCount() == 1);
+    CHECK(store.findBlock(brushNode1) == block1);
+
+    store.release(block2);
+    store.freeUnusedBlocks();
+    CHECK(store.blockCount() == 0);
+  }
+
+  SECTION("Changing a brush uploads its vertices again")
+  {
+    auto* oldBlock = store.acquire(brushNode1);
+
+    brushNode1.setBrush(builder.createCube(128.0, "material").value());
+
+    auto* newBlock = store.acquire(brushNode1);
+    CHECK(newBlock != oldBlock);
+    CHECK(store.blockCount() == 2);
+
+    // the new vertices are shared from now on
+    CHECK(store.acquire(brushNode1) == newBlock);
+
+    // the old block is freed immediately because it can't be acquired again
+    store.release(oldBlock);
+    CHECK(store.blockCount() == 1);
+
+    store.release(newBlock);
+    store.release(newBlock);
+    store.freeUnusedBlocks();
+    CHECK(store.blockCount() == 0);
+  }
+
+  SECTION("Changing a released brush frees its old block")
+  {
+    auto* oldBlock = store.acquire(brushNode1);
+    store.release(oldBlock);
+
+    brushNode1.setBrush(builder.createCube(128.0, "material").value());
+
+    auto* newBlock = store.acquire(brushNode1);
+    CHECK(store.blockCount() == 1);
+    CHECK(store.findBlock(brushNode1) == newBlock);
+
+    store.release(newBlock);
+    store.freeUnusedBlocks();
+    CHECK(store.blockCount() == 0);
+  }
+}
+
+TEST_CASE("BrushVertexStore.sharedByBrushRenderers")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Quake3, worldBounds};
+
+  auto brushNode = mdl::BrushNode{builder.createCube(64.0, "material").value()};
+
+  auto store = std::make_shared<BrushVertexStore>();
+  auto defaultRenderer = BrushRenderer{BrushRenderer::NoFilter{}, store};
+  auto selectionRenderer = BrushRenderer{BrushRenderer::NoFilter{}, store};
+
+  defaultRenderer.addBrush(&brushNode);
+  defaultRenderer.validate();
+
+  const auto* block = store->findBlock(brushNode);
+  REQUIRE(block != nullptr);
+
+  const auto uploadedVertexCount = store->uploadedVertexCount();
+
+  SECTION("Moving a brush to another renderer keeps its vertices")
+  {
+    // this is the order in which MapRenderer moves a brush when it is selected
+    defaultRenderer.removeBrush(&brushNode);
+    selectionRenderer.addBrush(&brushNode);
+    selectionRenderer.validate();
+    store->freeUnusedBlocks();
+
+    CHECK(store->findBlock(brushNode) == block);
+    CHECK(store->blockCount() == 1);
+    CHECK(store->uploadedVertexCount() == uploadedVertexCount);
+  }
+
+  SECTION("Removing a brush from all renderers frees its vertices")
+  {
+    defaultRenderer.removeBrush(&brushNode);
+    store->freeUnusedBlocks();
+
+    CHECK(store->findBlock(brushNode) == nullptr);
+    CHECK(store->blockCount() == 0);
+  }
+}
+
+} // namespace tb::render
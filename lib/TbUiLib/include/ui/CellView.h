@@ -24,6 +24,9 @@
 #include "ui/CellLayout.h"
 #include "ui/RenderView.h"
 
+#include <optional>
+#include <tuple>
+
 class QScrollBar;
 class QDrag;
 class QMimeData;
@@ -48,6 +51,9 @@ private:
 
   bool m_valid = false;
 
+  // the visible range for which the load priorities were last updated
+  std::optional<std::tuple<float, float>> m_loadPriorityRange;
+
   QScrollBar* m_scrollBar = nullptr;
   QPoint m_lastMousePos;
   bool m_potentialDrag = false;
@@ -118,12 +124,19 @@ private:
   void renderTitleBackgrounds(gl::Gl& gl, float y, float height);
   void renderTitleStrings(gl::Gl& gl, float y, float height);
 
+  /**
+   * Requests the resources of the visible cells to be loaded first, followed by those
+   * within one page of the visible range.
+   */
+  void updateLoadPriorities(float y, float height);
+
   virtual void doInitLayout(Layout& layout) = 0;
   virtual void doReloadLayout(Layout& layout) = 0;
   virtual void doClear();
   virtual void doRender(gl::Gl& gl, Layout& layout, float y, float height) = 0;
   virtual void doLeftClick(Layout& layout, float x, float y);
   virtual void doContextMenu(Layout& layout, float x, float y, QContextMenuEvent* event);
+  virtual void doSetLoadPriority(const Cell& cell, int priority);
 
   virtual bool dndEnabled();
   virtual QPixmap dndImage(const Cell& cell);
@@ -26,8 +26,10 @@
 #include "Result.h"
 #include "mdl/CompilationTask.h"
 #include "ui/CompilationContext.h"
+#include "ui/CompilationTaskOutput.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -47,6 +49,7 @@ class CompilationTaskRunner : public QObject
   Q_OBJECT
 protected:
   CompilationContext& m_context;
+  CompilationTaskOutput m_output;
 
 protected:
   explicit CompilationTaskRunner(CompilationContext& context);
@@ -54,6 +57,8 @@ protected:
 public:
   ~CompilationTaskRunner() override;
 
+  CompilationTaskOutput& output();
+
   void execute();
   void terminate();
 signals:
@@ -172,26 +177,48 @@ private slots:
   deleteCopyAndMove(CompilationRunToolTaskRunner);
 };
 
+/**
+ * Runs the enabled tasks of a compilation profile. A task is started once all of its
+ * dependencies have finished, and at most the given number of tasks run at the same time.
+ * The compilation stops when a task fails.
+ *
+ * If tasks can run concurrently, every line of a task's output is prefixed with the
+ * index of the task in the profile.
+ */
 class CompilationRunner : public QObject
 {
   Q_OBJECT
 private:
-  using TaskRunnerList = std::vector<std::unique_ptr<CompilationTaskRunner>>;
+  enum class TaskState
+  {
+    Pending,
+    Running,
+    Finished,
+  };
+
+  struct Task
+  {
+    std::unique_ptr<CompilationTaskRunner> runner;
+    std::vector<size_t> dependencies;
+    TaskState state = TaskState::Pending;
+  };
 
   CompilationContext m_context;
-  TaskRunnerList m_taskRunners;
-  TaskRunnerList::iterator m_currentTask;
+  std::vector<Task> m_tasks;
+  std::optional<std::string> m_error;
+  size_t m_jobLimit;
+  bool m_running = false;
 
 public:
   CompilationRunner(
     CompilationContext context,
     const mdl::CompilationProfile& profile,
+    size_t jobLimit = 1,
     QObject* parent = nullptr);
   ~CompilationRunner() override;
 
 private:
-  static TaskRunnerList createTaskRunners(
-    CompilationContext& context, const mdl::CompilationProfile& profile);
+  Result<void> createTasks(const mdl::CompilationProfile& profile);
 
 public:
   void execute();
@@ -199,11 +226,16 @@ public:
   bool running() const;
 
 private:
-  void bindEvents(CompilationTaskRunner& runner) const;
-  void unbindEvents(CompilationTaskRunner& runner) const;
-private slots:
-  void taskError();
-  void taskEnd();
+  void startTasks();
+  void stopTasks();
+  void endCompilation();
+  size_t runningTaskCount() const;
+
+  void bindEvents(size_t taskIndex);
+  void unbindEvents(size_t taskIndex) const;
+
+  void taskError(size_t taskIndex);
+  void taskEnd(size_t taskIndex);
 signals:
   void compilationStarted();
   void compilationEnded();
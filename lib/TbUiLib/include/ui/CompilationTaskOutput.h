@@ -0,0 +1,68 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QString>
+#include <QTextStream>
+
+namespace tb::ui
+{
+class CompilationContext;
+
+/**
+ * Writes the output of a compilation task to the compilation context.
+ *
+ * If a prefix is set, the output is buffered until a line is complete, and every line is
+ * written with the prefix. This keeps the output of tasks that run concurrently apart.
+ */
+class CompilationTaskOutput
+{
+private:
+  CompilationContext& m_context;
+  QString m_prefix;
+  QString m_pendingLine;
+
+public:
+  explicit CompilationTaskOutput(CompilationContext& context);
+
+  void setPrefix(QString prefix);
+
+  /**
+   * Writes any buffered incomplete line.
+   */
+  void flush();
+
+  template <typename T>
+  CompilationTaskOutput& operator<<(const T& t)
+  {
+    auto string = QString{};
+    auto stream = QTextStream{&string};
+    stream << t;
+    stream.flush();
+    append(string);
+    return *this;
+  }
+
+private:
+  void append(const QString& string);
+  void writeLine(const QString& line);
+};
+
+} // namespace tb::ui
@@ -47,6 +47,7 @@ namespace mdl
 enum class EntityDefinitionSortOrder;
 enum class Orientation;
 
+class EntityModel;
 struct EntityDefinition;
 } // namespace mdl
 
@@ -67,6 +68,7 @@ struct EntityCellData
 {
   using EntityRenderer = gl::MaterialRenderer;
   const mdl::EntityDefinition& entityDefinition;
+  const mdl::EntityModel* model;
   EntityRenderer* modelRenderer;
   mdl::Orientation modelOrientation;
   gl::FontDescriptor fontDescriptor;
@@ -149,6 +151,7 @@ private:
   vm::mat4x4f itemTransformation(const Cell& cell, float y, float height) const;
 
   QString tooltip(const Cell& cell) override;
+  void doSetLoadPriority(const Cell& cell, int priority) override;
 
   const EntityCellData& cellData(const Cell& cell) const;
 };
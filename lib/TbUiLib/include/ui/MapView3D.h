@@ -22,7 +22,11 @@
 #include "NotifierConnection.h"
 #include "ui/MapViewBase.h"
 
+#include "vm/vec.h"
+
 #include <filesystem>
+#include <optional>
+#include <string>
 #include <vector>
 
 class QKeyEvent;
@@ -46,6 +50,10 @@ private:
   std::unique_ptr<FlyModeHelper> m_flyModeHelper;
   bool m_ignoreCameraChangeEvents = false;
 
+  // the camera position for which the material load priorities were last updated
+  std::optional<vm::vec3f> m_loadPriorityPosition;
+  std::vector<std::string> m_prioritizedMaterialNames;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -60,6 +68,7 @@ private: // notification
   void connectObservers();
   void cameraDidChange(const gl::Camera& camera);
   void preferenceDidChange(const std::filesystem::path& path);
+  void invalidateLoadPriorities();
 
 protected: // QWidget overrides
   void keyPressEvent(QKeyEvent* event) override;
@@ -77,6 +86,11 @@ private: // other events
   void updateFlyMode();
   void resetFlyModeKeys();
 
+  /**
+   * Requests the materials of the objects close to the camera to be loaded first.
+   */
+  void updateLoadPriorities();
+
 private: // implement ToolBoxConnector interface
   PickRequest pickRequest(float x, float y) const override;
   mdl::PickResult pick(const vm::ray3d& pickRay) const override;
@@ -312,6 +312,7 @@ protected: // RenderView overrides
   void initializeGL() override;
 
 private: // implement RenderView interface
+  bool shouldProfileFrames() const override;
   bool shouldRenderFocusIndicator() const override;
   void renderContents(gl::Gl& gl) override;
 
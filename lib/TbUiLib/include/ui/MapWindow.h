@@ -316,6 +316,7 @@ public:
   bool canDoCsgConvexMerge() const;
 
   void csgSubtract();
+  void csgSubtractAndMerge();
   bool canDoCsgSubtract() const;
 
   void csgHollow();
@@ -413,6 +414,9 @@ public:
 
   void revealMaterial(const gl::Material* material);
 
+  void toggleFrameProfile();
+  void saveFrameProfile();
+
   void debugPrintVertices();
   void debugCreateBrush();
   void debugCreateCube();
@@ -116,6 +116,7 @@ private:
   void doLeftClick(Layout& layout, float x, float y) override;
   QString tooltip(const Cell& cell) override;
   void doContextMenu(Layout& layout, float x, float y, QContextMenuEvent* event) override;
+  void doSetLoadPriority(const Cell& cell, int priority) override;
 
   const gl::Material& cellData(const Cell& cell) const;
 signals:
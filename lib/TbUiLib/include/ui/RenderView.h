@@ -27,6 +27,7 @@
 #include "ui/InputEvent.h"
 
 #include <string>
+#include <vector>
 
 class QOpenGLFunctions_2_1;
 
@@ -64,6 +65,7 @@ private: // FPS counter
 
 protected:
   std::string m_currentFPS;
+  std::vector<std::string> m_currentFrameProfile;
 
 protected:
   explicit RenderView(AppController& appController, QWidget* parent = nullptr);
@@ -109,6 +111,11 @@ protected:
 private:
   virtual const Color& getBackgroundColor();
   virtual void updateViewport(int x, int y, int width, int height);
+  /**
+   * Returns whether the frame profiler records the paints of this view as frames. The
+   * paints of all other views are not recorded.
+   */
+  virtual bool shouldProfileFrames() const;
   virtual bool shouldRenderFocusIndicator() const = 0;
   virtual void renderContents(gl::Gl& gl) = 0;
 };
@@ -42,6 +42,7 @@ private:
   QCheckBox* m_showAxes = nullptr;
   QComboBox* m_filterModeCombo = nullptr;
   QCheckBox* m_enableMsaa = nullptr;
+  QCheckBox* m_compressTextures = nullptr;
   QComboBox* m_themeCombo = nullptr;
   QComboBox* m_materialBrowserIconSizeCombo = nullptr;
   QComboBox* m_rendererFontSizeCombo = nullptr;
@@ -70,6 +71,7 @@ private slots:
   void fovChanged(int value);
   void showAxesChanged(int state);
   void enableMsaaChanged(int state);
+  void compressTexturesChanged(int state);
   void filterModeChanged(int index);
   void themeChanged(int index);
   void materialBrowserIconSizeChanged(int index);
@@ -1215,6 +1215,17 @@ void ActionManager::createEditMenu()
         return context.hasDocument() && context.mapWindow().canDoCsgSubtract();
       },
     }));
+  csgMenu.addItem(addAction(
+    Action{
+      "Menu/Edit/CSG/Subtract and Merge",
+      QObject::tr("Subtract and Merge"),
+      ActionContext::Any,
+      QKeySequence{},
+      [](auto& context) { context.mapWindow().csgSubtractAndMerge(); },
+      [](const auto& context) {
+        return context.hasDocument() && context.mapWindow().canDoCsgSubtract();
+      },
+    }));
   csgMenu.addItem(addAction(
     Action{
       "Menu/Edit/CSG/Hollow",
@@ -2183,6 +2194,26 @@ void ActionManager::createViewMenu()
       },
     }));
   viewMenu.addSeparator();
+  viewMenu.addItem(addAction(
+    Action{
+      "Menu/View/Show Frame Profile",
+      QObject::tr("Show Frame Profile"),
+      ActionContext::Any,
+      QKeySequence{},
+      [](auto& context) { context.mapWindow().toggleFrameProfile(); },
+      [](const auto& context) { return context.hasDocument(); },
+      [](const auto&) { return pref(Preferences::ShowFrameProfile); },
+    }));
+  viewMenu.addItem(addAction(
+    Action{
+      "Menu/View/Save Frame Profile...",
+      QObject::tr("Save Frame Profile..."),
+      ActionContext::Any,
+      QKeySequence{},
+      [](auto& context) { context.mapWindow().saveFrameProfile(); },
+      [](const auto& context) { return context.hasDocument(); },
+    }));
+  viewMenu.addSeparator();
   viewMenu.addItem(addAction(
     Action{
       "Menu/File/Preferences...",
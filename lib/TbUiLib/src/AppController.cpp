@@ -65,7 +65,9 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <chrono>
+#include <thread>
 
 namespace tb::ui
 {
@@ -180,6 +182,11 @@ AppController::AppController(
 
   connectObservers();
 
+  // keep the task manager busy, but don't flood it so that resources which become
+  // visible later can still overtake the ones that were requested first
+  m_glManager->resourceManager().setMaxConcurrentLoads(
+    2 * std::max(std::thread::hardware_concurrency(), 1u));
+
   m_reloadRecentDocumentsTimer->start(1s);
   m_processResourcesTimer->start(20ms);
 }
@@ -458,6 +465,11 @@ void AppController::processGlResources()
     auto gl = GlQt{*glFunctions};
     auto processContext = tb::gl::ProcessContext{gl, errorHandler};
 
+    const auto textureMemoryBudget = pref(Preferences::TextureMemoryBudget);
+    m_glManager->resourceManager().setMemoryBudget(
+      textureMemoryBudget > 0 ? std::optional{size_t(textureMemoryBudget) * 1024 * 1024}
+                              : std::nullopt);
+
     m_glManager->resourceManager().process(taskRunner, processContext, 20ms);
     m_glManager->vboManager().destroyPendingVbos(gl);
     m_glManager->fontManager().destroyPendingFonts(gl);
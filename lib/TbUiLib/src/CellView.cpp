@@ -32,6 +32,7 @@
 #include "gl/FontManager.h"
 #include "gl/GlInterface.h"
 #include "gl/PrimType.h"
+#include "gl/Resource.h"
 #include "gl/Shaders.h"
 #include "gl/TextureFont.h"
 #include "gl/VertexArray.h"
@@ -79,6 +80,7 @@ void CellView::reloadLayout()
   doReloadLayout(m_layout);
   updateScrollBar();
 
+  m_loadPriorityRange = std::nullopt;
   m_valid = true;
 }
 
@@ -118,6 +120,7 @@ void CellView::clear()
 {
   m_layout.clear();
   doClear();
+  m_loadPriorityRange = std::nullopt;
   m_valid = true;
 }
 
@@ -126,6 +129,7 @@ void CellView::resizeEvent(QResizeEvent* event)
   validate();
   m_layout.setWidth(float(size().width()));
   updateScrollBar();
+  m_loadPriorityRange = std::nullopt;
 
   RenderView::resizeEvent(event);
 }
@@ -370,6 +374,7 @@ void CellView::renderContents(gl::Gl& gl)
   const auto y = float(visibleRect.y());
   const auto h = float(visibleRect.height());
 
+  updateLoadPriorities(y, h);
   doRender(gl, m_layout, y, h);
 
   const auto viewLeft = float(0);
@@ -549,9 +554,36 @@ void CellView::renderTitleStrings(gl::Gl& gl, float y, float height)
   }
 }
 
+void CellView::updateLoadPriorities(const float y, const float height)
+{
+  const auto range = std::tuple{y, height};
+  if (m_loadPriorityRange == range)
+  {
+    return;
+  }
+  m_loadPriorityRange = range;
+
+  for (const auto& group : m_layout.groups())
+  {
+    for (const auto& row : group.rows())
+    {
+      const auto priority = row.intersectsY(y, height)
+                              ? gl::ResourcePriority::Visible
+                            : row.intersectsY(y - height, 3.0f * height)
+                              ? gl::ResourcePriority::Nearby
+                              : gl::ResourcePriority::Default;
+      for (const auto& cell : row.cells())
+      {
+        doSetLoadPriority(cell, priority);
+      }
+    }
+  }
+}
+
 void CellView::doClear() {}
 void CellView::doLeftClick(Layout&, float, float) {}
 void CellView::doContextMenu(Layout&, float, float, QContextMenuEvent*) {}
+void CellView::doSetLoadPriority(const Cell&, int) {}
 
 bool CellView::dndEnabled()
 {
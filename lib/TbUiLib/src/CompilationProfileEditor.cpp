@@ -43,7 +43,6 @@
 #include "kd/contracts.h"
 #include "kd/k.h"
 #include "kd/range_utils.h"
-#include "kd/vector_utils.h"
 
 namespace tb::ui
 {
@@ -242,14 +241,13 @@ void CompilationProfileEditor::addTask()
     const auto index = m_taskList->currentRow();
     if (index < 0)
     {
-      m_profile->tasks.push_back(std::move(*task));
+      mdl::insertTask(*m_profile, m_profile->tasks.size(), std::move(*task));
       m_taskList->reloadTasks();
       m_taskList->setCurrentRow(static_cast<int>(m_profile->tasks.size()) - 1);
     }
     else
     {
-      m_profile->tasks.insert(
-        std::next(m_profile->tasks.begin(), index + 1), std::move(*task));
+      mdl::insertTask(*m_profile, size_t(index + 1), std::move(*task));
       m_taskList->reloadTasks();
       m_taskList->setCurrentRow(index + 1);
     }
@@ -266,7 +264,7 @@ void CompilationProfileEditor::removeTask(const int index)
 {
   contract_pre(index >= 0);
 
-  m_profile->tasks = kdl::vec_erase_at(std::move(m_profile->tasks), size_t(index));
+  mdl::removeTask(*m_profile, size_t(index));
   m_taskList->reloadTasks();
 
   if (!m_profile->tasks.empty())
@@ -279,8 +277,7 @@ void CompilationProfileEditor::removeTask(const int index)
 void CompilationProfileEditor::duplicateTask(const int index)
 {
   auto task = m_profile->tasks[size_t(index)];
-  m_profile->tasks.insert(
-    std::next(m_profile->tasks.begin(), index + 1), std::move(task));
+  mdl::insertTask(*m_profile, size_t(index + 1), std::move(task));
   m_taskList->reloadTasks();
   m_taskList->setCurrentRow(index + 1);
   emit profileChanged();
@@ -295,8 +292,7 @@ void CompilationProfileEditor::moveTaskUp(const int index)
 {
   contract_pre(index > 0);
 
-  auto it = std::next(m_profile->tasks.begin(), index);
-  std::iter_swap(it, std::prev(it));
+  mdl::swapTasks(*m_profile, size_t(index), size_t(index - 1));
   m_taskList->reloadTasks();
   m_taskList->setCurrentRow(index - 1);
   emit profileChanged();
@@ -311,8 +307,7 @@ void CompilationProfileEditor::moveTaskDown(const int index)
 {
   contract_pre(index >= 0 && index < static_cast<int>(m_profile->tasks.size()) - 1);
 
-  auto it = std::next(m_profile->tasks.begin(), index);
-  std::iter_swap(it, std::next(it));
+  mdl::swapTasks(*m_profile, size_t(index), size_t(index + 1));
   m_taskList->reloadTasks();
   m_taskList->setCurrentRow(index + 1);
   emit profileChanged();
@@ -19,6 +19,8 @@
 
 #include "ui/CompilationRun.h"
 
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "el/Interpolate.h"
 #include "mdl/CompilationProfile.h"
 #include "ui/CompilationContext.h"
@@ -28,10 +30,23 @@
 
 #include "kd/contracts.h"
 
+#include <algorithm>
 #include <string>
+#include <thread>
 
 namespace tb::ui
 {
+namespace
+{
+
+size_t jobLimit()
+{
+  const auto limit = pref(Preferences::CompilationJobLimit);
+  return limit > 0 ? size_t(limit)
+                   : size_t(std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+} // namespace
 
 CompilationRun::~CompilationRun()
 {
@@ -87,8 +102,8 @@ Result<void> CompilationRun::run(
            auto variables = CompilationVariables{map, workDir};
            auto compilationContext =
              CompilationContext{map, variables, TextOutputAdapter{currentOutput}, test};
-           m_currentRun =
-             new CompilationRunner{std::move(compilationContext), profile, this};
+           m_currentRun = new CompilationRunner{
+             std::move(compilationContext), profile, jobLimit(), this};
            connect(
              m_currentRun,
              &CompilationRunner::compilationStarted,
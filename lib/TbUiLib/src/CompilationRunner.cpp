@@ -49,6 +49,7 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <algorithm>
 #include <ranges>
 #include <string>
 
@@ -74,11 +75,17 @@ Result<std::string> workDir(const CompilationContext& context)
 
 CompilationTaskRunner::CompilationTaskRunner(CompilationContext& context)
   : m_context{context}
+  , m_output{context}
 {
 }
 
 CompilationTaskRunner::~CompilationTaskRunner() = default;
 
+CompilationTaskOutput& CompilationTaskRunner::output()
+{
+  return m_output;
+}
+
 void CompilationTaskRunner::execute()
 {
   doExecute();
@@ -117,7 +124,7 @@ void CompilationExportMapTaskRunner::doExecute()
 
   interpolate(m_task.targetSpec).and_then([&](const auto& interpolated) {
     const auto targetPath = kdl::parse_path(interpolated);
-    m_context << "#### Exporting map file '" << pathAsQString(targetPath) << "'\n";
+    m_output << "#### Exporting map file '" << pathAsQString(targetPath) << "'\n";
 
     if (!m_context.test())
     {
@@ -131,7 +138,7 @@ void CompilationExportMapTaskRunner::doExecute()
     return Result<void>{};
   }) | kdl::transform([&]() { emit end(); })
     | kdl::transform_error([&](auto e) {
-        m_context << "#### Export failed: " << QString::fromStdString(e.msg) << "\n";
+        m_output << "#### Export failed: " << QString::fromStdString(e.msg) << "\n";
         emit error();
       });
 }
@@ -170,10 +177,10 @@ void CompilationCopyFilesTaskRunner::doExecute()
                      })
                      | kdl::ranges::to<std::vector>();
 
-                   m_context << "#### Copying to '" << pathAsQString(targetPath) << "/': "
-                             << QString::fromStdString(
-                                  kdl::str_join(pathStrsToCopy, ", "))
-                             << "\n";
+                   m_output << "#### Copying to '" << pathAsQString(targetPath) << "/': "
+                            << QString::fromStdString(
+                                 kdl::str_join(pathStrsToCopy, ", "))
+                            << "\n";
                    if (!m_context.test())
                    {
                      return fs::Disk::createDirectory(targetPath)
@@ -191,7 +198,7 @@ void CompilationCopyFilesTaskRunner::doExecute()
                  });
       })
     | kdl::transform([&]() { emit end(); }) | kdl::transform_error([&](auto e) {
-        m_context << "#### Copy failed: " << QString::fromStdString(e.msg) << "\n";
+        m_output << "#### Copy failed: " << QString::fromStdString(e.msg) << "\n";
         emit error();
       });
 }
@@ -217,8 +224,8 @@ void CompilationRenameFileTaskRunner::doExecute()
         const auto sourcePath = kdl::parse_path(interpolatedSource);
         const auto targetPath = kdl::parse_path(interpolatedTarget);
 
-        m_context << "#### Renaming '" << pathAsQString(sourcePath) << "' to '"
-                  << pathAsQString(targetPath) << "'\n";
+        m_output << "#### Renaming '" << pathAsQString(sourcePath) << "' to '"
+                 << pathAsQString(targetPath) << "'\n";
         if (!m_context.test())
         {
           return fs::Disk::createDirectory(targetPath.parent_path())
@@ -228,7 +235,7 @@ void CompilationRenameFileTaskRunner::doExecute()
         return Result<void>{};
       })
     | kdl::transform([&]() { emit end(); }) | kdl::transform_error([&](auto e) {
-        m_context << "#### Rename failed: " << QString::fromStdString(e.msg) << "\n";
+        m_output << "#### Rename failed: " << QString::fromStdString(e.msg) << "\n";
         emit error();
       });
 }
@@ -264,9 +271,9 @@ void CompilationDeleteFilesTaskRunner::doExecute()
                  })
                  | kdl::ranges::to<std::vector>();
 
-               m_context << "#### Deleting: "
-                         << QString::fromStdString(kdl::str_join(pathStrsToDelete, ", "))
-                         << "\n";
+               m_output << "#### Deleting: "
+                        << QString::fromStdString(kdl::str_join(pathStrsToDelete, ", "))
+                        << "\n";
 
                if (!m_context.test())
                {
@@ -277,7 +284,7 @@ void CompilationDeleteFilesTaskRunner::doExecute()
              });
   }) | kdl::transform([&](auto) { emit end(); })
     | kdl::transform_error([&](auto e) {
-        m_context << "#### Delete failed: " << QString::fromStdString(e.msg) << "\n";
+        m_output << "#### Delete failed: " << QString::fromStdString(e.msg) << "\n";
         emit error();
       });
 }
@@ -313,7 +320,7 @@ void CompilationRunToolTaskRunner::doTerminate()
       this,
       &CompilationRunToolTaskRunner::processFinished);
     m_process->kill();
-    m_context << "\n\n#### Terminated\n";
+    m_output << "\n\n#### Terminated\n";
   }
 }
 
@@ -336,8 +343,8 @@ void CompilationRunToolTaskRunner::startProcess()
           const auto parameterStrList =
             QStringList{parameterStrs.begin(), parameterStrs.end()};
 
-          m_context << "#### Executing '" << programStr << " "
-                    << parameterStrList.join(" ") << "'\n";
+          m_output << "#### Executing '" << programStr << " "
+                   << parameterStrList.join(" ") << "'\n";
 
           if (!m_context.test())
           {
@@ -382,7 +389,7 @@ void CompilationRunToolTaskRunner::startProcess()
         }
       })
     | kdl::transform_error([&](auto e) {
-        m_context << "#### Execution failed: " << QString::fromStdString(e.msg) << "\n";
+        m_output << "#### Execution failed: " << QString::fromStdString(e.msg) << "\n";
         emit error();
       });
 }
@@ -402,9 +409,9 @@ Result<std::vector<std::string>> CompilationRunToolTaskRunner::parameters() cons
 void CompilationRunToolTaskRunner::processErrorOccurred(
   const QProcess::ProcessError processError)
 {
-  m_context << "#### Error '"
-            << QMetaEnum::fromType<QProcess::ProcessError>().valueToKey(processError)
-            << "' occurred when communicating with process\n\n";
+  m_output << "#### Error '"
+           << QMetaEnum::fromType<QProcess::ProcessError>().valueToKey(processError)
+           << "' occurred when communicating with process\n\n";
   emit error();
 }
 
@@ -414,7 +421,7 @@ void CompilationRunToolTaskRunner::processFinished(
   switch (exitStatus)
   {
   case QProcess::NormalExit:
-    m_context << "#### Finished with exit code " << exitCode << "\n\n";
+    m_output << "#### Finished with exit code " << exitCode << "\n\n";
     if (exitCode == 0 || !m_task.treatNonZeroResultCodeAsError)
     {
       emit end();
@@ -425,7 +432,7 @@ void CompilationRunToolTaskRunner::processFinished(
     }
     break;
   case QProcess::CrashExit:
-    m_context << "#### Crashed with exit code " << exitCode << "\n\n";
+    m_output << "#### Crashed with exit code " << exitCode << "\n\n";
     emit error();
     break;
   }
@@ -436,7 +443,7 @@ void CompilationRunToolTaskRunner::processReadyReadStandardError()
   if (m_process)
   {
     const QByteArray bytes = m_process->readAllStandardError();
-    m_context << QString::fromLocal8Bit(bytes);
+    m_output << QString::fromLocal8Bit(bytes);
   }
 }
 
@@ -445,82 +452,127 @@ void CompilationRunToolTaskRunner::processReadyReadStandardOutput()
   if (m_process)
   {
     const QByteArray bytes = m_process->readAllStandardOutput();
-    m_context << QString::fromLocal8Bit(bytes);
+    m_output << QString::fromLocal8Bit(bytes);
   }
 }
 
+namespace
+{
+
+std::unique_ptr<CompilationTaskRunner> createTaskRunner(
+  CompilationContext& context, const mdl::CompilationTask& task)
+{
+  return std::visit(
+    kdl::overload(
+      [&](const mdl::CompilationExportMap& exportMap)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationExportMapTaskRunner>(context, exportMap);
+      },
+      [&](const mdl::CompilationCopyFiles& copyFiles)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationCopyFilesTaskRunner>(context, copyFiles);
+      },
+      [&](const mdl::CompilationRenameFile& renameFile)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationRenameFileTaskRunner>(context, renameFile);
+      },
+      [&](const mdl::CompilationDeleteFiles& deleteFiles)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationDeleteFilesTaskRunner>(context, deleteFiles);
+      },
+      [&](const mdl::CompilationRunTool& runTool)
+        -> std::unique_ptr<CompilationTaskRunner> {
+        return std::make_unique<CompilationRunToolTaskRunner>(context, runTool);
+      }),
+    task);
+}
+
+} // namespace
+
 CompilationRunner::CompilationRunner(
-  CompilationContext context, const mdl::CompilationProfile& profile, QObject* parent)
+  CompilationContext context,
+  const mdl::CompilationProfile& profile,
+  const size_t jobLimit,
+  QObject* parent)
   : QObject{parent}
   , m_context{std::move(context)}
-  , m_taskRunners{createTaskRunners(m_context, profile)}
-  , m_currentTask{std::end(m_taskRunners)}
+  , m_jobLimit{std::max(jobLimit, size_t(1))}
 {
+  createTasks(profile)
+    | kdl::transform_error([&](auto e) { m_error = std::move(e.msg); });
 }
 
 CompilationRunner::~CompilationRunner() = default;
 
-CompilationRunner::TaskRunnerList CompilationRunner::createTaskRunners(
-  CompilationContext& context, const mdl::CompilationProfile& profile)
+Result<void> CompilationRunner::createTasks(const mdl::CompilationProfile& profile)
 {
-  auto result = TaskRunnerList{};
-  for (const auto& task : profile.tasks)
-  {
-    std::visit(
-      kdl::overload(
-        [&](const mdl::CompilationExportMap& exportMap) {
-          if (exportMap.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationExportMapTaskRunner>(context, exportMap));
-          }
-        },
-        [&](const mdl::CompilationCopyFiles& copyFiles) {
-          if (copyFiles.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationCopyFilesTaskRunner>(context, copyFiles));
-          }
-        },
-        [&](const mdl::CompilationRenameFile& renameFile) {
-          if (renameFile.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationRenameFileTaskRunner>(context, renameFile));
-          }
-        },
-        [&](const mdl::CompilationDeleteFiles& deleteFiles) {
-          if (deleteFiles.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationDeleteFilesTaskRunner>(context, deleteFiles));
-          }
-        },
-        [&](const mdl::CompilationRunTool& runTool) {
-          if (runTool.enabled)
-          {
-            result.push_back(
-              std::make_unique<CompilationRunToolTaskRunner>(context, runTool));
-          }
-        }),
-      task);
-  }
-  return result;
+  return mdl::resolveTaskDependencies(profile)
+         | kdl::transform([&](const auto& dependencies) {
+             // maps the indices of the enabled tasks in the profile to indices in m_tasks
+             auto taskIndices = std::vector<size_t>(profile.tasks.size());
+             auto profileIndices = std::vector<size_t>{};
+             for (size_t i = 0; i < profile.tasks.size(); ++i)
+             {
+               if (mdl::isEnabled(profile.tasks[i]))
+               {
+                 taskIndices[i] = profileIndices.size();
+                 profileIndices.push_back(i);
+               }
+             }
+
+             for (const auto profileIndex : profileIndices)
+             {
+               m_tasks.push_back(Task{
+                 createTaskRunner(m_context, profile.tasks[profileIndex]),
+                 dependencies[profileIndex]
+                   | std::views::transform(
+                     [&](const auto dependency) { return taskIndices[dependency]; })
+                   | kdl::ranges::to<std::vector>(),
+               });
+             }
+
+             const auto sequential = std::ranges::all_of(
+               std::views::iota(size_t(0), m_tasks.size()), [&](const auto i) {
+                 return m_tasks[i].dependencies
+                        == (i > 0 ? std::vector<size_t>{i - 1} : std::vector<size_t>{});
+               });
+
+             if (m_jobLimit > 1 && !sequential)
+             {
+               for (size_t i = 0; i < m_tasks.size(); ++i)
+               {
+                 m_tasks[i].runner->output().setPrefix(
+                   QString{"[%1] "}.arg(profileIndices[i]));
+               }
+             }
+           });
 }
 
 void CompilationRunner::execute()
 {
   contract_pre(!running());
 
-  m_currentTask = std::begin(m_taskRunners);
-  if (m_currentTask == std::end(m_taskRunners))
+  if (m_tasks.empty() && !m_error)
   {
     return;
   }
-  bindEvents(*m_currentTask->get());
 
+  for (auto& task : m_tasks)
+  {
+    task.state = TaskState::Pending;
+  }
+
+  m_running = true;
   emit compilationStarted();
 
+  if (m_error)
+  {
+    m_context << "#### Error: Invalid task dependencies: "
+              << QString::fromStdString(*m_error) << "\n";
+    endCompilation();
+    return;
+  }
+
   workDir(m_context)
     .transform([&](const auto& workDir) {
       const auto workDirQStr = QString::fromStdString(workDir);
@@ -533,11 +585,12 @@ void CompilationRunner::execute()
         m_context << "#### Error: working directory '" << workDirQStr
                   << "' does not exist\n";
       }
-      m_currentTask->get()->execute();
+      startTasks();
     })
     .transform_error([&](const auto& e) {
       m_context << "#### Error: Could not get determine working directory: "
                 << QString::fromStdString(e.msg) << "\n";
+      endCompilation();
     });
 }
 
@@ -545,53 +598,109 @@ void CompilationRunner::terminate()
 {
   contract_pre(running());
 
-  unbindEvents(*m_currentTask->get());
-  m_currentTask->get()->terminate();
-  m_currentTask = std::end(m_taskRunners);
+  stopTasks();
+  endCompilation();
+}
+
+bool CompilationRunner::running() const
+{
+  return m_running;
+}
 
+void CompilationRunner::startTasks()
+{
+  // Tasks can finish while they are being executed, which calls this function again.
+  for (size_t i = 0; i < m_tasks.size() && m_running && runningTaskCount() < m_jobLimit;
+       ++i)
+  {
+    auto& task = m_tasks[i];
+    if (
+      task.state == TaskState::Pending
+      && std::ranges::all_of(task.dependencies, [&](const auto dependency) {
+           return m_tasks[dependency].state == TaskState::Finished;
+         }))
+    {
+      task.state = TaskState::Running;
+      bindEvents(i);
+      task.runner->execute();
+    }
+  }
+}
+
+void CompilationRunner::stopTasks()
+{
+  for (size_t i = 0; i < m_tasks.size(); ++i)
+  {
+    auto& task = m_tasks[i];
+    if (task.state == TaskState::Running)
+    {
+      unbindEvents(i);
+      task.runner->terminate();
+      task.runner->output().flush();
+      task.state = TaskState::Pending;
+    }
+  }
+}
+
+void CompilationRunner::endCompilation()
+{
+  m_running = false;
   emit compilationEnded();
 }
 
-bool CompilationRunner::running() const
+size_t CompilationRunner::runningTaskCount() const
 {
-  return m_currentTask != std::end(m_taskRunners);
+  return size_t(std::ranges::count_if(
+    m_tasks, [](const auto& task) { return task.state == TaskState::Running; }));
 }
 
-void CompilationRunner::bindEvents(CompilationTaskRunner& runner) const
+void CompilationRunner::bindEvents(const size_t taskIndex)
 {
-  connect(&runner, &CompilationTaskRunner::error, this, &CompilationRunner::taskError);
-  connect(&runner, &CompilationTaskRunner::end, this, &CompilationRunner::taskEnd);
+  auto& runner = *m_tasks[taskIndex].runner;
+  connect(&runner, &CompilationTaskRunner::error, this, [this, taskIndex]() {
+    taskError(taskIndex);
+  });
+  connect(&runner, &CompilationTaskRunner::end, this, [this, taskIndex]() {
+    taskEnd(taskIndex);
+  });
 }
 
-void CompilationRunner::unbindEvents(CompilationTaskRunner& runner) const
+void CompilationRunner::unbindEvents(const size_t taskIndex) const
 {
-  runner.disconnect(this);
+  m_tasks[taskIndex].runner->disconnect(this);
 }
 
-void CompilationRunner::taskError()
+void CompilationRunner::taskError(const size_t taskIndex)
 {
   if (running())
   {
-    unbindEvents(*m_currentTask->get());
-    m_currentTask = std::end(m_taskRunners);
-    emit compilationEnded();
+    auto& task = m_tasks[taskIndex];
+    unbindEvents(taskIndex);
+    task.runner->output().flush();
+    task.state = TaskState::Finished;
+
+    stopTasks();
+    endCompilation();
   }
 }
 
-void CompilationRunner::taskEnd()
+void CompilationRunner::taskEnd(const size_t taskIndex)
 {
   if (running())
   {
-    unbindEvents(*m_currentTask->get());
-    ++m_currentTask;
-    if (m_currentTask != std::end(m_taskRunners))
+    auto& task = m_tasks[taskIndex];
+    unbindEvents(taskIndex);
+    task.runner->output().flush();
+    task.state = TaskState::Finished;
+
+    if (std::ranges::all_of(
+          m_tasks, [](const auto& t) { return t.state == TaskState::Finished; }))
     {
-      bindEvents(*m_currentTask->get());
-      m_currentTask->get()->execute();
+      endCompilation();
     }
     else
     {
-      emit compilationEnded();
+      startTasks();
     }
   }
 }
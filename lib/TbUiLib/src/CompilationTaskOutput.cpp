@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ui/CompilationTaskOutput.h"
+
+#include "ui/CompilationContext.h"
+
+namespace tb::ui
+{
+
+CompilationTaskOutput::CompilationTaskOutput(CompilationContext& context)
+  : m_context{context}
+{
+}
+
+void CompilationTaskOutput::setPrefix(QString prefix)
+{
+  flush();
+  m_prefix = std::move(prefix);
+}
+
+void CompilationTaskOutput::flush()
+{
+  if (!m_pendingLine.isEmpty())
+  {
+    writeLine(m_pendingLine);
+    m_pendingLine.clear();
+  }
+}
+
+void CompilationTaskOutput::append(const QString& string)
+{
+  if (m_prefix.isEmpty())
+  {
+    m_context << string;
+    return;
+  }
+
+  m_pendingLine += string;
+
+  auto lineStart = qsizetype(0);
+  for (auto lineEnd = m_pendingLine.indexOf('\n'); lineEnd >= 0;
+       lineEnd = m_pendingLine.indexOf('\n', lineStart))
+  {
+    writeLine(m_pendingLine.mid(lineStart, lineEnd - lineStart));
+    lineStart = lineEnd + 1;
+  }
+  m_pendingLine.remove(0, lineStart);
+}
+
+void CompilationTaskOutput::writeLine(const QString& line)
+{
+  // A carriage return moves back to the start of the line, which is then overwritten.
+  // Tools use this to update progress indicators.
+  auto visibleLine = QString{};
+  for (const auto& segment : line.split('\r'))
+  {
+    visibleLine = segment + visibleLine.mid(segment.size());
+  }
+
+  m_context << m_prefix << visibleLine << "\n";
+}
+
+} // namespace tb::ui
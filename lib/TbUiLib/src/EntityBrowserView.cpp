@@ -271,6 +271,7 @@ void EntityBrowserView::addEntityToLayout(
     layout.addItem(
       EntityCellData{
         definition,
+        model,
         modelRenderer,
         modelOrientation,
         actualFont,
@@ -438,6 +439,14 @@ QString EntityBrowserView::tooltip(const Cell& cell)
   return QString::fromStdString(cellData(cell).entityDefinition.name);
 }
 
+void EntityBrowserView::doSetLoadPriority(const Cell& cell, const int priority)
+{
+  if (const auto* model = cellData(cell).model)
+  {
+    model->setLoadPriority(priority);
+  }
+}
+
 const EntityCellData& EntityBrowserView::cellData(const Cell& cell) const
 {
   return cell.itemAs<EntityCellData>();
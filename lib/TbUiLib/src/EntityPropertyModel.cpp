@@ -51,8 +51,6 @@
 #include "kd/reflection_impl.h"
 #include "kd/string_utils.h"
 
-#include <fmt/format.h>
-
 #include <algorithm>
 #include <iterator>
 #include <map>
@@ -419,15 +417,8 @@ std::vector<std::string> getAllValuesForPropertyKeys(
   auto result = kdl::vector_set<std::string>();
   for (const auto& key : propertyKeys)
   {
-    for (const auto* entityNode :
-         map.findNodes<mdl::EntityNodeBase>(fmt::format("{}%*", key)))
-    {
-      const auto values =
-        entityNode->entity().numberedProperties(key)
-        | std::views::transform([](const auto& property) { return property.value(); });
-
-      result.insert(values.begin(), values.end());
-    }
+    const auto values = map.findNumberedPropertyValues(key);
+    result.insert(values.begin(), values.end());
   }
 
   // remove the empty string
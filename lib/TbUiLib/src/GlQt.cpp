@@ -21,6 +21,8 @@
 
 #include <QOpenGLFunctions_2_1>
 
+#include "FrameProfiler.h"
+
 namespace tb::ui
 {
 
@@ -424,12 +426,17 @@ void GlQt::bufferData(
   const GLenum target, const GLsizeiptr size, const GLvoid* data, const GLenum usage)
 {
   m_gl.glBufferData(target, size, data, usage);
+  if (data)
+  {
+    FrameProfiler::instance().count(FrameCounter::BytesUploaded, std::uint64_t(size));
+  }
 }
 
 void GlQt::bufferSubData(
   const GLenum target, const GLintptr offset, const GLsizeiptr size, const void* data)
 {
   m_gl.glBufferSubData(target, offset, size, data);
+  FrameProfiler::instance().count(FrameCounter::BytesUploaded, std::uint64_t(size));
 }
 
 void GlQt::vertexPointer(
@@ -525,6 +532,16 @@ void GlQt::compressedTexImage2D(
     target, level, internalformat, width, height, border, imageSize, data);
 }
 
+void GlQt::getTexImage(
+  const GLenum target,
+  const GLint level,
+  const GLenum format,
+  const GLenum type,
+  GLvoid* pixels)
+{
+  m_gl.glGetTexImage(target, level, format, type, pixels);
+}
+
 void GlQt::texParameterf(const GLenum target, const GLenum pname, const GLfloat param)
 {
   m_gl.glTexParameterf(target, pname, param);
@@ -553,18 +570,21 @@ void GlQt::clientActiveTexture(const GLenum texture)
 void GlQt::drawArrays(const GLenum mode, const GLint first, const GLsizei count)
 {
   m_gl.glDrawArrays(mode, first, count);
+  FrameProfiler::instance().count(FrameCounter::DrawCalls);
 }
 
 void GlQt::drawElements(
   const GLenum mode, const GLsizei count, const GLenum type, const void* indices)
 {
   m_gl.glDrawElements(mode, count, type, indices);
+  FrameProfiler::instance().count(FrameCounter::DrawCalls);
 }
 
 void GlQt::multiDrawArrays(
   const GLenum mode, const GLint* first, const GLsizei* count, const GLsizei primcount)
 {
   m_gl.glMultiDrawArrays(mode, first, count, primcount);
+  FrameProfiler::instance().count(FrameCounter::DrawCalls, std::uint64_t(primcount));
 }
 
 const GLubyte* GlQt::getString(const GLenum name)
@@ -25,11 +25,13 @@
 #include "fs/DiskIO.h"
 #include "gl/MaterialManager.h"
 #include "gl/ResourceManager.h"
+#include "gl/TextureCompressor.h"
 #include "mdl/Autosaver.h"
 #include "mdl/CommandProcessor.h"
 #include "mdl/EditorContext.h"
 #include "mdl/EntityDefinitionManager.h"
 #include "mdl/EntityModelManager.h"
+#include "mdl/EnvironmentConfig.h"
 #include "mdl/GameInfo.h"
 #include "mdl/Grid.h"
 #include "mdl/LinkedGroupUtils.h"
@@ -58,6 +60,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -195,6 +198,16 @@ void MapDocument::updateMapFromPreferences()
   m_map->editorContext().setShowBrushes(pref(Preferences::ShowBrushes));
   m_map->editorContext().setAlignmentLock(pref(Preferences::AlignmentLock));
   m_map->editorContext().setUVLock(pref(Preferences::UVLock));
+
+  const auto undoMemoryBudget = pref(Preferences::UndoMemoryBudget);
+  m_map->commandProcessor().setUndoMemoryBudget(
+    undoMemoryBudget > 0 ? std::optional{size_t(undoMemoryBudget) * 1024 * 1024}
+                         : std::nullopt);
+
+  m_map->textureCompressor().setConfig(gl::TextureCompressionConfig{
+    .enabled = pref(Preferences::CompressTextures),
+    .cachePath = m_map->environmentConfig().userDataFolderPath / "texture cache",
+  });
 }
 
 mdl::Map& MapDocument::map()
@@ -21,7 +21,10 @@
 
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "gl/Material.h"
+#include "gl/MaterialManager.h"
 #include "gl/PerspectiveCamera.h"
+#include "gl/Resource.h"
 #include "mdl/BezierPatch.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -31,10 +34,12 @@
 #include "mdl/HitAdapter.h"
 #include "mdl/HitFilter.h"
 #include "mdl/LayerNode.h"
+#include "mdl/Map.h"
 #include "mdl/Map_Picking.h"
 #include "mdl/PatchNode.h"
 #include "mdl/PickResult.h"
 #include "mdl/PointTrace.h"
+#include "mdl/WorldNode.h"
 #include "render/BoundsGuideRenderer.h"
 #include "render/Compass3D.h"
 #include "render/MapRenderer.h"
@@ -65,12 +70,24 @@
 #include "ui/VertexToolController.h"
 
 #include "kd/contracts.h"
+#include "kd/overload.h"
 #include "kd/set_temp.h"
+#include "kd/vector_utils.h"
 
 #include "vm/util.h"
 
 namespace tb::ui
 {
+namespace
+{
+
+// the materials of objects within this distance of the camera are loaded first
+constexpr auto LoadPriorityDistance = 2048.0;
+
+// the load priorities are updated when the camera has moved this far
+constexpr auto LoadPriorityUpdateDistance = 256.0f;
+
+} // namespace
 
 MapView3D::MapView3D(
   AppController& appController, MapDocument& document, MapViewToolBox& toolBox)
@@ -124,6 +141,11 @@ void MapView3D::connectObservers()
   m_notifierConnection +=
     m_camera->cameraDidChangeNotifier.connect(this, &MapView3D::cameraDidChange);
 
+  m_notifierConnection += m_document.documentWasLoadedNotifier.connect(
+    this, &MapView3D::invalidateLoadPriorities);
+  m_notifierConnection += m_document.materialCollectionsDidChangeNotifier.connect(
+    this, &MapView3D::invalidateLoadPriorities);
+
   auto& prefs = PreferenceManager::instance();
   m_notifierConnection +=
     prefs.preferenceDidChangeNotifier.connect(this, &MapView3D::preferenceDidChange);
@@ -138,6 +160,11 @@ void MapView3D::cameraDidChange(const gl::Camera& /* camera */)
   }
 }
 
+void MapView3D::invalidateLoadPriorities()
+{
+  m_loadPriorityPosition = std::nullopt;
+}
+
 void MapView3D::preferenceDidChange(const std::filesystem::path& path)
 {
   if (path == Preferences::CameraFov.path)
@@ -214,6 +241,63 @@ mdl::PickResult MapView3D::pick(const vm::ray3d& pickRay) const
   return pickResult;
 }
 
+void MapView3D::updateLoadPriorities()
+{
+  const auto& position = m_camera->position();
+  if (
+    m_loadPriorityPosition
+    && vm::squared_distance(*m_loadPriorityPosition, position)
+         < LoadPriorityUpdateDistance * LoadPriorityUpdateDistance)
+  {
+    return;
+  }
+  m_loadPriorityPosition = position;
+
+  auto& map = m_document.map();
+  auto& materialManager = map.materialManager();
+
+  auto materialNames = std::vector<std::string>{};
+  const auto bounds = vm::bbox3d{
+    vm::vec3d{position} - vm::vec3d::fill(LoadPriorityDistance),
+    vm::vec3d{position} + vm::vec3d::fill(LoadPriorityDistance)};
+  for (auto* node : map.worldNode().nodeTree().find_intersectors(bounds))
+  {
+    node->accept(kdl::overload(
+      [](mdl::WorldNode*) {},
+      [](mdl::LayerNode*) {},
+      [](mdl::GroupNode*) {},
+      [](mdl::EntityNode*) {},
+      [&](mdl::BrushNode* brushNode) {
+        for (const auto& face : brushNode->brush().faces())
+        {
+          materialNames.push_back(face.attributes().materialName());
+        }
+      },
+      [&](mdl::PatchNode* patchNode) {
+        materialNames.push_back(patchNode->patch().materialName());
+      }));
+  }
+  materialNames = kdl::vec_sort_and_remove_duplicates(std::move(materialNames));
+
+  // materials are looked up by name because they may have been replaced in the meantime
+  for (const auto& materialName : m_prioritizedMaterialNames)
+  {
+    if (const auto* material = materialManager.material(materialName))
+    {
+      material->setLoadPriority(gl::ResourcePriority::Default);
+    }
+  }
+  for (const auto& materialName : materialNames)
+  {
+    if (const auto* material = materialManager.material(materialName))
+    {
+      material->setLoadPriority(gl::ResourcePriority::Visible);
+    }
+  }
+
+  m_prioritizedMaterialNames = std::move(materialNames);
+}
+
 void MapView3D::updateViewport(
   const int x, const int y, const int width, const int height)
 {
@@ -536,6 +620,7 @@ void MapView3D::renderMap(
   render::RenderContext& renderContext,
   render::RenderBatch& renderBatch)
 {
+  updateLoadPriorities();
   renderer.render(renderContext, renderBatch);
 
   const auto& map = m_document.map();
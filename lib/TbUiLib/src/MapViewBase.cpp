@@ -29,6 +29,7 @@
 #include "Logger.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "gl/AttrString.h"
 #include "gl/Camera.h"
 #include "gl/FontDescriptor.h"
 #include "gl/FontManager.h"
@@ -947,6 +948,11 @@ void MapViewBase::initializeGL()
   }
 }
 
+bool MapViewBase::shouldProfileFrames() const
+{
+  return isCurrent();
+}
+
 bool MapViewBase::shouldRenderFocusIndicator() const
 {
   return true;
@@ -1115,10 +1121,21 @@ void MapViewBase::renderCompass(render::RenderBatch& renderBatch)
 void MapViewBase::renderFPS(
   render::RenderContext& renderContext, render::RenderBatch& renderBatch)
 {
-  if (pref(Preferences::ShowFPS))
+  const auto showFPS = pref(Preferences::ShowFPS);
+  if (showFPS || !m_currentFrameProfile.empty())
   {
+    auto string = gl::AttrString{};
+    if (showFPS)
+    {
+      string.appendLeftJustified(m_currentFPS);
+    }
+    for (const auto& line : m_currentFrameProfile)
+    {
+      string.appendLeftJustified(line);
+    }
+
     auto renderService = render::RenderService{renderContext, renderBatch};
-    renderService.renderHeadsUp(m_currentFPS);
+    renderService.renderHeadsUp(string);
   }
 }
 
@@ -26,6 +26,7 @@
 #include <QFileDialog>
 #include <QInputDialog>
 #include <QLabel>
+#include <QLocale>
 #include <QMessageBox>
 #include <QMimeData>
 #include <QPushButton>
@@ -38,11 +39,14 @@
 #include <QVBoxLayout>
 #include <QtGlobal>
 
+#include "FrameProfiler.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "fs/DiskIO.h"
 #include "mdl/Autosaver.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
+#include "mdl/CommandProcessor.h"
 #include "mdl/EditorContext.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
@@ -733,7 +737,13 @@ QString describeSelection(const mdl::Map& map)
 
 void MapWindow::updateStatusBar()
 {
-  m_statusBarLabel->setText(QString{describeSelection(m_document->map())});
+  const auto& map = m_document->map();
+  const auto undoMemoryFootprint =
+    QLocale{}.formattedDataSize(qint64(map.commandProcessor().undoMemoryFootprint()));
+
+  m_statusBarLabel->setText(
+    describeSelection(map) + QLatin1String("   |   ")
+    + tr("Undo: %1").arg(undoMemoryFootprint));
 }
 
 void MapWindow::updateStatusBarDelayed()
@@ -825,6 +835,7 @@ void MapWindow::transactionDone(const std::string&, const bool, const bool)
     // before it's pushed onto the undo stack, but we need to read the undo stack in
     // updateUndoRedoActions(), so this QTimer::singleShot is needed for now.
     updateUndoRedoActions();
+    updateStatusBarDelayed();
   });
 }
 
@@ -833,6 +844,7 @@ void MapWindow::transactionUndone(const std::string&, const bool, const bool)
   QTimer::singleShot(0, this, [this]() {
     // FIXME: see MapWindow::transactionDone
     updateUndoRedoActions();
+    updateStatusBarDelayed();
   });
 }
 
@@ -1882,6 +1894,14 @@ void MapWindow::csgSubtract()
   }
 }
 
+void MapWindow::csgSubtractAndMerge()
+{
+  if (canDoCsgSubtract())
+  {
+    mdl::csgSubtract(m_document->map(), true);
+  }
+}
+
 bool MapWindow::canDoCsgSubtract() const
 {
   const auto& map = m_document->map();
@@ -2338,6 +2358,41 @@ void MapWindow::revealMaterial(const gl::Material* material)
   m_inspector->faceInspector()->revealMaterial(material);
 }
 
+void MapWindow::toggleFrameProfile()
+{
+  togglePref(Preferences::ShowFrameProfile);
+  FrameProfiler::instance().setEnabled(pref(Preferences::ShowFrameProfile));
+  m_mapView->refreshViews();
+}
+
+void MapWindow::saveFrameProfile()
+{
+  const auto& profiler = FrameProfiler::instance();
+  if (!profiler.enabled())
+  {
+    QMessageBox::information(
+      this,
+      "",
+      tr("The frame profiler is disabled. Enable it with View > Show Frame Profile."));
+    return;
+  }
+
+  const auto fileName = QFileDialog::getSaveFileName(
+    this, tr("Save Frame Profile"), "", "Chrome trace files (*.json)");
+  if (fileName.isEmpty())
+  {
+    return;
+  }
+
+  const auto path = pathFromQString(fileName);
+  fs::Disk::withOutputStream(
+    path, [&](auto& stream) { profiler.writeChromeTrace(stream); })
+    | kdl::transform([&]() { logger().info() << "Saved frame profile to " << path; })
+    | kdl::transform_error([&](auto e) {
+        logger().error() << "Could not save frame profile: " << e.msg;
+      });
+}
+
 void MapWindow::debugPrintVertices()
 {
   const auto& selection = m_document->map().selection();
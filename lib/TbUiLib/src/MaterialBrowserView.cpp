@@ -482,6 +482,11 @@ void MaterialBrowserView::doContextMenu(
   }
 }
 
+void MaterialBrowserView::doSetLoadPriority(const Cell& cell, const int priority)
+{
+  cellData(cell).setLoadPriority(priority);
+}
+
 const gl::Material& MaterialBrowserView::cellData(const Cell& cell) const
 {
   return *cell.itemAs<const gl::Material*>();
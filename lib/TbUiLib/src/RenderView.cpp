@@ -27,6 +27,7 @@
 #include <QTimer>
 #include <QWidget>
 
+#include "FrameProfiler.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "gl/ActiveShader.h"
@@ -75,13 +76,26 @@ RenderView::RenderView(AppController& appController, QWidget* parent)
     m_maxFrameTimeMsecs = 0;
     m_lastFPSCounterUpdate = currentTime;
 
+    const auto resourceStatistics =
+      m_appController.glManager().resourceManager().statistics();
+
     m_currentFPS = fmt::format(
-      R"(Avg FPS: {} Max time between frames: {}ms. {} currentVBOS({} peak) totalling {} KiB)",
+      R"(Avg FPS: {} Max time between frames: {}ms. {} currentVBOS({} peak) totalling {} KiB. {} resources ({} loading, {} reduced, {} evicted) totalling {} KiB)",
       avgFps,
       maxFrameTime,
       vboManager().currentVboCount(),
       vboManager().peakVboCount(),
-      vboManager().currentVboSize() / 1024u);
+      vboManager().currentVboSize() / 1024u,
+      resourceStatistics.readyCount,
+      resourceStatistics.loadingCount,
+      resourceStatistics.reducedCount,
+      resourceStatistics.evictedCount,
+      resourceStatistics.memorySize / 1024u);
+
+    const auto& profiler = FrameProfiler::instance();
+    m_currentFrameProfile = profiler.enabled()
+                              ? summarizeFrameProfiles(profiler.frames())
+                              : std::vector<std::string>{};
   });
 
   fpsCounter->start(1000);
@@ -176,7 +190,21 @@ bool RenderView::event(QEvent* event)
 
 void RenderView::paintGL()
 {
-  render();
+  auto& profiler = FrameProfiler::instance();
+  if (shouldProfileFrames())
+  {
+    profiler.setEnabled(pref(Preferences::ShowFrameProfile));
+
+    profiler.beginFrame();
+    render();
+    profiler.endFrame();
+  }
+  else
+  {
+    // don't attribute the paints of other views to the profiled frames
+    const auto suspend = SuspendProfiling{profiler};
+    render();
+  }
 
   // Update stats
   m_framesRendered++;
@@ -331,6 +359,11 @@ QOpenGLFunctions_2_1& RenderView::glFunctions()
   return *glFunctions;
 }
 
+bool RenderView::shouldProfileFrames() const
+{
+  return false;
+}
+
 bool RenderView::doInitializeGL()
 {
   auto gl = GlQt{glFunctions()};
@@ -159,6 +159,11 @@ QWidget* ViewPreferencePane::createViewPreferences()
   m_enableMsaa = new QCheckBox{};
   m_enableMsaa->setToolTip("Enable multisampling");
 
+  m_compressTextures = new QCheckBox{};
+  m_compressTextures->setToolTip(
+    "Compress textures when they are loaded to reduce video memory usage. Compressed "
+    "textures are cached on disk. Takes effect when textures are loaded.");
+
   m_materialBrowserIconSizeCombo = new QComboBox{};
   m_materialBrowserIconSizeCombo->addItem("25%");
   m_materialBrowserIconSizeCombo->addItem("50%");
@@ -200,6 +205,7 @@ QWidget* ViewPreferencePane::createViewPreferences()
   layout->addRow("Show axes", m_showAxes);
   layout->addRow("Filter mode", m_filterModeCombo);
   layout->addRow("Enable multisampling", m_enableMsaa);
+  layout->addRow("Compress textures", m_compressTextures);
 
   layout->addSection("Material Browser");
   layout->addRow("Icon size", m_materialBrowserIconSizeCombo);
@@ -247,6 +253,11 @@ void ViewPreferencePane::bindEvents()
     &QCheckBox::checkStateChanged,
     this,
     &ViewPreferencePane::enableMsaaChanged);
+  connect(
+    m_compressTextures,
+    &QCheckBox::checkStateChanged,
+    this,
+    &ViewPreferencePane::compressTexturesChanged);
   connect(
     m_themeCombo,
     QOverload<int>::of(&QComboBox::activated),
@@ -284,6 +295,7 @@ void ViewPreferencePane::doResetToDefaults()
   prefs.resetToDefault(Preferences::CameraFov);
   prefs.resetToDefault(Preferences::ShowAxes);
   prefs.resetToDefault(Preferences::EnableMSAA);
+  prefs.resetToDefault(Preferences::CompressTextures);
   prefs.resetToDefault(Preferences::TextureMinFilter);
   prefs.resetToDefault(Preferences::TextureMagFilter);
   prefs.resetToDefault(Preferences::Theme);
@@ -310,6 +322,7 @@ void ViewPreferencePane::updateControls()
 
   m_showAxes->setChecked(prefs.getPendingValue(Preferences::ShowAxes));
   m_enableMsaa->setChecked(prefs.getPendingValue(Preferences::EnableMSAA));
+  m_compressTextures->setChecked(prefs.getPendingValue(Preferences::CompressTextures));
   m_themeCombo->setCurrentIndex(
     findThemeIndex(QString::fromStdString(prefs.getPendingValue(Preferences::Theme))));
 
@@ -414,6 +427,13 @@ void ViewPreferencePane::enableMsaaChanged(const int state)
   prefs.set(Preferences::EnableMSAA, value);
 }
 
+void ViewPreferencePane::compressTexturesChanged(const int state)
+{
+  const auto value = state == Qt::Checked;
+  auto& prefs = PreferenceManager::instance();
+  prefs.set(Preferences::CompressTextures, value);
+}
+
 void ViewPreferencePane::filterModeChanged(const int value)
 {
   const auto index = static_cast<size_t>(value);
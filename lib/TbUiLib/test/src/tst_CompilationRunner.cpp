@@ -34,6 +34,7 @@ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 #include "ui/CatchConfig.h"
 #include "ui/CompilationContext.h"
 #include "ui/CompilationRunner.h"
+#include "ui/CompilationTaskOutput.h"
 #include "ui/CompilationVariables.h"
 #include "ui/TextOutputAdapter.h"
 
@@ -561,6 +562,177 @@ TEST_CASE("CompilationRunner")
       context.interpolate(toInterpolate)
       == startSubstr + map.path().parent_path().string() + midSubstr + testWorkDir);
   }
+
+  SECTION("invalid task dependencies")
+  {
+    auto compilationProfile = mdl::CompilationProfile{
+      "name",
+      testEnvironment.dir().string(),
+      {
+        mdl::CompilationDeleteFiles{
+          K(enabled), "does_not_exist.map", std::vector<size_t>{1}},
+      }};
+
+    auto runner = CompilationRunner{
+      CompilationContext{map, variables, outputAdapter, false}, compilationProfile};
+
+    auto compilationStartedSpy = QSignalSpy{&runner, SIGNAL(compilationStarted())};
+    auto compilationEndedSpy = QSignalSpy{&runner, SIGNAL(compilationEnded())};
+
+    runner.execute();
+    REQUIRE(!runner.running());
+    REQUIRE(compilationStartedSpy.count() == 1);
+    REQUIRE(compilationEndedSpy.count() == 1);
+
+    CHECK_THAT(
+      output.toPlainText().toStdString(), ContainsSubstring("Invalid task dependencies"));
+  }
+}
+
+TEST_CASE("CompilationRunner.concurrentTasks")
+{
+  auto fixture = mdl::MapFixture{};
+  auto& map = fixture.create();
+
+  auto testEnvironment = fs::TestEnvironment{};
+
+  const auto testWorkDir = testEnvironment.dir().string();
+  auto variables = CompilationVariables{map, testWorkDir};
+  auto output = QTextEdit{};
+  auto outputAdapter = TextOutputAdapter{&output};
+
+  const auto runTool =
+    [](const std::string& parameters, std::vector<size_t> dependencies) {
+      return mdl::CompilationRunTool{
+        K(enabled),
+        CMD_TOOL_PATH,
+        parameters,
+        K(treatNonZeroResultCodeAsError),
+        std::move(dependencies)};
+    };
+
+  const auto execute =
+    [&](const mdl::CompilationProfile& profile, const size_t jobLimit) {
+      auto runner = CompilationRunner{
+        CompilationContext{map, variables, outputAdapter, false}, profile, jobLimit};
+
+      auto compilationEndedSpy = QSignalSpy{&runner, SIGNAL(compilationEnded())};
+
+      runner.execute();
+      REQUIRE((compilationEndedSpy.count() == 1 || compilationEndedSpy.wait(10000)));
+      REQUIRE(!runner.running());
+    };
+
+  SECTION("independent tasks run concurrently")
+  {
+    // the first task only succeeds if the second task runs while it is waiting
+    auto compilationProfile = mdl::CompilationProfile{
+      "name",
+      testWorkDir,
+      {
+        runTool("--wait second 5000", {}),
+        runTool("--touch second", {}),
+      }};
+
+    execute(compilationProfile, 2);
+
+    const auto outputStr = output.toPlainText().toStdString();
+    CHECK_THAT(outputStr, ContainsSubstring("[0] #### Finished with exit code 0"));
+    CHECK_THAT(outputStr, ContainsSubstring("[1] #### Finished with exit code 0"));
+  }
+
+  SECTION("the job limit is respected")
+  {
+    auto compilationProfile = mdl::CompilationProfile{
+      "name",
+      testWorkDir,
+      {
+        runTool("--wait second 500", {}),
+        runTool("--touch second", {}),
+      }};
+
+    execute(compilationProfile, 1);
+
+    CHECK_THAT(
+      output.toPlainText().toStdString(),
+      ContainsSubstring("#### Finished with exit code 1"));
+    CHECK_FALSE(testEnvironment.fileExists("second"));
+  }
+
+  SECTION("tasks wait for their dependencies")
+  {
+    auto compilationProfile = mdl::CompilationProfile{
+      "name",
+      testWorkDir,
+      {
+        runTool("--touch first", {}),
+        runTool("--touch second", {}),
+        runTool("--wait first 0", {0}),
+        runTool("--wait second 0", {1}),
+      }};
+
+    execute(compilationProfile, 4);
+
+    const auto outputStr = output.toPlainText().toStdString();
+    CHECK_THAT(outputStr, ContainsSubstring("[2] #### Finished with exit code 0"));
+    CHECK_THAT(outputStr, ContainsSubstring("[3] #### Finished with exit code 0"));
+  }
+
+  SECTION("sequential profiles are not prefixed")
+  {
+    auto compilationProfile = mdl::CompilationProfile{
+      "name",
+      testWorkDir,
+      {
+        mdl::CompilationRunTool{K(enabled), CMD_TOOL_PATH, "--touch first", true},
+        mdl::CompilationRunTool{K(enabled), CMD_TOOL_PATH, "--wait first 0", true},
+      }};
+
+    execute(compilationProfile, 4);
+
+    const auto outputStr = output.toPlainText().toStdString();
+    CHECK_THAT(outputStr, ContainsSubstring("\n#### Finished with exit code 0"));
+    CHECK_THAT(outputStr, !ContainsSubstring("[0]"));
+  }
+}
+
+TEST_CASE("CompilationTaskOutput")
+{
+  auto fixture = mdl::MapFixture{};
+  auto& map = fixture.create();
+
+  auto variables = el::NullVariableStore{};
+  auto textEdit = QTextEdit{};
+  auto context =
+    CompilationContext{map, variables, TextOutputAdapter{&textEdit}, false};
+
+  auto output = CompilationTaskOutput{context};
+
+  SECTION("Without a prefix")
+  {
+    output << "abc\nd" << "ef";
+    CHECK(textEdit.toPlainText() == "abc\ndef");
+  }
+
+  SECTION("With a prefix")
+  {
+    output.setPrefix("[1] ");
+
+    output << "abc\nd";
+    CHECK(textEdit.toPlainText() == "[1] abc\n");
+
+    output << "ef\r\n";
+    CHECK(textEdit.toPlainText() == "[1] abc\n[1] def\n");
+
+    output << "progress 10%\rprogress 20%\r\n";
+    CHECK(textEdit.toPlainText() == "[1] abc\n[1] def\n[1] progress 20%\n");
+
+    output << 42;
+    CHECK(textEdit.toPlainText() == "[1] abc\n[1] def\n[1] progress 20%\n");
+
+    output.flush();
+    CHECK(textEdit.toPlainText() == "[1] abc\n[1] def\n[1] progress 20%\n[1] 42\n");
+  }
 }
 
 } // namespace tb::ui
@@ -0,0 +1,378 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "vm/constants.h"
+#include "vm/plane.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <tuple>
+#include <vector>
+
+namespace vm
+{
+namespace detail
+{
+/**
+ * The number of planes or triangles that the packed intersection functions process at
+ * once. Each block is processed by a branch free loop that the compiler can vectorize,
+ * and the results of the block are then reduced by a scalar loop.
+ */
+constexpr std::size_t packed_block_size = 16;
+} // namespace detail
+
+/**
+ * Stores the normals and distances of a sequence of planes in separate arrays of
+ * components (structure of arrays), so that a ray can be tested against all planes at
+ * once.
+ *
+ * @tparam T the component type
+ */
+template <typename T>
+class packed_planes
+{
+private:
+  std::size_t m_size = 0;
+  // the normal x, normal y, normal z and distance arrays, one after the other
+  std::vector<T> m_components;
+
+public:
+  packed_planes() = default;
+
+  /**
+   * Creates packed planes from the given range of planes.
+   *
+   * @tparam R the range type
+   * @param planes the planes
+   */
+  template <std::ranges::forward_range R>
+  explicit packed_planes(const R& planes)
+    : m_size{static_cast<std::size_t>(std::ranges::distance(planes))}
+    , m_components(4 * m_size)
+  {
+    auto i = std::size_t(0);
+    for (const plane<T, 3>& p : planes)
+    {
+      m_components[0 * m_size + i] = p.normal.x();
+      m_components[1 * m_size + i] = p.normal.y();
+      m_components[2 * m_size + i] = p.normal.z();
+      m_components[3 * m_size + i] = p.distance;
+      ++i;
+    }
+  }
+
+  std::size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  const T* nx() const { return m_components.data() + 0 * m_size; }
+  const T* ny() const { return m_components.data() + 1 * m_size; }
+  const T* nz() const { return m_components.data() + 2 * m_size; }
+  const T* d() const { return m_components.data() + 3 * m_size; }
+};
+
+/**
+ * Stores the first point and the two edge vectors of a sequence of triangles in separate
+ * arrays of components (structure of arrays), so that a ray can be tested against many
+ * triangles at once.
+ *
+ * @tparam T the component type
+ */
+template <typename T>
+class packed_triangles
+{
+private:
+  std::vector<T> m_p1[3];
+  std::vector<T> m_e1[3];
+  std::vector<T> m_e2[3];
+
+public:
+  packed_triangles() = default;
+
+  /**
+   * Appends the triangle with the given points.
+   *
+   * @param p1 the first point
+   * @param p2 the second point
+   * @param p3 the third point
+   */
+  void push_back(const vec<T, 3>& p1, const vec<T, 3>& p2, const vec<T, 3>& p3)
+  {
+    const auto e1 = p2 - p1;
+    const auto e2 = p3 - p1;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      m_p1[i].push_back(p1[i]);
+      m_e1[i].push_back(e1[i]);
+      m_e2[i].push_back(e2[i]);
+    }
+  }
+
+  /**
+   * Reserves space for the given number of triangles.
+   *
+   * @param count the number of triangles
+   */
+  void reserve(const std::size_t count)
+  {
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      m_p1[i].reserve(count);
+      m_e1[i].reserve(count);
+      m_e2[i].reserve(count);
+    }
+  }
+
+  std::size_t size() const { return m_p1[0].size(); }
+  bool empty() const { return m_p1[0].empty(); }
+
+  const T* p1(const std::size_t component) const { return m_p1[component].data(); }
+  const T* e1(const std::size_t component) const { return m_e1[component].data(); }
+  const T* e2(const std::size_t component) const { return m_e2[component].data(); }
+};
+
+/**
+ * Computes the point where the given ray enters the convex polyhedron bounded by the
+ * given planes, whose normals must point outwards.
+ *
+ * The ray enters the polyhedron at the farthest of the planes it passes through from
+ * the front, provided that this is not farther than the nearest plane it passes through
+ * from the back. A ray that starts inside the polyhedron does not hit it. Planes that are
+ * almost parallel to the ray cannot be entered; if the ray starts in front of such a
+ * plane, it misses the polyhedron.
+ *
+ * @tparam T the component type
+ * @param r the ray
+ * @param planes the planes bounding the polyhedron
+ * @return the distance from the origin of the ray to the point of intersection and the
+ * index of the plane that contains that point, or nullopt if the ray does not intersect
+ * the polyhedron
+ */
+template <typename T>
+std::optional<std::tuple<T, std::size_t>> intersect_ray_convex_polyhedron(
+  const ray<T, 3>& r, const packed_planes<T>& planes)
+{
+  constexpr auto block_size = detail::packed_block_size;
+  constexpr auto epsilon = constants<T>::almost_zero();
+  constexpr auto infinity = std::numeric_limits<T>::infinity();
+
+  const auto ox = r.origin.x(), oy = r.origin.y(), oz = r.origin.z();
+  const auto dx = r.direction.x(), dy = r.direction.y(), dz = r.direction.z();
+
+  auto enter_distance = -infinity;
+  auto enter_index = planes.size();
+  auto exit_distance = infinity;
+
+  for (std::size_t first = 0; first < planes.size(); first += block_size)
+  {
+    const auto count = std::min(block_size, planes.size() - first);
+    const auto* nx = planes.nx() + first;
+    const auto* ny = planes.ny() + first;
+    const auto* nz = planes.nz() + first;
+    const auto* d = planes.d() + first;
+
+    T cos[block_size], dist[block_size], height[block_size];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      cos[i] = nx[i] * dx + ny[i] * dy + nz[i] * dz;
+      height[i] = nx[i] * ox + ny[i] * oy + nz[i] * oz - d[i];
+      dist[i] = -height[i] / cos[i];
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (cos[i] < -epsilon)
+      {
+        if (dist[i] > enter_distance)
+        {
+          enter_distance = dist[i];
+          enter_index = first + i;
+        }
+      }
+      else if (cos[i] > epsilon)
+      {
+        exit_distance = std::min(exit_distance, dist[i]);
+      }
+      else if (height[i] > T(0))
+      {
+        return std::nullopt;
+      }
+    }
+  }
+
+  if (
+    enter_index == planes.size() || enter_distance < -epsilon
+    || enter_distance > exit_distance + epsilon)
+  {
+    return std::nullopt;
+  }
+
+  return std::tuple{enter_distance, enter_index};
+}
+
+namespace detail
+{
+/**
+ * Computes the distances at which the given ray intersects a block of triangles. Lane i
+ * tests the triangle at index indices(i) of the given packed triangles, and its distance
+ * is infinity if the ray misses that triangle.
+ *
+ * The computation mirrors intersect_ray_triangle operation by operation, so both agree
+ * on which triangles are hit and at which distance.
+ */
+template <typename T, typename I>
+void intersect_ray_triangle_block(
+  const ray<T, 3>& r,
+  const packed_triangles<T>& triangles,
+  const I& indices,
+  const std::size_t count,
+  T* distances)
+{
+  constexpr auto epsilon = constants<T>::almost_zero();
+  constexpr auto infinity = std::numeric_limits<T>::infinity();
+
+  const auto ox = r.origin.x(), oy = r.origin.y(), oz = r.origin.z();
+  const auto dx = r.direction.x(), dy = r.direction.y(), dz = r.direction.z();
+
+  const auto *p1x = triangles.p1(0), *p1y = triangles.p1(1), *p1z = triangles.p1(2);
+  const auto *e1x = triangles.e1(0), *e1y = triangles.e1(1), *e1z = triangles.e1(2);
+  const auto *e2x = triangles.e2(0), *e2y = triangles.e2(1), *e2z = triangles.e2(2);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const auto j = indices(i);
+
+    // p = cross(d, e2), a = dot(p, e1)
+    const auto px = dy * e2z[j] - dz * e2y[j];
+    const auto py = dz * e2x[j] - dx * e2z[j];
+    const auto pz = dx * e2y[j] - dy * e2x[j];
+    const auto a = T(0) + px * e1x[j] + py * e1y[j] + pz * e1z[j];
+
+    // t = o - p1, q = cross(t, e1)
+    const auto tx = ox - p1x[j];
+    const auto ty = oy - p1y[j];
+    const auto tz = oz - p1z[j];
+    const auto qx = ty * e1z[j] - tz * e1y[j];
+    const auto qy = tz * e1x[j] - tx * e1z[j];
+    const auto qz = tx * e1y[j] - ty * e1x[j];
+
+    const auto u = (T(0) + qx * e2x[j] + qy * e2y[j] + qz * e2z[j]) / a;
+    const auto v = (T(0) + px * tx + py * ty + pz * tz) / a;
+    const auto w = (T(0) + qx * dx + qy * dy + qz * dz) / a;
+
+    // combine the conditions without short circuiting to keep the loop branch free
+    const auto hit = !(std::abs(a) <= epsilon) & !(u < -epsilon) & !(v < -epsilon)
+                     & !(w < -epsilon) & !(v + w - T(1) > epsilon);
+    distances[i] = hit ? u : infinity;
+  }
+}
+
+template <typename T, typename I>
+std::optional<std::tuple<T, std::size_t>> intersect_ray_triangles(
+  const ray<T, 3>& r,
+  const packed_triangles<T>& triangles,
+  const std::size_t count,
+  const I& indices)
+{
+  constexpr auto block_size = detail::packed_block_size;
+
+  auto closest_distance = std::numeric_limits<T>::infinity();
+  auto closest_index = count;
+
+  T distances[block_size];
+  for (std::size_t first = 0; first < count; first += block_size)
+  {
+    const auto block_count = std::min(block_size, count - first);
+    intersect_ray_triangle_block(
+      r,
+      triangles,
+      [&](const std::size_t i) { return indices(first + i); },
+      block_count,
+      distances);
+
+    for (std::size_t i = 0; i < block_count; ++i)
+    {
+      if (distances[i] < closest_distance)
+      {
+        closest_distance = distances[i];
+        closest_index = first + i;
+      }
+    }
+  }
+
+  if (closest_index == count)
+  {
+    return std::nullopt;
+  }
+  return std::tuple{closest_distance, indices(closest_index)};
+}
+} // namespace detail
+
+/**
+ * Computes the closest point of intersection of the given ray and the given triangles.
+ * The result is the same as calling intersect_ray_triangle for every triangle and
+ * taking the minimum.
+ *
+ * @tparam T the component type
+ * @param r the ray
+ * @param triangles the triangles
+ * @return the distance from the origin of the ray to the closest point of intersection
+ * and the index of the intersected triangle, or nullopt if the ray does not intersect any
+ * of the triangles
+ */
+template <typename T>
+std::optional<std::tuple<T, std::size_t>> intersect_ray_triangles(
+  const ray<T, 3>& r, const packed_triangles<T>& triangles)
+{
+  return detail::intersect_ray_triangles(
+    r, triangles, triangles.size(), [](const std::size_t i) { return i; });
+}
+
+/**
+ * Computes the closest point of intersection of the given ray and the triangles with the
+ * given indices. The result is the same as calling intersect_ray_triangle for every
+ * selected triangle and taking the minimum.
+ *
+ * @tparam T the component type
+ * @param r the ray
+ * @param triangles the triangles
+ * @param indices the indices of the triangles to test
+ * @return the distance from the origin of the ray to the closest point of intersection
+ * and the index of the intersected triangle, or nullopt if the ray does not intersect any
+ * of the selected triangles
+ */
+template <typename T>
+std::optional<std::tuple<T, std::size_t>> intersect_ray_triangles(
+  const ray<T, 3>& r,
+  const packed_triangles<T>& triangles,
+  const std::vector<std::size_t>& indices)
+{
+  return detail::intersect_ray_triangles(
+    r, triangles, indices.size(), [&](const std::size_t i) { return indices[i]; });
+}
+
+} // namespace vm
@@ -0,0 +1,364 @@
+/*
+ Copyright (C) 2026 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "vm/approx.h"
+#include "vm/bbox.h"
+#include "vm/bbox_io.h" // IWYU pragma: keep
+#include "vm/constants.h"
+#include "vm/intersection.h"
+#include "vm/packed_intersection.h"
+#include "vm/plane.h"
+#include "vm/quat.h"
+#include "vm/ray.h"
+#include "vm/ray_io.h" // IWYU pragma: keep
+#include "vm/vec.h"
+#include "vm/vec_io.h" // IWYU pragma: keep
+
+#include <cmath>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace vm
+{
+namespace
+{
+
+struct face
+{
+  plane3d boundary;
+  std::vector<vec3d> vertices;
+};
+
+face makeFace(std::vector<vec3d> vertices, const vec3d& normal)
+{
+  const auto boundary = plane3d{dot(vertices[0], normal), normal};
+  return face{boundary, std::move(vertices)};
+}
+
+std::vector<face> makeBoxFaces(const bbox3d& box, const quatd& rotation)
+{
+  auto result = std::vector<face>{};
+  box.for_each_face(
+    [&](const auto& v1, const auto& v2, const auto& v3, const auto& v4, const auto& n) {
+      result.push_back(makeFace(
+        {rotation * v1, rotation * v2, rotation * v3, rotation * v4}, rotation * n));
+    });
+  return result;
+}
+
+// a prism with the given number of sides, so it has two more faces than sides
+std::vector<face> makePrismFaces(
+  const size_t sideCount,
+  const double radius,
+  const double height,
+  const vec3d& center,
+  const quatd& rotation)
+{
+  const auto transform = [&](const vec3d& v) { return rotation * v + center; };
+  const auto corner = [&](const size_t i, const double z) {
+    const auto angle =
+      2.0 * constants<double>::pi() * double(i % sideCount) / double(sideCount);
+    return vec3d{radius * std::cos(angle), radius * std::sin(angle), z};
+  };
+
+  auto result = std::vector<face>{};
+  auto top = std::vector<vec3d>{};
+  auto bottom = std::vector<vec3d>{};
+  for (size_t i = 0; i < sideCount; ++i)
+  {
+    const auto angle =
+      2.0 * constants<double>::pi() * (double(i) + 0.5) / double(sideCount);
+    const auto normal = vec3d{std::cos(angle), std::sin(angle), 0.0};
+    result.push_back(makeFace(
+      {transform(corner(i, -height)),
+       transform(corner(i + 1, -height)),
+       transform(corner(i + 1, height)),
+       transform(corner(i, height))},
+      rotation * normal));
+
+    top.push_back(transform(corner(i, height)));
+    bottom.push_back(transform(corner(sideCount - i, -height)));
+  }
+  result.push_back(makeFace(std::move(top), rotation * vec3d{0, 0, 1}));
+  result.push_back(makeFace(std::move(bottom), rotation * vec3d{0, 0, -1}));
+
+  return result;
+}
+
+packed_planes<double> packPlanes(const std::vector<face>& faces)
+{
+  return packed_planes<double>{
+    faces | std::views::transform([](const auto& face) { return face.boundary; })};
+}
+
+// mirrors how a brush finds the face hit by a ray, one face polygon at a time
+std::optional<std::tuple<double, size_t>> intersectRayFaces(
+  const ray3d& r, const std::vector<face>& faces)
+{
+  for (size_t i = 0; i < faces.size(); ++i)
+  {
+    const auto& face = faces[i];
+    if (dot(face.boundary.normal, r.direction) < 0.0)
+    {
+      if (
+        const auto distance = intersect_ray_polygon(
+          r, face.boundary, face.vertices.begin(), face.vertices.end()))
+      {
+        return std::tuple{*distance, i};
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+std::optional<std::tuple<T, size_t>> intersectRayTriangles(
+  const ray<T, 3>& r,
+  const std::vector<vec<T, 3>>& points,
+  const std::vector<size_t>& indices)
+{
+  auto result = std::optional<std::tuple<T, size_t>>{};
+  for (const auto i : indices)
+  {
+    if (
+      const auto distance = intersect_ray_triangle(
+        r, points[3 * i + 0], points[3 * i + 1], points[3 * i + 2]))
+    {
+      if (!result || *distance < std::get<0>(*result))
+      {
+        result = std::tuple{*distance, i};
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T>
+void checkSameHit(
+  const std::optional<std::tuple<T, size_t>>& actual,
+  const std::optional<std::tuple<T, size_t>>& expected)
+{
+  REQUIRE(actual.has_value() == expected.has_value());
+  if (expected)
+  {
+    CHECK(std::get<0>(*actual) == approx{std::get<0>(*expected)});
+    CHECK(std::get<1>(*actual) == std::get<1>(*expected));
+  }
+}
+
+template <typename T>
+vec<T, 3> makeRandomPoint(std::mt19937& rng, const double size)
+{
+  auto distribution = std::uniform_real_distribution<double>{-size, size};
+  return vec<T, 3>{vec3d{distribution(rng), distribution(rng), distribution(rng)}};
+}
+
+template <typename T>
+ray<T, 3> makeRandomRay(
+  std::mt19937& rng, const double originSize, const double targetSize)
+{
+  const auto origin = makeRandomPoint<T>(rng, originSize);
+  const auto target = makeRandomPoint<T>(rng, targetSize);
+  return ray<T, 3>{origin, normalize(target - origin)};
+}
+
+} // namespace
+
+TEST_CASE("packed_intersection.intersect_ray_convex_polyhedron")
+{
+  SECTION("empty")
+  {
+    CHECK(
+      intersect_ray_convex_polyhedron(
+        ray3d{vec3d{0, 0, 0}, vec3d{1, 0, 0}}, packed_planes<double>{})
+      == std::nullopt);
+  }
+
+  SECTION("axis aligned box")
+  {
+    const auto faces = makeBoxFaces(bbox3d{16.0}, quatd{vec3d{0, 0, 1}, 0.0});
+    const auto planes = packPlanes(faces);
+
+    // top face
+    CHECK(
+      intersect_ray_convex_polyhedron(ray3d{vec3d{0, 0, 32}, vec3d{0, 0, -1}}, planes)
+      == std::tuple{16.0, size_t(0)});
+
+    // starts inside
+    CHECK(
+      intersect_ray_convex_polyhedron(ray3d{vec3d{0, 0, 0}, vec3d{0, 0, -1}}, planes)
+      == std::nullopt);
+
+    // points away
+    CHECK(
+      intersect_ray_convex_polyhedron(ray3d{vec3d{0, 0, 32}, vec3d{0, 0, 1}}, planes)
+      == std::nullopt);
+
+    // parallel to the top face, but above it
+    CHECK(
+      intersect_ray_convex_polyhedron(ray3d{vec3d{-32, 0, 17}, vec3d{1, 0, 0}}, planes)
+      == std::nullopt);
+
+    // parallel to the top face, but below it
+    CHECK(
+      intersect_ray_convex_polyhedron(ray3d{vec3d{-32, 0, 15}, vec3d{1, 0, 0}}, planes)
+      == std::tuple{16.0, size_t(4)});
+  }
+
+  SECTION("matches intersecting the face polygons")
+  {
+    auto rng = std::mt19937{7};
+    for (size_t i = 0; i < 64; ++i)
+    {
+      const auto axis = normalize(makeRandomPoint<double>(rng, 1.0));
+      const auto angle = std::uniform_real_distribution<double>{0.0, 3.0}(rng);
+      const auto box = bbox3d{makeRandomPoint<double>(rng, 8.0) - vec3d::fill(24.0),
+                              makeRandomPoint<double>(rng, 8.0) + vec3d::fill(24.0)};
+
+      const auto faces = makeBoxFaces(box, quatd{axis, angle});
+      const auto planes = packPlanes(faces);
+
+      for (size_t j = 0; j < 256; ++j)
+      {
+        const auto r = makeRandomRay<double>(rng, 128.0, 48.0);
+        CAPTURE(box, axis, angle, r);
+
+        checkSameHit(
+          intersect_ray_convex_polyhedron(r, planes), intersectRayFaces(r, faces));
+      }
+    }
+  }
+
+  SECTION("matches intersecting the face polygons of polyhedra with many faces")
+  {
+    // the planes are processed in blocks of 16, so these polyhedra have planes in
+    // partially and completely filled blocks
+    auto rng = std::mt19937{13};
+    for (const auto sideCount : {13u, 14u, 15u, 30u, 40u})
+    {
+      const auto axis = normalize(makeRandomPoint<double>(rng, 1.0));
+      const auto angle = std::uniform_real_distribution<double>{0.0, 3.0}(rng);
+      const auto center = makeRandomPoint<double>(rng, 8.0);
+
+      const auto faces =
+        makePrismFaces(sideCount, 32.0, 24.0, center, quatd{axis, angle});
+      REQUIRE(faces.size() == sideCount + 2);
+
+      const auto planes = packPlanes(faces);
+
+      auto hitFaceIndices = std::vector<bool>(faces.size(), false);
+      for (size_t j = 0; j < 4096; ++j)
+      {
+        const auto r = makeRandomRay<double>(rng, 128.0, 40.0);
+        CAPTURE(sideCount, axis, angle, center, r);
+
+        const auto expected = intersectRayFaces(r, faces);
+        checkSameHit(intersect_ray_convex_polyhedron(r, planes), expected);
+
+        if (expected)
+        {
+          hitFaceIndices[std::get<1>(*expected)] = true;
+        }
+      }
+
+      // the faces in the last block were hit, too
+      CHECK(hitFaceIndices.back());
+      CHECK(hitFaceIndices[faces.size() - 3]);
+    }
+  }
+}
+
+TEST_CASE("packed_intersection.intersect_ray_triangles")
+{
+  SECTION("empty")
+  {
+    CHECK(
+      intersect_ray_triangles(
+        ray3d{vec3d{0, 0, 0}, vec3d{1, 0, 0}}, packed_triangles<double>{})
+      == std::nullopt);
+  }
+
+  SECTION("closest triangle")
+  {
+    auto triangles = packed_triangles<float>{};
+    triangles.push_back({-1, -1, 4}, {1, -1, 4}, {0, 1, 4});
+    triangles.push_back({-1, -1, 2}, {1, -1, 2}, {0, 1, 2});
+    triangles.push_back({-1, -1, 8}, {1, -1, 8}, {0, 1, 8});
+    triangles.push_back({3, -1, 1}, {5, -1, 1}, {4, 1, 1});
+
+    const auto r = ray3f{vec3f{0, 0, 0}, vec3f{0, 0, 1}};
+    CHECK(intersect_ray_triangles(r, triangles) == std::tuple{2.0f, size_t(1)});
+    CHECK(
+      intersect_ray_triangles(r, triangles, std::vector<size_t>{0, 2, 3})
+      == std::tuple{4.0f, size_t(0)});
+    CHECK(
+      intersect_ray_triangles(r, triangles, std::vector<size_t>{3}) == std::nullopt);
+  }
+
+  SECTION("matches intersect_ray_triangle")
+  {
+    auto rng = std::mt19937{11};
+    for (const auto triangleCount : {1u, 15u, 16u, 17u, 100u})
+    {
+      auto points = std::vector<vec3f>{};
+      auto triangles = packed_triangles<float>{};
+      for (size_t i = 0; i < triangleCount; ++i)
+      {
+        const auto center = makeRandomPoint<float>(rng, 32.0);
+        const auto p1 = center + makeRandomPoint<float>(rng, 8.0);
+        const auto p2 = center + makeRandomPoint<float>(rng, 8.0);
+        const auto p3 = center + makeRandomPoint<float>(rng, 8.0);
+        points.insert(points.end(), {p1, p2, p3});
+        triangles.push_back(p1, p2, p3);
+      }
+
+      auto allIndices = std::vector<size_t>{};
+      auto someIndices = std::vector<size_t>{};
+      for (size_t i = 0; i < triangleCount; ++i)
+      {
+        allIndices.push_back(i);
+        if (i % 3 != 1)
+        {
+          someIndices.push_back(i);
+        }
+      }
+
+      for (size_t j = 0; j < 1024; ++j)
+      {
+        const auto r = makeRandomRay<float>(rng, 96.0, 40.0);
+        CAPTURE(triangleCount, r);
+
+        checkSameHit(
+          intersect_ray_triangles(r, triangles),
+          intersectRayTriangles(r, points, allIndices));
+        checkSameHit(
+          intersect_ray_triangles(r, triangles, someIndices),
+          intersectRayTriangles(r, points, someIndices));
+      }
+    }
+  }
+}
+
+} // namespace vm